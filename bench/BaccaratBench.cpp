@@ -0,0 +1,47 @@
+// Times the exact analysis of a fresh eight deck shoe and the side bet simulator in coups per second, dealing from
+// eight deck shoes and from an infinite deck.
+//
+// usage: BaccaratBench [coups] [threads]
+
+#include <Baccarat.hpp>
+#include <Shoe.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::uint64_t num_coups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+  const std::size_t num_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+  const auto start = Clock::now();
+  const BaccaratDistribution distribution{ Shoe(8) };
+  const double exact = std::chrono::duration<double>(Clock::now() - start).count();
+
+  const BaccaratBet bets[] = { &banker_bet, &player_bet, &tie_bet, &player_pair_bet, &dragon_seven_bet,
+                               &panda_eight_bet };
+  const char* names[] = { "banker", "player", "tie", "player pair", "dragon 7", "panda 8" };
+  const BaccaratSimulator simulator(BaccaratSimulator::Config{});
+  const auto simulation_start = Clock::now();
+  const BaccaratSimulation simulation = simulator.run(bets, 6, num_coups, num_threads);
+  const double simulated = std::chrono::duration<double>(Clock::now() - simulation_start).count();
+
+  BaccaratSimulator::Config infinite_config;
+  infinite_config.infinite_deck = true;
+  const auto infinite_start = Clock::now();
+  BaccaratSimulator(infinite_config).run(bets, 6, num_coups, num_threads);
+  const double infinite = std::chrono::duration<double>(Clock::now() - infinite_start).count();
+
+  std::printf("exact analysis %.4f s, simulation %.0f coups/s over %llu shoes, %.0f coups/s from an infinite deck\n",
+              exact, num_coups / simulated, static_cast<unsigned long long>(simulation.shoes), num_coups / infinite);
+  for (std::size_t bet = 0; bet < 6; ++bet)
+  {
+    std::printf("%-12s exact %+.6f simulated %+.6f +- %.6f\n", names[bet], distribution.expected_value(bets[bet]),
+                simulation.means[bet], simulation.standard_errors[bet]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+// Times the one time crib cache and the discard analysis of random six card deals.
+//
+// usage: CribbageBench [deals] [threads]
+
+#include <Cribbage.hpp>
+#include <Deck.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t num_deals = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const std::size_t num_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+  const auto start = Clock::now();
+  const CribbageAnalyzer analyzer(num_threads);
+  const auto cached = Clock::now();
+
+  std::mt19937_64 generator(1);
+  std::vector<CardId> cards(NumCards);
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    cards[card] = card;
+  }
+  double total = 0;
+  const auto analyzing = Clock::now();
+  for (std::size_t deal = 0; deal < num_deals; ++deal)
+  {
+    // a partial Fisher-Yates shuffle of the first six cards
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+      std::swap(cards[i], cards[i + generator() % (NumCards - i)]);
+    }
+    total += analyzer.analyze(CardSet(cards.data(), 6), deal % 2 == 0)[0].expected_value;
+  }
+  const auto analyzed = Clock::now();
+
+  std::printf("crib cache %.3f s, %.2f us per analysis, average best discard %.4f points\n",
+              std::chrono::duration<double>(cached - start).count(),
+              std::chrono::duration<double, std::micro>(analyzed - analyzing).count() / num_deals, total / num_deals);
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+// Compares shuffling and random access dealing over a DeckBatch backed by regular, transparent huge and explicit huge
+// pages, reporting decks per second and dTLB load misses.
+//
+// usage: DeckBatchBench [num_decks] [rounds]
+
+#include <DeckBatch.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// counts dTLB load misses of this thread, if the kernel lets us
+class TlbMissCounter
+{
+public:
+  TlbMissCounter()
+    : m_fd(-1)
+  {
+#if defined(__linux__)
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  ~TlbMissCounter()
+  {
+#if defined(__linux__)
+    if (m_fd >= 0)
+    {
+      close(m_fd);
+    }
+#endif
+  }
+
+  void start()
+  {
+#if defined(__linux__)
+    if (m_fd >= 0)
+    {
+      ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // returns -1 when counting is unavailable
+  long long stop()
+  {
+    long long count = -1;
+#if defined(__linux__)
+    if (m_fd >= 0)
+    {
+      ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+      {
+        count = -1;
+      }
+    }
+#endif
+    return count;
+  }
+
+private:
+  int m_fd;
+};
+
+const char* mode_name(deck_of_cards::PageMode mode)
+{
+  switch (mode)
+  {
+    case deck_of_cards::PageMode::Default:
+      return "4k";
+    case deck_of_cards::PageMode::Transparent:
+      return "thp";
+    case deck_of_cards::PageMode::Explicit:
+      return "hugetlb";
+  }
+  return "?";
+}
+
+void report(const char* name, deck_of_cards::PageMode requested, const deck_of_cards::DeckBatch& batch,
+            double decks, double seconds, long long misses)
+{
+  std::printf("%-8s requested %-8s obtained %-8s %12.0f decks/s", name, mode_name(requested),
+              mode_name(batch.page_mode()), decks / seconds);
+  if (misses >= 0)
+  {
+    std::printf(" %10.3f dTLB misses/deck\n", misses / decks);
+  }
+  else
+  {
+    std::printf("       dTLB misses n/a\n");
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t num_decks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1 << 18;
+  const int rounds = argc > 2 ? std::atoi(argv[2]) : 10;
+
+  const PageMode modes[] = { PageMode::Default, PageMode::Transparent, PageMode::Explicit };
+  for (const auto mode : modes)
+  {
+    DeckBatch batch(num_decks, mode);
+    std::mt19937 generator(42);
+    TlbMissCounter counter;
+
+    // sequential sweep: shuffle every deck
+    counter.start();
+    auto start = Clock::now();
+    for (int round = 0; round < rounds; ++round)
+    {
+      batch.reset_all();
+      batch.shuffle_all(generator);
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    report("shuffle", mode, batch, static_cast<double>(num_decks) * rounds, seconds, counter.stop());
+
+    // random access: deal a hand from a random table, as a table server does
+    CardId hand[2];
+    std::uint64_t checksum = 0;
+    const std::size_t deals = num_decks * rounds;
+    counter.start();
+    start = Clock::now();
+    for (std::size_t deal = 0; deal < deals; ++deal)
+    {
+      const std::size_t deck = generator() % num_decks;
+      if (batch.deal_cards(deck, hand, 2) < 2)
+      {
+        batch.order(deck)[NumCards] = 0;
+      }
+      checksum += hand[0];
+    }
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    report("deal", mode, batch, static_cast<double>(deals), seconds, counter.stop());
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+  }
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+// Times range against range equity on a flop, the full range against itself and a top 20 percent style range against
+// the full range, then compares the precision of the equity simulator's sampling modes on a flush draw against an
+// overpair, preflop and on the flop.
+//
+// usage: EquityBench [threads]
+
+#include <Equity.hpp>
+#include <HandEvaluator.hpp>
+#include <PreflopEquity.hpp>
+#include <Range.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t num_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 0;
+  const CardId flop_cards[] = { card_id(Suit::Heart, Value::King), card_id(Suit::Diamond, Value::Eight),
+                                card_id(Suit::Heart, Value::Three) };
+  const CardSet flop(flop_cards, 3);
+  HandEvaluator::instance();
+
+  // pairs and two broadway cards
+  Range strong;
+  for (std::size_t combo = 0; combo < NumCombos; ++combo)
+  {
+    const int low = (combo_low_card(combo) % 13 + 12) % 13;
+    const int high = (combo_high_card(combo) % 13 + 12) % 13;
+    if (low == high || (low >= 8 && high >= 8))
+    {
+      strong.set_weight(combo, 1);
+    }
+  }
+  const Range full = Range::full();
+
+  const Range* spots[][2] = { { &full, &full }, { &strong, &full } };
+  const char* names[] = { "full vs full", "strong vs full" };
+  for (std::size_t spot = 0; spot < 2; ++spot)
+  {
+    const auto start = Clock::now();
+    const EquityResult result = range_equity(*spots[spot][0], *spots[spot][1], flop, CardSet(), num_threads);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::printf("%-15s equity %.4f over %llu runouts in %.3f s\n", names[spot], result.equity,
+                static_cast<unsigned long long>(result.runouts), seconds);
+  }
+
+  const CardId hero_cards[] = { card_id(Suit::Heart, Value::Ace), card_id(Suit::Heart, Value::Jack) };
+  const CardId villain_cards[] = { card_id(Suit::Spade, Value::Queen), card_id(Suit::Club, Value::Queen) };
+  const CardSet hero(hero_cards, 2);
+  const CardSet villain(villain_cards, 2);
+  const CardSet boards[] = { CardSet(), flop };
+  const EquitySampling samplings[] = { EquitySampling::Independent, EquitySampling::Antithetic,
+                                       EquitySampling::Stratified, EquitySampling::ControlVariate };
+  const char* sampling_names[] = { "independent", "antithetic", "stratified", "control variate" };
+  const std::uint64_t num_deals = 1000000;
+  for (const CardSet board : boards)
+  {
+    std::printf("%s, exact equity %.5f\n", board.size() == 0 ? "preflop" : "flop",
+                heads_up_equity(hero, villain, board));
+    for (std::size_t sampling = 0; sampling < 4; ++sampling)
+    {
+      EquitySimulator::Config config;
+      config.sampling = samplings[sampling];
+      const auto start = Clock::now();
+      const EquitySimulation simulation = EquitySimulator(config).run(hero, villain, board, num_deals, num_threads);
+      const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      std::printf("  %-15s equity %.5f +- %.5f, %.2f effective deals per deal, %.1f ns per deal\n",
+                  sampling_names[sampling], simulation.equity, simulation.standard_error,
+                  simulation.effective_deals / static_cast<double>(simulation.deals), seconds * 1e9 / num_deals);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+// Compares the lookup table and bitsliced hand category kernels on dealt 7 card hands, and reports the kernel that
+// BitslicedEvaluator::calibrate() picks for this CPU.
+//
+// usage: HandCategoryBench [num_hands] [rounds]
+
+#include <BitslicedEvaluator.hpp>
+#include <DeckBatch.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+const char* kernel_name(deck_of_cards::BitslicedEvaluator::Kernel kernel)
+{
+  switch (kernel)
+  {
+    case deck_of_cards::BitslicedEvaluator::Kernel::Lookup:
+      return "lookup";
+    case deck_of_cards::BitslicedEvaluator::Kernel::Bitsliced64:
+      return "bitsliced64";
+    case deck_of_cards::BitslicedEvaluator::Kernel::Bitsliced512:
+      return "bitsliced512";
+  }
+  return "?";
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t num_hands = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1 << 20;
+  const int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+  // deal one 7 card hand from each of num_hands shuffled decks
+  DeckBatch decks(num_hands);
+  std::mt19937 generator(7);
+  decks.shuffle_all(generator);
+  std::vector<CardSet> hands(num_hands);
+  for (std::size_t i = 0; i < num_hands; ++i)
+  {
+    CardId cards[7];
+    decks.deal_cards(i, cards, 7);
+    hands[i] = CardSet(cards, 7);
+  }
+  std::vector<HandCategory> categories(num_hands);
+  HandEvaluator::instance();
+
+  const BitslicedEvaluator::Kernel kernels[] = { BitslicedEvaluator::Kernel::Lookup,
+                                                 BitslicedEvaluator::Kernel::Bitsliced64,
+                                                 BitslicedEvaluator::Kernel::Bitsliced512 };
+  for (const auto kernel : kernels)
+  {
+    const BitslicedEvaluator evaluator(kernel);
+    const auto start = Clock::now();
+    for (int round = 0; round < rounds; ++round)
+    {
+      evaluator.categorize(hands.data(), categories.data(), num_hands);
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::printf("%-13s %12.0f hands/s\n", kernel_name(kernel), static_cast<double>(num_hands) * rounds / seconds);
+  }
+  std::printf("calibrated    %s\n", kernel_name(BitslicedEvaluator::calibrate()));
+
+  return 0;
+}
@@ -0,0 +1,70 @@
+// Times applying permutations to many decks and composing a chain of permutations, in nanoseconds per operation.
+// Configure with -DDECK_OF_CARDS_NATIVE=ON to compare the vpermb or pshufb kernels with the byte loop.
+//
+// usage: PermutationBench [iterations]
+
+#include <DeckBatch.hpp>
+#include <Permutation.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000000;
+
+  // a handful of random permutations, cycled through so that no work can be hoisted out of the loops
+  std::mt19937 generator(1);
+  std::vector<Permutation> permutations;
+  for (int i = 0; i < 16; ++i)
+  {
+    std::uint8_t sources[NumCards];
+    std::iota(sources, sources + NumCards, 0);
+    std::shuffle(sources, sources + NumCards, generator);
+    permutations.emplace_back(sources);
+  }
+
+  // permute a thousand decks in place, as when replaying the shuffles of many tables: packed back to back as 52 byte
+  // orders, whose vectors straddle cache lines, and as the cache lines of a DeckBatch
+  constexpr std::size_t NumDecks = 1024;
+  std::vector<CardId> decks(NumDecks * NumCards);
+  for (std::size_t i = 0; i < decks.size(); ++i)
+  {
+    decks[i] = static_cast<CardId>(i % NumCards);
+  }
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    CardId* cards = decks.data() + i % NumDecks * NumCards;
+    apply(permutations[i % 16], cards, cards);
+  }
+  const double applied = std::chrono::duration<double>(Clock::now() - start).count();
+
+  DeckBatch batch(NumDecks);
+  start = Clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    batch.permute(i % NumDecks, permutations[i % 16]);
+  }
+  const double permuted = std::chrono::duration<double>(Clock::now() - start).count();
+
+  Permutation composed;
+  start = Clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    composed = compose(composed, permutations[i % 16]);
+  }
+  const double composing = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::printf("apply %.2f ns, DeckBatch::permute %.2f ns, compose %.2f ns (checksum %d)\n", applied * 1e9 / iterations,
+              permuted * 1e9 / iterations, composing * 1e9 / iterations, decks[0] + batch.order(0)[0] + composed[0]);
+
+  return 0;
+}
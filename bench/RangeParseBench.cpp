@@ -0,0 +1,64 @@
+// Times batch parsing of typical range strings, uncached and through a RangeCache that already holds them.
+//
+// usage: RangeParseBench [ranges] [rounds]
+
+#include <Range.hpp>
+#include <RangeParser.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t num_ranges = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+  const std::size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+
+  // opening ranges of varying width and mixing weight, all distinct
+  const char* const pairs[] = { "22+", "44+", "66+", "88+", "TT+", "QQ+" };
+  const char* const suited[] = { "A2s+", "A5s-A2s", "K9s+", "QTs+", "JTs", "T9s:0.5", "98s:0.5" };
+  const char* const offsuit[] = { "ATo+", "AJo+", "KQo", "KJo:0.25", "QJo:0.5" };
+  std::vector<std::string> texts;
+  for (std::size_t i = 0; i < num_ranges; ++i)
+  {
+    texts.push_back(std::string(pairs[i % 6]) + ", " + suited[i % 7] + ", " + offsuit[i % 5] + ", AhKh:0." +
+                    std::to_string(i + 1));
+  }
+
+  double checksum = 0;
+  const auto start = Clock::now();
+  for (std::size_t round = 0; round < rounds; ++round)
+  {
+    for (const auto& text : texts)
+    {
+      checksum += parse_range(text).num_combos();
+    }
+  }
+  const double parsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  RangeCache cache(num_ranges);
+  for (const auto& text : texts)
+  {
+    cache.get(text);
+  }
+  const auto cached_start = Clock::now();
+  for (std::size_t round = 0; round < rounds; ++round)
+  {
+    for (const auto& text : texts)
+    {
+      checksum += cache.get(text)->num_combos();
+    }
+  }
+  const double cached = std::chrono::duration<double>(Clock::now() - cached_start).count();
+
+  const double total = static_cast<double>(num_ranges * rounds);
+  std::printf("parse  %10.0f ranges/s (%.2f us each)\n", total / parsed, parsed / total * 1e6);
+  std::printf("cached %10.0f ranges/s (%.2f us each)\n", total / cached, cached / total * 1e6);
+  std::printf("checksum %.1f\n", checksum);
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+// Deals hold'em hands on 100,000 tables multiplexed onto a TableScheduler: every round posts one hand to every table,
+// which shuffles the table's deck and deals nine players and a board. Reports hands per second and the time to build
+// the tables.
+//
+// usage: TableSchedulerBench [num_tables] [threads] [rounds]
+
+#include <TableScheduler.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t num_tables = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const std::size_t num_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+  const int rounds = argc > 3 ? std::atoi(argv[3]) : 20;
+
+  const auto start = Clock::now();
+  TableScheduler scheduler(num_tables, num_threads);
+  const double setup = std::chrono::duration<double>(Clock::now() - start).count();
+  std::printf("%zu tables on %zu threads built in %.1f ms\n", num_tables, scheduler.num_threads(), setup * 1e3);
+
+  std::atomic<std::uint64_t> checksum(0);
+  for (int round = 0; round < rounds; ++round)
+  {
+    const auto round_start = Clock::now();
+    for (TableId table = 0; table < num_tables; ++table)
+    {
+      scheduler.post(table, [&checksum](TableState& state) {
+        CardId cards[9 * 2 + 5];
+        state.deck.reset();
+        state.shuffle();
+        state.deck.deal_cards(cards, sizeof(cards));
+        checksum.fetch_add(cards[0], std::memory_order_relaxed);
+      });
+    }
+    scheduler.wait_idle();
+    const double seconds = std::chrono::duration<double>(Clock::now() - round_start).count();
+    std::printf("round %2d: %.2f M hands/s\n", round, static_cast<double>(num_tables) / seconds * 1e-6);
+  }
+  std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum.load()));
+
+  return 0;
+}
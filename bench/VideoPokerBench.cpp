@@ -0,0 +1,33 @@
+// Times the one time draw tables, a solver for one paytable and the full optimal strategy analysis of the paytable.
+//
+// usage: VideoPokerBench [threads]
+
+#include <VideoPoker.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  const std::size_t num_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 0;
+  const Paytable paytables[] = { Paytable::jacks_or_better(), { { 0, 0, 1, 2, 3, 4, 5, 8, 25, 50, 800 } } };
+  const char* names[] = { "9/6 jacks or better", "8/5 jacks or better" };
+
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    const auto start = Clock::now();
+    const VideoPokerSolver solver(paytables[i]);
+    const auto solved = Clock::now();
+    const VideoPokerAnalysis analysis = solver.analyze(num_threads);
+    const auto analyzed = Clock::now();
+    std::printf("%s: return %.6f over %llu deal classes, solver %.3f s, analysis %.3f s\n", names[i],
+                analysis.expected_return, static_cast<unsigned long long>(analysis.deal_classes),
+                std::chrono::duration<double>(solved - start).count(),
+                std::chrono::duration<double>(analyzed - solved).count());
+  }
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Walker's alias method: draws from a discrete distribution in constant time with one random number per draw.
+ *
+ * Every outcome owns a column holding a threshold and an alias. A draw picks a column with the high 32 bits of a
+ * random number and returns the column's own outcome if the low 32 bits fall below its threshold, else its alias.
+ * Probabilities are kept to 32 bits, so each is exact to within 2^-32.
+ */
+class AliasTable
+{
+public:
+  /**
+   * @brief Builds the table with Vose's stable variant of the construction.
+   *
+   * @param weights The non negative weight of every outcome; outcomes of weight 0 are never drawn.
+   * @param num_weights The number of outcomes.
+   *
+   * @throws std::invalid_argument if there are no outcomes, more than 2^32 of them, a weight is negative or not
+   * finite, or every weight is 0.
+   */
+  AliasTable(const double* weights, std::size_t num_weights);
+
+  /**
+   * @brief Draws an outcome.
+   *
+   * @param random A uniformly distributed 64 bit number.
+   * @return The outcome index.
+   */
+  std::size_t sample(std::uint64_t random) const noexcept
+  {
+    const std::size_t column = static_cast<std::size_t>(((random >> 32) * m_thresholds.size()) >> 32);
+    return (random & 0xFFFFFFFF) < m_thresholds[column] ? column : m_aliases[column];
+  };
+
+  /**
+   * @brief Draws one outcome per random number.
+   *
+   * The loop is free of branches, so compilers can vectorize it with gather instructions where the target has them.
+   *
+   * @param randoms Uniformly distributed 64 bit numbers.
+   * @param outcomes Output array receiving the outcome indices.
+   * @param count The number of draws.
+   */
+  void sample_batch(const std::uint64_t* randoms, std::uint32_t* outcomes, std::size_t count) const noexcept;
+
+  /**
+   * @brief Gets the probability the table draws an outcome with, rounded to 32 bits.
+   *
+   * @param outcome The outcome index.
+   * @return The probability.
+   */
+  double probability(std::size_t outcome) const noexcept;
+
+  std::size_t size() const noexcept
+  {
+    return m_thresholds.size();
+  };
+
+private:
+  std::vector<std::uint64_t> m_thresholds;  ///< Per column, 2^32 times the share of the column's own outcome.
+  std::vector<std::uint32_t> m_aliases;     ///< Per column, the outcome filling the rest of the column.
+};
+
+}  // namespace deck_of_cards
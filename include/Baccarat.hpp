@@ -0,0 +1,227 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <Shoe.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The final state of one baccarat coup, which is all any main or side bet is settled on.
+ */
+struct BaccaratOutcome
+{
+  std::uint8_t player_total;  ///< Final player total, 0 to 9.
+  std::uint8_t banker_total;  ///< Final banker total, 0 to 9.
+  std::uint8_t player_cards;  ///< Number of player cards, 2 or 3.
+  std::uint8_t banker_cards;  ///< Number of banker cards, 2 or 3.
+  bool player_pair;           ///< Whether the first two player cards have the same value.
+  bool banker_pair;           ///< Whether the first two banker cards have the same value.
+};
+
+/**
+ * @brief The number of distinct baccarat outcomes.
+ */
+constexpr std::size_t NumBaccaratOutcomes = 2 * 2 * 10 * 10 * 2 * 2;
+
+/**
+ * @brief Gets the dense index of an outcome.
+ *
+ * @param outcome The outcome.
+ * @return The index in [0, NumBaccaratOutcomes).
+ */
+constexpr std::size_t outcome_index(const BaccaratOutcome& outcome) noexcept
+{
+  return ((outcome.player_cards - 2) * 2 + outcome.banker_cards - 2) * 400 + outcome.player_total * 40 +
+         outcome.banker_total * 4 + outcome.player_pair * 2 + outcome.banker_pair;
+}
+
+/**
+ * @brief Gets the outcome with a dense index.
+ *
+ * @param index The index in [0, NumBaccaratOutcomes).
+ * @return The outcome.
+ */
+BaccaratOutcome outcome_at(std::size_t index) noexcept;
+
+/**
+ * @brief The net result of a unit bet on an outcome, e.g. -1 for a lost bet and 0 for a push.
+ */
+using BaccaratBet = double (*)(const BaccaratOutcome& outcome);
+
+/**
+ * @brief The banker bet, paying 19 to 20 and pushing on a tie.
+ */
+double banker_bet(const BaccaratOutcome& outcome) noexcept;
+
+/**
+ * @brief The player bet, paying even money and pushing on a tie.
+ */
+double player_bet(const BaccaratOutcome& outcome) noexcept;
+
+/**
+ * @brief The tie bet, paying 8 to 1.
+ */
+double tie_bet(const BaccaratOutcome& outcome) noexcept;
+
+/**
+ * @brief The player pair side bet, paying 11 to 1 when the first two player cards have the same value.
+ */
+double player_pair_bet(const BaccaratOutcome& outcome) noexcept;
+
+/**
+ * @brief The banker pair side bet, paying 11 to 1 when the first two banker cards have the same value.
+ */
+double banker_pair_bet(const BaccaratOutcome& outcome) noexcept;
+
+/**
+ * @brief The Dragon 7 side bet, paying 40 to 1 when the banker wins with a three card 7.
+ */
+double dragon_seven_bet(const BaccaratOutcome& outcome) noexcept;
+
+/**
+ * @brief The Panda 8 side bet, paying 25 to 1 when the player wins with a three card 8.
+ */
+double panda_eight_bet(const BaccaratOutcome& outcome) noexcept;
+
+/**
+ * @brief Decides whether the banker draws a third card, following the punto banco tableau.
+ *
+ * @param banker_total The banker total of the first two cards.
+ * @param player_third The point of the player's third card, or -1 if the player stood.
+ * @return True if the banker draws.
+ */
+bool banker_draws(int banker_total, int player_third) noexcept;
+
+/**
+ * @brief Deals one coup from a shoe, which must hold at least six cards.
+ *
+ * @param shoe The shoe.
+ * @return The outcome.
+ */
+BaccaratOutcome play_coup(Shoe& shoe) noexcept;
+
+/**
+ * @brief Deals one coup from an infinite deck.
+ *
+ * @param shoe The shoe.
+ * @return The outcome.
+ */
+BaccaratOutcome play_coup(InfiniteShoe& shoe) noexcept;
+
+/**
+ * @brief The exact probability of every baccarat outcome for a given shoe composition.
+ */
+class BaccaratDistribution
+{
+public:
+  /**
+   * @brief Computes the distribution of the next coup.
+   *
+   * The first two cards of each side are enumerated by value, as the pair bets need, and the third cards by point, so
+   * a coup takes at most 13^4 * 10^2 steps whatever the size of the shoe.
+   *
+   * @param counts The number of remaining cards of every value, ace first, as returned by Shoe::counts().
+   *
+   * @throws std::invalid_argument if fewer than six cards remain.
+   */
+  explicit BaccaratDistribution(const std::size_t* counts);
+
+  /**
+   * @brief Computes the distribution of the next coup from the remainder of a shoe.
+   *
+   * @param shoe The shoe.
+   *
+   * @throws std::invalid_argument if fewer than six cards remain.
+   */
+  explicit BaccaratDistribution(const Shoe& shoe);
+
+  /**
+   * @brief Computes the distribution of the next coup from the undealt cards of a deck.
+   *
+   * @param deck The deck.
+   *
+   * @throws std::invalid_argument if fewer than six cards remain.
+   */
+  explicit BaccaratDistribution(const Deck& deck);
+
+  double probability(const BaccaratOutcome& outcome) const noexcept
+  {
+    return m_probabilities[outcome_index(outcome)];
+  };
+
+  /**
+   * @brief Gets the exact expected net result of a unit bet.
+   *
+   * @param bet The bet.
+   * @return The expected value, negative for a house edge.
+   */
+  double expected_value(BaccaratBet bet) const;
+
+  double player_win() const noexcept;
+
+  double banker_win() const noexcept;
+
+  double tie() const noexcept;
+
+private:
+  double m_probabilities[NumBaccaratOutcomes];  ///< Probability per outcome index.
+};
+
+/**
+ * @brief The estimated expected value of every simulated bet.
+ */
+struct BaccaratSimulation
+{
+  std::uint64_t coups;                  ///< Number of coups played.
+  std::uint64_t shoes;                  ///< Number of shoes shuffled.
+  std::vector<double> means;            ///< Average net result per bet.
+  std::vector<double> standard_errors;  ///< Standard error of every average.
+};
+
+/**
+ * @brief Plays shoe after shoe to estimate the expected value of bets, capturing the effect of shoe depletion that
+ * the exact analysis of a fresh shoe misses.
+ */
+class BaccaratSimulator
+{
+public:
+  struct Config
+  {
+    std::size_t num_decks = 8;   ///< Number of decks in the shoe.
+    std::size_t cut_card = 16;   ///< Number of cards left undealt when the shoe is reshuffled, at least 6.
+    std::uint64_t seed = 1;      ///< Seed of the per thread random number generators.
+    bool infinite_deck = false;  ///< Draw every card independently from an InfiniteShoe instead.
+  };
+
+  /**
+   * @brief Constructs a simulator.
+   *
+   * @param config The table options.
+   *
+   * @throws std::invalid_argument if the shoe is empty or the cut card leaves fewer than six cards or no coup.
+   */
+  explicit BaccaratSimulator(const Config& config);
+
+  /**
+   * @brief Plays coups and settles every bet on each of them.
+   *
+   * Every thread plays its share of the coups on its own shoe and generator, seeded from the configured seed and the
+   * thread index, so results are reproducible for a given seed and thread count.
+   *
+   * @param bets The bets to settle.
+   * @param num_bets The number of bets.
+   * @param num_coups The number of coups to play.
+   * @param num_threads The number of worker threads, 0 for one per hardware thread.
+   * @return The estimated expected value of every bet, in the order given.
+   */
+  BaccaratSimulation run(const BaccaratBet* bets, std::size_t num_bets, std::uint64_t num_coups,
+                         std::size_t num_threads = 0) const;
+
+private:
+  Config m_config;  ///< Table options.
+};
+
+}  // namespace deck_of_cards
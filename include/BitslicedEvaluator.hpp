@@ -0,0 +1,107 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <HandEvaluator.hpp>
+#include <Pipeline.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The number of hands one bitsliced block evaluates at once, one per bit of a 64 bit word.
+ */
+constexpr std::size_t BitslicedBlockHands = 64;
+
+/**
+ * @brief The number of hands one wide bitsliced block evaluates at once, one per bit of a 512 bit vector.
+ */
+constexpr std::size_t WideBitslicedBlockHands = 512;
+
+/**
+ * @brief Transposes a 64 by 64 bit matrix in place, so that bit c of word h moves to bit h of word c.
+ *
+ * @param words The 64 words of the matrix.
+ */
+void transpose_bits(std::uint64_t* words) noexcept;
+
+/**
+ * @brief Hand category evaluator for large batches of 5 to 7 card hands.
+ *
+ * The bitsliced kernels transpose a block of hands into one bit plane per card, with bit h of plane c set when hand h
+ * holds card c, and derive the category of every hand in the block with the same sequence of boolean operations. The
+ * wide kernel processes eight such planes side by side in a 512 bit vector, which the compiler maps to AVX-512
+ * registers when the library is built for them and to narrower registers otherwise. Which kernel is fastest depends
+ * on the CPU and the build, so calibrate() times them against the lookup table evaluator.
+ */
+class BitslicedEvaluator
+{
+public:
+  /**
+   * @brief The available evaluation kernels.
+   */
+  enum class Kernel
+  {
+    Lookup = 0,   ///< HandEvaluator lookups, one hand at a time.
+    Bitsliced64,  ///< Bitsliced blocks of 64 hands.
+    Bitsliced512  ///< Bitsliced blocks of 512 hands.
+  };
+
+  /**
+   * @brief Gets the process wide evaluator, using the kernel calibrate() picks for this CPU.
+   *
+   * @return The evaluator.
+   */
+  static const BitslicedEvaluator& instance();
+
+  /**
+   * @brief Times every kernel on random 7 card hands.
+   *
+   * @param num_hands The number of hands each kernel evaluates.
+   * @return The fastest kernel.
+   */
+  static Kernel calibrate(std::size_t num_hands = 1 << 15);
+
+  /**
+   * @brief Constructs an evaluator.
+   *
+   * @param kernel The kernel to evaluate with.
+   */
+  explicit BitslicedEvaluator(Kernel kernel = Kernel::Bitsliced64);
+
+  /**
+   * @brief Gets the category of many hands.
+   *
+   * @param hands The hands, each holding 5, 6 or 7 cards.
+   * @param categories Output array receiving one category per hand.
+   * @param count The number of hands.
+   *
+   * @throws std::invalid_argument if a hand does not hold 5, 6 or 7 cards.
+   */
+  void categorize(const CardSet* hands, HandCategory* categories, std::size_t count) const;
+
+  /**
+   * @brief Gets the category of every hand of a dealt batch.
+   *
+   * @param batch The dealt hands.
+   * @param categories Output array receiving one category per hand.
+   *
+   * @throws std::invalid_argument if the hands do not hold 5, 6 or 7 cards.
+   */
+  void categorize(const CardBatch& batch, HandCategory* categories) const;
+
+  Kernel kernel() const noexcept
+  {
+    return m_kernel;
+  };
+
+  void set_kernel(Kernel kernel) noexcept
+  {
+    m_kernel = kernel;
+  };
+
+private:
+  Kernel m_kernel;  ///< The kernel hands are evaluated with.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace deck_of_cards
+{
+/**
+ * @brief A set of cards stored as a 64 bit mask, with bit i set when the card with dense index i is present.
+ *
+ * Because card ids are suit-major, the cards of one suit occupy 13 consecutive bits (Ace first) which makes
+ * per-suit rank masks a shift and a mask away.
+ */
+class CardSet
+{
+public:
+  /**
+   * @brief Constructs an empty set.
+   */
+  constexpr CardSet() noexcept
+    : m_mask(0)
+  {
+  }
+
+  /**
+   * @brief Constructs a set from a raw mask.
+   *
+   * @param mask The mask, with only the low NumCards bits in use.
+   */
+  explicit constexpr CardSet(std::uint64_t mask) noexcept
+    : m_mask(mask)
+  {
+  }
+
+  /**
+   * @brief Constructs a set from card ids.
+   *
+   * @param cards Pointer to the card ids.
+   * @param count The number of card ids.
+   */
+  CardSet(const CardId* cards, std::size_t count) noexcept
+    : m_mask(0)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      insert(cards[i]);
+    }
+  }
+
+  /**
+   * @brief Gets the set containing every card of a standard deck.
+   *
+   * @return The full set.
+   */
+  static constexpr CardSet full() noexcept
+  {
+    return CardSet((std::uint64_t(1) << NumCards) - 1);
+  }
+
+  void insert(CardId card) noexcept
+  {
+    m_mask |= std::uint64_t(1) << card;
+  }
+
+  void erase(CardId card) noexcept
+  {
+    m_mask &= ~(std::uint64_t(1) << card);
+  }
+
+  bool contains(CardId card) const noexcept
+  {
+    return (m_mask >> card) & 1;
+  }
+
+  /**
+   * @brief Checks whether the set shares any card with another set.
+   *
+   * @param other The other set.
+   * @return True if the sets overlap.
+   */
+  bool intersects(CardSet other) const noexcept
+  {
+    return (m_mask & other.m_mask) != 0;
+  }
+
+  std::size_t size() const noexcept
+  {
+    return static_cast<std::size_t>(__builtin_popcountll(m_mask));
+  }
+
+  bool empty() const noexcept
+  {
+    return m_mask == 0;
+  }
+
+  std::uint64_t mask() const noexcept
+  {
+    return m_mask;
+  }
+
+  /**
+   * @brief Gets the 13 bit mask of the ranks present in one suit, Ace in bit 0 and King in bit 12.
+   *
+   * @param suit The suit.
+   * @return The rank mask.
+   */
+  std::uint32_t suit_mask(Suit suit) const noexcept
+  {
+    return static_cast<std::uint32_t>(m_mask >> (static_cast<int>(suit) * 13)) & 0x1FFF;
+  }
+
+  CardSet operator|(CardSet other) const noexcept
+  {
+    return CardSet(m_mask | other.m_mask);
+  }
+
+  CardSet operator&(CardSet other) const noexcept
+  {
+    return CardSet(m_mask & other.m_mask);
+  }
+
+  CardSet operator-(CardSet other) const noexcept
+  {
+    return CardSet(m_mask & ~other.m_mask);
+  }
+
+  CardSet& operator|=(CardSet other) noexcept
+  {
+    m_mask |= other.m_mask;
+    return *this;
+  }
+
+  bool operator==(CardSet other) const noexcept
+  {
+    return m_mask == other.m_mask;
+  }
+
+  bool operator!=(CardSet other) const noexcept
+  {
+    return m_mask != other.m_mask;
+  }
+
+private:
+  std::uint64_t m_mask;  ///< Bit per card id.
+};
+
+/**
+ * @brief Checks whether a set is the representative of its class under relabeling of the suits.
+ *
+ * The representative is the member whose per suit rank masks do not increase from clubs to spades, so enumerations
+ * of a suit symmetric game can visit one set per class and weight it by suit_class_size().
+ *
+ * @param cards The set.
+ * @return True for the representative of the class.
+ */
+inline bool suit_canonical(CardSet cards) noexcept
+{
+  return cards.suit_mask(Suit::Club) >= cards.suit_mask(Suit::Diamond) &&
+         cards.suit_mask(Suit::Diamond) >= cards.suit_mask(Suit::Heart) &&
+         cards.suit_mask(Suit::Heart) >= cards.suit_mask(Suit::Spade);
+}
+
+/**
+ * @brief Gets the number of distinct sets produced by the 24 relabelings of the suits.
+ *
+ * @param cards The set.
+ * @return The size of the suit isomorphism class of the set.
+ */
+inline std::size_t suit_class_size(CardSet cards) noexcept
+{
+  std::uint32_t masks[4];
+  for (const auto suit : Suits)
+  {
+    // insertion sort, so that suits with equal rank masks end up next to each other
+    std::size_t i = static_cast<std::size_t>(suit);
+    const std::uint32_t mask = cards.suit_mask(suit);
+    for (; i > 0 && masks[i - 1] < mask; --i)
+    {
+      masks[i] = masks[i - 1];
+    }
+    masks[i] = mask;
+  }
+
+  // the relabelings fixing the set permute suits with equal rank masks among themselves
+  static const std::size_t factorials[] = { 1, 1, 2, 6, 24 };
+  std::size_t stabilizer = 1;
+  for (std::size_t first = 0; first < 4;)
+  {
+    std::size_t last = first + 1;
+    while (last < 4 && masks[last] == masks[first])
+    {
+      ++last;
+    }
+    stabilizer *= factorials[last - first];
+    first = last;
+  }
+
+  return 24 / stabilizer;
+}
+
+/**
+ * @brief Calls a function with every set of count cards out of a list, in lexicographic order of their positions.
+ *
+ * @param cards The distinct cards to choose from.
+ * @param num_cards The number of cards, at most NumCards.
+ * @param count The number of cards per set; no set is visited if it exceeds num_cards.
+ * @param visit Called with every CardSet.
+ */
+template <typename Visit>
+void for_each_combination(const CardId* cards, std::size_t num_cards, std::size_t count, Visit visit)
+{
+  if (count > num_cards)
+  {
+    return;
+  }
+
+  std::size_t positions[NumCards];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    positions[i] = i;
+  }
+  for (;;)
+  {
+    CardSet set;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      set.insert(cards[positions[i]]);
+    }
+    visit(set);
+
+    // advance the rightmost position that can still move, and reset the ones after it
+    std::size_t i = count;
+    while (i > 0 && positions[i - 1] == num_cards - count + i - 1)
+    {
+      --i;
+    }
+    if (i == 0)
+    {
+      return;
+    }
+    ++positions[i - 1];
+    for (std::size_t j = i; j < count; ++j)
+    {
+      positions[j] = positions[j - 1] + 1;
+    }
+  }
+}
+
+}  // namespace deck_of_cards
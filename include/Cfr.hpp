@@ -0,0 +1,352 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+class ThreadPool;
+
+/**
+ * @brief The actions of fixed limit betting. Call also stands for check and Raise for bet.
+ */
+enum class CfrAction : std::uint8_t
+{
+  Fold = 0,
+  Call,
+  Raise
+};
+
+/**
+ * @brief The number of CfrAction values.
+ */
+constexpr std::size_t NumCfrActions = 3;
+
+/**
+ * @brief The number of betting rounds a CfrGame may have.
+ */
+constexpr std::size_t MaxCfrRounds = 4;
+
+/**
+ * @brief The most actions a line of play of a CfrGame may take: a betting history keys information sets with 2 bits
+ * per action after a leading 1 bit in 64 bits. A round takes at most max_raises + 2 actions, a check, every raise and
+ * the closing call.
+ */
+constexpr std::size_t MaxCfrActions = 31;
+
+/**
+ * @brief One betting round of a fixed limit game.
+ */
+struct BettingRound
+{
+  std::size_t board_cards;  ///< Public cards dealt before the round.
+  int bet_size;             ///< Size of every bet and raise.
+  int max_raises;           ///< Bets and raises allowed in the round.
+};
+
+/**
+ * @brief A two player, fixed limit poker game with cards dealt from a subset of the deck.
+ *
+ * Both players post the ante, player 0 acts first in every round, and a round ends when a bet is called or both
+ * players check. The card abstraction maps what a player sees to a bucket, which together with the betting makes the
+ * information set key: a lossless abstraction keeps every distinction that matters, a lossy one trades exactness for
+ * a smaller game.
+ */
+class CfrGame
+{
+public:
+  virtual ~CfrGame() = default;
+
+  /**
+   * @brief Gets a name identifying the game.
+   *
+   * @return The name.
+   */
+  virtual std::string name() const = 0;
+
+  /**
+   * @brief Gets the cards in play.
+   *
+   * @return The distinct cards the game deals from.
+   */
+  virtual std::vector<CardId> cards() const = 0;
+
+  /**
+   * @brief Gets the number of private cards of every player.
+   *
+   * @return The number of hole cards.
+   */
+  virtual std::size_t hole_cards() const = 0;
+
+  /**
+   * @brief Gets the forced bet of every player.
+   *
+   * @return The ante.
+   */
+  virtual int ante() const = 0;
+
+  /**
+   * @brief Gets the betting rounds, in order.
+   *
+   * @return Between one and MaxCfrRounds rounds.
+   */
+  virtual std::vector<BettingRound> rounds() const = 0;
+
+  /**
+   * @brief Compares the hands of a showdown.
+   *
+   * @param first The hole cards of player 0.
+   * @param second The hole cards of player 1.
+   * @param board The public cards.
+   * @return Positive if player 0 wins, negative if player 1 wins, zero for a split pot.
+   */
+  virtual int showdown(CardSet first, CardSet second, CardSet board) const = 0;
+
+  /**
+   * @brief Maps the cards a player sees to the bucket of the card abstraction.
+   *
+   * @param hole The player's hole cards.
+   * @param board The public cards dealt so far.
+   * @param round The betting round.
+   * @return The bucket.
+   */
+  virtual std::uint32_t bucket(CardSet hole, CardSet board, std::size_t round) const = 0;
+};
+
+/**
+ * @brief Kuhn poker: the jack, queen and king, one card each, an ante of 1 and one round with a single bet of 1.
+ *
+ * The first player loses 1/18 per hand at equilibrium.
+ */
+class KuhnPoker : public CfrGame
+{
+public:
+  std::string name() const override;
+
+  std::vector<CardId> cards() const override;
+
+  std::size_t hole_cards() const override;
+
+  int ante() const override;
+
+  std::vector<BettingRound> rounds() const override;
+
+  int showdown(CardSet first, CardSet second, CardSet board) const override;
+
+  std::uint32_t bucket(CardSet hole, CardSet board, std::size_t round) const override;
+};
+
+/**
+ * @brief Leduc hold'em: two jacks, queens and kings, one card each and one board card.
+ *
+ * Antes of 1, two rounds with bets of 2 then 4 and at most two raises per round. A pair with the board wins, else the
+ * higher card. The buckets are the ranks of the cards, which loses nothing since suits never matter.
+ */
+class LeducPoker : public CfrGame
+{
+public:
+  std::string name() const override;
+
+  std::vector<CardId> cards() const override;
+
+  std::size_t hole_cards() const override;
+
+  int ante() const override;
+
+  std::vector<BettingRound> rounds() const override;
+
+  int showdown(CardSet first, CardSet second, CardSet board) const override;
+
+  std::uint32_t bucket(CardSet hole, CardSet board, std::size_t round) const override;
+};
+
+/**
+ * @brief The regrets and strategy sums of one information set.
+ *
+ * The legal actions of a node occupy the first slots in CfrAction order. The slots are padded to four floats so that
+ * every update works on whole vectors.
+ */
+struct CfrInfoset
+{
+  std::uint64_t history;         ///< Betting history, 0 for an empty slot.
+  std::uint32_t bucket;          ///< Bucket of the acting player's cards.
+  std::uint32_t num_actions;     ///< Number of legal actions.
+  alignas(16) float regrets[4];  ///< Cumulative regret per legal action.
+  float strategy[4];             ///< Cumulative strategy weight per legal action.
+};
+
+/**
+ * @brief An open addressing hash table of information sets, stored in one flat array with linear probing.
+ */
+class InfosetTable
+{
+public:
+  /**
+   * @brief Constructs an empty table.
+   *
+   * @param capacity The initial number of slots, rounded up to a power of two.
+   */
+  explicit InfosetTable(std::size_t capacity = 64);
+
+  /**
+   * @brief Looks an information set up.
+   *
+   * @param history The betting history.
+   * @param bucket The bucket of the acting player.
+   * @return The information set, or nullptr if absent.
+   */
+  const CfrInfoset* find(std::uint64_t history, std::uint32_t bucket) const noexcept;
+
+  /**
+   * @brief Looks an information set up, inserting a zeroed one if absent. Pointers returned earlier are invalidated
+   * when the table grows.
+   *
+   * @param history The betting history, not 0.
+   * @param bucket The bucket of the acting player.
+   * @param num_actions The number of legal actions, at most NumCfrActions.
+   * @return The information set.
+   */
+  CfrInfoset& insert(std::uint64_t history, std::uint32_t bucket, std::uint32_t num_actions);
+
+  /**
+   * @brief Removes every information set, keeping the capacity.
+   */
+  void clear() noexcept;
+
+  std::size_t size() const noexcept
+  {
+    return m_size;
+  };
+
+  /**
+   * @brief Gets every slot, empty ones having a zero history, in a deterministic order.
+   *
+   * @return The slots.
+   */
+  const std::vector<CfrInfoset>& slots() const noexcept
+  {
+    return m_slots;
+  };
+
+private:
+  std::vector<CfrInfoset> m_slots;  ///< Slots, a power of two of them.
+  std::size_t m_size;               ///< Occupied slots.
+};
+
+/**
+ * @brief The algorithms of CfrSolver.
+ */
+enum class CfrAlgorithm
+{
+  CfrPlus,           ///< Full traversal of every deal, alternating updates, regrets floored at zero, linear averaging.
+  ExternalSampling,  ///< Monte Carlo CFR sampling the deal and the opponent's actions.
+};
+
+/**
+ * @brief Counterfactual regret minimization for a CfrGame.
+ *
+ * Every iteration updates each player in turn. The updates of one player are computed by the workers of a
+ * ThreadPool against the strategy of the previous update, each into its own InfosetTable of deltas, and merged in
+ * worker order, so a run is deterministic for a given seed and thread count whatever the scheduling. CFR+ splits the
+ * deals among the workers; external sampling gives every worker its own generator, seeded from the configured seed
+ * and the worker index, for a configured number of traversals.
+ */
+class CfrSolver
+{
+public:
+  struct Config
+  {
+    CfrAlgorithm algorithm = CfrAlgorithm::CfrPlus;  ///< Update rule.
+    std::size_t num_threads = 0;                     ///< Worker threads, 0 for one per hardware thread.
+    std::uint64_t seed = 1;                          ///< Seed of the external sampling generators.
+    std::size_t traversals = 16;                     ///< External sampling traversals per worker and player.
+  };
+
+  /**
+   * @brief Constructs a solver and enumerates the deals of the game.
+   *
+   * @param game The game, which must outlive the solver.
+   * @param config The training options.
+   *
+   * @throws std::invalid_argument if the game has no or too many rounds, can take more than MaxCfrActions actions,
+   * deals more cards than it has or the traversal count is zero.
+   */
+  CfrSolver(const CfrGame& game, const Config& config);
+
+  /**
+   * @brief Destroys the solver and stops its workers.
+   */
+  ~CfrSolver();
+
+  /**
+   * @brief Runs training iterations.
+   *
+   * @param iterations The number of iterations.
+   */
+  void train(std::size_t iterations);
+
+  std::size_t iterations() const noexcept
+  {
+    return m_iterations;
+  };
+
+  std::size_t num_infosets() const noexcept
+  {
+    return m_table.size();
+  };
+
+  /**
+   * @brief Gets the average strategy of an information set, the approximate equilibrium.
+   *
+   * @param history The actions taken so far.
+   * @param bucket The bucket of the acting player.
+   * @return The probability of every action indexed by CfrAction, 0 for illegal actions; uniform over the legal
+   * actions for an information set never visited.
+   *
+   * @throws std::invalid_argument if the history is illegal or does not lead to a decision.
+   */
+  std::vector<double> average_strategy(const std::vector<CfrAction>& history, std::uint32_t bucket) const;
+
+  /**
+   * @brief Gets the expected value of player 0 when both players follow the average strategy.
+   *
+   * @return The value per hand.
+   */
+  double expected_value() const;
+
+  /**
+   * @brief Gets how much best responses to the average strategy win, averaged over both players, in the abstract
+   * game.
+   *
+   * @return The exploitability per hand, 0 at an equilibrium.
+   */
+  double exploitability() const;
+
+  /**
+   * @brief A deal with everything the traversals need precomputed.
+   */
+  struct Deal
+  {
+    std::uint32_t buckets[2][MaxCfrRounds];  ///< Bucket of every player in every round.
+    int showdown;                            ///< Sign of the showdown for player 0.
+  };
+
+private:
+  const CfrGame& m_game;                      ///< Game being solved.
+  Config m_config;                            ///< Training options.
+  std::vector<BettingRound> m_rounds;         ///< Betting rounds of the game.
+  std::vector<CardId> m_cards;                ///< Cards in play.
+  std::vector<Deal> m_deals;                  ///< Every deal, equally likely.
+  InfosetTable m_table;                       ///< Regrets and strategy sums.
+  std::vector<InfosetTable> m_deltas;         ///< Updates of every worker.
+  std::vector<std::mt19937_64> m_generators;  ///< Sampling generator of every worker.
+  std::unique_ptr<ThreadPool> m_pool;         ///< Workers.
+  std::size_t m_iterations;                   ///< Iterations run.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Scores a cribbage hand or crib together with the starter card.
+ *
+ * Fifteens, pairs and runs only depend on the ranks of the five cards and are read from a table indexed by their rank
+ * multiset, which is built once per process by summing every subset of the five pip values. Flushes and nobs are
+ * tested on the suit masks.
+ *
+ * @param hand The four cards of the hand or crib.
+ * @param starter The starter card, not in the hand.
+ * @param crib Whether the cards form the crib, which only scores a flush of all five cards.
+ * @return The points, 0 to 29.
+ */
+int cribbage_score(CardSet hand, CardId starter, bool crib = false) noexcept;
+
+/**
+ * @brief The value of one way of discarding two cards to the crib.
+ */
+struct CribbageDiscard
+{
+  CardSet keep;           ///< The four cards kept in the hand.
+  CardSet discard;        ///< The two cards laid away to the crib.
+  double hand_value;      ///< Average hand points over every starter left.
+  double crib_value;      ///< Average crib points of the discard.
+  double expected_value;  ///< Hand value plus the crib value for the dealer, minus it for the pone.
+};
+
+/**
+ * @brief Finds the best discard from a six card cribbage deal.
+ *
+ * The hand value of each of the 15 discards averages all 46 starters exactly, grouping the starters by rank for the
+ * fifteens, pairs and runs and by suit for flushes and nobs. Crib values assume that the opponent discards two random
+ * cards: the average over every opponent discard and starter, 58,800 cribs, is the same for all discards of the same
+ * two ranks and suitedness, so the constructor enumerates those 169 classes once (13 pairs, 78 suited and 78 offsuit
+ * rank pairs), spread over a ThreadPool, and analyze() looks them up. An analysis takes a few microseconds.
+ */
+class CribbageAnalyzer
+{
+public:
+  /**
+   * @brief Constructs an analyzer by computing the average crib of every discard class.
+   *
+   * @param num_threads The number of worker threads, 0 for one per hardware thread.
+   */
+  explicit CribbageAnalyzer(std::size_t num_threads = 0);
+
+  /**
+   * @brief Values every discard of a deal.
+   *
+   * @param dealt The six dealt cards.
+   * @param dealer Whether the crib belongs to the player.
+   * @return The 15 discards, best expected value first.
+   *
+   * @throws std::invalid_argument if the deal does not hold six cards.
+   */
+  std::vector<CribbageDiscard> analyze(CardSet dealt, bool dealer) const;
+
+  /**
+   * @brief Gets the cached average crib of a discard, only the discard being known.
+   *
+   * @param discard The two discarded cards.
+   * @return The average crib points.
+   *
+   * @throws std::invalid_argument if the discard does not hold two cards.
+   */
+  double crib_value(CardSet discard) const;
+
+  /**
+   * @brief Averages the crib of a discard over every opponent discard and starter, without any cache.
+   *
+   * @param discard The two discarded cards.
+   * @param dead Further cards known not to be in the crib or the starter, e.g. the kept hand.
+   * @return The average crib points.
+   *
+   * @throws std::invalid_argument if the discard does not hold two cards or too few cards remain.
+   */
+  static double exact_crib_value(CardSet discard, CardSet dead = CardSet());
+
+private:
+  double m_crib_values[13 * 13 * 2];  ///< Average crib per lower rank, higher rank and suitedness.
+};
+
+}  // namespace deck_of_cards
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -52,6 +54,33 @@ constexpr std::initializer_list<Value> Values = { Value::Ace,  Value::Two,   Val
                                                   Value::Six,  Value::Seven, Value::Eight, Value::Nine, Value::Ten,
                                                   Value::Jack, Value::Queen, Value::King };
 
+/**
+ * @brief The number of cards in a standard deck of playing cards.
+ */
+constexpr std::size_t NumCards = 52;
+
+/**
+ * @brief Dense index of a card in the range [0, NumCards).
+ *
+ * Cards are numbered suit-major, so that Club Ace is 0, Club King is 12, Diamond Ace is 13 and so on.
+ */
+using CardId = std::uint8_t;
+
+/**
+ * @brief Computes the dense index of the card with the given suit and value.
+ *
+ * @param suit The suit of the card.
+ * @param value The value of the card.
+ * @return The dense index of the card.
+ */
+constexpr CardId card_id(Suit suit, Value value) noexcept
+{
+  return static_cast<CardId>(static_cast<int>(suit) * 13 + static_cast<int>(value) - 1);
+}
+
+class CardSet;
+class HealthMonitor;
+
 class Card
 {
 public:
@@ -148,6 +177,16 @@ public:
     return m_value;
   };
 
+  /**
+   * @brief Gets the dense index of the card.
+   *
+   * @return The index of the card in the range [0, NumCards).
+   */
+  CardId id() const noexcept
+  {
+    return card_id(m_suit, m_value);
+  };
+
 private:
   Suit m_suit;    ///< The suit of the card.
   Value m_value;  ///< The value of the card.
@@ -208,7 +247,8 @@ public:
    * @brief Shuffles the deck of cards.
    *
    * This function randomizes the order of the cards in the deck using the
-   * Fisher-Yates algorithm.
+   * Fisher-Yates algorithm. If a HealthMonitor is attached, the random
+   * samples consumed by the shuffle are fed to it.
    */
   void shuffle();
 
@@ -222,6 +262,19 @@ public:
    */
   std::shared_ptr<Card> deal_card();
 
+  /**
+   * @brief Deals several cards from the deck as compact card ids.
+   *
+   * The cards are dealt in the same order repeated calls to deal_card()
+   * would return them, without copying any shared pointers out of the deck.
+   *
+   * @param cards Output array receiving the ids of the dealt cards.
+   * @param count The number of cards to deal.
+   * @return The number of cards dealt, which is smaller than count if the
+   * deck runs out.
+   */
+  std::size_t deal_cards(CardId* cards, std::size_t count);
+
   /**
    * @brief Gets the number of cards remaining in the deck.
    *
@@ -232,14 +285,34 @@ public:
     return m_cards.size();
   };
 
+  /**
+   * @brief Gets the cards remaining in the deck.
+   *
+   * @return The undealt cards, whose complement are the cards removed from the deck.
+   */
+  CardSet undealt() const noexcept;
+
   void reset()
   {
     m_cards = m_original_cards;
+    m_monitored = false;
   }
 
+  /**
+   * @brief Attaches a health monitor to the deck.
+   *
+   * Subsequent shuffles feed their random samples to the monitor, and the
+   * cards dealt after a monitored shuffle are fed to its positional test.
+   *
+   * @param monitor The monitor to attach, or nullptr to detach the current one.
+   */
+  void set_health_monitor(std::shared_ptr<HealthMonitor> monitor);
+
 private:
   std::vector<std::shared_ptr<Card>> m_cards;           ///< A vector containing the cards in the deck.
   std::vector<std::shared_ptr<Card>> m_original_cards;  ///< A vector containing the original cards in the deck.
+  std::shared_ptr<HealthMonitor> m_health_monitor;      ///< Optional health monitor fed by shuffles and deals.
+  bool m_monitored;                                     ///< Whether the last shuffle is being monitored.
 };
 
 // Hash function for Card
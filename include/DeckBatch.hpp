@@ -0,0 +1,137 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <PageBuffer.hpp>
+#include <Permutation.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The number of bytes each deck occupies in a DeckBatch: one cache line.
+ */
+constexpr std::size_t DeckStride = 64;
+
+/**
+ * @brief Many decks stored back to back in one PageBuffer for batched shuffling and dealing.
+ *
+ * Every deck takes one cache line: its order as one card id per byte, followed by its deal cursor. Cards are dealt
+ * from the front of the order. Backing the batch with huge pages lets a shuffle sweep over thousands of decks touch a
+ * handful of TLB entries instead of one per 4 KB page.
+ */
+class DeckBatch
+{
+public:
+  /**
+   * @brief Constructs a batch of decks in card id order.
+   *
+   * @param num_decks The number of decks.
+   * @param mode The requested page mode, see PageBuffer for the fallbacks.
+   */
+  explicit DeckBatch(std::size_t num_decks, PageMode mode = PageMode::Default);
+
+  /**
+   * @brief Returns every card to every deck, in card id order.
+   */
+  void reset_all() noexcept;
+
+  /**
+   * @brief Shuffles the undealt cards of every deck with rand(), like Deck::shuffle().
+   */
+  void shuffle_all();
+
+  /**
+   * @brief Shuffles the undealt cards of every deck with the given random number generator.
+   *
+   * @param generator A uniform random bit generator producing at least 32 bits per call.
+   */
+  template <typename Generator>
+  void shuffle_all(Generator& generator)
+  {
+    for (std::size_t deck = 0; deck < m_num_decks; ++deck)
+    {
+      CardId* cards = order(deck);
+      const std::size_t cursor = cards[NumCards];
+      for (std::size_t i = NumCards - 1; i > cursor; --i)
+      {
+        const std::size_t j = cursor + static_cast<std::size_t>(generator()) % (i - cursor + 1);
+        std::swap(cards[i], cards[j]);
+      }
+    }
+  }
+
+  /**
+   * @brief Deals cards from one deck.
+   *
+   * @param deck The deck index.
+   * @param cards Output array receiving the ids of the dealt cards.
+   * @param count The number of cards to deal.
+   * @return The number of cards dealt, which is smaller than count if the deck runs out.
+   */
+  std::size_t deal_cards(std::size_t deck, CardId* cards, std::size_t count) noexcept;
+
+  /**
+   * @brief Rearranges the whole order of one deck, dealt cards included, and rewinds its deal cursor.
+   *
+   * As for PackedDeck::permute(), keeping the cursor would deal some cards twice, so permuting starts a new deal.
+   *
+   * @param deck The deck index.
+   * @param permutation The permutation, e.g. a replayed shuffle of a fresh deck.
+   */
+  void permute(std::size_t deck, const Permutation& permutation) noexcept
+  {
+    CardId* cards = order(deck);
+    apply_line(permutation, cards);
+    cards[NumCards] = 0;
+  }
+
+  /**
+   * @brief Gets the number of cards remaining in one deck.
+   *
+   * @param deck The deck index.
+   * @return The number of cards remaining.
+   */
+  std::size_t num_cards(std::size_t deck) const noexcept
+  {
+    return NumCards - order(deck)[NumCards];
+  }
+
+  /**
+   * @brief Gets the order of one deck, dealt cards included.
+   *
+   * @param deck The deck index.
+   * @return Pointer to NumCards card ids.
+   */
+  CardId* order(std::size_t deck) noexcept
+  {
+    return static_cast<CardId*>(m_buffer.data()) + deck * DeckStride;
+  }
+
+  const CardId* order(std::size_t deck) const noexcept
+  {
+    return static_cast<const CardId*>(m_buffer.data()) + deck * DeckStride;
+  }
+
+  std::size_t size() const noexcept
+  {
+    return m_num_decks;
+  };
+
+  /**
+   * @brief Gets the page mode backing the batch.
+   *
+   * @return The page mode actually obtained.
+   */
+  PageMode page_mode() const noexcept
+  {
+    return m_buffer.mode();
+  };
+
+private:
+  std::size_t m_num_decks;  ///< Number of decks.
+  PageBuffer m_buffer;      ///< Deck storage, DeckStride bytes per deck.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Range.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Equity of the first range against the second, over every runout and every compatible pair of combinations.
+ */
+struct EquityResult
+{
+  double win;             ///< Weighted share of matchups the first range wins.
+  double tie;             ///< Weighted share of matchups that split.
+  double equity;          ///< win + tie / 2, the share of the pot the first range takes.
+  double matchups;        ///< Total weight of the (runout, combination, combination) matchups.
+  std::uint64_t runouts;  ///< Number of distinct board runouts enumerated.
+};
+
+/**
+ * @brief Computes the exact equity of one weighted range against another.
+ *
+ * Every runout of the board is enumerated once and both ranges are evaluated in bulk on it. The combinations are then
+ * swept in rank order while the villain weights below and at the current rank are accumulated in total and per card,
+ * so the weight a hero combination beats or ties is found by subtracting the two per card sums of its cards instead
+ * of testing every pair. Runouts are spread over a ThreadPool.
+ *
+ * @param hero The first range.
+ * @param villain The second range.
+ * @param board The known board cards, 0, 3, 4 or 5 of them.
+ * @param dead Cards removed from the deck, e.g. folded or burnt cards.
+ * @param num_threads The number of threads, or zero for one per hardware thread.
+ * @return The equity of hero against villain.
+ *
+ * @throws std::invalid_argument if the board size is invalid, the board and dead cards overlap, or no combination of
+ * one range is compatible with one of the other.
+ */
+EquityResult range_equity(const Range& hero, const Range& villain, CardSet board, CardSet dead = CardSet(),
+                          std::size_t num_threads = 0);
+
+/**
+ * @brief The ways EquitySimulator draws the runouts of its deals.
+ */
+enum class EquitySampling
+{
+  Independent,     ///< Every deal draws its runout independently.
+  Antithetic,      ///< Deals come in pairs, the second runout mirroring the card values of the first.
+  Stratified,      ///< The first runout card cycles through the remaining cards, the rest is drawn at random.
+  ControlVariate,  ///< Outcomes are corrected by card counts of known mean, with coefficients fitted by pilot deals.
+};
+
+/**
+ * @brief The estimated equity of one hand against another.
+ */
+struct EquitySimulation
+{
+  std::uint64_t deals;     ///< Number of deals played, pilot deals excluded.
+  double equity;           ///< Estimated share of the pot the first hand wins, ties counting half.
+  double standard_error;   ///< Standard error of the estimate.
+  double effective_deals;  ///< Independent deals reaching the same standard error, infinite for an exact estimate.
+};
+
+/**
+ * @brief Estimates heads-up all-in equity by dealing random runouts, with sampling modes that reduce the variance.
+ *
+ * Every mode is unbiased. Antithetic pairs map each runout card to its mirror in the remaining cards sorted by value,
+ * a bijection, so both runouts of a pair are uniform while high boards are paired with low ones. Stratified sampling
+ * classifies runouts by their first card, gives every class the same number of deals give or take one and weighs the
+ * class means equally, which makes a turn exact once every river card was dealt. The control variates count the
+ * runout cards sharing a value or a suit with either hand, whose means are known exactly; their coefficients are fitted
+ * by least squares on separate pilot deals, so the corrected outcomes stay unbiased. The effective number of deals
+ * divides the variance of a single deal by the squared standard error.
+ */
+class EquitySimulator
+{
+public:
+  struct Config
+  {
+    EquitySampling sampling = EquitySampling::Independent;  ///< How runouts are drawn.
+    std::uint64_t seed = 1;                                 ///< Seed of the per thread random number generators.
+    std::uint64_t pilot_deals = 1000;                       ///< Deals fitting the control variate coefficients.
+  };
+
+  /**
+   * @brief Constructs a simulator.
+   *
+   * @param config The sampling options.
+   *
+   * @throws std::invalid_argument if control variates are requested without pilot deals.
+   */
+  explicit EquitySimulator(const Config& config);
+
+  /**
+   * @brief Deals runouts and estimates the equity of the first hand.
+   *
+   * Every thread deals its share on its own generator, seeded from the configured seed and the thread index, so
+   * results are reproducible for a given seed and thread count.
+   *
+   * @param hero The first hand.
+   * @param villain The second hand.
+   * @param board The known board cards, at most 5.
+   * @param num_deals The number of deals, rounded down to a whole number of antithetic pairs.
+   * @param num_threads The number of worker threads, 0 for one per hardware thread.
+   * @return The estimated equity of hero against villain.
+   *
+   * @throws std::invalid_argument if the cards overlap, the hands plus a full board do not make 5 to 7 cards, or there
+   * are fewer than two deals, pairs or, when stratified, deals per runout class.
+   */
+  EquitySimulation run(CardSet hero, CardSet villain, CardSet board, std::uint64_t num_deals,
+                       std::size_t num_threads = 0) const;
+
+private:
+  Config m_config;  ///< Sampling options.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The number of distinct starting hand classes in hold'em (13 pairs, 78 suited and 78 offsuit hands).
+ */
+constexpr std::size_t NumStartingHands = 169;
+
+/**
+ * @brief Computes the starting hand class of two hole cards.
+ *
+ * Classes index a 13x13 grid with the Ace high rank as row and column 0: pairs lie on the diagonal, suited hands above
+ * it and offsuit hands below it. For example AA is 0, AKs is 1 and AKo is 13.
+ *
+ * @param first The first hole card.
+ * @param second The second hole card.
+ * @return The class in the range [0, NumStartingHands).
+ */
+std::size_t starting_hand_class(CardId first, CardId second) noexcept;
+
+/**
+ * @brief Gets the probability of being dealt each starting hand class.
+ *
+ * @return A vector of NumStartingHands probabilities summing to one.
+ */
+std::vector<double> starting_hand_probabilities();
+
+/**
+ * @brief The outcome of a fairness test.
+ */
+struct FairnessResult
+{
+  double statistic;     ///< The test statistic (chi-squared value, or the category count for binomial tests).
+  double threshold;     ///< The critical value at the configured significance level, on the side of the statistic.
+  std::uint64_t hands;  ///< The number of hands the test was computed over.
+  bool passed;          ///< Whether the statistic stayed within the threshold.
+};
+
+/**
+ * @brief Mergeable per-seat counters of dealt hand categories.
+ */
+class FairnessCounters
+{
+public:
+  /**
+   * @brief Constructs zeroed counters.
+   *
+   * @param num_seats The number of seats counted.
+   * @param num_categories The number of hand categories counted.
+   */
+  FairnessCounters(std::size_t num_seats, std::size_t num_categories);
+
+  /**
+   * @brief Counts one hand.
+   *
+   * @param seat The seat the hand was dealt to.
+   * @param category The category of the hand.
+   */
+  void add(std::size_t seat, std::size_t category)
+  {
+    ++m_counts[seat * m_num_categories + category];
+  }
+
+  /**
+   * @brief Adds the counts of other counters to these ones.
+   *
+   * @param other Counters with the same shape.
+   *
+   * @throws std::invalid_argument if the shapes differ.
+   */
+  void merge(const FairnessCounters& other);
+
+  /**
+   * @brief Resets all counts to zero.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of hands of a category dealt to a seat.
+   *
+   * @param seat The seat.
+   * @param category The hand category.
+   * @return The count.
+   */
+  std::uint64_t count(std::size_t seat, std::size_t category) const
+  {
+    return m_counts[seat * m_num_categories + category];
+  }
+
+  /**
+   * @brief Gets the number of hands dealt to a seat.
+   *
+   * @param seat The seat.
+   * @return The count over all categories.
+   */
+  std::uint64_t seat_total(std::size_t seat) const;
+
+  std::size_t num_seats() const noexcept
+  {
+    return m_num_seats;
+  };
+
+  std::size_t num_categories() const noexcept
+  {
+    return m_num_categories;
+  };
+
+private:
+  std::size_t m_num_seats;              ///< Number of seats.
+  std::size_t m_num_categories;         ///< Number of categories per seat.
+  std::vector<std::uint64_t> m_counts;  ///< Seat-major counts.
+};
+
+/**
+ * @brief Streaming fairness statistics over dealt hands, per seat and per table.
+ *
+ * Per-seat counts are kept in a ring of windows that the owner rotates with advance_window(), so seat tests always
+ * cover the most recent `num_windows` windows. Per-table counts are cumulative. Memory is fixed at construction and
+ * does not grow with the number of hands recorded.
+ *
+ * A monitor is not thread safe; use ShardedFairnessMonitor to record from several threads.
+ */
+class FairnessMonitor
+{
+public:
+  /**
+   * @brief Configuration of a fairness monitor.
+   */
+  struct Config
+  {
+    std::size_t num_seats = 9;                                     ///< Seats per table.
+    std::size_t num_tables = 1;                                    ///< Tables tracked, with ids in [0, num_tables).
+    std::size_t num_windows = 8;                                   ///< Windows covered by the seat tests.
+    double alpha = 1e-4;                                           ///< Significance level of every test.
+    std::vector<double> expected = starting_hand_probabilities();  ///< Expected probability of each category.
+  };
+
+  /**
+   * @brief Constructs a fairness monitor.
+   *
+   * @param config The monitor configuration.
+   *
+   * @throws std::invalid_argument if the configuration is empty or the expected probabilities are not positive.
+   */
+  explicit FairnessMonitor(const Config& config);
+
+  /**
+   * @brief Records a hand of the given category.
+   *
+   * @param table The table the hand was dealt at.
+   * @param seat The seat the hand was dealt to.
+   * @param category The hand category.
+   *
+   * @throws std::out_of_range if the table, seat or category is not covered by the configuration.
+   */
+  void record(std::size_t table, std::size_t seat, std::size_t category)
+  {
+    check_hand(table, seat, category);
+    m_windows[m_current].add(seat, category);
+    ++m_table_counts[table * m_config.expected.size() + category];
+  }
+
+  /**
+   * @brief Records a pair of hole cards, categorized by starting hand class.
+   *
+   * @param table The table the hand was dealt at.
+   * @param seat The seat the hand was dealt to.
+   * @param first The first hole card.
+   * @param second The second hole card.
+   *
+   * @throws std::invalid_argument if the monitor does not count the NumStartingHands starting hand classes.
+   * @throws std::out_of_range if the table or seat is not covered by the configuration.
+   */
+  void record_hand(std::size_t table, std::size_t seat, const Card& first, const Card& second)
+  {
+    check_starting_hands(m_config);
+    record(table, seat, starting_hand_class(first.id(), second.id()));
+  }
+
+  /**
+   * @brief Checks that a hand can be recorded, without recording it.
+   *
+   * @param table The table the hand was dealt at.
+   * @param seat The seat the hand was dealt to.
+   * @param category The hand category.
+   *
+   * @throws std::out_of_range if the table, seat or category is not covered by the configuration.
+   */
+  void check_hand(std::size_t table, std::size_t seat, std::size_t category) const
+  {
+    if (table >= m_config.num_tables || seat >= m_config.num_seats || category >= m_config.expected.size())
+    {
+      throw std::out_of_range("Fairness monitor table, seat or category out of range");
+    }
+  }
+
+  /**
+   * @brief Checks that a configuration counts starting hand classes, as record_hand() needs.
+   *
+   * @param config The configuration.
+   *
+   * @throws std::invalid_argument if the configuration does not have NumStartingHands categories.
+   */
+  static void check_starting_hands(const Config& config)
+  {
+    if (config.expected.size() != NumStartingHands)
+    {
+      throw std::invalid_argument("Fairness monitor does not count starting hand classes");
+    }
+  }
+
+  /**
+   * @brief Starts a new window, discarding the oldest one from the seat tests.
+   */
+  void advance_window();
+
+  /**
+   * @brief Adds the counts of another monitor to this one, which may cover more tables.
+   *
+   * Windows are merged position by position, so monitors should be rotated together. The tables of the other monitor
+   * are added to this monitor's tables from first_table on, which merges a monitor of a block of tables.
+   *
+   * @param other The monitor to merge.
+   * @param first_table The table of this monitor that table 0 of the other monitor counts into.
+   *
+   * @throws std::invalid_argument if the seats, windows or categories differ or the tables do not fit.
+   */
+  void merge(const FairnessMonitor& other, std::size_t first_table = 0);
+
+  /**
+   * @brief Sums the per-seat counts over all windows.
+   *
+   * @return The windowed counts.
+   */
+  FairnessCounters window_counts() const;
+
+  /**
+   * @brief Chi-squared goodness-of-fit test of a seat's windowed category counts.
+   *
+   * @param seat The seat to test.
+   * @return The test outcome.
+   *
+   * @throws std::out_of_range if the seat does not exist.
+   */
+  FairnessResult seat_test(std::size_t seat) const;
+
+  /**
+   * @brief Chi-squared goodness-of-fit test of a table's cumulative category counts.
+   *
+   * @param table The table to test.
+   * @return The test outcome.
+   *
+   * @throws std::out_of_range if the table does not exist.
+   */
+  FairnessResult table_test(std::size_t table) const;
+
+  /**
+   * @brief Two sided binomial test of how often a seat received one category within the window.
+   *
+   * Uses the exact binomial tails, alpha / 2 each, since a rare class such as pocket aces (1 in 221) is far from
+   * normal at the counts one seat sees in a window.
+   *
+   * @param seat The seat to test.
+   * @param category The category, for example starting_hand_class() of pocket aces.
+   * @return The test outcome, with the count as statistic and, as threshold, the largest passing count if the count
+   * is above its expectation and the smallest passing count otherwise.
+   *
+   * @throws std::out_of_range if the seat or category does not exist.
+   */
+  FairnessResult binomial_test(std::size_t seat, std::size_t category) const;
+
+  const Config& config() const noexcept
+  {
+    return m_config;
+  };
+
+private:
+  FairnessResult chi_squared_test(const std::uint64_t* counts) const;
+
+  Config m_config;                            ///< The monitor configuration.
+  std::vector<FairnessCounters> m_windows;    ///< Ring of per-seat window counters.
+  std::size_t m_current;                      ///< Window currently being recorded into.
+  std::vector<std::uint64_t> m_table_counts;  ///< Table-major cumulative counts.
+};
+
+/**
+ * @brief Thread safe fairness monitor made of independently locked shards.
+ *
+ * Every shard owns a contiguous block of tables and holds the only per-table counts of those tables, so the table
+ * counts take the same memory however many shards there are; only the per-seat windows are repeated per shard. Hands
+ * are routed to shards by table, so threads that own disjoint blocks of tables rarely contend. Tests are run on a
+ * merged snapshot.
+ */
+class ShardedFairnessMonitor
+{
+public:
+  /**
+   * @brief Constructs a sharded monitor.
+   *
+   * @param config The configuration of the whole monitor, all tables included.
+   * @param num_shards The number of shards, typically the number of recording threads; at most one shard per table
+   * is created.
+   *
+   * @throws std::invalid_argument if there are no shards or the configuration is invalid.
+   */
+  ShardedFairnessMonitor(const FairnessMonitor::Config& config, std::size_t num_shards);
+
+  /**
+   * @brief Records a hand of the given category.
+   *
+   * @param table The table the hand was dealt at.
+   * @param seat The seat the hand was dealt to.
+   * @param category The hand category.
+   *
+   * @throws std::out_of_range if the table, seat or category is not covered by the configuration.
+   */
+  void record(std::size_t table, std::size_t seat, std::size_t category);
+
+  /**
+   * @brief Records a pair of hole cards, categorized by starting hand class.
+   *
+   * @param table The table the hand was dealt at.
+   * @param seat The seat the hand was dealt to.
+   * @param first The first hole card.
+   * @param second The second hole card.
+   *
+   * @throws std::invalid_argument if the monitor does not count the NumStartingHands starting hand classes.
+   * @throws std::out_of_range if the table or seat is not covered by the configuration.
+   */
+  void record_hand(std::size_t table, std::size_t seat, const Card& first, const Card& second)
+  {
+    FairnessMonitor::check_starting_hands(m_config);
+    record(table, seat, starting_hand_class(first.id(), second.id()));
+  }
+
+  /**
+   * @brief Starts a new window in every shard.
+   */
+  void advance_window();
+
+  /**
+   * @brief Merges all shards into a single monitor.
+   *
+   * @return The merged monitor, on which tests can be run.
+   */
+  FairnessMonitor snapshot() const;
+
+private:
+  struct Shard
+  {
+    Shard(const FairnessMonitor::Config& config, std::size_t first)
+      : monitor(config)
+      , first_table(first)
+    {
+    }
+
+    mutable std::mutex mutex;
+    FairnessMonitor monitor;  // counts tables [first_table, first_table + monitor.config().num_tables)
+    std::size_t first_table;
+  };
+
+  FairnessMonitor::Config m_config;              ///< The configuration of the whole monitor.
+  std::size_t m_tables_per_shard;                ///< Size of the block of tables owned by every shard but the last.
+  std::vector<std::unique_ptr<Shard>> m_shards;  ///< The shards, each padded by its own allocation.
+};
+
+}  // namespace deck_of_cards
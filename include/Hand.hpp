@@ -0,0 +1,258 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <DeckBatch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace deck_of_cards
+{
+/**
+ * @brief A hand of at most N cards stored inline, in the order they were added.
+ *
+ * Unlike a std::vector of shared_ptr<Card> it never allocates, so arrays of hands for a whole table live on the stack
+ * or inside an arena. A CardSet mirror of the cards makes contains() a single bit test.
+ *
+ * push_back() rejects a card the hand already holds, but deal() and deal_table() store the cards as the deck deals
+ * them: a multi-deck Shoe may deal a card twice to the same hand, and the set then holds it once.
+ *
+ * @tparam N The capacity.
+ */
+template <std::size_t N>
+class Hand
+{
+  static_assert(N > 0 && N <= NumCards, "a hand holds 1 to 52 cards");
+
+public:
+  /**
+   * @brief Constructs an empty hand.
+   */
+  Hand() noexcept
+    : m_set()
+    , m_size(0)
+  {
+  }
+
+  /**
+   * @brief Gets the capacity.
+   *
+   * @return The maximum number of cards.
+   */
+  static constexpr std::size_t capacity() noexcept
+  {
+    return N;
+  };
+
+  /**
+   * @brief Appends a card.
+   *
+   * @param card The card to append.
+   *
+   * @throws std::length_error if the hand is full.
+   * @throws std::invalid_argument if the hand already holds the card.
+   */
+  void push_back(CardId card)
+  {
+    if (m_size == N)
+    {
+      throw std::length_error("Hand is full");
+    }
+    if (m_set.contains(card))
+    {
+      throw std::invalid_argument("Hand already holds the card");
+    }
+
+    m_cards[m_size++] = card;
+    m_set.insert(card);
+  }
+
+  /**
+   * @brief Removes a card, keeping the order of the others.
+   *
+   * @param card The card to remove.
+   * @return True if the card was in the hand.
+   */
+  bool remove(CardId card) noexcept
+  {
+    if (!m_set.contains(card))
+    {
+      return false;
+    }
+
+    std::size_t position = 0;
+    while (m_cards[position] != card)
+    {
+      ++position;
+    }
+    std::memmove(m_cards + position, m_cards + position + 1, m_size - position - 1);
+    --m_size;
+    // cards dealt from a multi-deck shoe may repeat, and the set keeps a card while a copy remains
+    bool copy = false;
+    for (std::size_t i = position; i < m_size && !copy; ++i)
+    {
+      copy = m_cards[i] == card;
+    }
+    if (!copy)
+    {
+      m_set.erase(card);
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Checks whether the hand holds a card.
+   *
+   * @param card The card.
+   * @return True if the card is in the hand.
+   */
+  bool contains(CardId card) const noexcept
+  {
+    return m_set.contains(card);
+  }
+
+  /**
+   * @brief Removes every card.
+   */
+  void clear() noexcept
+  {
+    m_size = 0;
+    m_set = CardSet();
+  }
+
+  /**
+   * @brief Deals cards from any deck with a bulk deal_cards(CardId*, std::size_t), e.g. Deck or PackedDeck.
+   *
+   * @param deck The deck to deal from.
+   * @param count The number of cards to deal.
+   * @return The number of cards dealt, which is smaller than count if the deck or the hand runs out.
+   */
+  template <typename Source>
+  std::size_t deal(Source& deck, std::size_t count)
+  {
+    return add_dealt(deck.deal_cards(m_cards + m_size, clamp(count)));
+  }
+
+  /**
+   * @brief Deals cards from one deck of a DeckBatch.
+   *
+   * @param batch The deck batch.
+   * @param deck The deck index.
+   * @param count The number of cards to deal.
+   * @return The number of cards dealt, which is smaller than count if the deck or the hand runs out.
+   */
+  std::size_t deal(DeckBatch& batch, std::size_t deck, std::size_t count)
+  {
+    return add_dealt(batch.deal_cards(deck, m_cards + m_size, clamp(count)));
+  }
+
+  /**
+   * @brief Gets the cards of the hand as a set.
+   *
+   * @return The set of cards.
+   */
+  CardSet set() const noexcept
+  {
+    return m_set;
+  };
+
+  CardId operator[](std::size_t index) const noexcept
+  {
+    return m_cards[index];
+  };
+
+  const CardId* begin() const noexcept
+  {
+    return m_cards;
+  };
+
+  const CardId* end() const noexcept
+  {
+    return m_cards + m_size;
+  };
+
+  std::size_t size() const noexcept
+  {
+    return m_size;
+  };
+
+  bool empty() const noexcept
+  {
+    return m_size == 0;
+  };
+
+private:
+  std::size_t clamp(std::size_t count) const noexcept
+  {
+    return count < N - m_size ? count : N - m_size;
+  }
+
+  template <std::size_t M, typename Source>
+  friend std::size_t deal_table(Source& deck, Hand<M>* hands, std::size_t num_hands, std::size_t cards_per_hand);
+
+  void add_dealt_card(CardId card) noexcept
+  {
+    m_cards[m_size++] = card;
+    m_set.insert(card);
+  }
+
+  std::size_t add_dealt(std::size_t dealt) noexcept
+  {
+    for (std::size_t i = m_size; i < m_size + dealt; ++i)
+    {
+      m_set.insert(m_cards[i]);
+    }
+    m_size = static_cast<std::uint8_t>(m_size + dealt);
+
+    return dealt;
+  }
+
+  CardSet m_set;        ///< The cards as a set.
+  CardId m_cards[N];    ///< The cards in the order they were added.
+  std::uint8_t m_size;  ///< Number of cards.
+};
+
+/**
+ * @brief Deals a table of hands round-robin, one card per seat per round, with a single bulk deal from the deck.
+ *
+ * @param deck The deck to deal from, with a bulk deal_cards(CardId*, std::size_t).
+ * @param hands The hands of the seats, which the cards are appended to.
+ * @param num_hands The number of seats.
+ * @param cards_per_hand The number of cards for every seat.
+ * @return The number of cards dealt.
+ *
+ * Every check happens before the first card leaves the deck. As with Hand::deal(), cards repeated by a multi-deck
+ * Shoe are kept, so a seat may hold two copies of a card.
+ *
+ * @throws std::length_error if the hands cannot take the cards or the deck holds too few.
+ */
+template <std::size_t N, typename Source>
+std::size_t deal_table(Source& deck, Hand<N>* hands, std::size_t num_hands, std::size_t cards_per_hand)
+{
+  const std::size_t total = num_hands * cards_per_hand;
+  if (total > NumCards || total > deck.num_cards())
+  {
+    throw std::length_error("Not enough cards to deal the table");
+  }
+  for (std::size_t seat = 0; seat < num_hands; ++seat)
+  {
+    if (hands[seat].size() + cards_per_hand > N)
+    {
+      throw std::length_error("Hand is full");
+    }
+  }
+
+  CardId cards[NumCards];
+  deck.deal_cards(cards, total);
+  for (std::size_t card = 0; card < total; ++card)
+  {
+    hands[card % num_hands].add_dealt_card(cards[card]);
+  }
+
+  return total;
+}
+
+}  // namespace deck_of_cards
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Strength of a poker hand: the best 5 card hand scores 7462, the worst 1, and 0 marks an invalid hand.
+ */
+using HandRank = std::uint16_t;
+
+/**
+ * @brief The number of distinct 5 card poker hand strengths.
+ */
+constexpr std::size_t NumHandRanks = 7462;
+
+class MappedTableFile;
+
+/**
+ * @brief Version of the on-disk evaluator table format, bumped whenever the layout or the ranking changes.
+ */
+constexpr std::uint32_t EvaluatorTableVersion = 1;
+
+/**
+ * @brief Environment variable naming an evaluator table file for HandEvaluator::instance() to map.
+ */
+constexpr const char* EvaluatorTableEnvironment = "DECK_OF_CARDS_EVALUATOR_TABLES";
+
+/**
+ * @brief Enumeration of poker hand categories, from weakest to strongest.
+ */
+enum class HandCategory
+{
+  HighCard = 0,
+  Pair,
+  TwoPair,
+  ThreeOfAKind,
+  Straight,
+  Flush,
+  FullHouse,
+  FourOfAKind,
+  StraightFlush
+};
+
+/**
+ * @brief Gets the category of a hand rank.
+ *
+ * @param rank A valid hand rank.
+ * @return The hand category.
+ */
+HandCategory hand_category(HandRank rank) noexcept;
+
+/**
+ * @brief Lookup table poker hand evaluator for 5, 6 and 7 card hands.
+ *
+ * Flushes are resolved with a table indexed by the 13 bit rank mask of the flush suit. Every other hand only depends
+ * on its multiset of ranks, which is mapped to a dense index with the combinatorial number system and looked up in a
+ * table per hand size. All tables live in one contiguous block of about 160 KB, which is either generated in process or
+ * mapped read only from a file written by save(), so that it is paged in lazily and shared by every process using it.
+ */
+class HandEvaluator
+{
+public:
+  /**
+   * @brief Gets the process wide evaluator.
+   *
+   * On first use the tables are mapped from the file named by the DECK_OF_CARDS_EVALUATOR_TABLES environment
+   * variable. When it is unset, missing or invalid, they are generated on every core instead.
+   *
+   * @return The evaluator.
+   */
+  static const HandEvaluator& instance();
+
+  /**
+   * @brief Constructs an evaluator by generating its tables.
+   *
+   * @param num_threads The number of threads to generate with, or zero for one per hardware thread.
+   */
+  explicit HandEvaluator(std::size_t num_threads = 0);
+
+  /**
+   * @brief Constructs an evaluator by mapping tables saved with save().
+   *
+   * @param path The table file.
+   * @param verify Whether to verify the checksum, which reads the whole file instead of paging it in lazily.
+   *
+   * @throws std::runtime_error if the file cannot be mapped, or has the wrong format, version, size or checksum.
+   */
+  HandEvaluator(const std::string& path, bool verify = true);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  HandEvaluator(const HandEvaluator&) = delete;
+
+  /**
+   * @brief Unmaps the tables if they were mapped from a file.
+   */
+  ~HandEvaluator();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  HandEvaluator& operator=(const HandEvaluator&) = delete;
+
+  /**
+   * @brief Writes the tables to a file, replacing it atomically so that processes mapping the old file are unaffected.
+   *
+   * @param path The table file.
+   *
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void save(const std::string& path) const;
+
+  /**
+   * @brief Evaluates a hand of 5, 6 or 7 cards.
+   *
+   * @param cards The cards in the hand.
+   * @return The rank of the best 5 card hand that can be made from the cards.
+   *
+   * @throws std::invalid_argument if the hand does not hold 5, 6 or 7 cards.
+   */
+  HandRank evaluate(CardSet cards) const;
+
+  /**
+   * @brief Evaluates many hands.
+   *
+   * @param hands The hands to evaluate.
+   * @param ranks Output array receiving one rank per hand.
+   * @param count The number of hands.
+   */
+  void evaluate_batch(const CardSet* hands, HandRank* ranks, std::size_t count) const;
+
+  /**
+   * @brief Gets the lookup tables as one block of memory, e.g. to prefault or lock them.
+   *
+   * @return Pointer to the start of the tables.
+   */
+  const void* tables() const noexcept
+  {
+    return m_tables;
+  };
+
+  /**
+   * @brief Gets the size of the lookup tables.
+   *
+   * @return The size in bytes.
+   */
+  std::size_t table_bytes() const noexcept
+  {
+    return m_num_entries * sizeof(std::uint16_t);
+  };
+
+  /**
+   * @brief Gets whether the tables are mapped from a file rather than generated.
+   *
+   * @return True if the tables are mapped.
+   */
+  bool mapped() const noexcept
+  {
+    return m_file != nullptr;
+  };
+
+private:
+  void set_tables(const std::uint16_t* tables);
+
+  std::vector<std::uint16_t> m_storage;     ///< Generated lookup tables, empty when mapped.
+  std::unique_ptr<MappedTableFile> m_file;  ///< The mapped table file, or nullptr.
+  const std::uint16_t* m_tables;            ///< All lookup tables, back to back.
+  std::size_t m_num_entries;                ///< Number of entries in all lookup tables.
+  const std::uint16_t* m_flush;             ///< Best hand per 13 bit flush rank mask.
+  const std::uint16_t* m_rank_tables[8];    ///< Non-flush table per hand size, indexed by rank multiset.
+};
+
+/**
+ * @brief Evaluates a hand of 5, 6 or 7 cards with the process wide evaluator.
+ *
+ * @param cards The cards in the hand.
+ * @return The hand rank.
+ */
+inline HandRank evaluate(CardSet cards)
+{
+  return HandEvaluator::instance().evaluate(cards);
+}
+
+}  // namespace deck_of_cards
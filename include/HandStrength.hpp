@@ -0,0 +1,254 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Range.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+class MappedTableFile;
+class WritableTableFile;
+
+/**
+ * @brief Version of the on-disk hand strength table format.
+ */
+constexpr std::uint32_t HandStrengthVersion = 1;
+
+/**
+ * @brief The streets of hold'em with a board, valued by the number of board cards.
+ */
+enum class Street
+{
+  Flop = 3,
+  Turn = 4,
+  River = 5
+};
+
+/**
+ * @brief The bucket of entries that were not clustered: hole cards overlapping the board or boards not computed.
+ */
+constexpr std::uint16_t NoBucket = 0xFFFF;
+
+/**
+ * @brief Computes the hand strength of every two card combination on a complete board.
+ *
+ * @param board The five board cards.
+ * @param strengths Receives, per combination index, the share of the 990 opponent combinations the combination beats,
+ * ties counting half; entries of combinations overlapping the board are left alone.
+ *
+ * @throws std::invalid_argument if the board does not hold five cards.
+ */
+void river_strengths(CardSet board, float* strengths);
+
+/**
+ * @brief How far a hand strength job has got, reported after every finished board.
+ */
+struct HandStrengthProgress
+{
+  std::size_t units_done;  ///< Finished boards, those restored from the file included.
+  std::size_t num_units;   ///< Boards in total.
+  double seconds;          ///< Time spent by this run.
+};
+
+/**
+ * @brief Computes the expected hand strength of every hand on every canonical board of a street.
+ *
+ * The expected hand strength (EHS) of hole cards on a flop or turn averages their river hand strength over every
+ * runout, EHS² averages its square, and the histogram counts the runouts per hand strength bin. On the river EHS is
+ * the hand strength itself. Boards are only enumerated up to relabeling of the suits, 1,755 flops, 16,432 turns and
+ * 134,459 rivers, and every board is a work unit storing all 1,326 hole combinations. Units are spread over a
+ * ThreadPool. The output file, 2.3 GB for a turn job with 50 bins, is created at its full size and doubles as a
+ * checkpoint: every finished unit is written in place, and its done flag follows at the next checkpoint, once the
+ * record has been flushed to storage, so a job resumes from the file it writes even after a power loss. The checksum
+ * is computed once at the end of every run. A flop job evaluates about two billion hands.
+ */
+class HandStrengthJob
+{
+public:
+  struct Config
+  {
+    std::size_t num_bins = 50;             ///< Hand strength histogram bins on the flop and turn, 1 to 1000.
+    std::size_t num_threads = 0;           ///< Worker threads, 0 for one per hardware thread.
+    std::string path;                      ///< Output file to resume and write, empty to keep results in memory.
+    std::size_t checkpoint_interval = 64;  ///< Finished units between checkpoints, which flush and mark them done.
+    std::size_t max_units = 0;             ///< Units to finish in this run, 0 for all remaining.
+
+    /// Called after every finished unit, one call at a time, empty for no reporting.
+    std::function<void(const HandStrengthProgress&)> progress;
+  };
+
+  /**
+   * @brief Constructs a job.
+   *
+   * @param street The street to compute.
+   * @param config The run options; the number of bins is ignored on the river.
+   *
+   * @throws std::invalid_argument if the number of bins is out of range or the checkpoint interval is zero.
+   */
+  HandStrengthJob(Street street, const Config& config);
+
+  /**
+   * @brief Closes the output file.
+   */
+  ~HandStrengthJob();
+
+  /**
+   * @brief Computes the remaining units.
+   *
+   * @return True once every unit is done.
+   *
+   * @throws std::runtime_error if the file cannot be read or written or was written for another configuration.
+   */
+  bool run();
+
+  /**
+   * @brief Writes the results computed so far, replacing the file atomically; a job writing its own file copies it.
+   *
+   * @param path The output file.
+   *
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void save(const std::string& path) const;
+
+  std::size_t num_units() const noexcept
+  {
+    return m_boards.size();
+  };
+
+  std::size_t units_done() const noexcept;
+
+private:
+  Street m_street;                            ///< Street computed.
+  Config m_config;                            ///< Run options.
+  std::vector<CardSet> m_boards;              ///< Canonical boards, one per unit.
+  std::size_t m_record_words;                 ///< 64 bit words per unit record.
+  std::vector<char> m_done;                   ///< Whether every unit is finished.
+  std::vector<std::uint64_t> m_data;          ///< Unit records, when they are kept in memory.
+  std::unique_ptr<WritableTableFile> m_file;  ///< The output file, once a run opened it.
+};
+
+/**
+ * @brief A hand strength table written by HandStrengthJob, mapped read only.
+ *
+ * Each board record starts with a done flag and the size of its suit isomorphism class, followed by one entry per
+ * combination index: EHS and EHS² as 16 bit fixed point fractions, 65535 being 1, then the histogram counts. A lookup
+ * relabels the suits of the board to its canonical board, finds that by binary search and reads one entry.
+ */
+class HandStrengthTable
+{
+public:
+  /**
+   * @brief Maps a table file.
+   *
+   * @param path The table file.
+   * @param street The street it was computed for.
+   * @param num_bins The histogram bins it was computed with, ignored on the river.
+   * @param verify Whether to verify the checksum, which reads the whole file instead of paging it in lazily.
+   *
+   * @throws std::runtime_error if the file cannot be mapped, or has the wrong format, version, size or checksum.
+   */
+  HandStrengthTable(const std::string& path, Street street, std::size_t num_bins, bool verify = true);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  HandStrengthTable(const HandStrengthTable&) = delete;
+
+  /**
+   * @brief Unmaps the table.
+   */
+  ~HandStrengthTable();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  HandStrengthTable& operator=(const HandStrengthTable&) = delete;
+
+  /**
+   * @brief Finds the entry of hole cards on a board.
+   *
+   * @param hole The two hole cards.
+   * @param board The board of the table's street.
+   * @return The entry index, canonical board index times NumCombos plus the relabeled combination index.
+   *
+   * @throws std::invalid_argument if the cards have the wrong sizes or overlap.
+   * @throws std::out_of_range if the board has not been computed yet.
+   */
+  std::size_t entry(CardSet hole, CardSet board) const;
+
+  double ehs(std::size_t entry) const noexcept
+  {
+    return values(entry)[0] * (1.0 / 65535);
+  };
+
+  double ehs2(std::size_t entry) const noexcept
+  {
+    return values(entry)[1] * (1.0 / 65535);
+  };
+
+  /**
+   * @brief Gets the hand strength histogram of an entry.
+   *
+   * @param entry The entry index.
+   * @return The runouts per bin, num_bins() of them; nullptr on the river.
+   */
+  const std::uint16_t* histogram(std::size_t entry) const noexcept
+  {
+    return m_num_bins == 0 ? nullptr : values(entry) + 2;
+  };
+
+  std::size_t num_bins() const noexcept
+  {
+    return m_num_bins;
+  };
+
+  std::size_t num_entries() const noexcept
+  {
+    return m_boards.size() * NumCombos;
+  };
+
+  /**
+   * @brief Clusters every computed entry into buckets of similar strength with k-means.
+   *
+   * Flop and turn entries are compared by the squared distance between their cumulative histograms, which orders
+   * distributions like the earth mover's distance does, and river entries by hand strength. Entries are weighted by
+   * the size of their board's suit isomorphism class. Centers start at evenly spaced EHS quantiles and the Lloyd
+   * iterations run on a ThreadPool with partial sums merged in a fixed order, so the buckets are deterministic.
+   *
+   * @param num_buckets The number of buckets, at most NoBucket.
+   * @param iterations The number of Lloyd iterations.
+   * @param num_threads The number of worker threads, 0 for one per hardware thread.
+   * @return The bucket of every entry, NoBucket where the hole cards overlap the board or the board is not computed.
+   *
+   * @throws std::invalid_argument if the number of buckets is 0, too large or more than the computed entries.
+   */
+  std::vector<std::uint16_t> cluster(std::size_t num_buckets, std::size_t iterations,
+                                     std::size_t num_threads = 0) const;
+
+private:
+  const std::uint16_t* values(std::size_t entry) const noexcept
+  {
+    const std::uint64_t* record = m_records + entry / NumCombos * m_record_words;
+    return reinterpret_cast<const std::uint16_t*>(record + 1) + entry % NumCombos * (2 + m_num_bins);
+  };
+
+  bool computed(std::size_t unit) const noexcept
+  {
+    return (m_records[unit * m_record_words] & 0xFFFFFFFF) != 0;
+  };
+
+  std::unique_ptr<MappedTableFile> m_file;  ///< The mapped table file.
+  std::size_t m_num_bins;                   ///< Histogram bins per entry, 0 on the river.
+  std::vector<CardSet> m_boards;            ///< Canonical boards in ascending mask order, one per record.
+  std::size_t m_record_words;               ///< 64 bit words per board record.
+  const std::uint64_t* m_records;           ///< Board records.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <array>
+#include <cstdint>
+#include <functional>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Enumeration of the continuous health tests run by a HealthMonitor.
+ */
+enum class HealthTest
+{
+  RepetitionCount = 0,
+  AdaptiveProportion,
+  PositionalChiSquared
+};
+
+/**
+ * @brief Describes a failed health test.
+ */
+struct HealthFailure
+{
+  HealthTest test;        ///< The test that failed.
+  double statistic;       ///< The observed test statistic (run length, window count or chi-squared value).
+  double threshold;       ///< The cutoff the statistic reached or exceeded.
+  std::uint64_t samples;  ///< The number of samples the monitor had seen when the failure fired.
+};
+
+/**
+ * @brief Continuous health tests on the random stream feeding Deck::shuffle().
+ *
+ * The monitor runs the NIST SP 800-90B repetition count and adaptive proportion tests on the raw generator output
+ * consumed by shuffles, and a windowed per-position chi-squared test on the cards subsequently dealt. All tests are
+ * incremental: every sample costs a few compares and increments, and the chi-squared statistic is only evaluated
+ * once per window. To keep the amortized cost negligible only every `check_every`-th shuffle is monitored.
+ *
+ * A monitor is not thread safe; attach one monitor per thread (or per Deck).
+ */
+class HealthMonitor
+{
+public:
+  /**
+   * @brief Callback invoked whenever a health test fails.
+   */
+  using FailureCallback = std::function<void(const HealthFailure&)>;
+
+  /**
+   * @brief Tuning parameters for the health tests.
+   */
+  struct Config
+  {
+    double min_entropy = 6.0;               ///< Assessed min-entropy, in bits, of each 8 bit sample.
+    double alpha = 9.313225746154785e-10;   ///< False positive rate for the 800-90B tests (2^-30).
+    std::size_t window_size = 512;          ///< Number of samples in each adaptive proportion window.
+    std::size_t check_every = 64;           ///< Only every check_every-th shuffle is fed to the monitor.
+    std::size_t chi_squared_window = 4096;  ///< Number of monitored shuffles per chi-squared evaluation.
+    double chi_squared_alpha = 1e-6;        ///< Significance level of the positional chi-squared test.
+  };
+
+  /**
+   * @brief Constructs a HealthMonitor with the default configuration.
+   *
+   * @param callback The function called when a test fails.
+   */
+  explicit HealthMonitor(FailureCallback callback);
+
+  /**
+   * @brief Constructs a HealthMonitor with the given configuration.
+   *
+   * @param callback The function called when a test fails.
+   * @param config The test parameters.
+   *
+   * @throws std::invalid_argument if the configuration is inconsistent.
+   */
+  HealthMonitor(FailureCallback callback, const Config& config);
+
+  /**
+   * @brief Notifies the monitor that a shuffle is starting.
+   *
+   * @return True if this shuffle should be fed to the monitor, false if it is skipped.
+   */
+  bool begin_shuffle();
+
+  /**
+   * @brief Feeds one raw generator output to the repetition count and adaptive proportion tests.
+   *
+   * Only the low 8 bits of the sample are tested.
+   *
+   * @param sample The raw generator output.
+   */
+  void add_sample(std::uint32_t sample)
+  {
+    const std::uint8_t value = static_cast<std::uint8_t>(sample);
+    ++m_samples;
+
+    // repetition count test
+    if (value == m_rct_value)
+    {
+      if (++m_rct_count >= m_rct_cutoff)
+      {
+        fail(HealthTest::RepetitionCount, m_rct_count, m_rct_cutoff);
+        m_rct_count = 1;
+      }
+    }
+    else
+    {
+      m_rct_value = value;
+      m_rct_count = 1;
+    }
+
+    // adaptive proportion test
+    if (m_apt_index == 0)
+    {
+      m_apt_value = value;
+      m_apt_count = 1;
+    }
+    else if (value == m_apt_value && ++m_apt_count >= m_apt_cutoff)
+    {
+      fail(HealthTest::AdaptiveProportion, m_apt_count, m_apt_cutoff);
+      m_apt_index = 0;
+      return;
+    }
+    if (++m_apt_index == m_config.window_size)
+    {
+      m_apt_index = 0;
+    }
+  }
+
+  /**
+   * @brief Records that a card was dealt at the given position of a monitored shuffle.
+   *
+   * @param position The deal position, 0 for the first card dealt after the shuffle.
+   * @param card The dense index of the dealt card.
+   */
+  void add_deal(std::size_t position, CardId card)
+  {
+    ++m_position_counts[position][card];
+  }
+
+  /**
+   * @brief Gets the repetition count test cutoff derived from the configuration.
+   *
+   * @return The number of identical consecutive samples that triggers a failure.
+   */
+  std::size_t repetition_cutoff() const noexcept
+  {
+    return m_rct_cutoff;
+  };
+
+  /**
+   * @brief Gets the adaptive proportion test cutoff derived from the configuration.
+   *
+   * @return The count of the first sample value within one window that triggers a failure.
+   */
+  std::size_t proportion_cutoff() const noexcept
+  {
+    return m_apt_cutoff;
+  };
+
+  /**
+   * @brief Gets the number of samples fed to the monitor so far.
+   *
+   * @return The number of samples.
+   */
+  std::uint64_t samples() const noexcept
+  {
+    return m_samples;
+  };
+
+  /**
+   * @brief Evaluates the positional chi-squared test on the deals seen in the current window and starts a new one.
+   *
+   * This is called automatically every `chi_squared_window` monitored shuffles.
+   *
+   * @return True if the test passed (or there was nothing to test), false if it failed.
+   */
+  bool evaluate_positions();
+
+private:
+  void fail(HealthTest test, double statistic, double threshold);
+
+  Config m_config;                ///< The test parameters.
+  FailureCallback m_callback;     ///< Called on every failure.
+  std::size_t m_rct_cutoff;       ///< Repetition count test cutoff.
+  std::size_t m_apt_cutoff;       ///< Adaptive proportion test cutoff.
+  std::uint64_t m_samples;        ///< Total samples seen.
+  std::uint8_t m_rct_value;       ///< Value of the current repetition run.
+  std::size_t m_rct_count;        ///< Length of the current repetition run.
+  std::uint8_t m_apt_value;       ///< First value of the current proportion window.
+  std::size_t m_apt_count;        ///< Occurrences of m_apt_value in the current window.
+  std::size_t m_apt_index;        ///< Position within the current proportion window.
+  std::size_t m_shuffles;         ///< Shuffles seen, monitored or not.
+  std::size_t m_window_shuffles;  ///< Monitored shuffles in the current chi-squared window.
+
+  std::array<std::array<std::uint32_t, NumCards>, NumCards> m_position_counts;  ///< Card counts per deal position.
+};
+
+}  // namespace deck_of_cards
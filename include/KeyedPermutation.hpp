@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The number of Feistel rounds of a KeyedPermutation.
+ */
+constexpr std::size_t KeyedPermutationRounds = 12;
+
+/**
+ * @brief A keyed pseudorandom order of the deck whose cards are computed one at a time, without a deck in memory.
+ *
+ * The key and the shuffle number select one of the orders: the card at any position, and the position of any card,
+ * is a few dozen instructions away and the same on every machine, so a log that records the key and the shuffle
+ * numbers can be checked card by card. Positions are encrypted by a balanced Feistel network on six bits whose round
+ * functions are random tables of eight 3 bit values drawn from the key and the shuffle number with splitmix64. Values
+ * past the deck are encrypted again, cycle walking, until they land in [0, NumCards), which keeps the network a
+ * bijection on the deck and takes 1.2 passes on average.
+ *
+ * The order is only as unpredictable as the key is secret and the round functions are strong; this is a statistical
+ * shuffle for simulations and replays, not a cryptographic one.
+ */
+class KeyedPermutation
+{
+public:
+  /**
+   * @brief Derives the round functions of one order.
+   *
+   * @param key The key.
+   * @param shuffle The number of the shuffle under the key.
+   */
+  KeyedPermutation(std::uint64_t key, std::uint64_t shuffle) noexcept;
+
+  /**
+   * @brief Gets the card at a position of the order.
+   *
+   * @param position The position, less than NumCards.
+   * @return The card id.
+   */
+  CardId card_at(std::size_t position) const noexcept;
+
+  /**
+   * @brief Gets the position of a card in the order, the inverse of card_at().
+   *
+   * @param card The card id.
+   * @return The position.
+   */
+  std::size_t position_of(CardId card) const noexcept;
+
+  /**
+   * @brief Writes out the whole order.
+   *
+   * @param cards Output array of NumCards card ids.
+   */
+  void order(CardId* cards) const noexcept;
+
+private:
+  std::uint32_t m_rounds[KeyedPermutationRounds];  ///< Round functions, eight 3 bit outputs each.
+};
+
+/**
+ * @brief Gets the card at a position of a keyed order, see KeyedPermutation.
+ *
+ * @param key The key.
+ * @param shuffle The number of the shuffle under the key.
+ * @param position The position, less than NumCards.
+ * @return The card id.
+ */
+CardId card_at(std::uint64_t key, std::uint64_t shuffle, std::size_t position) noexcept;
+
+}  // namespace deck_of_cards
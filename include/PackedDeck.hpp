@@ -0,0 +1,181 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <Permutation.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The number of bytes holding a bit-packed deck order, 6 bits for each of the NumCards cards.
+ */
+constexpr std::size_t PackedOrderBytes = NumCards * 6 / 8;
+
+/**
+ * @brief Gets the shared, immutable Card object for a card id.
+ *
+ * Compact deck representations use these instead of allocating Card objects per deck.
+ *
+ * @param card The card id.
+ * @return The canonical card.
+ */
+std::shared_ptr<Card> card_from_id(CardId card);
+
+/**
+ * @brief Unpacks a bit-packed deck order into one card id per byte.
+ *
+ * @param packed The PackedOrderBytes packed bytes.
+ * @param cards Output array of NumCards card ids.
+ */
+void unpack_order(const std::uint8_t* packed, CardId* cards) noexcept;
+
+/**
+ * @brief Packs one card id per byte into a bit-packed deck order.
+ *
+ * @param cards The NumCards card ids.
+ * @param packed Output array of PackedOrderBytes bytes.
+ */
+void pack_order(const CardId* cards, std::uint8_t* packed) noexcept;
+
+/**
+ * @brief A deck stored in 40 bytes: the card order packed at 6 bits per card plus a deal cursor.
+ *
+ * PackedDeck offers the dealing interface of Deck for workloads that keep very many decks resident, such as
+ * simulations of millions of tables. Cards are dealt from the front of the packed order, and shuffling only permutes
+ * the cards that have not been dealt yet. PackedDeck is trivially copyable, so arrays of decks are contiguous and can
+ * be scanned in bulk.
+ */
+class PackedDeck
+{
+public:
+  /**
+   * @brief Constructs a deck holding every card, in card id order.
+   */
+  PackedDeck() noexcept;
+
+  /**
+   * @brief Returns every card to the deck, in card id order.
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief Shuffles the cards that have not been dealt yet with the Fisher-Yates algorithm, drawing from rand() like
+   * Deck.
+   */
+  void shuffle();
+
+  /**
+   * @brief Shuffles the cards that have not been dealt yet with the given random number generator.
+   *
+   * @param generator A uniform random bit generator producing at least 32 bits per call.
+   */
+  template <typename Generator>
+  void shuffle(Generator& generator)
+  {
+    CardId cards[NumCards];
+    unpack_order(m_packed, cards);
+    for (std::size_t i = NumCards - 1; i > m_cursor; --i)
+    {
+      const std::size_t j = m_cursor + static_cast<std::size_t>(generator()) % (i - m_cursor + 1);
+      std::swap(cards[i], cards[j]);
+    }
+    pack_order(cards, m_packed);
+  }
+
+  /**
+   * @brief Deals a card from the deck.
+   *
+   * @return A shared pointer to the canonical Card object, or nullptr if the deck is empty.
+   */
+  std::shared_ptr<Card> deal_card();
+
+  /**
+   * @brief Deals several cards from the deck as compact card ids.
+   *
+   * @param cards Output array receiving the ids of the dealt cards.
+   * @param count The number of cards to deal.
+   * @return The number of cards dealt, which is smaller than count if the deck runs out.
+   */
+  std::size_t deal_cards(CardId* cards, std::size_t count) noexcept;
+
+  /**
+   * @brief Gets the number of cards remaining in the deck.
+   *
+   * @return The number of cards remaining in the deck.
+   */
+  std::size_t num_cards() const noexcept
+  {
+    return NumCards - m_cursor;
+  };
+
+  /**
+   * @brief Gets the card at a position of the order without dealing it.
+   *
+   * @param position The position, 0 for the first card dealt after a reset.
+   * @return The card id.
+   */
+  CardId card_at(std::size_t position) const noexcept
+  {
+    // the card's 6 bits may straddle two bytes
+    const std::size_t bit = position * 6;
+    const unsigned low = m_packed[bit / 8];
+    const unsigned high = bit / 8 + 1 < PackedOrderBytes ? m_packed[bit / 8 + 1] : 0;
+    return static_cast<CardId>(((low | (high << 8)) >> (bit % 8)) & 0x3F);
+  }
+
+  /**
+   * @brief Gets the cards that have not been dealt yet.
+   *
+   * @return The remaining cards.
+   */
+  CardSet undealt() const noexcept;
+
+  /**
+   * @brief Copies out the whole order, dealt cards included.
+   *
+   * @param cards Output array of NumCards card ids.
+   */
+  void order(CardId* cards) const noexcept
+  {
+    unpack_order(m_packed, cards);
+  }
+
+  /**
+   * @brief Replaces the order and rewinds the deal cursor.
+   *
+   * @param cards The NumCards card ids, which must form a permutation of the deck.
+   */
+  void set_order(const CardId* cards) noexcept
+  {
+    pack_order(cards, m_packed);
+    m_cursor = 0;
+  }
+
+  /**
+   * @brief Rearranges the whole order, dealt cards included, and rewinds the deal cursor like set_order().
+   *
+   * A permutation acts on all NumCards positions, so the dealt cards move into the undealt part and the other way
+   * round. Keeping the cursor would deal some cards twice and others never; permuting starts a new deal instead.
+   *
+   * @param permutation The permutation, e.g. a replayed shuffle of a fresh deck.
+   */
+  void permute(const Permutation& permutation) noexcept;
+
+private:
+  std::uint8_t m_packed[PackedOrderBytes];  ///< The order, 6 bits per card, little-endian within groups of four.
+  std::uint8_t m_cursor;                    ///< Position of the next card to deal.
+};
+
+/**
+ * @brief Collects the undealt cards of many decks.
+ *
+ * @param decks The decks to scan.
+ * @param count The number of decks.
+ * @param undealt Output array receiving one set per deck.
+ */
+void undealt_cards(const PackedDeck* decks, std::size_t count, CardSet* undealt) noexcept;
+
+}  // namespace deck_of_cards
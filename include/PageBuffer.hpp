@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The size of a huge page on x86-64 and most aarch64 kernels.
+ */
+constexpr std::size_t HugePageSize = std::size_t(2) << 20;
+
+/**
+ * @brief How the memory of a PageBuffer is backed.
+ */
+enum class PageMode
+{
+  Default = 0,  ///< Regular 4 KB pages, with transparent huge pages disabled for the buffer.
+  Transparent,  ///< 2 MB aligned memory advised to the kernel as transparent huge page material.
+  Explicit      ///< Pages from the kernel's reserved hugetlbfs pool (vm.nr_hugepages).
+};
+
+/**
+ * @brief A page aligned, zero filled block of anonymous memory for bulk deck and simulation storage.
+ *
+ * Requesting huge pages never fails: an explicit request falls back to transparent huge pages when the reserved pool
+ * is exhausted, and transparent huge pages fall back to regular pages when unsupported. mode() reports what was
+ * actually obtained.
+ */
+class PageBuffer
+{
+public:
+  /**
+   * @brief Constructs an empty buffer.
+   */
+  PageBuffer() noexcept;
+
+  /**
+   * @brief Allocates a buffer.
+   *
+   * @param bytes The requested size, rounded up to the page size of the obtained mode.
+   * @param mode The requested page mode.
+   *
+   * @throws std::bad_alloc if no memory could be mapped at all.
+   */
+  PageBuffer(std::size_t bytes, PageMode mode);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  PageBuffer(const PageBuffer&) = delete;
+
+  /**
+   * @brief Move constructor, leaving other empty.
+   *
+   * @param other The buffer to take over.
+   */
+  PageBuffer(PageBuffer&& other) noexcept;
+
+  /**
+   * @brief Unmaps the buffer.
+   */
+  ~PageBuffer();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  PageBuffer& operator=(const PageBuffer&) = delete;
+
+  /**
+   * @brief Move assignment operator, leaving other empty.
+   *
+   * @param other The buffer to take over.
+   * @return Reference to this object.
+   */
+  PageBuffer& operator=(PageBuffer&& other) noexcept;
+
+  /**
+   * @brief Gets the start of the buffer.
+   *
+   * @return Pointer to the first byte, or nullptr for an empty buffer.
+   */
+  void* data() const noexcept
+  {
+    return m_data;
+  };
+
+  /**
+   * @brief Gets the usable size, which is the request rounded up to whole pages.
+   *
+   * @return The size in bytes.
+   */
+  std::size_t size() const noexcept
+  {
+    return m_size;
+  };
+
+  /**
+   * @brief Gets the page mode that was actually obtained.
+   *
+   * @return The page mode.
+   */
+  PageMode mode() const noexcept
+  {
+    return m_mode;
+  };
+
+private:
+  void release() noexcept;
+
+  void* m_data;        ///< Start of the mapping.
+  std::size_t m_size;  ///< Length of the mapping.
+  PageMode m_mode;     ///< Page mode actually obtained.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The number of bytes of a Permutation: the NumCards positions and identity padding, one vector of 64 bytes.
+ */
+constexpr std::size_t PermutationBytes = 64;
+
+/**
+ * @brief A rearrangement of the NumCards positions of a deck order, such as a replayed shuffle, a riffle or a cut.
+ *
+ * Entry i is the position of the source order that the card at position i comes from, so applying a permutation is
+ * a byte gather: result[i] = cards[permutation[i]]. The entries are padded to a full cache line with the identity,
+ * which lets the kernels behind apply() and compose() work on whole vectors. Those use vpermb, one instruction for
+ * all 64 bytes, when compiled for AVX-512 VBMI, sixteen pshufb over the four 16 byte quarters when compiled for
+ * SSSE3, and a byte loop otherwise; see the DECK_OF_CARDS_NATIVE build option.
+ */
+class Permutation
+{
+public:
+  /**
+   * @brief Constructs the identity.
+   */
+  Permutation() noexcept;
+
+  /**
+   * @brief Constructs a permutation from its source positions.
+   *
+   * @param sources The NumCards source positions, result[i] taking the card at sources[i].
+   *
+   * @throws std::invalid_argument if the positions are not a permutation of [0, NumCards).
+   */
+  explicit Permutation(const std::uint8_t* sources);
+
+  /**
+   * @brief Finds the permutation that rearranges one order into another, e.g. to replay a logged shuffle.
+   *
+   * @param before The NumCards card ids of the order before.
+   * @param after The NumCards card ids of the order after.
+   * @return The permutation taking before to after.
+   *
+   * @throws std::invalid_argument if the orders do not both hold every card once.
+   */
+  static Permutation between(const CardId* before, const CardId* after);
+
+  /**
+   * @brief Cuts the deck: the cards from a position on move to the front, like a rotation of the seats.
+   *
+   * @param position The position of the new first card, taken modulo NumCards.
+   * @return The permutation.
+   */
+  static Permutation cut(std::size_t position) noexcept;
+
+  /**
+   * @brief A perfect riffle of the two halves of the deck, cards alternating from each.
+   *
+   * @param out Whether the top card stays on top, an out faro, rather than the top card of the second half going on
+   * top, an in faro.
+   * @return The permutation.
+   */
+  static Permutation faro(bool out = true) noexcept;
+
+  /**
+   * @brief Gets the permutation undoing this one.
+   *
+   * @return The inverse.
+   */
+  Permutation inverse() const noexcept;
+
+  std::uint8_t operator[](std::size_t position) const noexcept
+  {
+    return m_sources[position];
+  };
+
+  /**
+   * @brief Gets the entries, identity padded.
+   *
+   * @return Pointer to PermutationBytes source positions.
+   */
+  const std::uint8_t* data() const noexcept
+  {
+    return m_sources;
+  };
+
+  bool operator==(const Permutation& other) const noexcept;
+
+  bool operator!=(const Permutation& other) const noexcept
+  {
+    return !(*this == other);
+  };
+
+private:
+  friend Permutation compose(const Permutation& first, const Permutation& second) noexcept;
+
+  std::uint8_t m_sources[PermutationBytes];  ///< Source position of every position.
+};
+
+/**
+ * @brief Applies a permutation to a deck order.
+ *
+ * @param permutation The permutation.
+ * @param cards The NumCards card ids of the order.
+ * @param result Output array of NumCards card ids, which may be cards itself.
+ */
+void apply(const Permutation& permutation, const CardId* cards, CardId* result) noexcept;
+
+/**
+ * @brief Applies a permutation to every byte of a cache line: a deck order padded to PermutationBytes, such as one
+ * deck of a DeckBatch. The padding stays in place.
+ *
+ * @param permutation The permutation.
+ * @param line The PermutationBytes bytes, permuted in place.
+ */
+void apply_line(const Permutation& permutation, std::uint8_t* line) noexcept;
+
+/**
+ * @brief Composes two permutations.
+ *
+ * @param first The permutation applied first.
+ * @param second The permutation applied second.
+ * @return The permutation equal to applying first, then second.
+ */
+Permutation compose(const Permutation& first, const Permutation& second) noexcept;
+
+}  // namespace deck_of_cards
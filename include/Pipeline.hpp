@@ -0,0 +1,193 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <HandEvaluator.hpp>
+#include <TableState.hpp>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The largest number of hands carried by one batch.
+ */
+constexpr std::size_t MaxBatchHands = 256;
+
+/**
+ * @brief The largest number of cards per hand carried by a batch.
+ */
+constexpr std::size_t MaxHandCards = 7;
+
+/**
+ * @brief A compact batch of dealt hands, stored as card ids back to back.
+ */
+struct CardBatch
+{
+  std::size_t num_hands;                       ///< Number of hands in the batch, zero marks end of stream.
+  std::size_t cards_per_hand;                  ///< Number of cards in every hand.
+  CardId cards[MaxBatchHands * MaxHandCards];  ///< Hand-major card ids.
+
+  /**
+   * @brief Gets the cards of one hand.
+   *
+   * @param index The hand index.
+   * @return Pointer to cards_per_hand card ids.
+   */
+  const CardId* hand(std::size_t index) const noexcept
+  {
+    return cards + index * cards_per_hand;
+  }
+};
+
+/**
+ * @brief The evaluated ranks of a CardBatch.
+ */
+struct RankBatch
+{
+  std::size_t num_hands;          ///< Number of hands in the batch, zero marks end of stream.
+  HandRank ranks[MaxBatchHands];  ///< One rank per hand.
+};
+
+/**
+ * @brief Timing of one pipeline stage, summed over its parallel instances.
+ */
+struct StageStats
+{
+  std::uint64_t batches;  ///< Batches processed.
+  std::uint64_t hands;    ///< Hands processed.
+  double busy_seconds;    ///< Time spent inside the stage function.
+  double stall_seconds;   ///< Time spent waiting on an empty input or a full output queue.
+};
+
+/**
+ * @brief Timing of a whole pipeline run.
+ */
+struct PipelineStats
+{
+  StageStats deal;       ///< The dealing stage.
+  StageStats evaluate;   ///< The evaluation stage.
+  StageStats aggregate;  ///< The aggregation stage.
+  double wall_seconds;   ///< Wall clock duration of the run.
+};
+
+/**
+ * @brief A staged deal, evaluate and aggregate simulation pipeline.
+ *
+ * Each stage runs its own tight loop on its own thread, so its code and data stay hot in cache instead of being
+ * interleaved with the other stages. The work is split into `lanes`: every lane owns a PackedDeck with its own
+ * generator, a dealing thread and an evaluation thread, connected by single producer, single consumer ring buffers of
+ * batches. The lane generators are seeded from the configured seed and the lane index, so the lanes never contend on
+ * the locked rand() and every run with the same seed deals the same hands. A single aggregation
+ * stage drains all lanes on the calling thread. Full queues block their producer, so a slow stage throttles the
+ * stages feeding it instead of letting memory grow.
+ *
+ * Stage functions must not throw.
+ */
+class Pipeline
+{
+public:
+  /**
+   * @brief Fills batch.num_hands hands of batch.cards_per_hand cards from a lane's deck and generator.
+   */
+  using DealStage = std::function<void(TableState&, CardBatch&)>;
+
+  /**
+   * @brief Evaluates every hand of a card batch into a rank batch.
+   */
+  using EvaluateStage = std::function<void(const CardBatch&, RankBatch&)>;
+
+  /**
+   * @brief Consumes evaluated batches, one at a time.
+   */
+  using AggregateStage = std::function<void(const RankBatch&)>;
+
+  /**
+   * @brief Shape of a pipeline.
+   */
+  struct Config
+  {
+    std::size_t lanes = 1;                   ///< Parallel deal and evaluate stage pairs.
+    std::size_t batch_size = MaxBatchHands;  ///< Hands per batch, at most MaxBatchHands.
+    std::size_t queue_capacity = 8;          ///< Batches buffered between two stages, a power of two.
+    std::size_t cards_per_hand = 7;          ///< Cards dealt per hand, at most MaxHandCards.
+    std::uint64_t seed = 1;                  ///< Seed of the lane generators, each seeded from it and the lane index.
+  };
+
+  /**
+   * @brief Constructs a pipeline with the default deal and evaluate stages.
+   *
+   * @param config The pipeline shape.
+   * @param aggregate The aggregation stage.
+   *
+   * @throws std::invalid_argument if the configuration is out of range, hands holding fewer than 5 cards included
+   * since the HandEvaluator cannot rank them.
+   */
+  Pipeline(const Config& config, AggregateStage aggregate);
+
+  /**
+   * @brief Constructs a pipeline with the default deal stage and a custom evaluate stage, which may take hands of any
+   * size up to MaxHandCards.
+   *
+   * @param config The pipeline shape.
+   * @param evaluate The evaluation stage, called concurrently from every lane.
+   * @param aggregate The aggregation stage.
+   *
+   * @throws std::invalid_argument if the configuration is out of range.
+   */
+  Pipeline(const Config& config, EvaluateStage evaluate, AggregateStage aggregate);
+
+  /**
+   * @brief Replaces the dealing stage.
+   *
+   * @param deal The new stage, called concurrently from every lane with that lane's deck and generator.
+   */
+  void set_deal_stage(DealStage deal)
+  {
+    m_deal = std::move(deal);
+  }
+
+  /**
+   * @brief Replaces the evaluation stage.
+   *
+   * @param evaluate The new stage, called concurrently from every lane.
+   */
+  void set_evaluate_stage(EvaluateStage evaluate)
+  {
+    m_evaluate = std::move(evaluate);
+  }
+
+  /**
+   * @brief Runs the pipeline until num_hands hands have been aggregated.
+   *
+   * @param num_hands The number of hands to simulate.
+   * @return Per-stage timings.
+   *
+   * @throws std::invalid_argument if the default evaluate stage would be fed hands of fewer than 5 cards.
+   */
+  PipelineStats run(std::uint64_t num_hands);
+
+  /**
+   * @brief The default dealing stage: every hand is dealt from a freshly reset deck shuffled with the lane's generator.
+   *
+   * @param lane The lane's deck and generator.
+   * @param batch The batch to fill.
+   */
+  static void deal_hands(TableState& lane, CardBatch& batch);
+
+  /**
+   * @brief The default evaluation stage, using the process wide HandEvaluator.
+   *
+   * @param cards The dealt hands.
+   * @param ranks The batch receiving their ranks.
+   */
+  static void evaluate_hands(const CardBatch& cards, RankBatch& ranks);
+
+private:
+  Config m_config;             ///< The pipeline shape.
+  DealStage m_deal;            ///< The dealing stage.
+  EvaluateStage m_evaluate;    ///< The evaluation stage.
+  AggregateStage m_aggregate;  ///< The aggregation stage.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Range.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+class MappedTableFile;
+
+/**
+ * @brief Version of the on-disk preflop equity table format.
+ */
+constexpr std::uint32_t PreflopEquityVersion = 1;
+
+/**
+ * @brief Computes the exact all-in equity of one hand against another by enumerating every runout of the board.
+ *
+ * @param hero The first hand.
+ * @param villain The second hand.
+ * @param board The known board cards, at most 5.
+ * @return The share of the pot the first hand wins, ties counting half.
+ *
+ * @throws std::invalid_argument if the cards overlap or the hands plus a full board do not make 5 to 7 cards.
+ */
+double heads_up_equity(CardSet hero, CardSet villain, CardSet board = CardSet());
+
+/**
+ * @brief Heads-up preflop all-in equities of every pair of two card combinations and of every pair of the 169 starting
+ * hand classes.
+ *
+ * Equities are stored as 16 bit fixed point fractions, 65535 being a certain win, in a 1326 by 1326 combination table
+ * followed by a 169 by 169 class table, so a lookup is a single load. Generation only computes one matchup per suit
+ * isomorphism class (about 47 thousand out of 812 thousand) and spreads them over a ThreadPool. Tables are saved to and
+ * mapped from a file in the same way as the HandEvaluator tables.
+ */
+class PreflopEquityTable
+{
+public:
+  /**
+   * @brief Function giving the equity of a hero hand against a villain hand, heads_up_equity by default.
+   */
+  using EquityFunction = std::function<double(CardSet, CardSet)>;
+
+  /**
+   * @brief Constructs a table by generating it, which takes CPU hours with the exact equity function.
+   *
+   * @param num_threads The number of threads to generate with, or zero for one per hardware thread.
+   * @param equity The equity of one matchup, which must not depend on the naming of the suits.
+   */
+  explicit PreflopEquityTable(std::size_t num_threads = 0, EquityFunction equity = EquityFunction());
+
+  /**
+   * @brief Constructs a table by mapping a file written by save().
+   *
+   * @param path The table file.
+   * @param verify Whether to verify the checksum, which reads the whole file instead of paging it in lazily.
+   *
+   * @throws std::runtime_error if the file cannot be mapped, or has the wrong format, version, size or checksum.
+   */
+  PreflopEquityTable(const std::string& path, bool verify = true);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  PreflopEquityTable(const PreflopEquityTable&) = delete;
+
+  /**
+   * @brief Unmaps the table if it was mapped from a file.
+   */
+  ~PreflopEquityTable();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  PreflopEquityTable& operator=(const PreflopEquityTable&) = delete;
+
+  /**
+   * @brief Writes the table to a file, replacing it atomically.
+   *
+   * @param path The table file.
+   *
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void save(const std::string& path) const;
+
+  /**
+   * @brief Gets the equity of one combination against another.
+   *
+   * @param hero The hero combination index.
+   * @param villain The villain combination index.
+   * @return The equity, or 0 when the combinations share a card.
+   */
+  double equity(std::size_t hero, std::size_t villain) const noexcept
+  {
+    return m_combos[hero * NumCombos + villain] * (1.0 / 65535);
+  }
+
+  /**
+   * @brief Gets the equity of one two card hand against another.
+   *
+   * @param hero The hero hole cards.
+   * @param villain The villain hole cards.
+   * @return The equity, or 0 when the hands share a card.
+   */
+  double equity(CardSet hero, CardSet villain) const noexcept;
+
+  /**
+   * @brief Gets the equity of one starting hand class against another, averaged over their compatible combinations.
+   *
+   * @param hero The hero class, see starting_hand_class().
+   * @param villain The villain class.
+   * @return The equity.
+   */
+  double class_equity(std::size_t hero, std::size_t villain) const noexcept;
+
+  /**
+   * @brief Gets the number of suit isomorphism classes that were computed.
+   *
+   * @return The number of classes, or 0 when the table was mapped from a file.
+   */
+  std::size_t num_matchup_classes() const noexcept
+  {
+    return m_num_matchup_classes;
+  };
+
+private:
+  std::vector<std::uint16_t> m_storage;     ///< Generated tables, empty when mapped.
+  std::unique_ptr<MappedTableFile> m_file;  ///< The mapped table file, or nullptr.
+  const std::uint16_t* m_combos;            ///< Combination against combination equities.
+  const std::uint16_t* m_classes;           ///< Class against class equities.
+  std::size_t m_num_matchup_classes;        ///< Suit isomorphism classes computed by the generator.
+};
+
+}  // namespace deck_of_cards
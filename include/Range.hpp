@@ -0,0 +1,163 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The number of distinct two card combinations, C(52, 2).
+ */
+constexpr std::size_t NumCombos = 1326;
+
+/**
+ * @brief The number of 64 bit words of a bitmask with one bit per combination.
+ */
+constexpr std::size_t ComboMaskWords = (NumCombos + 63) / 64;
+
+/**
+ * @brief Gets the dense index of a two card combination, independent of the order of the cards.
+ *
+ * @param first One card.
+ * @param second The other card, different from the first.
+ * @return The combination index in [0, NumCombos).
+ */
+constexpr std::size_t combo_index(CardId first, CardId second) noexcept
+{
+  return first < second ? std::size_t(second) * (second - 1) / 2 + first
+                        : std::size_t(first) * (first - 1) / 2 + second;
+}
+
+/**
+ * @brief Gets the cards of a two card combination.
+ *
+ * @param combo The combination index.
+ * @return The two cards.
+ */
+CardSet combo_cards(std::size_t combo) noexcept;
+
+/**
+ * @brief Gets the lower card id of a two card combination.
+ *
+ * @param combo The combination index.
+ * @return The lower card id.
+ */
+CardId combo_low_card(std::size_t combo) noexcept;
+
+/**
+ * @brief Gets the higher card id of a two card combination.
+ *
+ * @param combo The combination index.
+ * @return The higher card id.
+ */
+CardId combo_high_card(std::size_t combo) noexcept;
+
+/**
+ * @brief A weighted range of two card hands, one weight per combination.
+ *
+ * Next to the dense weights the range keeps a bitmask of the combinations with a positive weight, so membership
+ * tests and counting do not have to scan the weights.
+ */
+class Range
+{
+public:
+  /**
+   * @brief Constructs an empty range.
+   */
+  Range() noexcept;
+
+  /**
+   * @brief Gets the range holding every combination with weight 1.
+   *
+   * @return The full range.
+   */
+  static Range full() noexcept;
+
+  /**
+   * @brief Gets the weight of a combination.
+   *
+   * @param combo The combination index.
+   * @return The weight, zero when the combination is not in the range.
+   */
+  float weight(std::size_t combo) const noexcept
+  {
+    return m_weights[combo];
+  };
+
+  /**
+   * @brief Checks whether a combination has a positive weight.
+   *
+   * @param combo The combination index.
+   * @return True if the combination is in the range.
+   */
+  bool contains(std::size_t combo) const noexcept
+  {
+    return (m_mask[combo / 64] >> (combo % 64)) & 1;
+  };
+
+  /**
+   * @brief Sets the weight of a combination.
+   *
+   * @param combo The combination index.
+   * @param weight The weight, zero to remove the combination.
+   *
+   * @throws std::out_of_range if the combination index is too large.
+   * @throws std::invalid_argument if the weight is negative.
+   */
+  void set_weight(std::size_t combo, float weight);
+
+  /**
+   * @brief Sets the weight of the combination of two cards.
+   *
+   * @param first One card.
+   * @param second The other card.
+   * @param weight The weight, zero to remove the combination.
+   *
+   * @throws std::invalid_argument if the cards are equal or the weight is negative.
+   */
+  void set_weight(CardId first, CardId second, float weight);
+
+  /**
+   * @brief Removes every combination holding one of the given cards, e.g. the board or cards dead in a Deck.
+   *
+   * @param dead The dead cards.
+   */
+  void remove(CardSet dead) noexcept;
+
+  /**
+   * @brief Gets the number of combinations with a positive weight.
+   *
+   * @return The number of combinations.
+   */
+  std::size_t num_combos() const noexcept;
+
+  /**
+   * @brief Gets the sum of all weights.
+   *
+   * @return The total weight.
+   */
+  double total_weight() const noexcept;
+
+  const float* weights() const noexcept
+  {
+    return m_weights;
+  };
+
+  /**
+   * @brief Gets the bitmask of the combinations with a positive weight.
+   *
+   * @return Pointer to ComboMaskWords words, bit combo % 64 of word combo / 64 belonging to combination combo.
+   */
+  const std::uint64_t* combo_mask() const noexcept
+  {
+    return m_mask;
+  };
+
+private:
+  float m_weights[NumCombos];            ///< Weight per combination index.
+  std::uint64_t m_mask[ComboMaskWords];  ///< Bit per combination index, set when its weight is positive.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Deck.hpp>
+#include <Range.hpp>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Parses a range in the usual hand range notation.
+ *
+ * The text is a comma separated list of entries, each optionally followed by ":weight" (default 1):
+ * - "AA", "AKs", "AKo", "AK": a pair, the suited, offsuit or all combinations of two values.
+ * - "AhKh": one exact combination, suits written as c, d, h or s.
+ * - "TT+", "A5s+", "K9o+": the pairs from TT up to AA, or the kickers from 5 up to just below the high card.
+ * - "TT-77", "A5s-A2s": every pair or kicker between the two endpoints, both included.
+ *
+ * Values are written as A, K, Q, J, T and 9 to 2, in either case. Whitespace is ignored and a later entry overrides
+ * the weight an earlier entry gave the same combination.
+ *
+ * @param text The range text.
+ * @return The parsed range.
+ *
+ * @throws std::invalid_argument if the text is not valid range notation.
+ */
+Range parse_range(const std::string& text);
+
+/**
+ * @brief Parses a range and drops the combinations conflicting with the cards removed from a deck.
+ *
+ * @param text The range text, see parse_range(const std::string&).
+ * @param deck The deck, whose dealt cards can not be part of any combination.
+ * @return The parsed range without the combinations holding a removed card.
+ *
+ * @throws std::invalid_argument if the text is not valid range notation.
+ */
+Range parse_range(const std::string& text, const Deck& deck);
+
+/**
+ * @brief A thread safe, least recently used cache of parsed ranges keyed by their text.
+ *
+ * Tools evaluate the same few range strings over and over; the cache parses each one once and hands out shared,
+ * immutable results. Parsing happens outside the lock, so a slow parse never blocks lookups of other ranges.
+ */
+class RangeCache
+{
+public:
+  /**
+   * @brief Constructs an empty cache.
+   *
+   * @param capacity The number of ranges kept before the least recently used one is evicted.
+   *
+   * @throws std::invalid_argument if capacity is zero.
+   */
+  explicit RangeCache(std::size_t capacity = 1024);
+
+  /**
+   * @brief Gets the parsed range of a text, parsing it on a miss.
+   *
+   * @param text The range text.
+   * @return The parsed range.
+   *
+   * @throws std::invalid_argument if the text is not valid range notation; invalid texts are not cached.
+   */
+  std::shared_ptr<const Range> get(const std::string& text);
+
+  /**
+   * @brief Gets the parsed range of a text without the combinations conflicting with the cards removed from a deck.
+   *
+   * @param text The range text.
+   * @param deck The deck, whose dealt cards can not be part of any combination.
+   * @return A copy of the cached range with the conflicting combinations removed.
+   *
+   * @throws std::invalid_argument if the text is not valid range notation.
+   */
+  Range get(const std::string& text, const Deck& deck);
+
+  /**
+   * @brief Drops every cached range and resets the statistics.
+   */
+  void clear();
+
+  std::size_t size() const;
+
+  std::size_t capacity() const noexcept
+  {
+    return m_capacity;
+  };
+
+  std::size_t hits() const;
+
+  std::size_t misses() const;
+
+private:
+  using Entry = std::pair<std::string, std::shared_ptr<const Range>>;
+
+  const std::size_t m_capacity;                                         ///< Maximum number of cached ranges.
+  mutable std::mutex m_mutex;                                           ///< Guards everything below.
+  std::list<Entry> m_entries;                                           ///< Ranges, most recently used first.
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;  ///< Position of every cached text.
+  std::size_t m_hits;                                                   ///< Lookups answered from the cache.
+  std::size_t m_misses;                                                 ///< Lookups that had to parse.
+};
+
+}  // namespace deck_of_cards
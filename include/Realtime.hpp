@@ -0,0 +1,133 @@
+#pragma once
+
+#include <DeckBatch.hpp>
+#include <PageBuffer.hpp>
+#include <TableScheduler.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief What a RealtimeMemory did to the memory registered with it.
+ */
+struct RealtimeReport
+{
+  std::size_t regions = 0;           ///< Number of regions registered.
+  std::size_t prefaulted_bytes = 0;  ///< Bytes touched so that they are backed by physical pages.
+  std::size_t locked_bytes = 0;      ///< Bytes of registered regions locked with mlock.
+  std::size_t pinned_bytes = 0;      ///< Bytes the kernel reports as locked for the whole process (VmLck).
+  bool lock_failed = false;          ///< Whether locking was requested but refused, e.g. by RLIMIT_MEMLOCK.
+};
+
+/**
+ * @brief Realtime initialization for latency critical table processes.
+ *
+ * Every region registered is touched page by page when it is added, so that dealing never takes a page fault on it,
+ * and is optionally locked into RAM. Locking can also cover the whole process, including the heap behind Deck and
+ * future allocations. The hand evaluator tables are built and warmed on construction. Locks are released on
+ * destruction, but locking the process also stops glibc from trimming the heap and from serving allocations with
+ * mmap, and those allocator settings are process wide and stay in place after destruction.
+ */
+class RealtimeMemory
+{
+public:
+  /**
+   * @brief Realtime options.
+   */
+  struct Config
+  {
+    bool lock_memory = false;    ///< mlock every registered region.
+    bool lock_process = false;   ///< mlockall the current and future memory of the process, implies lock_memory.
+    bool warm_evaluator = true;  ///< Build, prefault and lock the HandEvaluator tables.
+  };
+
+  /**
+   * @brief Prepares the process according to the configuration.
+   *
+   * @param config The realtime options.
+   */
+  explicit RealtimeMemory(const Config& config);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  RealtimeMemory(const RealtimeMemory&) = delete;
+
+  /**
+   * @brief Unlocks everything this object locked.
+   */
+  ~RealtimeMemory();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  RealtimeMemory& operator=(const RealtimeMemory&) = delete;
+
+  /**
+   * @brief Prefaults, and optionally locks, a writable region.
+   *
+   * @param data The start of the region.
+   * @param bytes The length of the region.
+   */
+  void add_region(void* data, std::size_t bytes);
+
+  /**
+   * @brief Prefaults, and optionally locks, a read only region such as a lookup table.
+   *
+   * @param data The start of the region.
+   * @param bytes The length of the region.
+   */
+  void add_region(const void* data, std::size_t bytes);
+
+  /**
+   * @brief Prefaults, and optionally locks, a page buffer.
+   *
+   * @param buffer The buffer.
+   */
+  void add(PageBuffer& buffer);
+
+  /**
+   * @brief Prefaults, and optionally locks, the decks of a batch.
+   *
+   * @param batch The deck batch.
+   */
+  void add(DeckBatch& batch);
+
+  /**
+   * @brief Preallocates the mailboxes of every table, see TableScheduler::reserve().
+   *
+   * The mailboxes are heap memory, only prefaulted and locked by lock_process, and are not counted in the report.
+   *
+   * @param scheduler The table scheduler.
+   * @param messages The number of pending messages per table to make room for.
+   */
+  void add(TableScheduler& scheduler, std::size_t messages);
+
+  /**
+   * @brief Gets the report, with the process wide locked memory read at the time of the call.
+   *
+   * @return The report.
+   */
+  RealtimeReport report() const;
+
+private:
+  void lock(const void* data, std::size_t bytes);
+
+  Config m_config;                                            ///< Realtime options.
+  RealtimeReport m_report;                                    ///< What has been done so far.
+  std::vector<std::pair<const void*, std::size_t>> m_locked;  ///< Regions locked with mlock.
+  bool m_process_locked;                                      ///< Whether mlockall succeeded.
+};
+
+/**
+ * @brief Gets the memory the kernel has locked for this process.
+ *
+ * @return The VmLck figure in bytes, or 0 where it is unavailable.
+ */
+std::size_t locked_process_memory();
+
+}  // namespace deck_of_cards
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <AliasTable.hpp>
+#include <Deck.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Several standard decks shuffled together, as dealt from in baccarat and blackjack.
+ *
+ * The shoe keeps its order as compact card ids and counts the undealt cards of every value, so the composition of
+ * the remainder is available without a scan at any point of the shoe.
+ */
+class Shoe
+{
+public:
+  /**
+   * @brief Constructs a shoe in card id order, deck after deck.
+   *
+   * @param num_decks The number of decks.
+   *
+   * @throws std::invalid_argument if num_decks is zero.
+   */
+  explicit Shoe(std::size_t num_decks);
+
+  /**
+   * @brief Returns every card to the shoe, in card id order.
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief Shuffles the undealt cards with rand(), like Deck::shuffle().
+   */
+  void shuffle();
+
+  /**
+   * @brief Shuffles the undealt cards with the given random number generator.
+   *
+   * @param generator A uniform random bit generator producing at least 32 bits per call.
+   */
+  template <typename Generator>
+  void shuffle(Generator& generator)
+  {
+    const std::size_t size = m_cards.size();
+    for (std::size_t i = size - 1; i > m_cursor; --i)
+    {
+      const std::size_t j = m_cursor + static_cast<std::size_t>(generator()) % (i - m_cursor + 1);
+      std::swap(m_cards[i], m_cards[j]);
+    }
+  }
+
+  /**
+   * @brief Deals cards from the shoe.
+   *
+   * @param cards Output array receiving the ids of the dealt cards.
+   * @param count The number of cards to deal.
+   * @return The number of cards dealt, which is smaller than count if the shoe runs out.
+   */
+  std::size_t deal_cards(CardId* cards, std::size_t count) noexcept;
+
+  /**
+   * @brief Deals one card, the shoe must not be empty.
+   *
+   * @return The id of the dealt card.
+   */
+  CardId deal_card() noexcept
+  {
+    const CardId card = m_cards[m_cursor++];
+    --m_counts[card % 13];
+    return card;
+  };
+
+  /**
+   * @brief Gets the number of undealt cards of one value.
+   *
+   * @param value The value.
+   * @return The number of cards of that value remaining, over all suits.
+   */
+  std::size_t count(Value value) const noexcept
+  {
+    return m_counts[static_cast<int>(value) - 1];
+  };
+
+  /**
+   * @brief Gets the number of undealt cards of every value.
+   *
+   * @return Pointer to 13 counts, indexed by value with the ace first.
+   */
+  const std::size_t* counts() const noexcept
+  {
+    return m_counts;
+  };
+
+  std::size_t num_cards() const noexcept
+  {
+    return m_cards.size() - m_cursor;
+  };
+
+  std::size_t num_decks() const noexcept
+  {
+    return m_cards.size() / NumCards;
+  };
+
+  /**
+   * @brief Gets the number of cards dealt since the last reset, e.g. to compare against the cut card.
+   *
+   * @return The number of dealt cards.
+   */
+  std::size_t num_dealt() const noexcept
+  {
+    return m_cursor;
+  };
+
+private:
+  std::vector<CardId> m_cards;  ///< Order of the shoe, dealt cards included.
+  std::size_t m_cursor;         ///< Position of the next card to deal.
+  std::size_t m_counts[13];     ///< Undealt cards per value, ace first.
+};
+
+/**
+ * @brief A shoe of infinitely many decks, or of any fixed card or value distribution: every card is drawn
+ * independently.
+ *
+ * InfiniteShoe has the dealing interface of Shoe, so code written against one runs on the other. Shuffling reseeds
+ * the shoe's own generator from the given one, as the composition never changes; the shoe never runs out and its
+ * num_cards() is the largest std::size_t. Cards are drawn from an AliasTable over the 52 cards with a splitmix64
+ * generator, and deal_cards() draws in blocks: the random numbers first, then the table lookups in one batch.
+ */
+class InfiniteShoe
+{
+public:
+  /**
+   * @brief Constructs a shoe drawing every card with the same probability.
+   *
+   * @param seed The seed of the shoe's generator.
+   */
+  explicit InfiniteShoe(std::uint64_t seed = 1);
+
+  /**
+   * @brief Constructs a shoe drawing from a weighted composition.
+   *
+   * @param weights Either 13 weights per value, ace first, each spread evenly over the suits, or NumCards weights per
+   * card id.
+   * @param num_weights 13 or NumCards.
+   * @param seed The seed of the shoe's generator.
+   *
+   * @throws std::invalid_argument if the number of weights is wrong or the weights are invalid for an AliasTable.
+   */
+  InfiniteShoe(const double* weights, std::size_t num_weights, std::uint64_t seed = 1);
+
+  /**
+   * @brief Restarts the count of dealt cards.
+   */
+  void reset() noexcept
+  {
+    m_dealt = 0;
+  };
+
+  /**
+   * @brief Reseeds the shoe's generator with three calls to rand(), like Shoe::shuffle() drawing from rand().
+   */
+  void shuffle();
+
+  /**
+   * @brief Reseeds the shoe's generator from the given random number generator.
+   *
+   * @param generator A uniform random bit generator producing at least 32 bits per call.
+   */
+  template <typename Generator>
+  void shuffle(Generator& generator)
+  {
+    const std::uint64_t high = static_cast<std::uint32_t>(generator());
+    m_state = high << 32 | static_cast<std::uint32_t>(generator());
+  }
+
+  /**
+   * @brief Draws cards.
+   *
+   * @param cards Output array receiving the ids of the drawn cards.
+   * @param count The number of cards to draw.
+   * @return count.
+   */
+  std::size_t deal_cards(CardId* cards, std::size_t count) noexcept;
+
+  /**
+   * @brief Draws one card.
+   *
+   * @return The id of the drawn card.
+   */
+  CardId deal_card() noexcept
+  {
+    ++m_dealt;
+    return static_cast<CardId>(m_table.sample(next()));
+  };
+
+  /**
+   * @brief Gets the probability of drawing a card of one value.
+   *
+   * @param value The value.
+   * @return The probability, over all suits.
+   */
+  double probability(Value value) const noexcept;
+
+  std::size_t num_cards() const noexcept
+  {
+    return std::numeric_limits<std::size_t>::max();
+  };
+
+  /**
+   * @brief Gets the number of cards dealt since the last reset.
+   *
+   * @return The number of dealt cards.
+   */
+  std::size_t num_dealt() const noexcept
+  {
+    return m_dealt;
+  };
+
+private:
+  std::uint64_t next() noexcept
+  {
+    // splitmix64
+    std::uint64_t value = m_state += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+  }
+
+  AliasTable m_table;     ///< Distribution over the card ids.
+  std::uint64_t m_state;  ///< State of the generator.
+  std::size_t m_dealt;    ///< Cards dealt since the last reset.
+};
+
+}  // namespace deck_of_cards
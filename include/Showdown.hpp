@@ -0,0 +1,75 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <HandEvaluator.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The most seats a showdown can hold, one bit of the winners mask per seat.
+ */
+constexpr std::size_t MaxShowdownSeats = 16;
+
+/**
+ * @brief Outcome of a showdown.
+ */
+struct ShowdownResult
+{
+  std::uint32_t winners;  ///< Bit s set when seat s holds the best hand, more than one bit for a split pot.
+  HandRank best;          ///< Rank of the best hand.
+
+  /**
+   * @brief Gets the number of seats sharing the pot.
+   *
+   * @return The number of winners.
+   */
+  std::size_t num_winners() const noexcept
+  {
+    return static_cast<std::size_t>(__builtin_popcount(winners));
+  }
+
+  /**
+   * @brief Checks whether the pot is split.
+   *
+   * @return True if more than one seat holds the best hand.
+   */
+  bool split() const noexcept
+  {
+    return (winners & (winners - 1)) != 0;
+  }
+};
+
+/**
+ * @brief Ranks every seat's hand against the board and finds the winners.
+ *
+ * All seats are evaluated in one pass into a 16 lane rank vector, and the best rank and the mask of seats holding it
+ * are found with vector max, compare and movemask instructions, without branching on the ranks.
+ *
+ * @param board The community cards.
+ * @param hands The hole cards of every seat.
+ * @param num_seats The number of seats, 1 to MaxShowdownSeats.
+ * @param ranks Optional output array receiving the rank of every seat.
+ * @return The winners.
+ *
+ * @throws std::invalid_argument if there are too many seats, a hand shares a card with the board or another hand, or
+ * a hand plus the board does not hold 5 to 7 cards.
+ */
+ShowdownResult showdown(CardSet board, const CardSet* hands, std::size_t num_seats, HandRank* ranks = nullptr);
+
+/**
+ * @brief Runs many showdowns with the same number of seats, e.g. for simulated runouts.
+ *
+ * @param boards The board of every showdown.
+ * @param hands The hole cards, num_seats consecutive entries per showdown.
+ * @param num_seats The number of seats, 1 to MaxShowdownSeats.
+ * @param results Output array receiving one result per showdown.
+ * @param count The number of showdowns.
+ *
+ * @throws std::invalid_argument under the same conditions as showdown().
+ */
+void showdown_batch(const CardSet* boards, const CardSet* hands, std::size_t num_seats, ShowdownResult* results,
+                    std::size_t count);
+
+}  // namespace deck_of_cards
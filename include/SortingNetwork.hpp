@@ -0,0 +1,210 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The largest hand the sorting networks handle, a bridge hand.
+ */
+constexpr std::size_t MaxSortCards = 13;
+
+/**
+ * @brief Gets the number of compare-exchange steps of the sorting network for a hand size.
+ *
+ * @param count The number of cards, at most MaxSortCards.
+ * @return The number of comparators.
+ */
+std::size_t sorting_network_size(std::size_t count) noexcept;
+
+/**
+ * @brief Sorts a hand by card id, ascending, without data dependent branches.
+ *
+ * Hands of up to MaxSortCards cards go through a fixed sorting network of min/max steps; larger ones fall back to
+ * std::sort.
+ *
+ * @param cards The cards to sort in place.
+ * @param count The number of cards.
+ */
+void sort_cards(CardId* cards, std::size_t count) noexcept;
+
+/**
+ * @brief Sorts many hands of the same size by card id, ascending.
+ *
+ * With SSE2 sixteen hands are transposed into one vector per card position and run through the sorting network
+ * together, sixteen compare-exchanges per instruction.
+ *
+ * @param cards Hand-major card ids, as in CardBatch.
+ * @param cards_per_hand The number of cards in every hand.
+ * @param num_hands The number of hands.
+ */
+void sort_hands(CardId* cards, std::size_t cards_per_hand, std::size_t num_hands) noexcept;
+
+/**
+ * @brief A hand of up to MaxSortCards cards that is always sorted by card id.
+ *
+ * Unused slots hold an id above every card, so insert() can ripple the new card into place with one min/max pair per
+ * slot instead of searching and shifting.
+ */
+class SortedHand
+{
+public:
+  /**
+   * @brief The id stored in unused slots.
+   */
+  static constexpr CardId Empty = 0xFF;
+
+  /**
+   * @brief Constructs an empty hand.
+   */
+  SortedHand() noexcept
+    : m_size(0)
+  {
+    std::memset(m_cards, Empty, sizeof(m_cards));
+  }
+
+  /**
+   * @brief Constructs a hand from cards in any order.
+   *
+   * @param cards The cards.
+   * @param count The number of cards.
+   *
+   * @throws std::length_error if there are more than MaxSortCards cards.
+   */
+  SortedHand(const CardId* cards, std::size_t count)
+    : SortedHand()
+  {
+    if (count > MaxSortCards)
+    {
+      throw std::length_error("A sorted hand holds at most 13 cards");
+    }
+    std::memcpy(m_cards, cards, count);
+    sort_cards(m_cards, count);
+    m_size = count;
+  }
+
+  /**
+   * @brief Adds a card, keeping the hand sorted.
+   *
+   * @param card The card to add.
+   *
+   * @throws std::length_error if the hand is full.
+   */
+  void insert(CardId card)
+  {
+    if (m_size == MaxSortCards)
+    {
+      throw std::length_error("A sorted hand holds at most 13 cards");
+    }
+
+    CardId carry = card;
+    for (std::size_t i = 0; i < MaxSortCards; ++i)
+    {
+      const CardId low = std::min(m_cards[i], carry);
+      carry = std::max(m_cards[i], carry);
+      m_cards[i] = low;
+    }
+    ++m_size;
+  }
+
+  /**
+   * @brief Removes a card.
+   *
+   * @param card The card to remove.
+   * @return True if the card was in the hand.
+   */
+  bool erase(CardId card) noexcept
+  {
+    const std::size_t position = rank(card);
+    if (position == m_size || m_cards[position] != card)
+    {
+      return false;
+    }
+
+    std::memmove(m_cards + position, m_cards + position + 1, MaxSortCards - position - 1);
+    m_cards[MaxSortCards - 1] = Empty;
+    --m_size;
+
+    return true;
+  }
+
+  /**
+   * @brief Checks whether the hand holds a card.
+   *
+   * @param card The card.
+   * @return True if the card is in the hand.
+   */
+  bool contains(CardId card) const noexcept
+  {
+    bool found = false;
+    for (std::size_t i = 0; i < MaxSortCards; ++i)
+    {
+      found |= m_cards[i] == card;
+    }
+
+    return found;
+  }
+
+  /**
+   * @brief Gets the number of cards smaller than a card, which is where it is or would be inserted.
+   *
+   * @param card The card.
+   * @return The position of the card.
+   */
+  std::size_t rank(CardId card) const noexcept
+  {
+    std::size_t smaller = 0;
+    for (std::size_t i = 0; i < MaxSortCards; ++i)
+    {
+      smaller += m_cards[i] < card;
+    }
+
+    return smaller;
+  }
+
+  /**
+   * @brief Gets the cards of the hand as a set.
+   *
+   * @return The set of cards.
+   */
+  CardSet set() const noexcept
+  {
+    return CardSet(m_cards, m_size);
+  }
+
+  CardId operator[](std::size_t index) const noexcept
+  {
+    return m_cards[index];
+  };
+
+  const CardId* begin() const noexcept
+  {
+    return m_cards;
+  };
+
+  const CardId* end() const noexcept
+  {
+    return m_cards + m_size;
+  };
+
+  std::size_t size() const noexcept
+  {
+    return m_size;
+  };
+
+  bool empty() const noexcept
+  {
+    return m_size == 0;
+  };
+
+private:
+  CardId m_cards[MaxSortCards];  ///< The cards in ascending order, followed by Empty.
+  std::size_t m_size;            ///< Number of cards.
+};
+
+}  // namespace deck_of_cards
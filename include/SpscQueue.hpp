@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Bounded lock-free single producer, single consumer ring buffer.
+ *
+ * Slots are preallocated and reused, so pushing and popping never allocate. Producers fill a slot in place with
+ * begin_push()/commit_push() and consumers read it in place with front()/pop(), which avoids copying large batches.
+ * The head and tail indices live on separate cache lines so the two threads do not false share.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+  /**
+   * @brief Constructs a queue.
+   *
+   * @param capacity The number of slots, which must be a power of two.
+   *
+   * @throws std::invalid_argument if the capacity is not a power of two.
+   */
+  explicit SpscQueue(std::size_t capacity)
+    : m_slots(new T[capacity])
+    , m_mask(capacity - 1)
+    , m_head(0)
+    , m_tail(0)
+  {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+    {
+      throw std::invalid_argument("SpscQueue capacity must be a power of two");
+    }
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /**
+   * @brief Gets the next free slot for the producer to fill.
+   *
+   * @return The slot, or nullptr if the queue is full.
+   */
+  T* begin_push() noexcept
+  {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+    {
+      return nullptr;
+    }
+
+    return &m_slots[tail & m_mask];
+  }
+
+  /**
+   * @brief Publishes the slot returned by the last begin_push() to the consumer.
+   */
+  void commit_push() noexcept
+  {
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copies a value into the queue.
+   *
+   * @param value The value.
+   * @return False if the queue is full.
+   */
+  bool try_push(const T& value)
+  {
+    T* slot = begin_push();
+    if (slot == nullptr)
+    {
+      return false;
+    }
+    *slot = value;
+    commit_push();
+
+    return true;
+  }
+
+  /**
+   * @brief Gets the oldest published slot for the consumer to read.
+   *
+   * @return The slot, or nullptr if the queue is empty.
+   */
+  T* front() noexcept
+  {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+    {
+      return nullptr;
+    }
+
+    return &m_slots[head & m_mask];
+  }
+
+  /**
+   * @brief Releases the slot returned by the last front() back to the producer.
+   */
+  void pop() noexcept
+  {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Moves the oldest value out of the queue.
+   *
+   * @param value Receives the value.
+   * @return False if the queue is empty.
+   */
+  bool try_pop(T& value)
+  {
+    T* slot = front();
+    if (slot == nullptr)
+    {
+      return false;
+    }
+    value = *slot;
+    pop();
+
+    return true;
+  }
+
+  std::size_t capacity() const noexcept
+  {
+    return m_mask + 1;
+  }
+
+private:
+  std::unique_ptr<T[]> m_slots;     ///< The ring of slots.
+  std::size_t m_mask;               ///< capacity - 1, for wrapping indices.
+  char m_pad0[64];                  ///< Keeps the consumer index off the producer's cache line.
+  std::atomic<std::size_t> m_head;  ///< Next slot to consume, written by the consumer.
+  char m_pad1[64];                  ///< Keeps the producer index off the consumer's cache line.
+  std::atomic<std::size_t> m_tail;  ///< Next slot to fill, written by the producer.
+};
+
+}  // namespace deck_of_cards
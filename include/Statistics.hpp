@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Computes the quantile function (inverse CDF) of the standard normal distribution.
+ *
+ * @param p The probability, which must lie in the open interval (0, 1).
+ * @return The value z such that P(Z <= z) = p for Z ~ N(0, 1).
+ */
+double normal_quantile(double p);
+
+/**
+ * @brief Approximates the upper critical value of a chi-squared distribution.
+ *
+ * Uses the Wilson-Hilferty transformation, which is accurate to well under one percent for the large degrees of
+ * freedom seen in card position tests.
+ *
+ * @param dofs The degrees of freedom of the distribution.
+ * @param alpha The significance level of the test.
+ * @return The value x such that P(X > x) is approximately alpha.
+ */
+double chi_squared_critical_value(double dofs, double alpha);
+
+/**
+ * @brief Computes the smallest count c such that P(X <= c) >= 1 - alpha for X ~ Binomial(n, p).
+ *
+ * This is the CRITBINOM function used by NIST SP 800-90B to derive the adaptive proportion test cutoff.
+ *
+ * @param n The number of trials.
+ * @param p The success probability of each trial.
+ * @param alpha The significance level of the test.
+ * @return The critical count.
+ */
+std::size_t binomial_critical_value(std::size_t n, double p, double alpha);
+
+}  // namespace deck_of_cards
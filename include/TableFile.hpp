@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The 64 byte header of a precomputed table file, followed by the table entries in native byte order.
+ */
+struct TableFileHeader
+{
+  char magic[8];              ///< Identifies the kind of table.
+  std::uint32_t version;      ///< Format version of that kind of table.
+  std::uint32_t byte_order;   ///< 0x01020304 as written by the producing machine.
+  std::uint64_t num_entries;  ///< Number of table entries.
+  std::uint64_t checksum;     ///< 64 bit FNV-1a of the entries.
+  char reserved[32];          ///< Zero.
+};
+
+/**
+ * @brief The 64 bit FNV-1a hash of no bytes.
+ */
+constexpr std::uint64_t TableChecksumBasis = 14695981039346656037ull;
+
+/**
+ * @brief Computes the 64 bit FNV-1a hash used as table file checksum.
+ *
+ * @param data The bytes to hash.
+ * @param bytes The number of bytes.
+ * @param hash The hash of the bytes preceding these, to hash a table in pieces.
+ * @return The hash.
+ */
+std::uint64_t table_checksum(const void* data, std::size_t bytes, std::uint64_t hash = TableChecksumBasis) noexcept;
+
+/**
+ * @brief Writes a table file, replacing it atomically so that processes mapping the old file are unaffected.
+ *
+ * @param path The file to write.
+ * @param magic The 8 byte kind of the table.
+ * @param version The format version.
+ * @param entries The table entries.
+ * @param num_entries The number of entries.
+ * @param entry_bytes The size of one entry.
+ *
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void write_table_file(const std::string& path, const char* magic, std::uint32_t version, const void* entries,
+                      std::size_t num_entries, std::size_t entry_bytes);
+
+/**
+ * @brief A table file updated in place, entry by entry, for jobs filling tables too large to hold in memory.
+ *
+ * A missing file is created at its full size with zeroed entries, sparse where the file system allows, and an existing
+ * one is reopened if its kind, version, byte order and size match. Different parts of the entries may be written from
+ * several threads at once, with pwrite where available. The checksum in the header is only brought up to date by
+ * finish(), which reads the entries back once.
+ */
+class WritableTableFile
+{
+public:
+  /**
+   * @brief Opens or creates a table file.
+   *
+   * @param path The file.
+   * @param magic The 8 byte kind of the table.
+   * @param version The format version.
+   * @param num_entries The number of entries.
+   * @param entry_bytes The size of one entry.
+   *
+   * @throws std::runtime_error if the file cannot be created, or exists with the wrong kind, version or size.
+   */
+  WritableTableFile(const std::string& path, const char* magic, std::uint32_t version, std::size_t num_entries,
+                    std::size_t entry_bytes);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  WritableTableFile(const WritableTableFile&) = delete;
+
+  /**
+   * @brief Closes the file.
+   */
+  ~WritableTableFile();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  WritableTableFile& operator=(const WritableTableFile&) = delete;
+
+  /**
+   * @brief Writes bytes of the entries.
+   *
+   * @param offset The offset within the entries.
+   * @param data The bytes to write.
+   * @param bytes The number of bytes.
+   *
+   * @throws std::runtime_error if the write fails.
+   */
+  void write(std::size_t offset, const void* data, std::size_t bytes);
+
+  /**
+   * @brief Reads bytes of the entries.
+   *
+   * @param offset The offset within the entries.
+   * @param data Receives the bytes.
+   * @param bytes The number of bytes.
+   *
+   * @throws std::runtime_error if the read fails.
+   */
+  void read(std::size_t offset, void* data, std::size_t bytes) const;
+
+  /**
+   * @brief Flushes the writes so far to storage.
+   *
+   * @throws std::runtime_error if the flush fails.
+   */
+  void sync();
+
+  /**
+   * @brief Checksums the entries, writes the header and flushes the file, which may then be mapped and verified.
+   *
+   * @throws std::runtime_error if the file cannot be read or written.
+   */
+  void finish();
+
+private:
+  std::string m_path;             ///< The file.
+  TableFileHeader m_header;       ///< Header written by finish().
+  std::size_t m_entries_size;     ///< Length of the entries.
+  int m_fd;                       ///< Descriptor of the file where POSIX I/O is available.
+  mutable std::mutex m_mutex;     ///< Serializes the stream elsewhere.
+  mutable std::fstream m_stream;  ///< The file elsewhere.
+};
+
+/**
+ * @brief A table file mapped read only and shared, so that it is paged in lazily and shared by every process.
+ */
+class MappedTableFile
+{
+public:
+  /**
+   * @brief Maps and validates a table file.
+   *
+   * @param path The file to map.
+   * @param magic The expected 8 byte kind of the table.
+   * @param version The expected format version.
+   * @param num_entries The expected number of entries.
+   * @param entry_bytes The size of one entry.
+   * @param verify Whether to verify the checksum, which reads the whole file instead of paging it in lazily.
+   *
+   * @throws std::runtime_error if the file cannot be mapped, or has the wrong kind, version, size or checksum.
+   */
+  MappedTableFile(const std::string& path, const char* magic, std::uint32_t version, std::size_t num_entries,
+                  std::size_t entry_bytes, bool verify);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  MappedTableFile(const MappedTableFile&) = delete;
+
+  /**
+   * @brief Unmaps the file.
+   */
+  ~MappedTableFile();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  MappedTableFile& operator=(const MappedTableFile&) = delete;
+
+  /**
+   * @brief Gets the table entries.
+   *
+   * @return Pointer to the first entry, cache line aligned.
+   */
+  const void* entries() const noexcept
+  {
+    return m_entries;
+  };
+
+private:
+  void* m_mapping;             ///< The whole file, or nullptr where it was read instead.
+  std::size_t m_size;          ///< Length of the file.
+  std::vector<char> m_buffer;  ///< The file contents on systems without mmap.
+  const void* m_entries;       ///< Start of the entries.
+};
+
+}  // namespace deck_of_cards
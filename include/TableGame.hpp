@@ -0,0 +1,129 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief A casino table game described by how it deals from one deck and how a complete deal settles.
+ *
+ * The cards go to groups in dealing order, e.g. the player, the board and the dealer. A game must treat the suits
+ * symmetrically, which every poker based game does: relabeling the suits of a deal must not change its result.
+ */
+class TableGame
+{
+public:
+  virtual ~TableGame() = default;
+
+  /**
+   * @brief Gets a name identifying the game and its paytable, recorded in checkpoints.
+   *
+   * @return The name.
+   */
+  virtual std::string name() const = 0;
+
+  /**
+   * @brief Gets the number of cards dealt to every group, in dealing order.
+   *
+   * @return The group sizes, adding up to at most NumCards.
+   */
+  virtual std::vector<std::size_t> groups() const = 0;
+
+  /**
+   * @brief Settles one complete deal, playing the game's fixed strategy.
+   *
+   * @param groups The cards of every group.
+   * @return The net result in units of the initial wager, negative when the player loses.
+   */
+  virtual double settle(const CardSet* groups) const = 0;
+};
+
+/**
+ * @brief How far a verification has got, reported after every finished work unit.
+ */
+struct VerificationProgress
+{
+  std::size_t units_done;  ///< Finished work units, those restored from a checkpoint included.
+  std::size_t num_units;   ///< Work units in total.
+  std::uint64_t settled;   ///< Deals settled by this run.
+  double seconds;          ///< Time spent by this run.
+};
+
+/**
+ * @brief The exact figures of a game, or the figures of the finished part of the enumeration.
+ */
+struct VerificationResult
+{
+  double expected_value;      ///< Expected net result per initial wager, minus the house edge.
+  double standard_deviation;  ///< Standard deviation of the net result of one deal.
+  std::uint64_t deals;        ///< Deals covered, isomorphic deals included.
+  std::uint64_t settled;      ///< Deals actually settled, over all runs.
+  std::size_t units_done;     ///< Finished work units.
+  std::size_t num_units;      ///< Work units in total.
+
+  bool complete() const noexcept
+  {
+    return units_done == num_units;
+  };
+};
+
+/**
+ * @brief Exhaustively enumerates every deal of a TableGame to certify its house edge.
+ *
+ * The first group is only enumerated up to relabeling of the suits: every class is represented by one set and
+ * weighted by the size of the class, which divides the work by close to 24. Every representative is a work unit that
+ * enumerates all deals of the remaining groups, and units are spread over a ThreadPool. Finished units can be written
+ * to a checkpoint file, so a verification running for days survives restarts and can be split into several runs.
+ */
+class TableGameVerifier
+{
+public:
+  struct Config
+  {
+    std::size_t num_threads = 0;           ///< Worker threads, 0 for one per hardware thread.
+    std::string checkpoint;                ///< Checkpoint file to resume from and write to, empty for none.
+    std::size_t checkpoint_interval = 64;  ///< Finished work units between checkpoint writes.
+    std::size_t max_units = 0;             ///< Work units to finish in this run, 0 for all remaining.
+
+    /// Called after every finished unit, one call at a time, empty for no reporting.
+    std::function<void(const VerificationProgress&)> progress;
+  };
+
+  /**
+   * @brief Constructs a verifier.
+   *
+   * @param game The game, which must outlive the verifier.
+   * @param config The run options.
+   *
+   * @throws std::invalid_argument if the game deals no group or more cards than a deck holds, or the checkpoint
+   * interval is zero.
+   */
+  TableGameVerifier(const TableGame& game, const Config& config);
+
+  /**
+   * @brief Enumerates the remaining work units.
+   *
+   * @return The figures over every finished unit, complete() once all units are done.
+   *
+   * @throws std::runtime_error if the checkpoint cannot be read or written, is corrupt or belongs to another game.
+   */
+  VerificationResult run();
+
+  std::size_t num_units() const noexcept
+  {
+    return m_units.size();
+  };
+
+private:
+  const TableGame& m_game;            ///< Game being verified.
+  Config m_config;                    ///< Run options.
+  std::vector<std::size_t> m_groups;  ///< Cards per group.
+  std::vector<CardSet> m_units;       ///< Representatives of the first group, one per work unit.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <TableState.hpp>
+#include <ThreadPool.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Identifier of a table owned by a TableScheduler.
+ */
+using TableId = std::size_t;
+
+/**
+ * @brief Multiplexes many tables, each owning a deck, onto a small work-stealing thread pool.
+ *
+ * Every table is an actor: messages posted to it are queued in its mailbox and executed one at a time, in posting
+ * order, by whichever worker currently holds the table. A table is scheduled on at most one worker at a time, so
+ * messages can use the table's state without any locking, and every table shuffles with its own generator rather
+ * than the process wide rand(), which takes a lock. Tables are stored contiguously, 48 bytes of deck and generator
+ * plus the mailbox each, and drained a mailbox at a time to keep their state hot while it is being used.
+ */
+class TableScheduler
+{
+public:
+  /**
+   * @brief A message executed by a table's actor with exclusive access to its state.
+   */
+  using Message = std::function<void(TableState&)>;
+
+  /**
+   * @brief Constructs a scheduler.
+   *
+   * @param num_tables The number of tables, with ids in [0, num_tables).
+   * @param num_threads The number of workers, or zero for one per hardware thread.
+   * @param seed The seed of the table generators, each seeded from it and the table id.
+   */
+  TableScheduler(std::size_t num_tables, std::size_t num_threads = 0, std::uint64_t seed = 1);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  TableScheduler(const TableScheduler&) = delete;
+
+  /**
+   * @brief Runs every queued message, then stops the workers.
+   */
+  ~TableScheduler();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  TableScheduler& operator=(const TableScheduler&) = delete;
+
+  /**
+   * @brief Queues a message on a table.
+   *
+   * This function is thread safe and may be called from inside other messages.
+   *
+   * @param table The table to run the message on.
+   * @param message The message.
+   *
+   * @throws std::out_of_range if the table does not exist.
+   */
+  void post(TableId table, Message message);
+
+  /**
+   * @brief Blocks until every mailbox is empty and no message is running.
+   */
+  void wait_idle();
+
+  /**
+   * @brief Preallocates every mailbox so that queueing up to the given number of pending messages does not grow it.
+   *
+   * Posting still allocates where a message captures more than std::function stores inline and to submit the actor
+   * to the pool. This function is thread safe and may be called while messages run.
+   *
+   * @param messages The number of pending messages per table.
+   */
+  void reserve(std::size_t messages);
+
+  /**
+   * @brief Gets the number of tables.
+   *
+   * @return The number of tables.
+   */
+  std::size_t num_tables() const noexcept
+  {
+    return m_num_tables;
+  };
+
+  /**
+   * @brief Gets the number of worker threads.
+   *
+   * @return The number of workers.
+   */
+  std::size_t num_threads() const noexcept
+  {
+    return m_pool.size();
+  };
+
+private:
+  struct Table
+  {
+    Table()
+      : scheduled(false)
+      , state{ PackedDeck(), TableGenerator(0, 0) }
+    {
+    }
+
+    std::mutex mutex;                 ///< Guards the mailbox only, never the state.
+    std::vector<Message> mailbox;     ///< Messages waiting to run.
+    std::vector<Message> processing;  ///< Messages being run, swapped out of the mailbox.
+    std::atomic<bool> scheduled;      ///< Whether the actor is queued or running on a worker.
+    TableState state;                 ///< The table's deck and generator, only touched by the actor.
+  };
+
+  void schedule(Table& table);
+  void run(Table& table);
+
+  std::size_t m_num_tables;           ///< Number of tables.
+  std::unique_ptr<Table[]> m_tables;  ///< Contiguous table state.
+  ThreadPool m_pool;                  ///< Workers the actors run on.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <PackedDeck.hpp>
+#include <cstdint>
+#include <limits>
+
+namespace deck_of_cards
+{
+/**
+ * @brief A splitmix64 generator, eight bytes of state per table or pipeline lane instead of the global, locked rand().
+ */
+class TableGenerator
+{
+public:
+  using result_type = std::uint64_t;
+
+  /**
+   * @brief Constructs the generator of one stream.
+   *
+   * @param seed The seed shared by every stream.
+   * @param stream The stream, e.g. a table id or a lane index; the starting points of the streams are scattered over
+   * the period.
+   */
+  TableGenerator(std::uint64_t seed, std::uint64_t stream) noexcept
+    : m_state(mix(mix(seed) + stream))
+  {
+  }
+
+  static constexpr result_type min() noexcept
+  {
+    return 0;
+  };
+
+  static constexpr result_type max() noexcept
+  {
+    return std::numeric_limits<result_type>::max();
+  };
+
+  result_type operator()() noexcept
+  {
+    m_state += 0x9E3779B97F4A7C15;
+    return mix(m_state);
+  }
+
+private:
+  static std::uint64_t mix(std::uint64_t value) noexcept
+  {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+    return value ^ (value >> 31);
+  }
+
+  std::uint64_t m_state;  ///< Generator state.
+};
+
+/**
+ * @brief A deck with its own generator: the state of one table or pipeline lane, only ever touched by one thread at a
+ * time.
+ */
+struct TableState
+{
+  /**
+   * @brief Shuffles the undealt cards of the deck with its own generator.
+   */
+  void shuffle() noexcept
+  {
+    deck.shuffle(generator);
+  }
+
+  PackedDeck deck;           ///< The deck.
+  TableGenerator generator;  ///< The deck's random number generator.
+};
+
+}  // namespace deck_of_cards
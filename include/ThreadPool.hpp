@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief A fixed size work-stealing thread pool.
+ *
+ * Every worker owns a task deque. Tasks submitted from a worker go to the front of its own deque and are popped LIFO
+ * for cache locality, tasks submitted from outside the pool are spread round-robin, and idle workers steal from the
+ * back of the other deques.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief A unit of work.
+   */
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Constructs a pool and starts its workers.
+   *
+   * @param num_threads The number of workers, or zero for one per hardware thread.
+   */
+  explicit ThreadPool(std::size_t num_threads = 0);
+
+  /**
+   * @brief Deleted copy constructor.
+   */
+  ThreadPool(const ThreadPool&) = delete;
+
+  /**
+   * @brief Runs all queued tasks, then stops and joins the workers.
+   */
+  ~ThreadPool();
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @return Reference to this object.
+   */
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief Queues a task.
+   *
+   * @param task The task to run on one of the workers.
+   */
+  void submit(Task task);
+
+  /**
+   * @brief Blocks until every submitted task, including tasks they submitted, has finished.
+   */
+  void wait_idle();
+
+  /**
+   * @brief Gets the number of workers.
+   *
+   * @return The number of workers.
+   */
+  std::size_t size() const noexcept
+  {
+    return m_threads.size();
+  };
+
+private:
+  struct Worker
+  {
+    std::mutex mutex;        ///< Guards the task deque.
+    std::deque<Task> tasks;  ///< Tasks owned by this worker.
+  };
+
+  void run(std::size_t index);
+  bool try_pop(std::size_t index, Task& task);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;  ///< Per-worker task deques.
+  std::vector<std::thread> m_threads;              ///< The worker threads.
+  std::mutex m_mutex;                              ///< Guards sleeping, waking and stopping.
+  std::condition_variable m_work_cv;               ///< Signalled when tasks are queued or the pool stops.
+  std::condition_variable m_idle_cv;               ///< Signalled when the last pending task finishes.
+  std::atomic<std::size_t> m_queued;               ///< Tasks waiting in some deque.
+  std::atomic<std::size_t> m_pending;              ///< Tasks queued or running.
+  std::atomic<std::size_t> m_next;                 ///< Round-robin cursor for external submissions.
+  bool m_stop;                                     ///< Set when the pool is shutting down.
+};
+
+}  // namespace deck_of_cards
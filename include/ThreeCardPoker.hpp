@@ -0,0 +1,109 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <TableGame.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The categories of three card hands, worst first; with three cards straights are rarer than flushes.
+ */
+enum class ThreeCardCategory
+{
+  HighCard = 0,
+  Pair,
+  Flush,
+  Straight,
+  ThreeOfAKind,
+  StraightFlush
+};
+
+/**
+ * @brief The number of ThreeCardCategory values.
+ */
+constexpr std::size_t NumThreeCardCategories = 6;
+
+/**
+ * @brief Ranks a three card hand.
+ *
+ * Ace-2-3 is the lowest straight and ace-king-queen the highest.
+ *
+ * @param hand The three cards.
+ * @return A rank that orders hands like the game does, higher is better, equal for hands that tie.
+ */
+std::uint32_t three_card_rank(CardSet hand) noexcept;
+
+/**
+ * @brief Gets the category of a three card rank.
+ *
+ * @param rank A rank returned by three_card_rank().
+ * @return The category.
+ */
+ThreeCardCategory three_card_category(std::uint32_t rank) noexcept;
+
+/**
+ * @brief The Ante and Play wager of Three Card Poker, played with the optimal strategy of playing Q-6-4 or better.
+ *
+ * Folding loses the ante. Otherwise the play wager equals the ante, the dealer qualifies with queen high or better,
+ * a non qualifying dealer pays the ante and pushes the play wager, and the ante bonus is paid whatever the dealer has.
+ * Groups: the player's three cards, then the dealer's.
+ */
+class ThreeCardPoker : public TableGame
+{
+public:
+  /**
+   * @brief Constructs the game with the common ante bonus of 1 for a straight, 4 for trips and 5 for a straight
+   * flush.
+   */
+  ThreeCardPoker();
+
+  /**
+   * @brief Constructs the game with another ante bonus.
+   *
+   * @param ante_bonus Bonus per unit ante, indexed by ThreeCardCategory.
+   */
+  explicit ThreeCardPoker(const double* ante_bonus);
+
+  std::string name() const override;
+
+  std::vector<std::size_t> groups() const override;
+
+  double settle(const CardSet* groups) const override;
+
+private:
+  double m_ante_bonus[NumThreeCardCategories];  ///< Bonus per unit ante, by category of the player hand.
+};
+
+/**
+ * @brief The Pairplus wager of Three Card Poker, paying on the player's three cards alone.
+ */
+class PairPlus : public TableGame
+{
+public:
+  /**
+   * @brief Constructs the game with the common 1/4/6/30/40 paytable.
+   */
+  PairPlus();
+
+  /**
+   * @brief Constructs the game with another paytable.
+   *
+   * @param pays Winnings per unit bet indexed by ThreeCardCategory, 0 for a losing category.
+   */
+  explicit PairPlus(const double* pays);
+
+  std::string name() const override;
+
+  std::vector<std::size_t> groups() const override;
+
+  double settle(const CardSet* groups) const override;
+
+private:
+  double m_pays[NumThreeCardCategories];  ///< Winnings per unit bet, by category.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <HandEvaluator.hpp>
+#include <TableGame.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief Ultimate Texas Hold'em, played with a fixed basic strategy.
+ *
+ * The player posts equal ante and blind wagers and may make one play wager: 4 times the ante before the flop, 2 times
+ * on the flop or 1 time on the river, or fold on the river losing ante and blind. The dealer qualifies with a pair or
+ * better; a non qualifying dealer pushes the ante. The blind pays by the paytable when the player wins with a straight
+ * or better and pushes on any other win.
+ *
+ * The strategy is the common simplified basic strategy: raise 4 times with 33 or better, any ace, K5 offsuit or K2
+ * suited, Q8 offsuit or Q6 suited and JT offsuit or J8 suited; raise 2 times on the flop with a hand of two pair or
+ * better that uses a hole card, a hidden pair other than pocket deuces, or four to a flush holding a ten or better of
+ * the suit; raise on the river with a hidden pair or better, else fold.
+ *
+ * Groups: the player's two cards, the flop, the turn and river, and the dealer's two cards.
+ */
+class UltimateHoldem : public TableGame
+{
+public:
+  /**
+   * @brief Constructs the game with the common blind paytable: 500 for a royal flush, 50 for a straight flush, 10 for
+   * quads, 3 for a full house, 3 to 2 for a flush and 1 for a straight.
+   */
+  UltimateHoldem();
+
+  /**
+   * @brief Constructs the game with another blind paytable.
+   *
+   * @param blind_pays Blind winnings per unit indexed by HandCategory, 0 for a push.
+   * @param royal_pays Blind winnings per unit for a royal flush.
+   */
+  UltimateHoldem(const double* blind_pays, double royal_pays);
+
+  /**
+   * @brief Decides the play wager of the basic strategy.
+   *
+   * @param hole The player's two cards.
+   * @param flop The three flop cards.
+   * @param turn_river The turn and river cards.
+   * @return The play wager in antes: 4 before the flop, 2 on the flop, 1 on the river or 0 for a fold.
+   */
+  static int play_wager(CardSet hole, CardSet flop, CardSet turn_river);
+
+  std::string name() const override;
+
+  std::vector<std::size_t> groups() const override;
+
+  double settle(const CardSet* groups) const override;
+
+private:
+  double m_blind_pays[9];  ///< Blind winnings per unit, by category of the player hand.
+  double m_royal_pays;     ///< Blind winnings per unit for a royal flush.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deck_of_cards
+{
+/**
+ * @brief The paying categories of draw poker style video poker, worst first.
+ */
+enum class PayCategory
+{
+  Nothing = 0,    ///< No pair, straight or flush.
+  LowPair,        ///< One pair of tens or lower.
+  HighPair,       ///< One pair of jacks or better.
+  TwoPair,        ///< Two pairs.
+  ThreeOfAKind,   ///< Three cards of one value.
+  Straight,       ///< Five consecutive values, the ace playing high or low.
+  Flush,          ///< Five cards of one suit.
+  FullHouse,      ///< Three of a kind and a pair.
+  FourOfAKind,    ///< Four cards of one value.
+  StraightFlush,  ///< A straight in one suit, royal flushes excluded.
+  RoyalFlush      ///< Ten to ace in one suit.
+};
+
+/**
+ * @brief The number of PayCategory values.
+ */
+constexpr std::size_t NumPayCategories = 11;
+
+/**
+ * @brief The number of ways to hold cards from a five card deal, from discarding all to keeping all.
+ */
+constexpr std::size_t NumHolds = 32;
+
+/**
+ * @brief Classifies a five card hand.
+ *
+ * @param hand The five cards.
+ * @return The pay category.
+ */
+PayCategory pay_category(CardSet hand) noexcept;
+
+/**
+ * @brief What a video poker machine pays per unit bet for every category of the final hand.
+ */
+struct Paytable
+{
+  double pays[NumPayCategories];  ///< Payout per unit bet, indexed by PayCategory, the bet itself included.
+
+  /**
+   * @brief Gets the full pay 9/6 Jacks or Better paytable at the maximum bet, royal flush paying 800 per unit.
+   *
+   * @return The paytable.
+   */
+  static Paytable jacks_or_better() noexcept;
+};
+
+/**
+ * @brief The outcome of playing every deal with the optimal strategy.
+ */
+struct VideoPokerAnalysis
+{
+  double expected_return;                  ///< Expected payout per unit bet.
+  double probabilities[NumPayCategories];  ///< Probability of ending in each PayCategory.
+  std::uint64_t deal_classes;              ///< Number of deals solved after suit isomorphism reduction.
+};
+
+/**
+ * @brief Exact expected values of every hold in five card draw video poker, and the return of a paytable.
+ *
+ * For a hold H out of the deal, the final hands reachable by drawing are the five card hands containing H and none of
+ * the discarded cards. Instead of enumerating draws, the solver keeps, for every set of at most five cards, the total
+ * payout of all five card hands containing it, and gets the payout over the reachable hands by inclusion-exclusion
+ * over the discards: one superset Moebius transform over the 32 subsets of the deal yields all 32 holds at once.
+ *
+ * The payout totals depend on the paytable only linearly, so the category counts behind them are computed once per
+ * process and shared by all solvers. A full paytable analysis only visits one deal per suit isomorphism class,
+ * 134,459 instead of 2,598,960, weighted by the size of the class, and takes a few seconds.
+ */
+class VideoPokerSolver
+{
+public:
+  /**
+   * @brief Constructs a solver for a paytable.
+   *
+   * @param paytable The paytable.
+   */
+  explicit VideoPokerSolver(const Paytable& paytable);
+
+  /**
+   * @brief Computes the expected payout of every hold.
+   *
+   * @param cards The five dealt cards, all different.
+   * @param values Output array receiving the expected payout per unit bet of every hold, indexed by the hold mask in
+   * which bit i keeps cards[i].
+   *
+   * @throws std::invalid_argument if the cards are not five different cards.
+   */
+  void hold_values(const CardId* cards, double* values) const;
+
+  /**
+   * @brief Finds the hold with the highest expected payout.
+   *
+   * @param cards The five dealt cards, all different.
+   * @return The hold mask, bit i keeping cards[i]; among equal holds the smallest mask wins.
+   *
+   * @throws std::invalid_argument if the cards are not five different cards.
+   */
+  unsigned best_hold(const CardId* cards) const;
+
+  /**
+   * @brief Plays every possible deal with the optimal strategy.
+   *
+   * @param num_threads The number of worker threads, 0 for one per hardware thread.
+   * @return The expected return and the distribution of final hands.
+   */
+  VideoPokerAnalysis analyze(std::size_t num_threads = 0) const;
+
+  const Paytable& paytable() const noexcept
+  {
+    return m_paytable;
+  };
+
+private:
+  void subset_values(const CardId* sorted, double* values) const noexcept;
+
+  Paytable m_paytable;              ///< Paytable being solved.
+  std::vector<double> m_totals[5];  ///< Total payout of the hands containing each set of 0 to 4 cards.
+};
+
+}  // namespace deck_of_cards
@@ -0,0 +1,91 @@
+#include "AliasTable.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace deck_of_cards;
+
+deck_of_cards::AliasTable::AliasTable(const double* weights, std::size_t num_weights)
+  : m_thresholds(num_weights)
+  , m_aliases(num_weights)
+{
+  if (num_weights == 0 || num_weights > 0xFFFFFFFFull)
+  {
+    throw std::invalid_argument("An alias table needs 1 to 2^32 outcomes");
+  }
+  double total = 0;
+  for (std::size_t i = 0; i < num_weights; ++i)
+  {
+    if (!(weights[i] >= 0) || !std::isfinite(weights[i]))
+    {
+      throw std::invalid_argument("Alias table weights must be finite and non negative");
+    }
+    total += weights[i];
+  }
+  if (total == 0)
+  {
+    throw std::invalid_argument("An alias table needs a positive weight");
+  }
+
+  // scale every weight so that a full column is 1, then pair each column short of 1 with one that has weight to spare
+  std::vector<double> scaled(num_weights);
+  std::vector<std::uint32_t> small;
+  std::vector<std::uint32_t> large;
+  for (std::size_t i = 0; i < num_weights; ++i)
+  {
+    scaled[i] = weights[i] * num_weights / total;
+    (scaled[i] < 1 ? small : large).push_back(static_cast<std::uint32_t>(i));
+  }
+  while (!small.empty() && !large.empty())
+  {
+    const std::uint32_t short_column = small.back();
+    small.pop_back();
+    const std::uint32_t donor = large.back();
+    m_thresholds[short_column] = static_cast<std::uint64_t>(std::ldexp(scaled[short_column], 32));
+    m_aliases[short_column] = donor;
+    scaled[donor] -= 1 - scaled[short_column];
+    if (scaled[donor] < 1)
+    {
+      large.pop_back();
+      small.push_back(donor);
+    }
+  }
+  // what is left is full up to rounding
+  for (const auto column : small)
+  {
+    m_thresholds[column] = 1ull << 32;
+    m_aliases[column] = column;
+  }
+  for (const auto column : large)
+  {
+    m_thresholds[column] = 1ull << 32;
+    m_aliases[column] = column;
+  }
+}
+
+void deck_of_cards::AliasTable::sample_batch(const std::uint64_t* randoms, std::uint32_t* outcomes,
+                                             std::size_t count) const noexcept
+{
+  const std::uint64_t size = m_thresholds.size();
+  const std::uint64_t* thresholds = m_thresholds.data();
+  const std::uint32_t* aliases = m_aliases.data();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const std::uint32_t column = static_cast<std::uint32_t>(((randoms[i] >> 32) * size) >> 32);
+    outcomes[i] = (randoms[i] & 0xFFFFFFFF) < thresholds[column] ? column : aliases[column];
+  }
+}
+
+double deck_of_cards::AliasTable::probability(std::size_t outcome) const noexcept
+{
+  // the own share of the outcome's column plus the rest of every column aliased to it
+  double probability = 0;
+  for (std::size_t column = 0; column < m_thresholds.size(); ++column)
+  {
+    const double own = std::ldexp(static_cast<double>(m_thresholds[column]), -32);
+    probability += column == outcome ? own : 0;
+    probability += m_aliases[column] == outcome && column != outcome ? 1 - own : 0;
+  }
+
+  return probability / m_thresholds.size();
+}
@@ -0,0 +1,437 @@
+#include "Baccarat.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include "CardSet.hpp"
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+constexpr std::size_t NumValues = 13;
+constexpr std::size_t NumPoints = 10;
+
+// baccarat point of every value, ace first, tens and faces counting zero
+constexpr int Points[NumValues] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0 };
+
+// the punto banco tableau: whether the banker draws, by banker total and by the point of the player's third card
+// plus one, column 0 standing for a player who stood
+struct Tableau
+{
+  Tableau()
+  {
+    for (int banker = 0; banker < 10; ++banker)
+    {
+      draws[banker][0] = banker <= 5;
+      for (int third = 0; third < 10; ++third)
+      {
+        draws[banker][third + 1] = banker <= 2 || (banker == 3 && third != 8) ||
+                                   (banker == 4 && third >= 2 && third <= 7) ||
+                                   (banker == 5 && third >= 4 && third <= 7) ||
+                                   (banker == 6 && third >= 6 && third <= 7);
+      }
+    }
+  }
+
+  bool draws[10][11];
+};
+
+const Tableau& tableau()
+{
+  static const Tableau table;
+  return table;
+}
+
+BaccaratOutcome outcome(int player_total, int banker_total, int player_cards, int banker_cards, bool player_pair,
+                        bool banker_pair) noexcept
+{
+  return BaccaratOutcome{ static_cast<std::uint8_t>(player_total), static_cast<std::uint8_t>(banker_total),
+                          static_cast<std::uint8_t>(player_cards), static_cast<std::uint8_t>(banker_cards),
+                          player_pair, banker_pair };
+}
+
+// enumerates the third cards after the first four, by point
+void add_draws(double* probabilities, std::size_t* points, double remaining, double weight, int player, int banker,
+               bool player_pair, bool banker_pair)
+{
+  if (player >= 8 || banker >= 8)
+  {
+    probabilities[outcome_index(outcome(player, banker, 2, 2, player_pair, banker_pair))] += weight;
+    return;
+  }
+
+  if (player >= 6)
+  {
+    if (!banker_draws(banker, -1))
+    {
+      probabilities[outcome_index(outcome(player, banker, 2, 2, player_pair, banker_pair))] += weight;
+      return;
+    }
+    for (std::size_t point = 0; point < NumPoints; ++point)
+    {
+      const int total = (banker + static_cast<int>(point)) % 10;
+      probabilities[outcome_index(outcome(player, total, 2, 3, player_pair, banker_pair))] +=
+        weight * points[point] / remaining;
+    }
+    return;
+  }
+
+  for (std::size_t third = 0; third < NumPoints; ++third)
+  {
+    if (points[third] == 0)
+    {
+      continue;
+    }
+    const double third_weight = weight * points[third] / remaining;
+    const int player_total = (player + static_cast<int>(third)) % 10;
+    if (!banker_draws(banker, static_cast<int>(third)))
+    {
+      probabilities[outcome_index(outcome(player_total, banker, 3, 2, player_pair, banker_pair))] += third_weight;
+      continue;
+    }
+
+    --points[third];
+    for (std::size_t point = 0; point < NumPoints; ++point)
+    {
+      const int total = (banker + static_cast<int>(point)) % 10;
+      probabilities[outcome_index(outcome(player_total, total, 3, 3, player_pair, banker_pair))] +=
+        third_weight * points[point] / (remaining - 1);
+    }
+    ++points[third];
+  }
+}
+
+// undealt cards of a deck per value
+struct DeckCounts
+{
+  explicit DeckCounts(const Deck& deck)
+    : values()
+  {
+    const CardSet undealt = deck.undealt();
+    for (CardId card = 0; card < NumCards; ++card)
+    {
+      values[card % NumValues] += undealt.contains(card);
+    }
+  }
+
+  std::size_t values[NumValues];
+};
+
+struct PartialSimulation
+{
+  std::uint64_t shoes;
+  std::vector<double> sums;
+  std::vector<double> squares;
+};
+
+// one coup from any source with the dealing interface of Shoe
+template <typename Source>
+BaccaratOutcome deal_coup(Source& shoe) noexcept
+{
+  int values[4];
+  for (auto& value : values)
+  {
+    value = shoe.deal_card() % NumValues;
+  }
+  int player = (Points[values[0]] + Points[values[2]]) % 10;
+  int banker = (Points[values[1]] + Points[values[3]]) % 10;
+  const bool player_pair = values[0] == values[2];
+  const bool banker_pair = values[1] == values[3];
+  if (player >= 8 || banker >= 8)
+  {
+    return outcome(player, banker, 2, 2, player_pair, banker_pair);
+  }
+
+  int player_cards = 2;
+  int third = -1;
+  if (player <= 5)
+  {
+    third = Points[shoe.deal_card() % NumValues];
+    player = (player + third) % 10;
+    player_cards = 3;
+  }
+  int banker_cards = 2;
+  if (banker_draws(banker, third))
+  {
+    banker = (banker + Points[shoe.deal_card() % NumValues]) % 10;
+    banker_cards = 3;
+  }
+
+  return outcome(player, banker, player_cards, banker_cards, player_pair, banker_pair);
+}
+
+// plays coups from a shoe, reshuffling it at the cut card, and settles every bet on each of them
+template <typename Source>
+void simulate(Source& shoe, std::mt19937_64& generator, std::size_t cut_card, const BaccaratBet* bets,
+              std::size_t num_bets, std::uint64_t num_coups, PartialSimulation& partial)
+{
+  bool shuffled = false;
+  for (std::uint64_t coup = 0; coup < num_coups; ++coup)
+  {
+    if (!shuffled || shoe.num_cards() <= cut_card)
+    {
+      shoe.reset();
+      shoe.shuffle(generator);
+      shuffled = true;
+      ++partial.shoes;
+    }
+    const BaccaratOutcome outcome = deal_coup(shoe);
+    for (std::size_t bet = 0; bet < num_bets; ++bet)
+    {
+      const double result = bets[bet](outcome);
+      partial.sums[bet] += result;
+      partial.squares[bet] += result * result;
+    }
+  }
+}
+
+}  // namespace
+
+BaccaratOutcome deck_of_cards::outcome_at(std::size_t index) noexcept
+{
+  return outcome(index / 40 % 10, index / 4 % 10, 2 + index / 800, 2 + index / 400 % 2, index / 2 % 2 != 0,
+                 index % 2 != 0);
+}
+
+double deck_of_cards::banker_bet(const BaccaratOutcome& outcome) noexcept
+{
+  return outcome.banker_total > outcome.player_total ? 0.95 : outcome.banker_total < outcome.player_total ? -1 : 0;
+}
+
+double deck_of_cards::player_bet(const BaccaratOutcome& outcome) noexcept
+{
+  return outcome.player_total > outcome.banker_total ? 1 : outcome.player_total < outcome.banker_total ? -1 : 0;
+}
+
+double deck_of_cards::tie_bet(const BaccaratOutcome& outcome) noexcept
+{
+  return outcome.player_total == outcome.banker_total ? 8 : -1;
+}
+
+double deck_of_cards::player_pair_bet(const BaccaratOutcome& outcome) noexcept
+{
+  return outcome.player_pair ? 11 : -1;
+}
+
+double deck_of_cards::banker_pair_bet(const BaccaratOutcome& outcome) noexcept
+{
+  return outcome.banker_pair ? 11 : -1;
+}
+
+double deck_of_cards::dragon_seven_bet(const BaccaratOutcome& outcome) noexcept
+{
+  return outcome.banker_cards == 3 && outcome.banker_total == 7 && outcome.player_total < 7 ? 40 : -1;
+}
+
+double deck_of_cards::panda_eight_bet(const BaccaratOutcome& outcome) noexcept
+{
+  return outcome.player_cards == 3 && outcome.player_total == 8 && outcome.banker_total < 8 ? 25 : -1;
+}
+
+bool deck_of_cards::banker_draws(int banker_total, int player_third) noexcept
+{
+  return tableau().draws[banker_total][player_third + 1];
+}
+
+BaccaratOutcome deck_of_cards::play_coup(Shoe& shoe) noexcept
+{
+  return deal_coup(shoe);
+}
+
+BaccaratOutcome deck_of_cards::play_coup(InfiniteShoe& shoe) noexcept
+{
+  return deal_coup(shoe);
+}
+
+deck_of_cards::BaccaratDistribution::BaccaratDistribution(const std::size_t* counts)
+  : m_probabilities()
+{
+  std::size_t values[NumValues];
+  std::copy(counts, counts + NumValues, values);
+  double total = 0;
+  for (const auto count : values)
+  {
+    total += count;
+  }
+  if (total < 6)
+  {
+    throw std::invalid_argument("A baccarat coup needs at least six cards");
+  }
+
+  // first player card, first banker card, second player card, second banker card
+  for (std::size_t p1 = 0; p1 < NumValues; ++p1)
+  {
+    if (values[p1] == 0)
+    {
+      continue;
+    }
+    const double w1 = values[p1]-- / total;
+    for (std::size_t b1 = 0; b1 < NumValues; ++b1)
+    {
+      if (values[b1] == 0)
+      {
+        continue;
+      }
+      const double w2 = w1 * values[b1]-- / (total - 1);
+      for (std::size_t p2 = 0; p2 < NumValues; ++p2)
+      {
+        if (values[p2] == 0)
+        {
+          continue;
+        }
+        const double w3 = w2 * values[p2]-- / (total - 2);
+        for (std::size_t b2 = 0; b2 < NumValues; ++b2)
+        {
+          if (values[b2] == 0)
+          {
+            continue;
+          }
+          const double w4 = w3 * values[b2]-- / (total - 3);
+
+          std::size_t points[NumPoints] = {};
+          for (std::size_t value = 0; value < NumValues; ++value)
+          {
+            points[Points[value]] += values[value];
+          }
+          add_draws(m_probabilities, points, total - 4, w4, (Points[p1] + Points[p2]) % 10,
+                    (Points[b1] + Points[b2]) % 10, p1 == p2, b1 == b2);
+
+          ++values[b2];
+        }
+        ++values[p2];
+      }
+      ++values[b1];
+    }
+    ++values[p1];
+  }
+}
+
+deck_of_cards::BaccaratDistribution::BaccaratDistribution(const Shoe& shoe)
+  : BaccaratDistribution(shoe.counts())
+{
+}
+
+deck_of_cards::BaccaratDistribution::BaccaratDistribution(const Deck& deck)
+  : BaccaratDistribution(DeckCounts(deck).values)
+{
+}
+
+double deck_of_cards::BaccaratDistribution::expected_value(BaccaratBet bet) const
+{
+  double value = 0;
+  for (std::size_t index = 0; index < NumBaccaratOutcomes; ++index)
+  {
+    if (m_probabilities[index] > 0)
+    {
+      value += m_probabilities[index] * bet(outcome_at(index));
+    }
+  }
+
+  return value;
+}
+
+double deck_of_cards::BaccaratDistribution::player_win() const noexcept
+{
+  double probability = 0;
+  for (std::size_t index = 0; index < NumBaccaratOutcomes; ++index)
+  {
+    const BaccaratOutcome outcome = outcome_at(index);
+    probability += outcome.player_total > outcome.banker_total ? m_probabilities[index] : 0;
+  }
+
+  return probability;
+}
+
+double deck_of_cards::BaccaratDistribution::banker_win() const noexcept
+{
+  double probability = 0;
+  for (std::size_t index = 0; index < NumBaccaratOutcomes; ++index)
+  {
+    const BaccaratOutcome outcome = outcome_at(index);
+    probability += outcome.banker_total > outcome.player_total ? m_probabilities[index] : 0;
+  }
+
+  return probability;
+}
+
+double deck_of_cards::BaccaratDistribution::tie() const noexcept
+{
+  double probability = 0;
+  for (std::size_t index = 0; index < NumBaccaratOutcomes; ++index)
+  {
+    const BaccaratOutcome outcome = outcome_at(index);
+    probability += outcome.banker_total == outcome.player_total ? m_probabilities[index] : 0;
+  }
+
+  return probability;
+}
+
+deck_of_cards::BaccaratSimulator::BaccaratSimulator(const Config& config)
+  : m_config(config)
+{
+  if (config.num_decks == 0)
+  {
+    throw std::invalid_argument("A shoe needs at least one deck");
+  }
+  if (config.cut_card < 6 || config.cut_card >= config.num_decks * NumCards)
+  {
+    throw std::invalid_argument("The cut card must leave at least six cards and allow one coup");
+  }
+}
+
+BaccaratSimulation deck_of_cards::BaccaratSimulator::run(const BaccaratBet* bets, std::size_t num_bets,
+                                                         std::uint64_t num_coups, std::size_t num_threads) const
+{
+  ThreadPool pool(num_threads);
+  std::vector<PartialSimulation> partials(pool.size(), PartialSimulation{ 0, std::vector<double>(num_bets),
+                                                                          std::vector<double>(num_bets) });
+  for (std::size_t thread = 0; thread < pool.size(); ++thread)
+  {
+    const std::uint64_t begin = num_coups * thread / pool.size();
+    const std::uint64_t end = num_coups * (thread + 1) / pool.size();
+    pool.submit([this, bets, num_bets, &partials, thread, begin, end]() {
+      PartialSimulation& partial = partials[thread];
+      std::seed_seq seed{ static_cast<std::uint32_t>(m_config.seed), static_cast<std::uint32_t>(m_config.seed >> 32),
+                          static_cast<std::uint32_t>(thread) };
+      std::mt19937_64 generator(seed);
+      if (m_config.infinite_deck)
+      {
+        InfiniteShoe shoe;
+        simulate(shoe, generator, m_config.cut_card, bets, num_bets, end - begin, partial);
+      }
+      else
+      {
+        Shoe shoe(m_config.num_decks);
+        simulate(shoe, generator, m_config.cut_card, bets, num_bets, end - begin, partial);
+      }
+    });
+  }
+  pool.wait_idle();
+
+  BaccaratSimulation simulation{ num_coups, 0, std::vector<double>(num_bets), std::vector<double>(num_bets) };
+  for (std::size_t bet = 0; bet < num_bets; ++bet)
+  {
+    double sum = 0;
+    double squares = 0;
+    for (const auto& partial : partials)
+    {
+      sum += partial.sums[bet];
+      squares += partial.squares[bet];
+    }
+    const double coups = static_cast<double>(num_coups);
+    simulation.means[bet] = num_coups > 0 ? sum / coups : 0;
+    simulation.standard_errors[bet] =
+      num_coups > 1 ? std::sqrt(std::max(0.0, squares / coups - simulation.means[bet] * simulation.means[bet]) / coups)
+                    : 0;
+  }
+  for (const auto& partial : partials)
+  {
+    simulation.shoes += partial.shoes;
+  }
+
+  return simulation;
+}
@@ -0,0 +1,281 @@
+#include "BitslicedEvaluator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace deck_of_cards;
+
+namespace
+{
+// eight 64 bit planes side by side
+typedef std::uint64_t WideWord __attribute__((vector_size(64)));
+
+constexpr std::size_t WideLanes = WideBitslicedBlockHands / BitslicedBlockHands;
+
+// category of every hand of a block from its 52 card planes, as four bit planes of the HandCategory value
+template <typename Word>
+void categorize_planes(const Word* planes, Word* code)
+{
+  const Word none = Word();
+
+  // per value: whether a hand holds at least one, two, three or four cards of it
+  Word has[13];
+  Word pair[13];
+  Word trips[13];
+  Word quads[13];
+  for (std::size_t value = 0; value < 13; ++value)
+  {
+    const Word a = planes[value];
+    const Word b = planes[13 + value];
+    const Word c = planes[26 + value];
+    const Word d = planes[39 + value];
+    const Word ab = a & b;
+    const Word cd = c & d;
+    const Word a_or_b = a | b;
+    const Word c_or_d = c | d;
+    has[value] = a_or_b | c_or_d;
+    pair[value] = ab | cd | (a_or_b & c_or_d);
+    trips[value] = (ab & c_or_d) | (cd & a_or_b);
+    quads[value] = ab & cd;
+  }
+
+  // five values in a row, the last window being T-J-Q-K-A
+  Word straight = none;
+  for (std::size_t low = 0; low < 10; ++low)
+  {
+    straight |= has[low] & has[low + 1] & has[low + 2] & has[low + 3] & has[(low + 4) % 13];
+  }
+
+  // per suit, a saturating three bit count of its cards and its straights
+  Word flush = none;
+  Word straight_flush = none;
+  for (std::size_t suit = 0; suit < 4; ++suit)
+  {
+    const Word* cards = planes + 13 * suit;
+    Word count0 = none;
+    Word count1 = none;
+    Word count2 = none;
+    for (std::size_t value = 0; value < 13; ++value)
+    {
+      const Word carry0 = count0 & cards[value];
+      count0 ^= cards[value];
+      const Word carry1 = count1 & carry0;
+      count1 ^= carry0;
+      count2 |= carry1;
+    }
+    flush |= count2 & (count0 | count1);
+
+    for (std::size_t low = 0; low < 10; ++low)
+    {
+      straight_flush |= cards[low] & cards[low + 1] & cards[low + 2] & cards[low + 3] & cards[(low + 4) % 13];
+    }
+  }
+
+  // how many values reach a pair or trips
+  Word any_quads = none;
+  Word any_trips = none;
+  Word two_trips = none;
+  Word any_pair = none;
+  Word two_pairs = none;
+  Word pair_only = none;
+  for (std::size_t value = 0; value < 13; ++value)
+  {
+    any_quads |= quads[value];
+    two_trips |= any_trips & trips[value];
+    any_trips |= trips[value];
+    two_pairs |= any_pair & pair[value];
+    any_pair |= pair[value];
+    pair_only |= pair[value] & ~trips[value];
+  }
+  const Word full_house = two_trips | (any_trips & pair_only);
+
+  // strongest category first, each one only claiming the hands no stronger one did
+  Word rest = ~straight_flush;
+  const Word is_quads = any_quads & rest;
+  rest &= ~is_quads;
+  const Word is_full_house = full_house & rest;
+  rest &= ~is_full_house;
+  const Word is_flush = flush & rest;
+  rest &= ~is_flush;
+  const Word is_straight = straight & rest;
+  rest &= ~is_straight;
+  const Word is_trips = any_trips & rest;
+  rest &= ~is_trips;
+  const Word is_two_pair = two_pairs & rest;
+  rest &= ~is_two_pair;
+  const Word is_pair = any_pair & rest;
+
+  code[0] = is_quads | is_flush | is_trips | is_pair;
+  code[1] = is_quads | is_full_house | is_trips | is_two_pair;
+  code[2] = is_quads | is_full_house | is_flush | is_straight;
+  code[3] = straight_flush;
+}
+
+// hands with fewer than 64 entries are padded with empty hands, whose categories are dropped
+void categorize_block(const CardSet* hands, HandCategory* categories, std::size_t count)
+{
+  std::uint64_t planes[BitslicedBlockHands] = {};
+  for (std::size_t hand = 0; hand < count; ++hand)
+  {
+    planes[hand] = hands[hand].mask();
+  }
+  transpose_bits(planes);
+
+  std::uint64_t code[4];
+  categorize_planes(planes, code);
+  for (std::size_t hand = 0; hand < count; ++hand)
+  {
+    const unsigned category = ((code[0] >> hand) & 1) | (((code[1] >> hand) & 1) << 1) |
+                              (((code[2] >> hand) & 1) << 2) | (((code[3] >> hand) & 1) << 3);
+    categories[hand] = static_cast<HandCategory>(category);
+  }
+}
+
+void categorize_wide_block(const CardSet* hands, HandCategory* categories, std::size_t count)
+{
+  WideWord planes[NumCards];
+  for (std::size_t lane = 0; lane < WideLanes; ++lane)
+  {
+    std::uint64_t lane_planes[BitslicedBlockHands] = {};
+    const std::size_t first = lane * BitslicedBlockHands;
+    for (std::size_t hand = first; hand < std::min(count, first + BitslicedBlockHands); ++hand)
+    {
+      lane_planes[hand - first] = hands[hand].mask();
+    }
+    transpose_bits(lane_planes);
+    for (std::size_t card = 0; card < NumCards; ++card)
+    {
+      planes[card][lane] = lane_planes[card];
+    }
+  }
+
+  WideWord code[4];
+  categorize_planes(planes, code);
+  for (std::size_t hand = 0; hand < count; ++hand)
+  {
+    const std::size_t lane = hand / BitslicedBlockHands;
+    const std::size_t bit = hand % BitslicedBlockHands;
+    const unsigned category = ((code[0][lane] >> bit) & 1) | (((code[1][lane] >> bit) & 1) << 1) |
+                              (((code[2][lane] >> bit) & 1) << 2) | (((code[3][lane] >> bit) & 1) << 3);
+    categories[hand] = static_cast<HandCategory>(category);
+  }
+}
+
+}  // namespace
+
+void deck_of_cards::transpose_bits(std::uint64_t* words) noexcept
+{
+  // swap the off-diagonal blocks of ever smaller sub-matrices: 32 by 32, then 16 by 16, down to single bits
+  std::uint64_t mask = 0x00000000FFFFFFFFull;
+  for (std::size_t width = 32; width != 0; width >>= 1, mask ^= mask << width)
+  {
+    for (std::size_t row = 0; row < 64; row = (row + width + 1) & ~width)
+    {
+      const std::uint64_t swap = ((words[row] >> width) ^ words[row + width]) & mask;
+      words[row] ^= swap << width;
+      words[row + width] ^= swap;
+    }
+  }
+}
+
+const BitslicedEvaluator& deck_of_cards::BitslicedEvaluator::instance()
+{
+  static const BitslicedEvaluator evaluator(calibrate());
+  return evaluator;
+}
+
+BitslicedEvaluator::Kernel deck_of_cards::BitslicedEvaluator::calibrate(std::size_t num_hands)
+{
+  using Clock = std::chrono::steady_clock;
+
+  // a generator of its own, so calibrating does not move the rand() stream that Deck shuffles with
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int> card(0, NumCards - 1);
+  std::vector<CardSet> hands(num_hands);
+  for (auto& hand : hands)
+  {
+    while (hand.size() < 7)
+    {
+      hand.insert(static_cast<CardId>(card(generator)));
+    }
+  }
+  std::vector<HandCategory> categories(num_hands);
+
+  // build the lookup tables outside of the timing
+  HandEvaluator::instance();
+
+  const Kernel kernels[] = { Kernel::Lookup, Kernel::Bitsliced64, Kernel::Bitsliced512 };
+  Kernel fastest = Kernel::Lookup;
+  double best = 0;
+  for (const auto kernel : kernels)
+  {
+    const BitslicedEvaluator evaluator(kernel);
+    const auto start = Clock::now();
+    evaluator.categorize(hands.data(), categories.data(), num_hands);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (kernel == Kernel::Lookup || seconds < best)
+    {
+      fastest = kernel;
+      best = seconds;
+    }
+  }
+
+  return fastest;
+}
+
+deck_of_cards::BitslicedEvaluator::BitslicedEvaluator(Kernel kernel)
+  : m_kernel(kernel)
+{
+}
+
+void deck_of_cards::BitslicedEvaluator::categorize(const CardSet* hands, HandCategory* categories,
+                                                   std::size_t count) const
+{
+  for (std::size_t hand = 0; hand < count; ++hand)
+  {
+    const std::size_t size = hands[hand].size();
+    if (size < 5 || size > 7)
+    {
+      throw std::invalid_argument("Only hands of 5 to 7 cards can be evaluated");
+    }
+  }
+
+  switch (m_kernel)
+  {
+    case Kernel::Lookup:
+    {
+      const HandEvaluator& evaluator = HandEvaluator::instance();
+      for (std::size_t hand = 0; hand < count; ++hand)
+      {
+        categories[hand] = hand_category(evaluator.evaluate(hands[hand]));
+      }
+      break;
+    }
+    case Kernel::Bitsliced64:
+      for (std::size_t first = 0; first < count; first += BitslicedBlockHands)
+      {
+        categorize_block(hands + first, categories + first, std::min(BitslicedBlockHands, count - first));
+      }
+      break;
+    case Kernel::Bitsliced512:
+      for (std::size_t first = 0; first < count; first += WideBitslicedBlockHands)
+      {
+        categorize_wide_block(hands + first, categories + first, std::min(WideBitslicedBlockHands, count - first));
+      }
+      break;
+  }
+}
+
+void deck_of_cards::BitslicedEvaluator::categorize(const CardBatch& batch, HandCategory* categories) const
+{
+  CardSet hands[MaxBatchHands];
+  for (std::size_t hand = 0; hand < batch.num_hands; ++hand)
+  {
+    hands[hand] = CardSet(batch.hand(hand), batch.cards_per_hand);
+  }
+
+  categorize(hands, categories, batch.num_hands);
+}
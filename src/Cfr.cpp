@@ -0,0 +1,748 @@
+#include "Cfr.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+// card values within a suit, the ace being 0
+constexpr CardId Jack = 10;
+constexpr CardId Queen = 11;
+constexpr CardId King = 12;
+
+constexpr std::size_t Slots = 4;
+
+// the betting so far; histories append 2 bits per action after a leading 1, so that 0 never is a history
+struct Betting
+{
+  std::uint64_t history;
+  std::size_t round;
+  int player;
+  int raises;
+  int actions;
+  int pot[2];
+  bool terminal;
+  int folder;
+};
+
+Betting initial_betting(int ante) noexcept
+{
+  Betting betting = Betting();
+  betting.history = 1;
+  betting.pot[0] = ante;
+  betting.pot[1] = ante;
+  betting.folder = -1;
+  return betting;
+}
+
+std::size_t legal_actions(const Betting& betting, const std::vector<BettingRound>& rounds, CfrAction* actions) noexcept
+{
+  std::size_t count = 0;
+  const bool facing = betting.pot[betting.player] < betting.pot[1 - betting.player];
+  if (facing)
+  {
+    actions[count++] = CfrAction::Fold;
+  }
+  actions[count++] = CfrAction::Call;
+  if (betting.raises < rounds[betting.round].max_raises)
+  {
+    actions[count++] = CfrAction::Raise;
+  }
+
+  return count;
+}
+
+Betting apply(Betting betting, CfrAction action, const std::vector<BettingRound>& rounds) noexcept
+{
+  const int player = betting.player;
+  const int opponent = 1 - player;
+  betting.history = betting.history << 2 | (static_cast<std::uint64_t>(action) + 1);
+  ++betting.actions;
+  switch (action)
+  {
+    case CfrAction::Fold:
+      betting.terminal = true;
+      betting.folder = player;
+      return betting;
+    case CfrAction::Raise:
+      betting.pot[player] = betting.pot[opponent] + rounds[betting.round].bet_size;
+      ++betting.raises;
+      betting.player = opponent;
+      return betting;
+    case CfrAction::Call:
+      break;
+  }
+
+  // a check opening the round passes the action, any other call closes the round
+  const bool facing = betting.pot[player] < betting.pot[opponent];
+  betting.pot[player] = betting.pot[opponent];
+  if (!facing && betting.actions == 1)
+  {
+    betting.player = opponent;
+    return betting;
+  }
+  if (betting.round + 1 == rounds.size())
+  {
+    betting.terminal = true;
+    return betting;
+  }
+  ++betting.round;
+  betting.player = 0;
+  betting.raises = 0;
+  betting.actions = 0;
+  return betting;
+}
+
+// the net result of a terminal state for a player
+double utility(const Betting& betting, const CfrSolver::Deal& deal, int player) noexcept
+{
+  double result;
+  if (betting.folder >= 0)
+  {
+    result = betting.folder == 0 ? -betting.pot[0] : betting.pot[1];
+  }
+  else
+  {
+    result = deal.showdown > 0 ? betting.pot[1] : deal.showdown < 0 ? -betting.pot[0] : 0;
+  }
+
+  return player == 0 ? result : -result;
+}
+
+std::uint64_t mix(std::uint64_t history, std::uint32_t bucket) noexcept
+{
+  // the splitmix64 finalizer
+  std::uint64_t key = history * 0x9E3779B97F4A7C15ull ^ bucket;
+  key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+  key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+  return key ^ (key >> 31);
+}
+
+// the current strategy by regret matching, uniform when no regret is positive
+void current_strategy(const CfrInfoset* infoset, std::size_t num_actions, float* strategy) noexcept
+{
+  float positive[Slots] = {};
+  float total = 0;
+  if (infoset != nullptr)
+  {
+    for (std::size_t i = 0; i < Slots; ++i)
+    {
+      positive[i] = std::max(infoset->regrets[i], 0.0f);
+    }
+    total = positive[0] + positive[1] + positive[2] + positive[3];
+  }
+  for (std::size_t i = 0; i < Slots; ++i)
+  {
+    strategy[i] = total > 0 ? positive[i] / total : (i < num_actions ? 1.0f / num_actions : 0.0f);
+  }
+}
+
+// the average strategy, uniform when never updated
+void average(const CfrInfoset* infoset, std::size_t num_actions, double* strategy) noexcept
+{
+  double total = 0;
+  if (infoset != nullptr)
+  {
+    for (std::size_t i = 0; i < num_actions; ++i)
+    {
+      total += infoset->strategy[i];
+    }
+  }
+  for (std::size_t i = 0; i < num_actions; ++i)
+  {
+    strategy[i] = total > 0 ? infoset->strategy[i] / total : 1.0 / num_actions;
+  }
+}
+
+// everything a traversal reads, shared by the workers
+struct Traversal
+{
+  const std::vector<BettingRound>& rounds;
+  const InfosetTable& table;
+  InfosetTable& deltas;
+  int player;
+  float weight;
+};
+
+// vanilla CFR over one deal: returns the traverser's value, records reach weighted regrets and strategies
+double cfr(const Traversal& traversal, const Betting& betting, const CfrSolver::Deal& deal, double reach,
+           double opponent_reach)
+{
+  if (betting.terminal)
+  {
+    return utility(betting, deal, traversal.player);
+  }
+
+  CfrAction actions[NumCfrActions];
+  const std::size_t num_actions = legal_actions(betting, traversal.rounds, actions);
+  const std::uint32_t bucket = deal.buckets[betting.player][betting.round];
+  float strategy[Slots];
+  current_strategy(traversal.table.find(betting.history, bucket), num_actions, strategy);
+
+  if (betting.player != traversal.player)
+  {
+    double value = 0;
+    for (std::size_t i = 0; i < num_actions; ++i)
+    {
+      if (strategy[i] > 0)
+      {
+        value += strategy[i] * cfr(traversal, apply(betting, actions[i], traversal.rounds), deal, reach,
+                                   opponent_reach * strategy[i]);
+      }
+    }
+    return value;
+  }
+
+  float values[Slots] = {};
+  double value = 0;
+  for (std::size_t i = 0; i < num_actions; ++i)
+  {
+    values[i] = static_cast<float>(
+      cfr(traversal, apply(betting, actions[i], traversal.rounds), deal, reach * strategy[i], opponent_reach));
+    value += strategy[i] * values[i];
+  }
+
+  CfrInfoset& delta = traversal.deltas.insert(betting.history, bucket, static_cast<std::uint32_t>(num_actions));
+  const float regret_weight = static_cast<float>(opponent_reach);
+  const float strategy_weight = static_cast<float>(reach) * traversal.weight;
+  const float node = static_cast<float>(value);
+  for (std::size_t i = 0; i < Slots; ++i)
+  {
+    // the padding slots add zeros, so the loop runs over whole vectors
+    delta.regrets[i] += i < num_actions ? regret_weight * (values[i] - node) : 0.0f;
+    delta.strategy[i] += strategy_weight * strategy[i];
+  }
+  return value;
+}
+
+// external sampling MCCFR: all actions of the traverser, one sampled action of the opponent
+double sample(const Traversal& traversal, const Betting& betting, const CfrSolver::Deal& deal,
+              std::mt19937_64& generator)
+{
+  if (betting.terminal)
+  {
+    return utility(betting, deal, traversal.player);
+  }
+
+  CfrAction actions[NumCfrActions];
+  const std::size_t num_actions = legal_actions(betting, traversal.rounds, actions);
+  const std::uint32_t bucket = deal.buckets[betting.player][betting.round];
+  float strategy[Slots];
+  current_strategy(traversal.table.find(betting.history, bucket), num_actions, strategy);
+
+  if (betting.player != traversal.player)
+  {
+    CfrInfoset& delta = traversal.deltas.insert(betting.history, bucket, static_cast<std::uint32_t>(num_actions));
+    for (std::size_t i = 0; i < Slots; ++i)
+    {
+      delta.strategy[i] += traversal.weight * strategy[i];
+    }
+
+    const double draw = std::uniform_real_distribution<double>()(generator);
+    std::size_t action = 0;
+    for (double cumulative = strategy[0]; action + 1 < num_actions && draw >= cumulative;)
+    {
+      cumulative += strategy[++action];
+    }
+    return sample(traversal, apply(betting, actions[action], traversal.rounds), deal, generator);
+  }
+
+  float values[Slots] = {};
+  double value = 0;
+  for (std::size_t i = 0; i < num_actions; ++i)
+  {
+    values[i] = static_cast<float>(sample(traversal, apply(betting, actions[i], traversal.rounds), deal, generator));
+    value += strategy[i] * values[i];
+  }
+
+  CfrInfoset& delta = traversal.deltas.insert(betting.history, bucket, static_cast<std::uint32_t>(num_actions));
+  const float node = static_cast<float>(value);
+  for (std::size_t i = 0; i < Slots; ++i)
+  {
+    delta.regrets[i] += i < num_actions ? values[i] - node : 0.0f;
+  }
+  return value;
+}
+
+// the best response value of player against the average strategy, per deal weighted by the deal's reach
+std::vector<double> best_response(const std::vector<BettingRound>& rounds, const InfosetTable& table,
+                                  const std::vector<CfrSolver::Deal>& deals, const Betting& betting, int player,
+                                  const std::vector<double>& reach)
+{
+  std::vector<double> values(deals.size());
+  if (betting.terminal)
+  {
+    for (std::size_t i = 0; i < deals.size(); ++i)
+    {
+      values[i] = reach[i] == 0 ? 0 : reach[i] * utility(betting, deals[i], player);
+    }
+    return values;
+  }
+
+  CfrAction actions[NumCfrActions];
+  const std::size_t num_actions = legal_actions(betting, rounds, actions);
+  if (betting.player != player)
+  {
+    std::vector<double> child_reach(deals.size());
+    for (std::size_t action = 0; action < num_actions; ++action)
+    {
+      for (std::size_t i = 0; i < deals.size(); ++i)
+      {
+        double strategy[NumCfrActions];
+        average(table.find(betting.history, deals[i].buckets[betting.player][betting.round]), num_actions, strategy);
+        child_reach[i] = reach[i] * strategy[action];
+      }
+      const auto child = best_response(rounds, table, deals, apply(betting, actions[action], rounds), player,
+                                       child_reach);
+      for (std::size_t i = 0; i < deals.size(); ++i)
+      {
+        values[i] += child[i];
+      }
+    }
+    return values;
+  }
+
+  // every bucket of the responder picks the action that is best over all deals it cannot tell apart
+  std::vector<std::vector<double>> children;
+  for (std::size_t action = 0; action < num_actions; ++action)
+  {
+    children.push_back(best_response(rounds, table, deals, apply(betting, actions[action], rounds), player, reach));
+  }
+  std::vector<std::uint32_t> buckets;
+  for (const auto& deal : deals)
+  {
+    buckets.push_back(deal.buckets[player][betting.round]);
+  }
+  std::vector<std::uint32_t> distinct = buckets;
+  std::sort(distinct.begin(), distinct.end());
+  distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+  for (const auto bucket : distinct)
+  {
+    std::size_t best = 0;
+    double best_total = 0;
+    for (std::size_t action = 0; action < num_actions; ++action)
+    {
+      double total = 0;
+      for (std::size_t i = 0; i < deals.size(); ++i)
+      {
+        total += buckets[i] == bucket ? children[action][i] : 0;
+      }
+      if (action == 0 || total > best_total)
+      {
+        best = action;
+        best_total = total;
+      }
+    }
+    for (std::size_t i = 0; i < deals.size(); ++i)
+    {
+      values[i] = buckets[i] == bucket ? children[best][i] : values[i];
+    }
+  }
+  return values;
+}
+
+// the value of player 0 when both players follow the average strategy
+double average_value(const std::vector<BettingRound>& rounds, const InfosetTable& table,
+                     const CfrSolver::Deal& deal, const Betting& betting)
+{
+  if (betting.terminal)
+  {
+    return utility(betting, deal, 0);
+  }
+
+  CfrAction actions[NumCfrActions];
+  const std::size_t num_actions = legal_actions(betting, rounds, actions);
+  double strategy[NumCfrActions];
+  average(table.find(betting.history, deal.buckets[betting.player][betting.round]), num_actions, strategy);
+  double value = 0;
+  for (std::size_t i = 0; i < num_actions; ++i)
+  {
+    value += strategy[i] * average_value(rounds, table, deal, apply(betting, actions[i], rounds));
+  }
+  return value;
+}
+
+// calls visit with every set of count cards out of cards
+template <typename Visit>
+void for_each_set(const std::vector<CardId>& cards, CardSet used, std::size_t count, std::size_t first,
+                  CardSet set, Visit& visit)
+{
+  if (count == 0)
+  {
+    visit(set);
+    return;
+  }
+  for (std::size_t i = first; i < cards.size(); ++i)
+  {
+    if (!used.contains(cards[i]))
+    {
+      CardSet next = set;
+      next.insert(cards[i]);
+      for_each_set(cards, used, count - 1, i + 1, next, visit);
+    }
+  }
+}
+
+}  // namespace
+
+std::string deck_of_cards::KuhnPoker::name() const
+{
+  return "Kuhn poker";
+}
+
+std::vector<CardId> deck_of_cards::KuhnPoker::cards() const
+{
+  return { Jack, Queen, King };
+}
+
+std::size_t deck_of_cards::KuhnPoker::hole_cards() const
+{
+  return 1;
+}
+
+int deck_of_cards::KuhnPoker::ante() const
+{
+  return 1;
+}
+
+std::vector<BettingRound> deck_of_cards::KuhnPoker::rounds() const
+{
+  return { { 0, 1, 1 } };
+}
+
+int deck_of_cards::KuhnPoker::showdown(CardSet first, CardSet second, CardSet) const
+{
+  return __builtin_ctzll(first.mask()) % 13 - __builtin_ctzll(second.mask()) % 13;
+}
+
+std::uint32_t deck_of_cards::KuhnPoker::bucket(CardSet hole, CardSet, std::size_t) const
+{
+  return __builtin_ctzll(hole.mask()) % 13;
+}
+
+std::string deck_of_cards::LeducPoker::name() const
+{
+  return "Leduc hold'em";
+}
+
+std::vector<CardId> deck_of_cards::LeducPoker::cards() const
+{
+  return { Jack, Queen, King, Jack + 13, Queen + 13, King + 13 };
+}
+
+std::size_t deck_of_cards::LeducPoker::hole_cards() const
+{
+  return 1;
+}
+
+int deck_of_cards::LeducPoker::ante() const
+{
+  return 1;
+}
+
+std::vector<BettingRound> deck_of_cards::LeducPoker::rounds() const
+{
+  return { { 0, 2, 2 }, { 1, 4, 2 } };
+}
+
+int deck_of_cards::LeducPoker::showdown(CardSet first, CardSet second, CardSet board) const
+{
+  const int board_rank = __builtin_ctzll(board.mask()) % 13;
+  const int first_rank = __builtin_ctzll(first.mask()) % 13;
+  const int second_rank = __builtin_ctzll(second.mask()) % 13;
+  const int first_pair = first_rank == board_rank;
+  const int second_pair = second_rank == board_rank;
+
+  return first_pair != second_pair ? first_pair - second_pair : first_rank - second_rank;
+}
+
+std::uint32_t deck_of_cards::LeducPoker::bucket(CardSet hole, CardSet board, std::size_t round) const
+{
+  const std::uint32_t hole_rank = __builtin_ctzll(hole.mask()) % 13;
+
+  return round == 0 ? hole_rank : hole_rank * 13 + __builtin_ctzll(board.mask()) % 13;
+}
+
+deck_of_cards::InfosetTable::InfosetTable(std::size_t capacity)
+  : m_slots()
+  , m_size(0)
+{
+  std::size_t slots = 1;
+  while (slots < capacity)
+  {
+    slots *= 2;
+  }
+  m_slots.assign(slots, CfrInfoset());
+}
+
+const CfrInfoset* deck_of_cards::InfosetTable::find(std::uint64_t history, std::uint32_t bucket) const noexcept
+{
+  const std::size_t mask = m_slots.size() - 1;
+  for (std::size_t slot = mix(history, bucket) & mask;; slot = (slot + 1) & mask)
+  {
+    const CfrInfoset& infoset = m_slots[slot];
+    if (infoset.history == 0)
+    {
+      return nullptr;
+    }
+    if (infoset.history == history && infoset.bucket == bucket)
+    {
+      return &infoset;
+    }
+  }
+}
+
+CfrInfoset& deck_of_cards::InfosetTable::insert(std::uint64_t history, std::uint32_t bucket,
+                                                std::uint32_t num_actions)
+{
+  // keep the load factor at most one half
+  if (2 * (m_size + 1) > m_slots.size())
+  {
+    std::vector<CfrInfoset> slots(2 * m_slots.size(), CfrInfoset());
+    slots.swap(m_slots);
+    m_size = 0;
+    for (const auto& infoset : slots)
+    {
+      if (infoset.history != 0)
+      {
+        insert(infoset.history, infoset.bucket, infoset.num_actions) = infoset;
+      }
+    }
+  }
+
+  const std::size_t mask = m_slots.size() - 1;
+  for (std::size_t slot = mix(history, bucket) & mask;; slot = (slot + 1) & mask)
+  {
+    CfrInfoset& infoset = m_slots[slot];
+    if (infoset.history == 0)
+    {
+      infoset.history = history;
+      infoset.bucket = bucket;
+      infoset.num_actions = num_actions;
+      ++m_size;
+      return infoset;
+    }
+    if (infoset.history == history && infoset.bucket == bucket)
+    {
+      return infoset;
+    }
+  }
+}
+
+void deck_of_cards::InfosetTable::clear() noexcept
+{
+  std::memset(static_cast<void*>(m_slots.data()), 0, m_slots.size() * sizeof(CfrInfoset));
+  m_size = 0;
+}
+
+deck_of_cards::CfrSolver::CfrSolver(const CfrGame& game, const Config& config)
+  : m_game(game)
+  , m_config(config)
+  , m_rounds(game.rounds())
+  , m_cards(game.cards())
+  , m_deals()
+  , m_table()
+  , m_deltas()
+  , m_generators()
+  , m_pool(new ThreadPool(config.num_threads))
+  , m_iterations(0)
+{
+  if (m_rounds.empty() || m_rounds.size() > MaxCfrRounds)
+  {
+    throw std::invalid_argument("A game needs between one and four betting rounds");
+  }
+  std::size_t dealt = 2 * game.hole_cards();
+  std::size_t longest = 0;
+  for (const auto& round : m_rounds)
+  {
+    dealt += round.board_cards;
+    longest += static_cast<std::size_t>(std::max(round.max_raises, 0)) + 2;
+  }
+  if (longest > MaxCfrActions)
+  {
+    throw std::invalid_argument("The game's betting histories do not fit in 64 bits");
+  }
+  if (dealt > m_cards.size())
+  {
+    throw std::invalid_argument("The game deals more cards than it has");
+  }
+  if (config.traversals == 0)
+  {
+    throw std::invalid_argument("External sampling needs at least one traversal");
+  }
+
+  // every deal: the hole cards of both players, then the board of every round
+  const std::size_t num_rounds = m_rounds.size();
+  std::vector<CardSet> boards(num_rounds + 1);
+  CardSet holes[2];
+  std::size_t round = 0;
+  std::function<void(CardSet)> deal_board;
+  deal_board = [&](CardSet cards) {
+    boards[round + 1] = boards[round] | cards;
+    ++round;
+    if (round == num_rounds)
+    {
+      Deal deal = Deal();
+      for (std::size_t player = 0; player < 2; ++player)
+      {
+        for (std::size_t r = 0; r < num_rounds; ++r)
+        {
+          deal.buckets[player][r] = game.bucket(holes[player], boards[r + 1], r);
+        }
+      }
+      deal.showdown = game.showdown(holes[0], holes[1], boards[num_rounds]);
+      m_deals.push_back(deal);
+    }
+    else
+    {
+      for_each_set(m_cards, holes[0] | holes[1] | boards[round], m_rounds[round].board_cards, 0, CardSet(),
+                   deal_board);
+    }
+    --round;
+  };
+  std::function<void(CardSet)> deal_second = [&](CardSet cards) {
+    holes[1] = cards;
+    for_each_set(m_cards, holes[0] | holes[1], m_rounds[0].board_cards, 0, CardSet(), deal_board);
+  };
+  std::function<void(CardSet)> deal_first = [&](CardSet cards) {
+    holes[0] = cards;
+    for_each_set(m_cards, cards, game.hole_cards(), 0, CardSet(), deal_second);
+  };
+  for_each_set(m_cards, CardSet(), game.hole_cards(), 0, CardSet(), deal_first);
+
+  m_deltas.resize(m_pool->size());
+  for (std::size_t worker = 0; worker < m_pool->size(); ++worker)
+  {
+    std::seed_seq seed{ static_cast<std::uint32_t>(config.seed), static_cast<std::uint32_t>(config.seed >> 32),
+                        static_cast<std::uint32_t>(worker) };
+    m_generators.emplace_back(seed);
+  }
+}
+
+deck_of_cards::CfrSolver::~CfrSolver() = default;
+
+void deck_of_cards::CfrSolver::train(std::size_t iterations)
+{
+  const Betting root = initial_betting(m_game.ante());
+  const std::size_t num_workers = m_pool->size();
+  for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+  {
+    ++m_iterations;
+    for (int player = 0; player < 2; ++player)
+    {
+      for (std::size_t worker = 0; worker < num_workers; ++worker)
+      {
+        m_pool->submit([this, &root, player, worker, num_workers]() {
+          InfosetTable& deltas = m_deltas[worker];
+          deltas.clear();
+          if (m_config.algorithm == CfrAlgorithm::CfrPlus)
+          {
+            // linear averaging weighs iteration t by t
+            const Traversal traversal{ m_rounds, m_table, deltas, player, static_cast<float>(m_iterations) };
+            const double chance = 1.0 / m_deals.size();
+            for (std::size_t deal = worker; deal < m_deals.size(); deal += num_workers)
+            {
+              cfr(traversal, root, m_deals[deal], 1, chance);
+            }
+          }
+          else
+          {
+            const Traversal traversal{ m_rounds, m_table, deltas, player, 1.0f };
+            std::mt19937_64& generator = m_generators[worker];
+            for (std::size_t i = 0; i < m_config.traversals; ++i)
+            {
+              const Deal& deal = m_deals[std::uniform_int_distribution<std::size_t>(0, m_deals.size() - 1)(generator)];
+              sample(traversal, root, deal, generator);
+            }
+          }
+        });
+      }
+      m_pool->wait_idle();
+
+      // merge in worker order, so that the floating point sums do not depend on the scheduling
+      const bool floor = m_config.algorithm == CfrAlgorithm::CfrPlus;
+      for (const auto& deltas : m_deltas)
+      {
+        for (const auto& delta : deltas.slots())
+        {
+          if (delta.history == 0)
+          {
+            continue;
+          }
+          CfrInfoset& infoset = m_table.insert(delta.history, delta.bucket, delta.num_actions);
+          for (std::size_t i = 0; i < Slots; ++i)
+          {
+            const float regret = infoset.regrets[i] + delta.regrets[i];
+            infoset.regrets[i] = floor ? std::max(regret, 0.0f) : regret;
+            infoset.strategy[i] += delta.strategy[i];
+          }
+        }
+      }
+    }
+  }
+}
+
+std::vector<double> deck_of_cards::CfrSolver::average_strategy(const std::vector<CfrAction>& history,
+                                                                std::uint32_t bucket) const
+{
+  Betting betting = initial_betting(m_game.ante());
+  CfrAction actions[NumCfrActions];
+  for (const auto action : history)
+  {
+    const std::size_t num_actions = betting.terminal ? 0 : legal_actions(betting, m_rounds, actions);
+    if (std::find(actions, actions + num_actions, action) == actions + num_actions)
+    {
+      throw std::invalid_argument("Illegal betting history");
+    }
+    betting = apply(betting, action, m_rounds);
+  }
+  if (betting.terminal)
+  {
+    throw std::invalid_argument("The betting history ends the hand");
+  }
+
+  const std::size_t num_actions = legal_actions(betting, m_rounds, actions);
+  double strategy[NumCfrActions];
+  average(m_table.find(betting.history, bucket), num_actions, strategy);
+  std::vector<double> probabilities(NumCfrActions, 0.0);
+  for (std::size_t i = 0; i < num_actions; ++i)
+  {
+    probabilities[static_cast<std::size_t>(actions[i])] = strategy[i];
+  }
+
+  return probabilities;
+}
+
+double deck_of_cards::CfrSolver::expected_value() const
+{
+  const Betting root = initial_betting(m_game.ante());
+  double value = 0;
+  for (const auto& deal : m_deals)
+  {
+    value += average_value(m_rounds, m_table, deal, root);
+  }
+
+  return value / m_deals.size();
+}
+
+double deck_of_cards::CfrSolver::exploitability() const
+{
+  const Betting root = initial_betting(m_game.ante());
+  const std::vector<double> reach(m_deals.size(), 1.0 / m_deals.size());
+  double total = 0;
+  for (int player = 0; player < 2; ++player)
+  {
+    for (const auto value : best_response(m_rounds, m_table, m_deals, root, player, reach))
+    {
+      total += value;
+    }
+  }
+
+  return total / 2;
+}
@@ -0,0 +1,343 @@
+#include "Cribbage.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+// card values within a suit, the ace being 0
+constexpr CardId Jack = 10;
+
+// number of multisets of 5 out of 13 ranks, C(17, 5)
+constexpr std::size_t NumRankHands = 6188;
+
+int pips(int rank) noexcept
+{
+  return std::min(rank + 1, 10);
+}
+
+// fifteens, pairs and runs of every 5 card rank multiset, indexed by the colex index of its ascending ranks
+struct RankScores
+{
+  RankScores()
+    : points()
+  {
+    for (std::size_t n = 0; n < 18; ++n)
+    {
+      for (std::size_t k = 0; k < 6; ++k)
+      {
+        binomials[n][k] = k == 0 ? 1 : (n == 0 ? 0 : binomials[n - 1][k - 1] + binomials[n - 1][k]);
+      }
+    }
+
+    int ranks[5];
+    for (ranks[0] = 0; ranks[0] < 13; ++ranks[0])
+    {
+      for (ranks[1] = ranks[0]; ranks[1] < 13; ++ranks[1])
+      {
+        for (ranks[2] = ranks[1]; ranks[2] < 13; ++ranks[2])
+        {
+          for (ranks[3] = ranks[2]; ranks[3] < 13; ++ranks[3])
+          {
+            for (ranks[4] = ranks[3]; ranks[4] < 13; ++ranks[4])
+            {
+              points[index(ranks)] = static_cast<std::uint8_t>(score(ranks));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  std::size_t index(const int* ranks) const noexcept
+  {
+    std::size_t index = 0;
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      index += binomials[ranks[i] + i][i + 1];
+    }
+
+    return index;
+  }
+
+  static int score(const int* ranks) noexcept
+  {
+    // every subset adding up to 15 scores 2
+    int points = 0;
+    for (unsigned subset = 1; subset < 32; ++subset)
+    {
+      int sum = 0;
+      for (std::size_t i = 0; i < 5; ++i)
+      {
+        sum += subset & (1u << i) ? pips(ranks[i]) : 0;
+      }
+      points += sum == 15 ? 2 : 0;
+    }
+
+    // every pair of equal ranks scores 2
+    int counts[14] = {};
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      points += 2 * counts[ranks[i]]++;
+    }
+
+    // a run of 3 or more scores its length once per combination of the duplicated ranks; 5 cards hold at most one
+    for (int first = 0; first < 13;)
+    {
+      int last = first;
+      int combinations = 1;
+      while (counts[last] != 0)
+      {
+        combinations *= counts[last++];
+      }
+      if (last - first >= 3)
+      {
+        points += (last - first) * combinations;
+      }
+      first = last + 1;
+    }
+
+    return points;
+  }
+
+  std::uint32_t binomials[18][6];
+  std::uint8_t points[NumRankHands];
+};
+
+const RankScores& rank_scores()
+{
+  static const RankScores scores;
+  return scores;
+}
+
+// gathers the ranks of a hand of four cards, ascending
+void sorted_ranks(CardSet hand, int* ranks) noexcept
+{
+  std::size_t count = 0;
+  for (const auto suit : Suits)
+  {
+    for (std::uint32_t mask = hand.suit_mask(suit); mask != 0; mask &= mask - 1)
+    {
+      // insertion sort
+      const int rank = __builtin_ctz(mask);
+      std::size_t i = count++;
+      for (; i > 0 && ranks[i - 1] > rank; --i)
+      {
+        ranks[i] = ranks[i - 1];
+      }
+      ranks[i] = rank;
+    }
+  }
+}
+
+// fifteens, pairs and runs of a hand of four cards with ascending ranks and a starter rank
+int rank_points(const int* hand_ranks, int starter_rank) noexcept
+{
+  const RankScores& scores = rank_scores();
+  int ranks[5];
+  std::size_t i = 0;
+  for (; i < 4 && hand_ranks[i] <= starter_rank; ++i)
+  {
+    ranks[i] = hand_ranks[i];
+  }
+  ranks[i] = starter_rank;
+  for (; i < 4; ++i)
+  {
+    ranks[i + 1] = hand_ranks[i];
+  }
+
+  return scores.points[scores.index(ranks)];
+}
+
+// scores a hand of four cards whose ascending ranks are known, so that the starters of one hand reuse them
+int score_sorted(CardSet hand, const int* hand_ranks, CardId starter, bool crib) noexcept
+{
+  const int starter_rank = starter % 13;
+  int points = rank_points(hand_ranks, starter_rank);
+
+  const Suit starter_suit = static_cast<Suit>(starter / 13);
+  for (const auto suit : Suits)
+  {
+    if (__builtin_popcount(hand.suit_mask(suit)) == 4)
+    {
+      points += suit == starter_suit ? 5 : (crib ? 0 : 4);
+    }
+  }
+  if (hand.contains(static_cast<CardId>(starter - starter_rank + Jack)))
+  {
+    ++points;
+  }
+
+  return points;
+}
+
+std::size_t crib_class(int low, int high, bool suited) noexcept
+{
+  return (static_cast<std::size_t>(low) * 13 + high) * 2 + suited;
+}
+
+// gathers the cards of a set, ascending
+std::size_t set_cards(CardSet set, CardId* cards) noexcept
+{
+  std::size_t count = 0;
+  for (std::uint64_t mask = set.mask(); mask != 0; mask &= mask - 1)
+  {
+    cards[count++] = static_cast<CardId>(__builtin_ctzll(mask));
+  }
+
+  return count;
+}
+
+}  // namespace
+
+int deck_of_cards::cribbage_score(CardSet hand, CardId starter, bool crib) noexcept
+{
+  int ranks[4];
+  sorted_ranks(hand, ranks);
+
+  return score_sorted(hand, ranks, starter, crib);
+}
+
+deck_of_cards::CribbageAnalyzer::CribbageAnalyzer(std::size_t num_threads)
+  : m_crib_values()
+{
+  // one representative discard per class: the lower rank in clubs, the higher one in clubs or diamonds
+  ThreadPool pool(num_threads);
+  for (int low = 0; low < 13; ++low)
+  {
+    for (int high = low; high < 13; ++high)
+    {
+      for (int suited = 0; suited < (low == high ? 1 : 2); ++suited)
+      {
+        pool.submit([this, low, high, suited]() {
+          CardSet discard;
+          discard.insert(static_cast<CardId>(low));
+          discard.insert(static_cast<CardId>(high + (suited ? 0 : 13)));
+          m_crib_values[crib_class(low, high, suited != 0)] = exact_crib_value(discard);
+        });
+      }
+    }
+  }
+  pool.wait_idle();
+}
+
+std::vector<CribbageDiscard> deck_of_cards::CribbageAnalyzer::analyze(CardSet dealt, bool dealer) const
+{
+  if (dealt.size() != 6)
+  {
+    throw std::invalid_argument("A cribbage deal holds six cards");
+  }
+
+  CardId cards[6];
+  set_cards(dealt, cards);
+
+  // the starters left per rank and per suit
+  int rank_starters[13];
+  std::fill(rank_starters, rank_starters + 13, 4);
+  int suit_starters[4];
+  for (const auto suit : Suits)
+  {
+    const std::uint32_t mask = dealt.suit_mask(suit);
+    suit_starters[static_cast<int>(suit)] = 13 - __builtin_popcount(mask);
+    for (std::uint32_t rest = mask; rest != 0; rest &= rest - 1)
+    {
+      --rank_starters[__builtin_ctz(rest)];
+    }
+  }
+  const int num_starters = static_cast<int>(NumCards) - 6;
+
+  std::vector<CribbageDiscard> discards;
+  discards.reserve(15);
+  for (std::size_t first = 0; first < 6; ++first)
+  {
+    for (std::size_t second = first + 1; second < 6; ++second)
+    {
+      CribbageDiscard option;
+      option.discard.insert(cards[first]);
+      option.discard.insert(cards[second]);
+      option.keep = dealt - option.discard;
+
+      // rank points only depend on the rank of the starter, flush and nobs on its suit
+      int ranks[4];
+      sorted_ranks(option.keep, ranks);
+      int points = 0;
+      for (int rank = 0; rank < 13; ++rank)
+      {
+        points += rank_starters[rank] != 0 ? rank_starters[rank] * rank_points(ranks, rank) : 0;
+      }
+      for (const auto suit : Suits)
+      {
+        const std::uint32_t mask = option.keep.suit_mask(suit);
+        const int starters = suit_starters[static_cast<int>(suit)];
+        points += __builtin_popcount(mask) == 4 ? 4 * num_starters + starters : 0;
+        points += mask & (1u << Jack) ? starters : 0;
+      }
+      option.hand_value = static_cast<double>(points) / num_starters;
+      option.crib_value = crib_value(option.discard);
+      option.expected_value = option.hand_value + (dealer ? option.crib_value : -option.crib_value);
+      discards.push_back(option);
+    }
+  }
+  std::stable_sort(discards.begin(), discards.end(), [](const CribbageDiscard& a, const CribbageDiscard& b) {
+    return a.expected_value > b.expected_value;
+  });
+
+  return discards;
+}
+
+double deck_of_cards::CribbageAnalyzer::crib_value(CardSet discard) const
+{
+  CardId cards[NumCards];
+  if (set_cards(discard, cards) != 2)
+  {
+    throw std::invalid_argument("A cribbage discard holds two cards");
+  }
+
+  const int first = cards[0] % 13;
+  const int second = cards[1] % 13;
+  const bool suited = cards[0] / 13 == cards[1] / 13;
+
+  return m_crib_values[crib_class(std::min(first, second), std::max(first, second), suited)];
+}
+
+double deck_of_cards::CribbageAnalyzer::exact_crib_value(CardSet discard, CardSet dead)
+{
+  if (discard.size() != 2)
+  {
+    throw std::invalid_argument("A cribbage discard holds two cards");
+  }
+  CardId cards[NumCards];
+  const std::size_t num_cards = set_cards(CardSet::full() - discard - dead, cards);
+  if (num_cards < 3)
+  {
+    throw std::invalid_argument("Too few cards remain to complete the crib");
+  }
+
+  std::uint64_t points = 0;
+  std::uint64_t cribs = 0;
+  for (std::size_t first = 0; first < num_cards; ++first)
+  {
+    for (std::size_t second = first + 1; second < num_cards; ++second)
+    {
+      CardSet crib = discard;
+      crib.insert(cards[first]);
+      crib.insert(cards[second]);
+      int ranks[4];
+      sorted_ranks(crib, ranks);
+      for (std::size_t starter = 0; starter < num_cards; ++starter)
+      {
+        if (starter != first && starter != second)
+        {
+          points += score_sorted(crib, ranks, cards[starter], true);
+          ++cribs;
+        }
+      }
+    }
+  }
+
+  return static_cast<double>(points) / cribs;
+}
@@ -2,7 +2,12 @@
 
 #include <time.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <utility>
+
+#include "CardSet.hpp"
+#include "HealthMonitor.hpp"
 
 using namespace deck_of_cards;
 
@@ -14,6 +19,7 @@ deck_of_cards::Card::Card(Suit suit, Value value)
 
 deck_of_cards::Deck::Deck()
   : m_cards(std::vector<std::shared_ptr<deck_of_cards::Card>>())
+  , m_monitored(false)
 {
   srand(time(NULL));  // set random seed
   // build our deck of cards
@@ -31,13 +37,20 @@ deck_of_cards::Deck::Deck()
 
 void deck_of_cards::Deck::shuffle()
 {
+  m_monitored = m_health_monitor && m_health_monitor->begin_shuffle();
+
   // Fisher-Yates shuffle algorithm
   // iterate over the entire deck, swapping each card with a randomly selected card
   // this ensures that every card has an equal chance of being dealt
   for (size_t i = m_cards.size() - 1; i > 0; --i)
   {
     // generate a random index between i and m_cards.size() - 1
-    int j = rand() % (i + 1);
+    const int sample = rand();
+    if (m_monitored)
+    {
+      m_health_monitor->add_sample(static_cast<std::uint32_t>(sample));
+    }
+    int j = sample % (i + 1);
     std::iter_swap(m_cards.begin() + i, m_cards.begin() + j);
   }
 }
@@ -49,8 +62,47 @@ std::shared_ptr<deck_of_cards::Card> deck_of_cards::Deck::deal_card()
     const auto card = m_cards.back();
     m_cards.pop_back();
 
+    if (m_monitored)
+    {
+      m_health_monitor->add_deal(m_original_cards.size() - m_cards.size() - 1, card->id());
+    }
+
     return card;
   }
 
   return nullptr;
 }
+
+std::size_t deck_of_cards::Deck::deal_cards(CardId* cards, std::size_t count)
+{
+  const std::size_t dealt = std::min(count, m_cards.size());
+  const std::size_t first_position = m_original_cards.size() - m_cards.size();
+  for (std::size_t i = 0; i < dealt; ++i)
+  {
+    cards[i] = m_cards[m_cards.size() - 1 - i]->id();
+    if (m_monitored)
+    {
+      m_health_monitor->add_deal(first_position + i, cards[i]);
+    }
+  }
+  m_cards.resize(m_cards.size() - dealt);
+
+  return dealt;
+}
+
+CardSet deck_of_cards::Deck::undealt() const noexcept
+{
+  CardSet cards;
+  for (const auto& card : m_cards)
+  {
+    cards.insert(card->id());
+  }
+
+  return cards;
+}
+
+void deck_of_cards::Deck::set_health_monitor(std::shared_ptr<HealthMonitor> monitor)
+{
+  m_health_monitor = std::move(monitor);
+  m_monitored = false;
+}
@@ -0,0 +1,44 @@
+#include "DeckBatch.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace deck_of_cards;
+
+deck_of_cards::DeckBatch::DeckBatch(std::size_t num_decks, PageMode mode)
+  : m_num_decks(num_decks)
+  , m_buffer(num_decks * DeckStride, mode)
+{
+  reset_all();
+}
+
+void deck_of_cards::DeckBatch::reset_all() noexcept
+{
+  CardId fresh[DeckStride] = {};
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    fresh[i] = static_cast<CardId>(i);
+  }
+
+  for (std::size_t deck = 0; deck < m_num_decks; ++deck)
+  {
+    std::memcpy(order(deck), fresh, DeckStride);
+  }
+}
+
+void deck_of_cards::DeckBatch::shuffle_all()
+{
+  int (*generator)() = &rand;
+  shuffle_all(generator);
+}
+
+std::size_t deck_of_cards::DeckBatch::deal_cards(std::size_t deck, CardId* cards, std::size_t count) noexcept
+{
+  CardId* deck_cards = order(deck);
+  const std::size_t cursor = deck_cards[NumCards];
+  const std::size_t dealt = std::min(count, NumCards - cursor);
+  std::memcpy(cards, deck_cards + cursor, dealt);
+  deck_cards[NumCards] = static_cast<CardId>(cursor + dealt);
+
+  return dealt;
+}
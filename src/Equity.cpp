@@ -0,0 +1,594 @@
+#include "Equity.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "HandEvaluator.hpp"
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+// a combination of a range that survives the board and the dead cards
+struct RangeEntry
+{
+  std::uint16_t combo;  ///< Combination index.
+  CardId low;           ///< Lower card.
+  CardId high;          ///< Higher card.
+  float weight;         ///< Range weight.
+};
+
+// a combination of a range evaluated on one runout
+struct RankedEntry
+{
+  HandRank rank;        ///< Rank of the combination with the full board.
+  std::uint16_t entry;  ///< Index into the range entries.
+};
+
+// villain weight accumulated over a prefix of the rank order, in total and per card
+struct WeightSums
+{
+  void add(const RangeEntry& entry)
+  {
+    total += entry.weight;
+    card[entry.low] += entry.weight;
+    card[entry.high] += entry.weight;
+  }
+
+  // weight of the accumulated combinations sharing no card with a combination
+  double compatible(const RangeEntry& entry) const
+  {
+    return total - card[entry.low] - card[entry.high];
+  }
+
+  double total = 0;
+  double card[NumCards] = {};
+};
+
+struct Partial
+{
+  double win = 0;
+  double tie = 0;
+  double matchups = 0;
+};
+
+std::vector<RangeEntry> range_entries(const Range& range, CardSet blocked)
+{
+  std::vector<RangeEntry> entries;
+  for (std::size_t combo = 0; combo < NumCombos; ++combo)
+  {
+    if (range.weight(combo) > 0 && !combo_cards(combo).intersects(blocked))
+    {
+      entries.push_back(RangeEntry{ static_cast<std::uint16_t>(combo), combo_low_card(combo), combo_high_card(combo),
+                                    range.weight(combo) });
+    }
+  }
+
+  return entries;
+}
+
+// every way to draw `count` cards from `remaining`, appended to runouts
+void enumerate_runouts(CardSet remaining, std::size_t count, CardSet drawn, std::vector<CardSet>& runouts)
+{
+  if (count == 0)
+  {
+    runouts.push_back(drawn);
+    return;
+  }
+
+  std::uint64_t mask = remaining.mask();
+  while (mask != 0)
+  {
+    const CardId card = static_cast<CardId>(__builtin_ctzll(mask));
+    mask &= mask - 1;
+    // only later cards, so every set of cards is drawn once
+    enumerate_runouts(CardSet(mask), count - 1, drawn | CardSet(std::uint64_t(1) << card), runouts);
+  }
+}
+
+// ranks the entries not blocked by the runout, ascending
+void rank_entries(const HandEvaluator& evaluator, const std::vector<RangeEntry>& entries, CardSet full,
+                  std::vector<RankedEntry>& ranked)
+{
+  ranked.clear();
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    const CardSet cards = combo_cards(entries[i].combo);
+    if (!cards.intersects(full))
+    {
+      ranked.push_back(RankedEntry{ evaluator.evaluate(full | cards), static_cast<std::uint16_t>(i) });
+    }
+  }
+  std::sort(ranked.begin(), ranked.end(),
+            [](const RankedEntry& a, const RankedEntry& b) { return a.rank < b.rank; });
+}
+
+void equity_on_runouts(const std::vector<RangeEntry>& hero, const std::vector<RangeEntry>& villain,
+                       const float* villain_weights, CardSet board, const CardSet* runouts, std::size_t count,
+                       Partial& partial)
+{
+  const HandEvaluator& evaluator = HandEvaluator::instance();
+  std::vector<RankedEntry> hero_ranked;
+  std::vector<RankedEntry> villain_ranked;
+  hero_ranked.reserve(hero.size());
+  villain_ranked.reserve(villain.size());
+  std::unique_ptr<WeightSums[]> sums(new WeightSums[3]);
+  WeightSums& all = sums[0];
+  WeightSums& below = sums[1];
+  WeightSums& at_most = sums[2];
+
+  for (std::size_t runout = 0; runout < count; ++runout)
+  {
+    const CardSet full = board | runouts[runout];
+    rank_entries(evaluator, hero, full, hero_ranked);
+    rank_entries(evaluator, villain, full, villain_ranked);
+
+    all = WeightSums();
+    below = WeightSums();
+    at_most = WeightSums();
+    for (const auto& entry : villain_ranked)
+    {
+      all.add(villain[entry.entry]);
+    }
+
+    std::size_t below_end = 0;
+    std::size_t at_most_end = 0;
+    for (const auto& ranked : hero_ranked)
+    {
+      while (below_end < villain_ranked.size() && villain_ranked[below_end].rank < ranked.rank)
+      {
+        below.add(villain[villain_ranked[below_end++].entry]);
+      }
+      while (at_most_end < villain_ranked.size() && villain_ranked[at_most_end].rank <= ranked.rank)
+      {
+        at_most.add(villain[villain_ranked[at_most_end++].entry]);
+      }
+
+      // the only villain combination holding both hero cards is the hero combination itself, which ranks equal; it
+      // was subtracted once per card, so adding it back once leaves it excluded
+      const RangeEntry& entry = hero[ranked.entry];
+      const double same = villain_weights[entry.combo];
+      const double win = below.compatible(entry);
+      const double tie = at_most.compatible(entry) + same - win;
+      const double total = all.compatible(entry) + same;
+
+      partial.win += entry.weight * win;
+      partial.tie += entry.weight * tie;
+      partial.matchups += entry.weight * total;
+    }
+  }
+}
+
+// card counts of known mean correcting the outcomes of control variate sampling
+constexpr std::size_t NumControls = 4;
+
+// the cards the runouts of a simulated matchup are drawn from
+struct DealSpace
+{
+  CardSet hero;                         ///< Hero hand.
+  CardSet villain;                      ///< Villain hand.
+  CardSet board;                        ///< Known board cards.
+  std::size_t draw;                     ///< Runout cards per deal.
+  std::vector<CardId> remaining;        ///< Cards left to draw, ascending.
+  CardId mirror[NumCards];              ///< Antithetic image of every remaining card.
+  std::uint64_t controls[NumControls];  ///< Cards counted by every control variate.
+  double control_means[NumControls];    ///< Expected count of every control variate.
+};
+
+// runout totals of one thread, per stratum
+struct SamplePartial
+{
+  std::vector<std::uint64_t> units;  ///< Deals, or antithetic pairs, per stratum.
+  std::vector<double> sums;          ///< Sum of the unit estimates per stratum.
+  std::vector<double> squares;       ///< Sum of their squares per stratum.
+  double outcomes;                   ///< Sum of the uncorrected outcome of every deal.
+  double outcome_squares;            ///< Sum of their squares.
+};
+
+// every card of the values in a hand
+std::uint64_t value_mask(CardSet hand)
+{
+  std::uint64_t mask = 0;
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    if (hand.contains(card))
+    {
+      mask |= (std::uint64_t(1) | std::uint64_t(1) << 13 | std::uint64_t(1) << 26 | std::uint64_t(1) << 39)
+              << card % 13;
+    }
+  }
+  return mask;
+}
+
+// every card of the suits in a hand
+std::uint64_t suit_mask(CardSet hand)
+{
+  std::uint64_t mask = 0;
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    if (hand.contains(card))
+    {
+      mask |= ((std::uint64_t(1) << 13) - 1) << card / 13 * 13;
+    }
+  }
+  return mask;
+}
+
+DealSpace deal_space(CardSet hero, CardSet villain, CardSet board)
+{
+  DealSpace space;
+  space.hero = hero;
+  space.villain = villain;
+  space.board = board;
+  space.draw = 5 - board.size();
+  const CardSet remaining = CardSet::full() - hero - villain - board;
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    space.mirror[card] = card;
+    if (remaining.contains(card))
+    {
+      space.remaining.push_back(card);
+    }
+  }
+
+  // the lowest remaining card is mirrored to the highest, the second lowest to the second highest and so on
+  std::vector<CardId> by_value = space.remaining;
+  std::sort(by_value.begin(), by_value.end(), [](CardId a, CardId b) {
+    const int a_rank = (a % 13 + 12) % 13;
+    const int b_rank = (b % 13 + 12) % 13;
+    return a_rank != b_rank ? a_rank < b_rank : a < b;
+  });
+  for (std::size_t i = 0; i < by_value.size(); ++i)
+  {
+    space.mirror[by_value[i]] = by_value[by_value.size() - 1 - i];
+  }
+
+  const std::uint64_t controls[NumControls] = { value_mask(hero), value_mask(villain), suit_mask(hero),
+                                                suit_mask(villain) };
+  const double share = space.remaining.empty() ? 0 : 1.0 / static_cast<double>(space.remaining.size());
+  for (std::size_t control = 0; control < NumControls; ++control)
+  {
+    // the mean of a hypergeometric count
+    space.controls[control] = controls[control] & remaining.mask();
+    space.control_means[control] =
+      static_cast<double>(space.draw) * static_cast<double>(CardSet(space.controls[control]).size()) * share;
+  }
+
+  return space;
+}
+
+// draws a uniform runout into the first places of cards by a partial Fisher-Yates shuffle, keeping the first `fixed`
+CardSet draw_runout(std::vector<CardId>& cards, std::size_t fixed, std::size_t draw, std::mt19937_64& generator)
+{
+  std::uint64_t mask = 0;
+  for (std::size_t i = 0; i < draw; ++i)
+  {
+    if (i >= fixed)
+    {
+      std::uniform_int_distribution<std::size_t> pick(i, cards.size() - 1);
+      std::swap(cards[i], cards[pick(generator)]);
+    }
+    mask |= std::uint64_t(1) << cards[i];
+  }
+
+  return CardSet(mask);
+}
+
+CardSet mirrored(const DealSpace& space, CardSet runout)
+{
+  std::uint64_t mask = 0;
+  for (std::uint64_t cards = runout.mask(); cards != 0; cards &= cards - 1)
+  {
+    mask |= std::uint64_t(1) << space.mirror[__builtin_ctzll(cards)];
+  }
+
+  return CardSet(mask);
+}
+
+// the share of the pot hero takes on a runout
+double showdown(const HandEvaluator& evaluator, const DealSpace& space, CardSet runout)
+{
+  const CardSet full = space.board | runout;
+  const HandRank hero = evaluator.evaluate(full | space.hero);
+  const HandRank villain = evaluator.evaluate(full | space.villain);
+  return hero > villain ? 1 : hero == villain ? 0.5 : 0;
+}
+
+// the deviation of the control variates from their means, weighted by their coefficients
+double control_deviation(const DealSpace& space, const double* coefficients, CardSet runout)
+{
+  double deviation = 0;
+  for (std::size_t control = 0; control < NumControls; ++control)
+  {
+    const double count = static_cast<double>(__builtin_popcountll(runout.mask() & space.controls[control]));
+    deviation += coefficients[control] * (count - space.control_means[control]);
+  }
+
+  return deviation;
+}
+
+// fits the control variate coefficients by least squares on independent pilot deals; the coefficients of controls
+// that are constant or depend on the others are left at zero
+void fit_controls(const DealSpace& space, std::uint64_t pilot_deals, std::mt19937_64& generator,
+                  double* coefficients)
+{
+  const HandEvaluator& evaluator = HandEvaluator::instance();
+  std::vector<CardId> cards = space.remaining;
+  double sums[NumControls + 1] = {};
+  double products[NumControls + 1][NumControls + 1] = {};
+  for (std::uint64_t deal = 0; deal < pilot_deals; ++deal)
+  {
+    const CardSet runout = draw_runout(cards, 0, space.draw, generator);
+    double values[NumControls + 1];
+    for (std::size_t control = 0; control < NumControls; ++control)
+    {
+      values[control] = static_cast<double>(__builtin_popcountll(runout.mask() & space.controls[control]));
+    }
+    values[NumControls] = showdown(evaluator, space, runout);
+    for (std::size_t i = 0; i <= NumControls; ++i)
+    {
+      sums[i] += values[i];
+      for (std::size_t j = 0; j <= NumControls; ++j)
+      {
+        products[i][j] += values[i] * values[j];
+      }
+    }
+  }
+
+  // the covariances of the controls, augmented by their covariances with the outcome, reduced by Gauss-Jordan
+  double system[NumControls][NumControls + 1];
+  const double deals = static_cast<double>(pilot_deals);
+  for (std::size_t i = 0; i < NumControls; ++i)
+  {
+    for (std::size_t j = 0; j <= NumControls; ++j)
+    {
+      system[i][j] = products[i][j] / deals - sums[i] / deals * sums[j] / deals;
+    }
+  }
+  std::size_t pivot_of[NumControls];
+  std::size_t rank = 0;
+  for (std::size_t column = 0; column < NumControls; ++column)
+  {
+    pivot_of[column] = NumControls;
+    std::size_t pivot = rank;
+    for (std::size_t row = rank; row < NumControls; ++row)
+    {
+      pivot = std::fabs(system[row][column]) > std::fabs(system[pivot][column]) ? row : pivot;
+    }
+    if (rank == NumControls || std::fabs(system[pivot][column]) < 1e-9)
+    {
+      continue;
+    }
+    std::swap(system[pivot], system[rank]);
+    for (std::size_t row = 0; row < NumControls; ++row)
+    {
+      if (row != rank)
+      {
+        const double factor = system[row][column] / system[rank][column];
+        for (std::size_t j = column; j <= NumControls; ++j)
+        {
+          system[row][j] -= factor * system[rank][j];
+        }
+      }
+    }
+    pivot_of[column] = rank++;
+  }
+  for (std::size_t column = 0; column < NumControls; ++column)
+  {
+    const std::size_t row = pivot_of[column];
+    coefficients[column] = row == NumControls ? 0 : system[row][NumControls] / system[row][column];
+  }
+}
+
+void sample_deals(const DealSpace& space, EquitySampling sampling, const double* coefficients, std::uint64_t begin,
+                  std::uint64_t end, std::mt19937_64& generator, SamplePartial& partial)
+{
+  const HandEvaluator& evaluator = HandEvaluator::instance();
+  const std::size_t num_strata = partial.units.size();
+  std::vector<CardId> cards = space.remaining;
+  for (std::uint64_t unit = begin; unit < end; ++unit)
+  {
+    std::size_t stratum = 0;
+    double value;
+    if (sampling == EquitySampling::Antithetic)
+    {
+      const CardSet runout = draw_runout(cards, 0, space.draw, generator);
+      const double first = showdown(evaluator, space, runout);
+      const double second = showdown(evaluator, space, mirrored(space, runout));
+      value = (first + second) / 2;
+      partial.outcomes += first + second;
+      partial.outcome_squares += first * first + second * second;
+    }
+    else
+    {
+      std::size_t fixed = 0;
+      if (sampling == EquitySampling::Stratified && space.draw > 0)
+      {
+        // the runout class of the deal goes first and the rest is drawn from the other cards
+        stratum = static_cast<std::size_t>(unit % num_strata);
+        std::swap(cards[0], *std::find(cards.begin(), cards.end(), space.remaining[stratum]));
+        fixed = 1;
+      }
+      const CardSet runout = draw_runout(cards, fixed, space.draw, generator);
+      const double outcome = showdown(evaluator, space, runout);
+      value = sampling == EquitySampling::ControlVariate ? outcome - control_deviation(space, coefficients, runout) :
+                                                           outcome;
+      partial.outcomes += outcome;
+      partial.outcome_squares += outcome * outcome;
+    }
+    ++partial.units[stratum];
+    partial.sums[stratum] += value;
+    partial.squares[stratum] += value * value;
+  }
+}
+
+}  // namespace
+
+EquityResult deck_of_cards::range_equity(const Range& hero, const Range& villain, CardSet board, CardSet dead,
+                                         std::size_t num_threads)
+{
+  const std::size_t board_size = board.size();
+  if (board_size == 1 || board_size == 2 || board_size > 5)
+  {
+    throw std::invalid_argument("The board must hold 0, 3, 4 or 5 cards");
+  }
+  if (board.intersects(dead))
+  {
+    throw std::invalid_argument("The board and the dead cards overlap");
+  }
+
+  const CardSet blocked = board | dead;
+  const std::vector<RangeEntry> hero_entries = range_entries(hero, blocked);
+  const std::vector<RangeEntry> villain_entries = range_entries(villain, blocked);
+  Range villain_weights = villain;
+  villain_weights.remove(blocked);
+
+  std::vector<CardSet> runouts;
+  enumerate_runouts(CardSet::full() - blocked, 5 - board_size, CardSet(), runouts);
+
+  // a few chunks per thread keeps the workers busy when chunks finish unevenly
+  ThreadPool pool(num_threads);
+  const std::size_t num_chunks = std::min(runouts.size(), pool.size() * 4);
+  std::vector<Partial> partials(num_chunks);
+  for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+  {
+    const std::size_t begin = runouts.size() * chunk / num_chunks;
+    const std::size_t end = runouts.size() * (chunk + 1) / num_chunks;
+    Partial* partial = &partials[chunk];
+    const CardSet* chunk_runouts = runouts.data() + begin;
+    pool.submit([&, partial, chunk_runouts, begin, end]() {
+      equity_on_runouts(hero_entries, villain_entries, villain_weights.weights(), board, chunk_runouts, end - begin,
+                        *partial);
+    });
+  }
+  pool.wait_idle();
+
+  Partial sum;
+  for (const auto& partial : partials)
+  {
+    sum.win += partial.win;
+    sum.tie += partial.tie;
+    sum.matchups += partial.matchups;
+  }
+  if (!(sum.matchups > 0))
+  {
+    throw std::invalid_argument("The ranges have no compatible combinations");
+  }
+
+  EquityResult result;
+  result.win = sum.win / sum.matchups;
+  result.tie = sum.tie / sum.matchups;
+  result.equity = result.win + result.tie / 2;
+  result.matchups = sum.matchups;
+  result.runouts = runouts.size();
+
+  return result;
+}
+
+deck_of_cards::EquitySimulator::EquitySimulator(const Config& config)
+  : m_config(config)
+{
+  if (config.sampling == EquitySampling::ControlVariate && config.pilot_deals < 2)
+  {
+    throw std::invalid_argument("Control variates need at least two pilot deals");
+  }
+}
+
+EquitySimulation deck_of_cards::EquitySimulator::run(CardSet hero, CardSet villain, CardSet board,
+                                                     std::uint64_t num_deals, std::size_t num_threads) const
+{
+  if (hero.intersects(villain) || hero.intersects(board) || villain.intersects(board) || board.size() > 5 ||
+      hero.size() > 2 || villain.size() > 2)
+  {
+    throw std::invalid_argument("Hands and board must not share cards, hands hold at most 2 and the board 5 cards");
+  }
+
+  const DealSpace space = deal_space(hero, villain, board);
+  if (space.remaining.size() < space.draw)
+  {
+    throw std::invalid_argument("Not enough cards left to complete the board");
+  }
+  const bool stratified = m_config.sampling == EquitySampling::Stratified && space.draw > 0;
+  const std::size_t num_strata = stratified ? space.remaining.size() : 1;
+  const std::uint64_t num_units = m_config.sampling == EquitySampling::Antithetic ? num_deals / 2 : num_deals;
+  if (num_units / num_strata < 2)
+  {
+    throw std::invalid_argument("Too few deals to estimate the standard error");
+  }
+
+  double coefficients[NumControls] = {};
+  if (m_config.sampling == EquitySampling::ControlVariate)
+  {
+    // a stream of its own, so the pilot does not depend on the thread count
+    std::seed_seq seed{ static_cast<std::uint32_t>(m_config.seed), static_cast<std::uint32_t>(m_config.seed >> 32),
+                        std::numeric_limits<std::uint32_t>::max() };
+    std::mt19937_64 generator(seed);
+    fit_controls(space, m_config.pilot_deals, generator, coefficients);
+  }
+
+  ThreadPool pool(num_threads);
+  std::vector<SamplePartial> partials(pool.size(),
+                                      SamplePartial{ std::vector<std::uint64_t>(num_strata),
+                                                     std::vector<double>(num_strata),
+                                                     std::vector<double>(num_strata), 0, 0 });
+  for (std::size_t thread = 0; thread < pool.size(); ++thread)
+  {
+    const std::uint64_t begin = num_units * thread / pool.size();
+    const std::uint64_t end = num_units * (thread + 1) / pool.size();
+    pool.submit([this, &space, &coefficients, &partials, thread, begin, end]() {
+      std::seed_seq seed{ static_cast<std::uint32_t>(m_config.seed), static_cast<std::uint32_t>(m_config.seed >> 32),
+                          static_cast<std::uint32_t>(thread) };
+      std::mt19937_64 generator(seed);
+      sample_deals(space, m_config.sampling, coefficients, begin, end, generator, partials[thread]);
+    });
+  }
+  pool.wait_idle();
+
+  // the strata are equally likely, so their means are weighed equally
+  EquitySimulation simulation{ 0, 0, 0, 0 };
+  double variance = 0;
+  double outcomes = 0;
+  double outcome_squares = 0;
+  for (std::size_t stratum = 0; stratum < num_strata; ++stratum)
+  {
+    double units = 0;
+    double sum = 0;
+    double squares = 0;
+    for (const auto& partial : partials)
+    {
+      units += static_cast<double>(partial.units[stratum]);
+      sum += partial.sums[stratum];
+      squares += partial.squares[stratum];
+    }
+    const double mean = sum / units;
+    simulation.equity += mean / static_cast<double>(num_strata);
+    variance += std::max(0.0, squares - units * mean * mean) / (units - 1) / units /
+                (static_cast<double>(num_strata) * static_cast<double>(num_strata));
+  }
+  for (const auto& partial : partials)
+  {
+    outcomes += partial.outcomes;
+    outcome_squares += partial.outcome_squares;
+  }
+
+  simulation.deals = m_config.sampling == EquitySampling::Antithetic ? num_units * 2 : num_units;
+  simulation.standard_error = std::sqrt(variance);
+  const double deals = static_cast<double>(simulation.deals);
+  const double deal_variance = outcome_squares / deals - outcomes / deals * outcomes / deals;
+  if (!(deal_variance > 1e-12))
+  {
+    simulation.effective_deals = deals;
+  }
+  else
+  {
+    simulation.effective_deals = variance > 0 ? deal_variance / variance : std::numeric_limits<double>::infinity();
+  }
+
+  return simulation;
+}
@@ -0,0 +1,265 @@
+#include "FairnessMonitor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "Statistics.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+// rank with Ace high: Two is 0 and Ace is 12
+std::size_t high_rank(CardId card)
+{
+  return (card % 13 + 12) % 13;
+}
+
+}  // namespace
+
+std::size_t deck_of_cards::starting_hand_class(CardId first, CardId second) noexcept
+{
+  // grid rows and columns run from Ace (0) down to Two (12)
+  std::size_t a = 12 - high_rank(first);
+  std::size_t b = 12 - high_rank(second);
+  if (a > b)
+  {
+    std::swap(a, b);
+  }
+
+  const bool suited = first / 13 == second / 13;
+  return suited ? a * 13 + b : b * 13 + a;
+}
+
+std::vector<double> deck_of_cards::starting_hand_probabilities()
+{
+  std::vector<double> probabilities(NumStartingHands);
+  for (std::size_t row = 0; row < 13; ++row)
+  {
+    for (std::size_t column = 0; column < 13; ++column)
+    {
+      // 6 combinations of a pair, 4 of a suited hand and 12 of an offsuit hand out of C(52, 2)
+      const double combos = row == column ? 6.0 : (row < column ? 4.0 : 12.0);
+      probabilities[row * 13 + column] = combos / 1326.0;
+    }
+  }
+
+  return probabilities;
+}
+
+deck_of_cards::FairnessCounters::FairnessCounters(std::size_t num_seats, std::size_t num_categories)
+  : m_num_seats(num_seats)
+  , m_num_categories(num_categories)
+  , m_counts(num_seats * num_categories, 0)
+{
+}
+
+void deck_of_cards::FairnessCounters::merge(const FairnessCounters& other)
+{
+  if (other.m_num_seats != m_num_seats || other.m_num_categories != m_num_categories)
+  {
+    throw std::invalid_argument("cannot merge fairness counters of different shapes");
+  }
+
+  for (std::size_t i = 0; i < m_counts.size(); ++i)
+  {
+    m_counts[i] += other.m_counts[i];
+  }
+}
+
+void deck_of_cards::FairnessCounters::clear()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+}
+
+std::uint64_t deck_of_cards::FairnessCounters::seat_total(std::size_t seat) const
+{
+  std::uint64_t total = 0;
+  for (std::size_t category = 0; category < m_num_categories; ++category)
+  {
+    total += count(seat, category);
+  }
+
+  return total;
+}
+
+deck_of_cards::FairnessMonitor::FairnessMonitor(const Config& config)
+  : m_config(config)
+  , m_windows(config.num_windows, FairnessCounters(config.num_seats, config.expected.size()))
+  , m_current(0)
+  , m_table_counts(config.num_tables * config.expected.size(), 0)
+{
+  if (config.num_seats == 0 || config.num_tables == 0 || config.num_windows == 0 || config.expected.empty())
+  {
+    throw std::invalid_argument("fairness monitor needs at least one seat, table, window and category");
+  }
+  for (const auto probability : config.expected)
+  {
+    if (!(probability > 0.0))
+    {
+      throw std::invalid_argument("expected category probabilities must be positive");
+    }
+  }
+}
+
+void deck_of_cards::FairnessMonitor::advance_window()
+{
+  m_current = (m_current + 1) % m_windows.size();
+  m_windows[m_current].clear();
+}
+
+void deck_of_cards::FairnessMonitor::merge(const FairnessMonitor& other, std::size_t first_table)
+{
+  if (other.m_windows.size() != m_windows.size() || other.m_config.num_seats != m_config.num_seats ||
+      other.m_config.expected.size() != m_config.expected.size() || first_table > m_config.num_tables ||
+      other.m_config.num_tables > m_config.num_tables - first_table)
+  {
+    throw std::invalid_argument("cannot merge fairness monitors of different shapes");
+  }
+
+  // align the rings on their current windows
+  for (std::size_t age = 0; age < m_windows.size(); ++age)
+  {
+    const std::size_t mine = (m_current + m_windows.size() - age) % m_windows.size();
+    const std::size_t theirs = (other.m_current + m_windows.size() - age) % m_windows.size();
+    m_windows[mine].merge(other.m_windows[theirs]);
+  }
+  const std::size_t offset = first_table * m_config.expected.size();
+  for (std::size_t i = 0; i < other.m_table_counts.size(); ++i)
+  {
+    m_table_counts[offset + i] += other.m_table_counts[i];
+  }
+}
+
+FairnessCounters deck_of_cards::FairnessMonitor::window_counts() const
+{
+  FairnessCounters counts(m_config.num_seats, m_config.expected.size());
+  for (const auto& window : m_windows)
+  {
+    counts.merge(window);
+  }
+
+  return counts;
+}
+
+FairnessResult deck_of_cards::FairnessMonitor::seat_test(std::size_t seat) const
+{
+  check_hand(0, seat, 0);
+  const auto counts = window_counts();
+  std::vector<std::uint64_t> row(m_config.expected.size());
+  for (std::size_t category = 0; category < row.size(); ++category)
+  {
+    row[category] = counts.count(seat, category);
+  }
+
+  return chi_squared_test(row.data());
+}
+
+FairnessResult deck_of_cards::FairnessMonitor::table_test(std::size_t table) const
+{
+  check_hand(table, 0, 0);
+  return chi_squared_test(&m_table_counts[table * m_config.expected.size()]);
+}
+
+FairnessResult deck_of_cards::FairnessMonitor::binomial_test(std::size_t seat, std::size_t category) const
+{
+  check_hand(0, seat, category);
+  const auto counts = window_counts();
+  const std::uint64_t hands = counts.seat_total(seat);
+  if (hands == 0)
+  {
+    return FairnessResult{ 0.0, 0.0, 0, true };
+  }
+
+  // the smallest count with P(X <= count) >= alpha / 2 and the smallest with P(X <= count) >= 1 - alpha / 2 bound
+  // the counts whose tails both hold more than alpha / 2
+  const double p = m_config.expected[category];
+  const std::uint64_t count = counts.count(seat, category);
+  if (count >= hands * p)
+  {
+    const std::size_t upper = binomial_critical_value(hands, p, m_config.alpha / 2.0);
+    return FairnessResult{ static_cast<double>(count), static_cast<double>(upper), hands, count <= upper };
+  }
+
+  const std::size_t lower = binomial_critical_value(hands, p, 1.0 - m_config.alpha / 2.0);
+  return FairnessResult{ static_cast<double>(count), static_cast<double>(lower), hands, count >= lower };
+}
+
+FairnessResult deck_of_cards::FairnessMonitor::chi_squared_test(const std::uint64_t* counts) const
+{
+  const std::size_t num_categories = m_config.expected.size();
+  std::uint64_t hands = 0;
+  for (std::size_t category = 0; category < num_categories; ++category)
+  {
+    hands += counts[category];
+  }
+
+  const double threshold = chi_squared_critical_value(num_categories - 1.0, m_config.alpha);
+  if (hands == 0)
+  {
+    return FairnessResult{ 0.0, threshold, 0, true };
+  }
+
+  double chi_squared = 0.0;
+  for (std::size_t category = 0; category < num_categories; ++category)
+  {
+    const double expected = hands * m_config.expected[category];
+    const double delta = counts[category] - expected;
+    chi_squared += delta * delta / expected;
+  }
+
+  return FairnessResult{ chi_squared, threshold, hands, chi_squared < threshold };
+}
+
+deck_of_cards::ShardedFairnessMonitor::ShardedFairnessMonitor(const FairnessMonitor::Config& config,
+                                                              std::size_t num_shards)
+  : m_config(config)
+  , m_tables_per_shard(0)
+{
+  if (num_shards == 0 || config.num_tables == 0)
+  {
+    throw std::invalid_argument("sharded fairness monitor needs at least one shard and table");
+  }
+
+  m_tables_per_shard = (config.num_tables + num_shards - 1) / num_shards;
+  FairnessMonitor::Config shard_config = config;
+  for (std::size_t first = 0; first < config.num_tables; first += m_tables_per_shard)
+  {
+    shard_config.num_tables = std::min(m_tables_per_shard, config.num_tables - first);
+    m_shards.emplace_back(new Shard(shard_config, first));
+  }
+}
+
+void deck_of_cards::ShardedFairnessMonitor::record(std::size_t table, std::size_t seat, std::size_t category)
+{
+  if (table >= m_config.num_tables || seat >= m_config.num_seats || category >= m_config.expected.size())
+  {
+    throw std::out_of_range("Fairness monitor table, seat or category out of range");
+  }
+
+  Shard& shard = *m_shards[table / m_tables_per_shard];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.monitor.record(table - shard.first_table, seat, category);
+}
+
+void deck_of_cards::ShardedFairnessMonitor::advance_window()
+{
+  for (auto& shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->monitor.advance_window();
+  }
+}
+
+FairnessMonitor deck_of_cards::ShardedFairnessMonitor::snapshot() const
+{
+  FairnessMonitor merged(m_config);
+  for (const auto& shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    merged.merge(shard->monitor, shard->first_table);
+  }
+
+  return merged;
+}
@@ -0,0 +1,477 @@
+#include "HandEvaluator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "TableFile.hpp"
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+// size of the flush table, one entry per 13 bit rank mask
+constexpr std::size_t FlushTableSize = 1 << 13;
+
+// binomial coefficients C(n, k) for the multiset indices, n < 20 and k <= 7
+struct Binomials
+{
+  Binomials()
+  {
+    for (std::size_t n = 0; n < 20; ++n)
+    {
+      for (std::size_t k = 0; k < 8; ++k)
+      {
+        c[n][k] = k == 0 ? 1 : (n == 0 ? 0 : c[n - 1][k - 1] + c[n - 1][k]);
+      }
+    }
+  }
+
+  std::uint32_t c[20][8];
+};
+
+const Binomials binomials;
+
+// number of multisets of k ranks, C(13 + k - 1, k)
+std::size_t rank_table_size(std::size_t k)
+{
+  return binomials.c[12 + k][k];
+}
+
+// start of every table in the block: flush, then the rank tables for 5, 6 and 7 cards, then the end of the block
+struct TableOffsets
+{
+  TableOffsets()
+  {
+    start[0] = 0;
+    start[1] = FlushTableSize;
+    for (std::size_t count = 5; count <= 7; ++count)
+    {
+      start[count - 3] = start[count - 4] + rank_table_size(count);
+    }
+  }
+
+  std::size_t start[5];
+};
+
+const TableOffsets offsets;
+
+const char TableFileMagic[8] = { 'D', 'O', 'C', 'E', 'V', 'A', 'L', '\0' };
+
+// the four card bits of a rank, indexed by poker rank (Two is 0 and Ace is 12)
+std::uint64_t rank_bits(int rank)
+{
+  const int bit = (rank + 1) % 13;
+  return (std::uint64_t(1) << bit) | (std::uint64_t(1) << (bit + 13)) | (std::uint64_t(1) << (bit + 26)) |
+         (std::uint64_t(1) << (bit + 39));
+}
+
+// converts a suit mask with Ace in bit 0 to a poker rank mask with Two in bit 0 and Ace in bit 12
+std::uint32_t to_poker_order(std::uint32_t mask)
+{
+  return (mask >> 1) | ((mask & 1) << 12);
+}
+
+// colex index of an ascending rank multiset: ranks r_i map to the distinct values r_i + i
+std::size_t multiset_index(const int* ranks, std::size_t count)
+{
+  std::size_t index = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    index += binomials.c[ranks[i] + i][i + 1];
+  }
+
+  return index;
+}
+
+// totally ordered key of a 5 card hand: category in bits 20 and up, then one nibble per rank group
+std::uint32_t five_card_key(const int* ranks, bool flush)
+{
+  int counts[13] = {};
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    ++counts[ranks[i]];
+  }
+
+  // groups ordered by size, then rank, both descending
+  int groups[5][2];
+  std::size_t num_groups = 0;
+  for (int size = 4; size > 0; --size)
+  {
+    for (int rank = 12; rank >= 0; --rank)
+    {
+      if (counts[rank] == size)
+      {
+        groups[num_groups][0] = size;
+        groups[num_groups][1] = rank;
+        ++num_groups;
+      }
+    }
+  }
+
+  int straight_top = -1;
+  if (num_groups == 5)
+  {
+    if (groups[0][1] - groups[4][1] == 4)
+    {
+      straight_top = groups[0][1];
+    }
+    else if (groups[0][1] == 12 && groups[1][1] == 3)  // the wheel, A-2-3-4-5
+    {
+      straight_top = 3;
+    }
+  }
+
+  HandCategory category = HandCategory::HighCard;
+  if (straight_top >= 0)
+  {
+    category = flush ? HandCategory::StraightFlush : HandCategory::Straight;
+    return (static_cast<std::uint32_t>(category) << 20) | (static_cast<std::uint32_t>(straight_top) << 16);
+  }
+  if (flush)
+  {
+    category = HandCategory::Flush;
+  }
+  else if (groups[0][0] == 4)
+  {
+    category = HandCategory::FourOfAKind;
+  }
+  else if (groups[0][0] == 3)
+  {
+    category = groups[1][0] == 2 ? HandCategory::FullHouse : HandCategory::ThreeOfAKind;
+  }
+  else if (groups[0][0] == 2)
+  {
+    category = groups[1][0] == 2 ? HandCategory::TwoPair : HandCategory::Pair;
+  }
+
+  std::uint32_t key = static_cast<std::uint32_t>(category) << 20;
+  for (std::size_t i = 0; i < num_groups; ++i)
+  {
+    key |= static_cast<std::uint32_t>(groups[i][1]) << (16 - 4 * i);
+  }
+
+  return key;
+}
+
+// calls visit(ranks) for every ascending multiset of `count` ranks holding no rank more than four times
+template <typename Visitor>
+void for_each_multiset(int* ranks, std::size_t count, std::size_t depth, int first, Visitor& visit)
+{
+  if (depth == count)
+  {
+    visit(ranks);
+    return;
+  }
+
+  for (int rank = first; rank < 13; ++rank)
+  {
+    if (depth >= 4 && ranks[depth - 4] == rank)
+    {
+      continue;
+    }
+    ranks[depth] = rank;
+    for_each_multiset(ranks, count, depth + 1, rank, visit);
+  }
+}
+
+// ranks every key, best hand last
+class KeyRanking
+{
+public:
+  explicit KeyRanking(std::vector<std::uint32_t> keys)
+    : m_keys(std::move(keys))
+  {
+    std::sort(m_keys.begin(), m_keys.end());
+    m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+    if (m_keys.size() != NumHandRanks)
+    {
+      throw std::logic_error("hand evaluator produced an unexpected number of hand ranks");
+    }
+  }
+
+  HandRank operator()(std::uint32_t key) const
+  {
+    return static_cast<HandRank>(std::lower_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin() + 1);
+  }
+
+private:
+  std::vector<std::uint32_t> m_keys;
+};
+
+struct NonFlushKeys
+{
+  void operator()(const int* ranks)
+  {
+    keys.push_back(five_card_key(ranks, false));
+  }
+
+  std::vector<std::uint32_t> keys;
+};
+
+struct FiveCardTable
+{
+  void operator()(const int* ranks)
+  {
+    table[multiset_index(ranks, 5)] = ranking(five_card_key(ranks, false));
+  }
+
+  const KeyRanking& ranking;
+  std::uint16_t* table;
+};
+
+// best 5 card sub-hand of a larger rank multiset
+struct LargerTable
+{
+  void operator()(const int* ranks)
+  {
+    HandRank best = 0;
+    const std::size_t subsets = 1u << count;
+    for (std::size_t subset = 0; subset < subsets; ++subset)
+    {
+      if (__builtin_popcount(static_cast<unsigned>(subset)) != 5)
+      {
+        continue;
+      }
+      int chosen[5];
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        if (subset & (1u << i))
+        {
+          chosen[n++] = ranks[i];
+        }
+      }
+      best = std::max(best, five[multiset_index(chosen, 5)]);
+    }
+    table[multiset_index(ranks, count)] = best;
+  }
+
+  std::size_t count;
+  const std::uint16_t* five;
+  std::uint16_t* table;
+};
+
+// ranks of the set bits of a mask, ascending
+std::size_t mask_ranks(std::uint32_t mask, int* ranks)
+{
+  std::size_t count = 0;
+  for (int rank = 0; rank < 13; ++rank)
+  {
+    if (mask & (1u << rank))
+    {
+      ranks[count++] = rank;
+    }
+  }
+
+  return count;
+}
+
+// best 5 card flush inside every flush rank mask in [begin, end)
+void fill_flush_table(const KeyRanking& ranking, std::uint16_t* flush, std::uint32_t begin, std::uint32_t end)
+{
+  int ranks[7];
+  for (std::uint32_t mask = begin; mask < end; ++mask)
+  {
+    const std::size_t count = static_cast<std::size_t>(__builtin_popcount(mask));
+    if (count < 5 || count > 7)
+    {
+      continue;
+    }
+    mask_ranks(mask, ranks);
+    for (std::size_t subset = 0; subset < (1u << count); ++subset)
+    {
+      if (__builtin_popcount(static_cast<unsigned>(subset)) != 5)
+      {
+        continue;
+      }
+      int chosen[5];
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        if (subset & (1u << i))
+        {
+          chosen[n++] = ranks[i];
+        }
+      }
+      flush[mask] = std::max(flush[mask], ranking(five_card_key(chosen, true)));
+    }
+  }
+}
+
+// calls visit(ranks) for every multiset of `count` ranks whose lowest rank is `lowest`
+template <typename Visitor>
+void for_each_multiset_from(int lowest, std::size_t count, Visitor visit)
+{
+  int ranks[7];
+  ranks[0] = lowest;
+  for_each_multiset(ranks, count, 1, lowest, visit);
+}
+
+HandEvaluator* load_or_generate()
+{
+  const char* path = std::getenv(EvaluatorTableEnvironment);
+  if (path != nullptr && *path != '\0')
+  {
+    try
+    {
+      return new HandEvaluator(std::string(path));
+    }
+    catch (const std::runtime_error&)
+    {
+      // fall back to generating the tables
+    }
+  }
+
+  return new HandEvaluator();
+}
+
+}  // namespace
+
+HandCategory deck_of_cards::hand_category(HandRank rank) noexcept
+{
+  // the first rank of every category above high card
+  static const HandRank bounds[] = { 1278, 4138, 4996, 5854, 5864, 7141, 7297, 7453 };
+
+  int category = 0;
+  while (category < 8 && rank >= bounds[category])
+  {
+    ++category;
+  }
+
+  return static_cast<HandCategory>(category);
+}
+
+const HandEvaluator& deck_of_cards::HandEvaluator::instance()
+{
+  static const std::unique_ptr<const HandEvaluator> evaluator(load_or_generate());
+  return *evaluator;
+}
+
+deck_of_cards::HandEvaluator::HandEvaluator(std::size_t num_threads)
+  : m_storage(offsets.start[4], 0)
+  , m_file()
+  , m_tables(nullptr)
+  , m_num_entries(0)
+  , m_flush(nullptr)
+  , m_rank_tables()
+{
+  int ranks[7];
+
+  // rank every distinct 5 card hand
+  NonFlushKeys non_flush;
+  for_each_multiset(ranks, 5, 0, 0, non_flush);
+  std::vector<std::uint32_t> keys = non_flush.keys;
+  for (std::uint32_t mask = 0; mask < FlushTableSize; ++mask)
+  {
+    if (__builtin_popcount(mask) == 5)
+    {
+      mask_ranks(mask, ranks);
+      keys.push_back(five_card_key(ranks, true));
+    }
+  }
+  const KeyRanking ranking(std::move(keys));
+
+  // every table entry is independent, so split the flush masks into blocks and the rank multisets by lowest rank
+  ThreadPool pool(num_threads);
+  std::uint16_t* flush = &m_storage[offsets.start[0]];
+  std::uint16_t* five = &m_storage[offsets.start[1]];
+  constexpr std::uint32_t FlushBlock = 512;
+  for (std::uint32_t begin = 0; begin < FlushTableSize; begin += FlushBlock)
+  {
+    pool.submit([&ranking, flush, begin]() { fill_flush_table(ranking, flush, begin, begin + FlushBlock); });
+  }
+  for (int lowest = 0; lowest < 13; ++lowest)
+  {
+    pool.submit([&ranking, five, lowest]() { for_each_multiset_from(lowest, 5, FiveCardTable{ ranking, five }); });
+  }
+  pool.wait_idle();
+
+  // the larger tables are built from the 5 card table
+  for (std::size_t count = 6; count <= 7; ++count)
+  {
+    std::uint16_t* table = &m_storage[offsets.start[count - 4]];
+    for (int lowest = 0; lowest < 13; ++lowest)
+    {
+      pool.submit([count, five, table, lowest]() {
+        for_each_multiset_from(lowest, count, LargerTable{ count, five, table });
+      });
+    }
+  }
+  pool.wait_idle();
+
+  set_tables(m_storage.data());
+}
+
+deck_of_cards::HandEvaluator::HandEvaluator(const std::string& path, bool verify)
+  : m_storage()
+  , m_file(new MappedTableFile(path, TableFileMagic, EvaluatorTableVersion, offsets.start[4], sizeof(std::uint16_t),
+                               verify))
+  , m_tables(nullptr)
+  , m_num_entries(0)
+  , m_flush(nullptr)
+  , m_rank_tables()
+{
+  set_tables(static_cast<const std::uint16_t*>(m_file->entries()));
+}
+
+deck_of_cards::HandEvaluator::~HandEvaluator() = default;
+
+void deck_of_cards::HandEvaluator::save(const std::string& path) const
+{
+  write_table_file(path, TableFileMagic, EvaluatorTableVersion, m_tables, m_num_entries, sizeof(std::uint16_t));
+}
+
+void deck_of_cards::HandEvaluator::set_tables(const std::uint16_t* tables)
+{
+  m_tables = tables;
+  m_num_entries = offsets.start[4];
+  m_flush = tables + offsets.start[0];
+  for (std::size_t count = 5; count <= 7; ++count)
+  {
+    m_rank_tables[count] = tables + offsets.start[count - 4];
+  }
+}
+
+HandRank deck_of_cards::HandEvaluator::evaluate(CardSet cards) const
+{
+  const std::size_t count = cards.size();
+  if (count < 5 || count > 7)
+  {
+    throw std::invalid_argument("Only hands of 5 to 7 cards can be evaluated");
+  }
+
+  // with at most 7 cards only one suit can hold 5 or more
+  for (const auto suit : Suits)
+  {
+    const std::uint32_t mask = cards.suit_mask(suit);
+    if (__builtin_popcount(mask) >= 5)
+    {
+      return m_flush[to_poker_order(mask)];
+    }
+  }
+
+  std::size_t index = 0;
+  std::size_t seen = 0;
+  for (int rank = 0; rank < 13; ++rank)
+  {
+    for (int copies = __builtin_popcountll(cards.mask() & rank_bits(rank)); copies > 0; --copies)
+    {
+      index += binomials.c[rank + seen][seen + 1];
+      ++seen;
+    }
+  }
+
+  return m_rank_tables[count][index];
+}
+
+void deck_of_cards::HandEvaluator::evaluate_batch(const CardSet* hands, HandRank* ranks, std::size_t count) const
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ranks[i] = evaluate(hands[i]);
+  }
+}
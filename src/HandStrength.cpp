@@ -0,0 +1,651 @@
+#include "HandStrength.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#include "HandEvaluator.hpp"
+#include "TableFile.hpp"
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+const char TableFileMagic[8] = { 'D', 'O', 'C', 'E', 'H', 'S', 'T', '\0' };
+
+// boards per work unit of the clustering, fixed so that the merge order does not depend on the thread count
+constexpr std::size_t ClusterChunk = 64;
+
+std::size_t num_values(Street street, std::size_t num_bins) noexcept
+{
+  return 2 + (street == Street::River ? 0 : num_bins);
+}
+
+// 64 bit words of a board record: the header word, then the 16 bit values of every combination
+std::size_t record_words(Street street, std::size_t num_bins) noexcept
+{
+  return 1 + (NumCombos * num_values(street, num_bins) * sizeof(std::uint16_t) + 7) / 8;
+}
+
+// every board of a street whose suits are in canonical order, ascending by mask
+std::vector<CardSet> canonical_boards(Street street)
+{
+  CardId cards[NumCards];
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    cards[i] = static_cast<CardId>(i);
+  }
+  std::vector<CardSet> boards;
+  for_each_combination(cards, NumCards, static_cast<std::size_t>(street), [&boards](CardSet board) {
+    if (suit_canonical(board))
+    {
+      boards.push_back(board);
+    }
+  });
+  std::sort(boards.begin(), boards.end(), [](CardSet a, CardSet b) { return a.mask() < b.mask(); });
+
+  return boards;
+}
+
+std::uint16_t fixed_point(double fraction) noexcept
+{
+  return static_cast<std::uint16_t>(std::lround(fraction * 65535));
+}
+
+// computes every combination of one board into a record
+void compute_board(Street street, CardSet board, std::size_t num_bins, std::uint64_t* record)
+{
+  const std::size_t values_per_combo = num_values(street, num_bins);
+  std::vector<std::uint16_t> values(NumCombos * values_per_combo, 0);
+  std::vector<float> strengths(NumCombos);
+
+  if (street == Street::River)
+  {
+    river_strengths(board, strengths.data());
+    for (std::size_t combo = 0; combo < NumCombos; ++combo)
+    {
+      if (!combo_cards(combo).intersects(board))
+      {
+        values[combo * values_per_combo] = fixed_point(strengths[combo]);
+        values[combo * values_per_combo + 1] = fixed_point(strengths[combo] * strengths[combo]);
+      }
+    }
+  }
+  else
+  {
+    CardId cards[NumCards];
+    std::size_t num_cards = 0;
+    for (CardId card = 0; card < NumCards; ++card)
+    {
+      if (!board.contains(card))
+      {
+        cards[num_cards++] = card;
+      }
+    }
+
+    std::vector<double> sums(NumCombos, 0.0);
+    std::vector<double> squares(NumCombos, 0.0);
+    std::vector<std::uint32_t> runouts(NumCombos, 0);
+    std::vector<std::uint16_t> counts(NumCombos * num_bins, 0);
+    const auto add_runout = [&](CardSet river) {
+      river_strengths(river, strengths.data());
+      for (std::size_t combo = 0; combo < NumCombos; ++combo)
+      {
+        if (!combo_cards(combo).intersects(river))
+        {
+          const float strength = strengths[combo];
+          sums[combo] += strength;
+          squares[combo] += strength * strength;
+          ++runouts[combo];
+          ++counts[combo * num_bins + std::min(static_cast<std::size_t>(strength * num_bins), num_bins - 1)];
+        }
+      }
+    };
+
+    for (std::size_t turn = 0; turn < num_cards; ++turn)
+    {
+      CardSet with_turn = board;
+      with_turn.insert(cards[turn]);
+      if (street == Street::Turn)
+      {
+        add_runout(with_turn);
+        continue;
+      }
+      for (std::size_t river = turn + 1; river < num_cards; ++river)
+      {
+        CardSet with_river = with_turn;
+        with_river.insert(cards[river]);
+        add_runout(with_river);
+      }
+    }
+
+    for (std::size_t combo = 0; combo < NumCombos; ++combo)
+    {
+      if (runouts[combo] != 0)
+      {
+        std::uint16_t* entry = &values[combo * values_per_combo];
+        entry[0] = fixed_point(sums[combo] / runouts[combo]);
+        entry[1] = fixed_point(squares[combo] / runouts[combo]);
+        std::copy(&counts[combo * num_bins], &counts[combo * num_bins] + num_bins, entry + 2);
+      }
+    }
+  }
+
+  // the header word: done flag, then the size of the suit isomorphism class
+  record[0] = 1 | static_cast<std::uint64_t>(suit_class_size(board)) << 32;
+  std::memcpy(record + 1, values.data(), values.size() * sizeof(std::uint16_t));
+}
+
+// relabels the suits of a set: suit s becomes suit order[s]
+CardSet relabel(CardSet cards, const std::size_t* order) noexcept
+{
+  std::uint64_t mask = 0;
+  for (const auto suit : Suits)
+  {
+    mask |= static_cast<std::uint64_t>(cards.suit_mask(suit)) << (13 * order[static_cast<std::size_t>(suit)]);
+  }
+
+  return CardSet(mask);
+}
+
+}  // namespace
+
+void deck_of_cards::river_strengths(CardSet board, float* strengths)
+{
+  if (board.size() != 5)
+  {
+    throw std::invalid_argument("A river board holds five cards");
+  }
+
+  CardSet hands[NumCombos];
+  std::uint16_t combos[NumCombos];
+  std::size_t count = 0;
+  for (std::size_t combo = 0; combo < NumCombos; ++combo)
+  {
+    const CardSet hole = combo_cards(combo);
+    if (!hole.intersects(board))
+    {
+      hands[count] = hole | board;
+      combos[count++] = static_cast<std::uint16_t>(combo);
+    }
+  }
+  HandRank ranks[NumCombos];
+  HandEvaluator::instance().evaluate_batch(hands, ranks, count);
+
+  std::uint16_t order[NumCombos];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    order[i] = static_cast<std::uint16_t>(i);
+  }
+  std::sort(order, order + count, [&ranks](std::uint16_t a, std::uint16_t b) { return ranks[a] < ranks[b]; });
+
+  // sweep the hands from the weakest up: a hand beats every weaker hand except those sharing one of its cards, which
+  // the weaker hands per card count; ties work the same within a group of equal ranks, the hand itself included
+  std::uint16_t weaker[NumCards] = {};
+  std::uint16_t equal[NumCards] = {};
+  std::size_t below = 0;
+  const double opponents = (NumCards - 7) * (NumCards - 8) / 2;
+  for (std::size_t first = 0; first < count;)
+  {
+    std::size_t last = first;
+    while (last < count && ranks[order[last]] == ranks[order[first]])
+    {
+      const std::size_t combo = combos[order[last++]];
+      ++equal[combo_low_card(combo)];
+      ++equal[combo_high_card(combo)];
+    }
+    const std::size_t group = last - first;
+    for (std::size_t i = first; i < last; ++i)
+    {
+      const std::size_t combo = combos[order[i]];
+      const CardId low = combo_low_card(combo);
+      const CardId high = combo_high_card(combo);
+      const double wins = static_cast<double>(below) - weaker[low] - weaker[high];
+      const double ties = static_cast<double>(group) - equal[low] - equal[high] + 1;
+      strengths[combo] = static_cast<float>((wins + ties / 2) / opponents);
+    }
+    for (std::size_t i = first; i < last; ++i)
+    {
+      const std::size_t combo = combos[order[i]];
+      ++weaker[combo_low_card(combo)];
+      ++weaker[combo_high_card(combo)];
+      equal[combo_low_card(combo)] = 0;
+      equal[combo_high_card(combo)] = 0;
+    }
+    below += group;
+    first = last;
+  }
+}
+
+deck_of_cards::HandStrengthJob::HandStrengthJob(Street street, const Config& config)
+  : m_street(street)
+  , m_config(config)
+  , m_boards(canonical_boards(street))
+  , m_record_words(0)
+  , m_done(m_boards.size(), 0)
+  , m_data()
+  , m_file()
+{
+  if (street != Street::River && (config.num_bins == 0 || config.num_bins > 1000))
+  {
+    throw std::invalid_argument("A hand strength histogram needs between 1 and 1000 bins");
+  }
+  if (config.checkpoint_interval == 0)
+  {
+    throw std::invalid_argument("The checkpoint interval must be positive");
+  }
+
+  m_config.num_bins = street == Street::River ? 0 : config.num_bins;
+  m_record_words = record_words(street, m_config.num_bins);
+  if (m_config.path.empty())
+  {
+    m_data.assign(m_boards.size() * m_record_words, 0);
+  }
+}
+
+deck_of_cards::HandStrengthJob::~HandStrengthJob() = default;
+
+std::size_t deck_of_cards::HandStrengthJob::units_done() const noexcept
+{
+  return static_cast<std::size_t>(std::count(m_done.begin(), m_done.end(), 1));
+}
+
+bool deck_of_cards::HandStrengthJob::run()
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  const std::size_t record_bytes = m_record_words * sizeof(std::uint64_t);
+  if (!m_config.path.empty() && !m_file)
+  {
+    m_file.reset(
+      new WritableTableFile(m_config.path, TableFileMagic, HandStrengthVersion, m_boards.size(), record_bytes));
+    for (std::size_t unit = 0; unit < m_boards.size(); ++unit)
+    {
+      std::uint64_t header;
+      m_file->read(unit * record_bytes, &header, sizeof(header));
+      m_done[unit] = (header & 0xFFFFFFFF) != 0;
+    }
+  }
+
+  std::size_t units_done = this->units_done();
+  std::mutex mutex;
+  std::size_t finished = 0;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  // headers of units whose records are written but not yet known to be on storage; a header only follows its record
+  // once a flush has passed, so that after a crash or power loss a done flag never marks a record that was lost
+  std::vector<std::pair<std::size_t, std::uint64_t>> pending;
+  const auto commit = [&](const std::vector<std::pair<std::size_t, std::uint64_t>>& headers) {
+    m_file->sync();
+    for (const auto& header : headers)
+    {
+      m_file->write(header.first * record_bytes, &header.second, sizeof(header.second));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& header : headers)
+    {
+      m_done[header.first] = 1;
+    }
+  };
+  {
+    ThreadPool pool(m_config.num_threads);
+    std::size_t submitted = 0;
+    for (std::size_t unit = 0; unit < m_boards.size(); ++unit)
+    {
+      if (m_done[unit])
+      {
+        continue;
+      }
+      if (m_config.max_units != 0 && submitted == m_config.max_units)
+      {
+        break;
+      }
+      ++submitted;
+
+      pool.submit([&, unit]() {
+        try
+        {
+          std::vector<std::uint64_t> record(m_record_words, 0);
+          compute_board(m_street, m_boards[unit], m_config.num_bins, record.data());
+          const std::uint64_t header = record[0];
+          if (m_file)
+          {
+            // the header word, which marks the unit done, is held back until the next checkpoint
+            record[0] = 0;
+            m_file->write(unit * record_bytes, record.data(), record_bytes);
+          }
+          else
+          {
+            std::copy(record.begin(), record.end(), m_data.begin() + unit * m_record_words);
+          }
+
+          std::vector<std::pair<std::size_t, std::uint64_t>> checkpoint;
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (m_file)
+            {
+              pending.emplace_back(unit, header);
+              if (pending.size() == m_config.checkpoint_interval)
+              {
+                checkpoint.swap(pending);
+              }
+            }
+            else
+            {
+              m_done[unit] = 1;
+            }
+            ++units_done;
+            ++finished;
+            if (m_config.progress)
+            {
+              m_config.progress(HandStrengthProgress{ units_done, m_boards.size(),
+                                                      std::chrono::duration<double>(Clock::now() - start).count() });
+            }
+          }
+          if (!checkpoint.empty())
+          {
+            commit(checkpoint);
+          }
+        }
+        catch (...)
+        {
+          // keep the first failure, the remaining units still run but the file is not finished
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+        }
+      });
+    }
+    pool.wait_idle();
+  }
+  if (!pending.empty())
+  {
+    // the units finished since the last checkpoint are done even when others failed
+    try
+    {
+      commit(pending);
+    }
+    catch (...)
+    {
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+  if (m_file && finished > 0)
+  {
+    m_file->finish();
+  }
+
+  return units_done == m_boards.size();
+}
+
+void deck_of_cards::HandStrengthJob::save(const std::string& path) const
+{
+  if (!m_file)
+  {
+    write_table_file(path, TableFileMagic, HandStrengthVersion, m_data.data(), m_boards.size(),
+                     m_record_words * sizeof(std::uint64_t));
+    return;
+  }
+
+  // copy the job's file a chunk at a time, next to the target and renamed over it like write_table_file
+  m_file->finish();
+  if (path == m_config.path)
+  {
+    return;
+  }
+  const std::string temporary = path + ".tmp";
+  {
+    std::ifstream source(m_config.path, std::ios::binary);
+    std::ofstream target(temporary, std::ios::binary | std::ios::trunc);
+    target << source.rdbuf();
+    if (!source || !target)
+    {
+      std::remove(temporary.c_str());
+      throw std::runtime_error("Cannot write table file " + temporary);
+    }
+  }
+  if (std::rename(temporary.c_str(), path.c_str()) != 0)
+  {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("Cannot replace table file " + path);
+  }
+}
+
+deck_of_cards::HandStrengthTable::HandStrengthTable(const std::string& path, Street street, std::size_t num_bins,
+                                                    bool verify)
+  : m_file()
+  , m_num_bins(street == Street::River ? 0 : num_bins)
+  , m_boards(canonical_boards(street))
+  , m_record_words(record_words(street, m_num_bins))
+  , m_records(nullptr)
+{
+  m_file.reset(new MappedTableFile(path, TableFileMagic, HandStrengthVersion, m_boards.size(),
+                                   m_record_words * sizeof(std::uint64_t), verify));
+  m_records = static_cast<const std::uint64_t*>(m_file->entries());
+}
+
+deck_of_cards::HandStrengthTable::~HandStrengthTable() = default;
+
+std::size_t deck_of_cards::HandStrengthTable::entry(CardSet hole, CardSet board) const
+{
+  if (hole.size() != 2 || board.size() != m_boards.front().size() || hole.intersects(board))
+  {
+    throw std::invalid_argument("The hole cards or the board have the wrong size or overlap");
+  }
+
+  // the canonical board orders the suits by descending rank mask
+  std::size_t suits[4] = { 0, 1, 2, 3 };
+  std::stable_sort(suits, suits + 4, [board](std::size_t a, std::size_t b) {
+    return board.suit_mask(static_cast<Suit>(a)) > board.suit_mask(static_cast<Suit>(b));
+  });
+  std::size_t order[4];
+  for (std::size_t position = 0; position < 4; ++position)
+  {
+    order[suits[position]] = position;
+  }
+
+  const CardSet canonical = relabel(board, order);
+  const auto found = std::lower_bound(m_boards.begin(), m_boards.end(), canonical,
+                                      [](CardSet a, CardSet b) { return a.mask() < b.mask(); });
+  const std::size_t unit = static_cast<std::size_t>(found - m_boards.begin());
+  if (!computed(unit))
+  {
+    throw std::out_of_range("The board has not been computed");
+  }
+  const CardSet relabeled = relabel(hole, order);
+  const CardId low = static_cast<CardId>(__builtin_ctzll(relabeled.mask()));
+  const CardId high = static_cast<CardId>(63 - __builtin_clzll(relabeled.mask()));
+
+  return unit * NumCombos + combo_index(low, high);
+}
+
+std::vector<std::uint16_t> deck_of_cards::HandStrengthTable::cluster(std::size_t num_buckets, std::size_t iterations,
+                                                                     std::size_t num_threads) const
+{
+  if (num_buckets == 0 || num_buckets >= NoBucket)
+  {
+    throw std::invalid_argument("The number of buckets must be between 1 and 65534");
+  }
+
+  // features: the cumulative histogram normalized to 1, or the hand strength on the river
+  const std::size_t dimensions = m_num_bins == 0 ? 1 : m_num_bins;
+  const auto feature = [this](std::size_t entry, double* out) {
+    if (m_num_bins == 0)
+    {
+      out[0] = ehs(entry);
+      return;
+    }
+    const std::uint16_t* counts = histogram(entry);
+    double total = 0;
+    for (std::size_t bin = 0; bin < m_num_bins; ++bin)
+    {
+      total += counts[bin];
+      out[bin] = total;
+    }
+    for (std::size_t bin = 0; bin < m_num_bins; ++bin)
+    {
+      out[bin] /= total;
+    }
+  };
+  const auto weight = [this](std::size_t unit) { return static_cast<double>(m_records[unit * m_record_words] >> 32); };
+
+  // initial buckets: evenly spaced quantiles of the weighted EHS
+  std::vector<double> ehs_weights(65536, 0.0);
+  double total_weight = 0;
+  std::size_t num_points = 0;
+  for (std::size_t unit = 0; unit < m_boards.size(); ++unit)
+  {
+    if (!computed(unit))
+    {
+      continue;
+    }
+    for (std::size_t combo = 0; combo < NumCombos; ++combo)
+    {
+      if (!combo_cards(combo).intersects(m_boards[unit]))
+      {
+        ehs_weights[values(unit * NumCombos + combo)[0]] += weight(unit);
+        total_weight += weight(unit);
+        ++num_points;
+      }
+    }
+  }
+  if (num_buckets > num_points)
+  {
+    throw std::invalid_argument("More buckets than computed entries");
+  }
+  std::vector<std::uint16_t> quantile_buckets(65536);
+  double cumulative = 0;
+  for (std::size_t value = 0; value < 65536; ++value)
+  {
+    const double middle = (cumulative + ehs_weights[value] / 2) / total_weight;
+    const std::size_t bucket = static_cast<std::size_t>(middle * num_buckets);
+    quantile_buckets[value] = static_cast<std::uint16_t>(std::min(num_buckets - 1, bucket));
+    cumulative += ehs_weights[value];
+  }
+
+  std::vector<std::uint16_t> buckets(num_entries(), NoBucket);
+  for (std::size_t unit = 0; unit < m_boards.size(); ++unit)
+  {
+    for (std::size_t combo = 0; computed(unit) && combo < NumCombos; ++combo)
+    {
+      if (!combo_cards(combo).intersects(m_boards[unit]))
+      {
+        buckets[unit * NumCombos + combo] = quantile_buckets[values(unit * NumCombos + combo)[0]];
+      }
+    }
+  }
+
+  // Lloyd iterations: recompute the centers from the buckets, then move every entry to its nearest center
+  ThreadPool pool(num_threads);
+  const std::size_t num_chunks = (m_boards.size() + ClusterChunk - 1) / ClusterChunk;
+  std::vector<double> centers(num_buckets * dimensions, 0.0);
+  std::vector<std::vector<double>> partial_sums(num_chunks);
+  std::vector<std::vector<double>> partial_weights(num_chunks);
+  for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+  {
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      pool.submit([&, chunk]() {
+        std::vector<double>& sums = partial_sums[chunk];
+        std::vector<double>& weights = partial_weights[chunk];
+        sums.assign(num_buckets * dimensions, 0.0);
+        weights.assign(num_buckets, 0.0);
+        std::vector<double> point(dimensions);
+        const std::size_t end = std::min(m_boards.size(), (chunk + 1) * ClusterChunk);
+        for (std::size_t unit = chunk * ClusterChunk; unit < end; ++unit)
+        {
+          for (std::size_t entry = unit * NumCombos; entry < (unit + 1) * NumCombos; ++entry)
+          {
+            if (buckets[entry] == NoBucket)
+            {
+              continue;
+            }
+            feature(entry, point.data());
+            weights[buckets[entry]] += weight(unit);
+            for (std::size_t d = 0; d < dimensions; ++d)
+            {
+              sums[buckets[entry] * dimensions + d] += weight(unit) * point[d];
+            }
+          }
+        }
+      });
+    }
+    pool.wait_idle();
+
+    // merge in chunk order; an empty bucket keeps its center
+    std::vector<double> sums(num_buckets * dimensions, 0.0);
+    std::vector<double> weights(num_buckets, 0.0);
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      for (std::size_t i = 0; i < sums.size(); ++i)
+      {
+        sums[i] += partial_sums[chunk][i];
+      }
+      for (std::size_t i = 0; i < weights.size(); ++i)
+      {
+        weights[i] += partial_weights[chunk][i];
+      }
+    }
+    for (std::size_t bucket = 0; bucket < num_buckets; ++bucket)
+    {
+      for (std::size_t d = 0; weights[bucket] > 0 && d < dimensions; ++d)
+      {
+        centers[bucket * dimensions + d] = sums[bucket * dimensions + d] / weights[bucket];
+      }
+    }
+
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+    {
+      pool.submit([&, chunk]() {
+        std::vector<double> point(dimensions);
+        const std::size_t end = std::min(m_boards.size(), (chunk + 1) * ClusterChunk);
+        for (std::size_t entry = chunk * ClusterChunk * NumCombos; entry < end * NumCombos; ++entry)
+        {
+          if (buckets[entry] == NoBucket)
+          {
+            continue;
+          }
+          feature(entry, point.data());
+          std::size_t best = 0;
+          double best_distance = 0;
+          for (std::size_t bucket = 0; bucket < num_buckets; ++bucket)
+          {
+            double distance = 0;
+            for (std::size_t d = 0; d < dimensions; ++d)
+            {
+              const double difference = point[d] - centers[bucket * dimensions + d];
+              distance += difference * difference;
+            }
+            if (bucket == 0 || distance < best_distance)
+            {
+              best = bucket;
+              best_distance = distance;
+            }
+          }
+          buckets[entry] = static_cast<std::uint16_t>(best);
+        }
+      });
+    }
+    pool.wait_idle();
+  }
+
+  return buckets;
+}
@@ -0,0 +1,133 @@
+#include "HealthMonitor.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "Statistics.hpp"
+
+using namespace deck_of_cards;
+
+deck_of_cards::HealthMonitor::HealthMonitor(FailureCallback callback)
+  : HealthMonitor(std::move(callback), Config())
+{
+}
+
+deck_of_cards::HealthMonitor::HealthMonitor(FailureCallback callback, const Config& config)
+  : m_config(config)
+  , m_callback(std::move(callback))
+  , m_rct_cutoff(0)
+  , m_apt_cutoff(0)
+  , m_samples(0)
+  , m_rct_value(0)
+  , m_rct_count(0)
+  , m_apt_value(0)
+  , m_apt_count(0)
+  , m_apt_index(0)
+  , m_shuffles(0)
+  , m_window_shuffles(0)
+  , m_position_counts()
+{
+  if (!(config.min_entropy > 0.0 && config.min_entropy <= 8.0))
+  {
+    throw std::invalid_argument("min_entropy must be in (0, 8] bits per sample");
+  }
+  if (!(config.alpha > 0.0 && config.alpha < 1.0) ||
+      !(config.chi_squared_alpha > 0.0 && config.chi_squared_alpha < 1.0))
+  {
+    throw std::invalid_argument("alpha must be in (0, 1)");
+  }
+  if (config.window_size < 2 || config.check_every == 0 || config.chi_squared_window == 0)
+  {
+    throw std::invalid_argument("window sizes and check interval must be positive");
+  }
+
+  // SP 800-90B section 4.4.1: C = 1 + ceil(-log2(alpha) / H)
+  m_rct_cutoff = 1 + static_cast<std::size_t>(std::ceil(-std::log2(config.alpha) / config.min_entropy));
+  // SP 800-90B section 4.4.2: C = 1 + CRITBINOM(W, 2^-H, 1 - alpha)
+  m_apt_cutoff =
+      1 + binomial_critical_value(config.window_size, std::pow(2.0, -config.min_entropy), config.alpha);
+}
+
+bool deck_of_cards::HealthMonitor::begin_shuffle()
+{
+  if (m_shuffles++ % m_config.check_every != 0)
+  {
+    return false;
+  }
+
+  if (m_window_shuffles++ == m_config.chi_squared_window)
+  {
+    evaluate_positions();
+    m_window_shuffles = 1;
+  }
+
+  return true;
+}
+
+bool deck_of_cards::HealthMonitor::evaluate_positions()
+{
+  // the Pearson statistic of the position by card table: when shuffles are dealt only partly each dealt position is a
+  // goodness-of-fit test against the uniform distribution over cards with (NumCards - 1) degrees of freedom
+  double chi_squared = 0.0;
+  double dofs = 0.0;
+  std::size_t positions = 0;
+  std::uint64_t first_total = 0;
+  bool whole_decks = true;
+  for (auto& counts : m_position_counts)
+  {
+    std::uint64_t total = 0;
+    for (const auto count : counts)
+    {
+      total += count;
+    }
+    if (total == 0)
+    {
+      continue;
+    }
+    first_total = positions++ == 0 ? total : first_total;
+    whole_decks = whole_decks && total == first_total;
+
+    const double expected = static_cast<double>(total) / NumCards;
+    for (auto& count : counts)
+    {
+      const double delta = count - expected;
+      chi_squared += delta * delta / expected;
+      count = 0;
+    }
+    dofs += NumCards - 1;
+  }
+  m_window_shuffles = 0;
+
+  // when every shuffle was dealt out completely each card also appears once per shuffle, which fixes the card totals
+  // as well and leaves (NumCards - 1) squared degrees of freedom. Each shuffle is then a permutation rather than
+  // NumCards independent draws, so every cell is Binomial(shuffles, 1 / NumCards) and the sum has mean
+  // NumCards * (NumCards - 1); scaling by (NumCards - 1) / NumCards brings it to the chi-squared mean
+  if (positions == NumCards && whole_decks)
+  {
+    dofs = (NumCards - 1) * (NumCards - 1);
+    chi_squared *= static_cast<double>(NumCards - 1) / NumCards;
+  }
+
+  if (dofs == 0.0)
+  {
+    return true;
+  }
+
+  const double threshold = chi_squared_critical_value(dofs, m_config.chi_squared_alpha);
+  if (chi_squared >= threshold)
+  {
+    fail(HealthTest::PositionalChiSquared, chi_squared, threshold);
+    return false;
+  }
+
+  return true;
+}
+
+void deck_of_cards::HealthMonitor::fail(HealthTest test, double statistic, double threshold)
+{
+  if (m_callback)
+  {
+    m_callback(HealthFailure{ test, statistic, threshold, m_samples });
+  }
+}
@@ -0,0 +1,95 @@
+#include "KeyedPermutation.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+// one step of the splitmix64 generator
+std::uint64_t splitmix(std::uint64_t& state) noexcept
+{
+  std::uint64_t value = state += 0x9E3779B97F4A7C15ull;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+// one pass of the Feistel network over the 64 values of six bits
+unsigned encrypt(const std::uint32_t* rounds, unsigned value) noexcept
+{
+  unsigned left = value >> 3;
+  unsigned right = value & 7;
+  for (std::size_t round = 0; round < KeyedPermutationRounds; ++round)
+  {
+    const unsigned next = left ^ ((rounds[round] >> (3 * right)) & 7);
+    left = right;
+    right = next;
+  }
+
+  return left << 3 | right;
+}
+
+unsigned decrypt(const std::uint32_t* rounds, unsigned value) noexcept
+{
+  unsigned left = value >> 3;
+  unsigned right = value & 7;
+  for (std::size_t round = KeyedPermutationRounds; round > 0; --round)
+  {
+    const unsigned previous = right ^ ((rounds[round - 1] >> (3 * left)) & 7);
+    right = left;
+    left = previous;
+  }
+
+  return left << 3 | right;
+}
+
+}  // namespace
+
+deck_of_cards::KeyedPermutation::KeyedPermutation(std::uint64_t key, std::uint64_t shuffle) noexcept
+{
+  // hash the shuffle number before mixing it with the key so that neighbouring shuffles share nothing
+  std::uint64_t state = shuffle;
+  state = key ^ splitmix(state);
+  splitmix(state);
+  for (std::size_t round = 0; round < KeyedPermutationRounds; round += 2)
+  {
+    const std::uint64_t bits = splitmix(state);
+    m_rounds[round] = static_cast<std::uint32_t>(bits & 0xFFFFFF);
+    m_rounds[round + 1] = static_cast<std::uint32_t>((bits >> 24) & 0xFFFFFF);
+  }
+}
+
+CardId deck_of_cards::KeyedPermutation::card_at(std::size_t position) const noexcept
+{
+  // the cycle of a value below NumCards always returns below NumCards, so the walk ends
+  unsigned value = static_cast<unsigned>(position);
+  do
+  {
+    value = encrypt(m_rounds, value);
+  } while (value >= NumCards);
+
+  return static_cast<CardId>(value);
+}
+
+std::size_t deck_of_cards::KeyedPermutation::position_of(CardId card) const noexcept
+{
+  unsigned value = card;
+  do
+  {
+    value = decrypt(m_rounds, value);
+  } while (value >= NumCards);
+
+  return value;
+}
+
+void deck_of_cards::KeyedPermutation::order(CardId* cards) const noexcept
+{
+  for (std::size_t position = 0; position < NumCards; ++position)
+  {
+    cards[position] = card_at(position);
+  }
+}
+
+CardId deck_of_cards::card_at(std::uint64_t key, std::uint64_t shuffle, std::size_t position) noexcept
+{
+  return KeyedPermutation(key, shuffle).card_at(position);
+}
@@ -0,0 +1,212 @@
+#include "PackedDeck.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace deck_of_cards;
+
+namespace
+{
+// every group of four cards occupies three bytes: v = c0 | c1 << 6 | c2 << 12 | c3 << 18, stored little-endian
+constexpr std::size_t GroupCards = 4;
+constexpr std::size_t GroupBytes = 3;
+
+void unpack_group(const std::uint8_t* packed, CardId* cards) noexcept
+{
+  const std::uint32_t v = packed[0] | (packed[1] << 8) | (packed[2] << 16);
+  for (std::size_t i = 0; i < GroupCards; ++i)
+  {
+    cards[i] = static_cast<CardId>((v >> (6 * i)) & 0x3F);
+  }
+}
+
+void pack_group(const CardId* cards, std::uint8_t* packed) noexcept
+{
+  const std::uint32_t v = cards[0] | (cards[1] << 6) | (cards[2] << 12) | (cards[3] << 18);
+  packed[0] = static_cast<std::uint8_t>(v);
+  packed[1] = static_cast<std::uint8_t>(v >> 8);
+  packed[2] = static_cast<std::uint8_t>(v >> 16);
+}
+
+#if defined(__SSE2__)
+// number of cards handled by one vector, four groups in four 32 bit lanes
+constexpr std::size_t VectorCards = 16;
+
+std::uint32_t load24(const std::uint8_t* bytes) noexcept
+{
+  return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+}
+
+void unpack_vector(const std::uint8_t* packed, CardId* cards) noexcept
+{
+  const __m128i v = _mm_set_epi32(load24(packed + 9), load24(packed + 6), load24(packed + 3), load24(packed));
+
+  // move card k of every lane from bit 6k to bit 8k
+  const __m128i c0 = _mm_and_si128(v, _mm_set1_epi32(0x3F));
+  const __m128i c1 = _mm_and_si128(_mm_slli_epi32(v, 2), _mm_set1_epi32(0x3F00));
+  const __m128i c2 = _mm_and_si128(_mm_slli_epi32(v, 4), _mm_set1_epi32(0x3F0000));
+  const __m128i c3 = _mm_and_si128(_mm_slli_epi32(v, 6), _mm_set1_epi32(0x3F000000));
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(cards),
+                   _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3)));
+}
+
+void pack_vector(const CardId* cards, std::uint8_t* packed) noexcept
+{
+  const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cards));
+
+  // move card k of every lane from bit 8k to bit 6k
+  const __m128i c0 = _mm_and_si128(c, _mm_set1_epi32(0x3F));
+  const __m128i c1 = _mm_and_si128(_mm_srli_epi32(c, 2), _mm_set1_epi32(0xFC0));
+  const __m128i c2 = _mm_and_si128(_mm_srli_epi32(c, 4), _mm_set1_epi32(0x3F000));
+  const __m128i c3 = _mm_and_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0xFC0000));
+
+  std::uint32_t lanes[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3)));
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    std::memcpy(packed + i * GroupBytes, &lanes[i], GroupBytes);  // little-endian
+  }
+}
+#endif
+
+// the packed order of a freshly reset deck
+struct IdentityOrder
+{
+  IdentityOrder()
+  {
+    CardId cards[NumCards];
+    for (std::size_t i = 0; i < NumCards; ++i)
+    {
+      cards[i] = static_cast<CardId>(i);
+    }
+    pack_order(cards, packed);
+  }
+
+  std::uint8_t packed[PackedOrderBytes];
+};
+
+const IdentityOrder& identity_order()
+{
+  static const IdentityOrder order;
+  return order;
+}
+
+}  // namespace
+
+std::shared_ptr<Card> deck_of_cards::card_from_id(CardId card)
+{
+  static const std::vector<std::shared_ptr<Card>> cards = []() {
+    std::vector<std::shared_ptr<Card>> all;
+    for (const auto suit : Suits)
+    {
+      for (const auto value : Values)
+      {
+        all.push_back(std::make_shared<Card>(suit, value));
+      }
+    }
+    return all;
+  }();
+
+  return cards[card];
+}
+
+void deck_of_cards::unpack_order(const std::uint8_t* packed, CardId* cards) noexcept
+{
+  std::size_t card = 0;
+#if defined(__SSE2__)
+  for (; card + VectorCards <= NumCards; card += VectorCards)
+  {
+    unpack_vector(packed + card / GroupCards * GroupBytes, cards + card);
+  }
+#endif
+  for (; card < NumCards; card += GroupCards)
+  {
+    unpack_group(packed + card / GroupCards * GroupBytes, cards + card);
+  }
+}
+
+void deck_of_cards::pack_order(const CardId* cards, std::uint8_t* packed) noexcept
+{
+  std::size_t card = 0;
+#if defined(__SSE2__)
+  for (; card + VectorCards <= NumCards; card += VectorCards)
+  {
+    pack_vector(cards + card, packed + card / GroupCards * GroupBytes);
+  }
+#endif
+  for (; card < NumCards; card += GroupCards)
+  {
+    pack_group(cards + card, packed + card / GroupCards * GroupBytes);
+  }
+}
+
+deck_of_cards::PackedDeck::PackedDeck() noexcept
+{
+  reset();
+}
+
+void deck_of_cards::PackedDeck::reset() noexcept
+{
+  std::memcpy(m_packed, identity_order().packed, PackedOrderBytes);
+  m_cursor = 0;
+}
+
+void deck_of_cards::PackedDeck::shuffle()
+{
+  int (*generator)() = &rand;
+  shuffle(generator);
+}
+
+std::shared_ptr<Card> deck_of_cards::PackedDeck::deal_card()
+{
+  if (m_cursor == NumCards)
+  {
+    return nullptr;
+  }
+
+  return card_from_id(card_at(m_cursor++));
+}
+
+std::size_t deck_of_cards::PackedDeck::deal_cards(CardId* cards, std::size_t count) noexcept
+{
+  const std::size_t dealt = count < num_cards() ? count : num_cards();
+  for (std::size_t i = 0; i < dealt; ++i)
+  {
+    cards[i] = card_at(m_cursor + i);
+  }
+  m_cursor = static_cast<std::uint8_t>(m_cursor + dealt);
+
+  return dealt;
+}
+
+CardSet deck_of_cards::PackedDeck::undealt() const noexcept
+{
+  CardId cards[NumCards];
+  unpack_order(m_packed, cards);
+
+  return CardSet(cards + m_cursor, NumCards - m_cursor);
+}
+
+void deck_of_cards::PackedDeck::permute(const Permutation& permutation) noexcept
+{
+  CardId cards[NumCards];
+  unpack_order(m_packed, cards);
+  apply(permutation, cards, cards);
+  pack_order(cards, m_packed);
+  m_cursor = 0;
+}
+
+void deck_of_cards::undealt_cards(const PackedDeck* decks, std::size_t count, CardSet* undealt) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    undealt[i] = decks[i].undealt();
+  }
+}
@@ -0,0 +1,178 @@
+#include "PageBuffer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace deck_of_cards;
+
+namespace
+{
+std::size_t round_up(std::size_t bytes, std::size_t granularity)
+{
+  return (bytes + granularity - 1) / granularity * granularity;
+}
+
+#if defined(__linux__)
+std::size_t small_page_size()
+{
+  static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+void* map_anonymous(std::size_t bytes, int extra_flags)
+{
+  void* data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  return data == MAP_FAILED ? nullptr : data;
+}
+
+// maps bytes (a multiple of HugePageSize) at a HugePageSize aligned address by trimming an oversized mapping
+void* map_huge_aligned(std::size_t bytes)
+{
+  const std::size_t padded = bytes + HugePageSize;
+  char* raw = static_cast<char*>(map_anonymous(padded, 0));
+  if (raw == nullptr)
+  {
+    return nullptr;
+  }
+
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+  char* aligned = raw + (round_up(address, HugePageSize) - address);
+  if (aligned > raw)
+  {
+    munmap(raw, aligned - raw);
+  }
+  const std::size_t tail = (raw + padded) - (aligned + bytes);
+  if (tail > 0)
+  {
+    munmap(aligned + bytes, tail);
+  }
+
+  return aligned;
+}
+#endif
+
+}  // namespace
+
+deck_of_cards::PageBuffer::PageBuffer() noexcept
+  : m_data(nullptr)
+  , m_size(0)
+  , m_mode(PageMode::Default)
+{
+}
+
+deck_of_cards::PageBuffer::PageBuffer(std::size_t bytes, PageMode mode)
+  : PageBuffer()
+{
+  if (bytes == 0)
+  {
+    return;
+  }
+
+#if defined(__linux__)
+  if (mode == PageMode::Explicit)
+  {
+    const std::size_t size = round_up(bytes, HugePageSize);
+    m_data = map_anonymous(size, MAP_HUGETLB);
+    if (m_data != nullptr)
+    {
+      m_size = size;
+      m_mode = PageMode::Explicit;
+      return;
+    }
+    // the reserved pool is empty or too small
+    mode = PageMode::Transparent;
+  }
+
+#if defined(MADV_HUGEPAGE)
+  if (mode == PageMode::Transparent)
+  {
+    const std::size_t size = round_up(bytes, HugePageSize);
+    m_data = map_huge_aligned(size);
+    if (m_data != nullptr && madvise(m_data, size, MADV_HUGEPAGE) == 0)
+    {
+      m_size = size;
+      m_mode = PageMode::Transparent;
+      return;
+    }
+    if (m_data != nullptr)
+    {
+      munmap(m_data, size);
+      m_data = nullptr;
+    }
+  }
+#endif
+
+  const std::size_t size = round_up(bytes, small_page_size());
+  m_data = map_anonymous(size, 0);
+  if (m_data == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  m_size = size;
+  m_mode = PageMode::Default;
+#if defined(MADV_NOHUGEPAGE)
+  // keep a system wide "always" THP policy from silently turning this into a huge page buffer
+  madvise(m_data, size, MADV_NOHUGEPAGE);
+#endif
+#else
+  (void)mode;
+  const std::size_t size = round_up(bytes, 4096);
+  m_data = std::calloc(size, 1);
+  if (m_data == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  m_size = size;
+#endif
+}
+
+deck_of_cards::PageBuffer::PageBuffer(PageBuffer&& other) noexcept
+  : m_data(other.m_data)
+  , m_size(other.m_size)
+  , m_mode(other.m_mode)
+{
+  other.m_data = nullptr;
+  other.m_size = 0;
+}
+
+deck_of_cards::PageBuffer::~PageBuffer()
+{
+  release();
+}
+
+PageBuffer& deck_of_cards::PageBuffer::operator=(PageBuffer&& other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_mode = other.m_mode;
+    other.m_data = nullptr;
+    other.m_size = 0;
+  }
+
+  return *this;
+}
+
+void deck_of_cards::PageBuffer::release() noexcept
+{
+  if (m_data == nullptr)
+  {
+    return;
+  }
+
+#if defined(__linux__)
+  munmap(m_data, m_size);
+#else
+  std::free(m_data);
+#endif
+  m_data = nullptr;
+  m_size = 0;
+}
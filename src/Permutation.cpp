@@ -0,0 +1,204 @@
+#include "Permutation.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX512VBMI__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+using namespace deck_of_cards;
+
+namespace
+{
+#if defined(__AVX512VBMI__)
+// the bytes of a line holding the cards of an order
+constexpr __mmask64 CardMask = (1ull << NumCards) - 1;
+#elif defined(__SSSE3__)
+// result[i] = table[indices[i]] for 64 bytes held in four quarters: pshufb looks up 16 bytes and zeroes the lanes
+// whose index has the high bit set, and adding 0x70 with saturation keeps the indices of the wanted quarter in 0x70
+// to 0x7F while pushing every other one to 0x80 or above
+void gather_quarters(const __m128i* table, const std::uint8_t* indices, __m128i* result) noexcept
+{
+  const __m128i bias = _mm_set1_epi8(0x70);
+  for (std::size_t chunk = 0; chunk < 4; ++chunk)
+  {
+    const __m128i chunk_indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + 16 * chunk));
+    result[chunk] = _mm_setzero_si128();
+    for (std::size_t quarter = 0; quarter < 4; ++quarter)
+    {
+      const __m128i local = _mm_sub_epi8(chunk_indices, _mm_set1_epi8(static_cast<char>(16 * quarter)));
+      result[chunk] = _mm_or_si128(result[chunk], _mm_shuffle_epi8(table[quarter], _mm_adds_epu8(local, bias)));
+    }
+  }
+}
+#endif
+
+// result[i] = table[indices[i]] for the PermutationBytes bytes of a line, every index below PermutationBytes; result
+// may alias table
+void gather_line(const std::uint8_t* table, const std::uint8_t* indices, std::uint8_t* result) noexcept
+{
+#if defined(__AVX512VBMI__)
+  const __m512i gathered = _mm512_permutexvar_epi8(_mm512_loadu_si512(indices), _mm512_loadu_si512(table));
+  _mm512_storeu_si512(result, gathered);
+#elif defined(__SSSE3__)
+  __m128i quarters[4];
+  for (std::size_t quarter = 0; quarter < 4; ++quarter)
+  {
+    quarters[quarter] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * quarter));
+  }
+  __m128i gathered[4];
+  gather_quarters(quarters, indices, gathered);
+  for (std::size_t chunk = 0; chunk < 4; ++chunk)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(result + 16 * chunk), gathered[chunk]);
+  }
+#else
+  std::uint8_t gathered[PermutationBytes];
+  for (std::size_t i = 0; i < PermutationBytes; ++i)
+  {
+    gathered[i] = table[indices[i]];
+  }
+  std::memcpy(result, gathered, PermutationBytes);
+#endif
+}
+
+}  // namespace
+
+deck_of_cards::Permutation::Permutation() noexcept
+{
+  for (std::size_t i = 0; i < PermutationBytes; ++i)
+  {
+    m_sources[i] = static_cast<std::uint8_t>(i);
+  }
+}
+
+deck_of_cards::Permutation::Permutation(const std::uint8_t* sources)
+  : Permutation()
+{
+  bool seen[NumCards] = {};
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    if (sources[i] >= NumCards || seen[sources[i]])
+    {
+      throw std::invalid_argument("The source positions are not a permutation of the deck");
+    }
+    seen[sources[i]] = true;
+    m_sources[i] = sources[i];
+  }
+}
+
+Permutation deck_of_cards::Permutation::between(const CardId* before, const CardId* after)
+{
+  std::uint8_t positions[NumCards];
+  bool seen[NumCards] = {};
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    if (before[i] >= NumCards || seen[before[i]])
+    {
+      throw std::invalid_argument("The order before does not hold every card once");
+    }
+    seen[before[i]] = true;
+    positions[before[i]] = static_cast<std::uint8_t>(i);
+  }
+
+  Permutation permutation;
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    if (after[i] >= NumCards || !seen[after[i]])
+    {
+      throw std::invalid_argument("The order after does not hold every card once");
+    }
+    seen[after[i]] = false;
+    permutation.m_sources[i] = positions[after[i]];
+  }
+
+  return permutation;
+}
+
+Permutation deck_of_cards::Permutation::cut(std::size_t position) noexcept
+{
+  Permutation permutation;
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    permutation.m_sources[i] = static_cast<std::uint8_t>((i + position) % NumCards);
+  }
+
+  return permutation;
+}
+
+Permutation deck_of_cards::Permutation::faro(bool out) noexcept
+{
+  constexpr std::size_t Half = NumCards / 2;
+  Permutation permutation;
+  for (std::size_t i = 0; i < Half; ++i)
+  {
+    permutation.m_sources[2 * i] = static_cast<std::uint8_t>(out ? i : Half + i);
+    permutation.m_sources[2 * i + 1] = static_cast<std::uint8_t>(out ? Half + i : i);
+  }
+
+  return permutation;
+}
+
+Permutation deck_of_cards::Permutation::inverse() const noexcept
+{
+  Permutation inverse;
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    inverse.m_sources[m_sources[i]] = static_cast<std::uint8_t>(i);
+  }
+
+  return inverse;
+}
+
+bool deck_of_cards::Permutation::operator==(const Permutation& other) const noexcept
+{
+  return std::memcmp(m_sources, other.m_sources, PermutationBytes) == 0;
+}
+
+void deck_of_cards::apply(const Permutation& permutation, const CardId* cards, CardId* result) noexcept
+{
+  // an order is only NumCards bytes long, so the vector kernels load and store its tail separately
+#if defined(__AVX512VBMI__)
+  const __m512i table = _mm512_maskz_loadu_epi8(CardMask, cards);
+  _mm512_mask_storeu_epi8(result, CardMask, _mm512_permutexvar_epi8(_mm512_loadu_si512(permutation.data()), table));
+#elif defined(__SSSE3__)
+  std::uint32_t tail;
+  std::memcpy(&tail, cards + 48, sizeof(tail));
+  const __m128i table[4] = { _mm_loadu_si128(reinterpret_cast<const __m128i*>(cards)),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(cards + 16)),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(cards + 32)),
+                             _mm_cvtsi32_si128(static_cast<int>(tail)) };
+  __m128i gathered[4];
+  gather_quarters(table, permutation.data(), gathered);
+  for (std::size_t chunk = 0; chunk < 3; ++chunk)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(result + 16 * chunk), gathered[chunk]);
+  }
+  tail = static_cast<std::uint32_t>(_mm_cvtsi128_si32(gathered[3]));
+  std::memcpy(result + 48, &tail, sizeof(tail));
+#else
+  CardId gathered[NumCards];
+  for (std::size_t i = 0; i < NumCards; ++i)
+  {
+    gathered[i] = cards[permutation[i]];
+  }
+  std::memcpy(result, gathered, NumCards);
+#endif
+}
+
+void deck_of_cards::apply_line(const Permutation& permutation, std::uint8_t* line) noexcept
+{
+  gather_line(line, permutation.data(), line);
+}
+
+Permutation deck_of_cards::compose(const Permutation& first, const Permutation& second) noexcept
+{
+  // applying first then second takes the card at first[second[i]]; starting from a copy rather than the identity
+  // saves a call
+  Permutation composed(second);
+  gather_line(first.m_sources, composed.m_sources, composed.m_sources);
+  return composed;
+}
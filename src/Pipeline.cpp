@@ -0,0 +1,271 @@
+#include "Pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "CardSet.hpp"
+#include "SpscQueue.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// blocks until the queue has a free slot, charging the wait to stats
+template <typename T>
+T* wait_push(SpscQueue<T>& queue, StageStats& stats)
+{
+  T* slot = queue.begin_push();
+  if (slot == nullptr)
+  {
+    const auto start = Clock::now();
+    while ((slot = queue.begin_push()) == nullptr)
+    {
+      std::this_thread::yield();
+    }
+    stats.stall_seconds += seconds_since(start);
+  }
+
+  return slot;
+}
+
+// blocks until the queue has a value, charging the wait to stats
+template <typename T>
+T* wait_front(SpscQueue<T>& queue, StageStats& stats)
+{
+  T* slot = queue.front();
+  if (slot == nullptr)
+  {
+    const auto start = Clock::now();
+    while ((slot = queue.front()) == nullptr)
+    {
+      std::this_thread::yield();
+    }
+    stats.stall_seconds += seconds_since(start);
+  }
+
+  return slot;
+}
+
+void accumulate(StageStats& total, const StageStats& part)
+{
+  total.batches += part.batches;
+  total.hands += part.hands;
+  total.busy_seconds += part.busy_seconds;
+  total.stall_seconds += part.stall_seconds;
+}
+
+struct Lane
+{
+  Lane(std::size_t capacity, std::uint64_t hands, std::uint64_t seed, std::size_t index)
+    : state{ PackedDeck(), TableGenerator(seed, index) }
+    , cards(capacity)
+    , ranks(capacity)
+    , num_hands(hands)
+    , deal()
+    , evaluate()
+    , done(false)
+  {
+  }
+
+  TableState state;            // owned by the dealing thread
+  SpscQueue<CardBatch> cards;  // dealing -> evaluation
+  SpscQueue<RankBatch> ranks;  // evaluation -> aggregation
+  std::uint64_t num_hands;     // hands this lane deals
+  StageStats deal;             // written by the dealing thread only
+  StageStats evaluate;         // written by the evaluation thread only
+  bool done;                   // read and written by the aggregating thread only
+};
+
+}  // namespace
+
+deck_of_cards::Pipeline::Pipeline(const Config& config, AggregateStage aggregate)
+  : Pipeline(config, &Pipeline::evaluate_hands, std::move(aggregate))
+{
+  if (config.cards_per_hand < 5)
+  {
+    throw std::invalid_argument("pipeline hands must hold 5 to MaxHandCards cards for the default evaluate stage");
+  }
+}
+
+deck_of_cards::Pipeline::Pipeline(const Config& config, EvaluateStage evaluate, AggregateStage aggregate)
+  : m_config(config)
+  , m_deal(&Pipeline::deal_hands)
+  , m_evaluate(std::move(evaluate))
+  , m_aggregate(std::move(aggregate))
+{
+  if (config.lanes == 0 || config.batch_size == 0 || config.batch_size > MaxBatchHands)
+  {
+    throw std::invalid_argument("pipeline needs at least one lane and a batch size of 1 to MaxBatchHands");
+  }
+  if (config.cards_per_hand == 0 || config.cards_per_hand > MaxHandCards)
+  {
+    throw std::invalid_argument("pipeline hands must hold 1 to MaxHandCards cards");
+  }
+  if (config.queue_capacity == 0 || (config.queue_capacity & (config.queue_capacity - 1)) != 0)
+  {
+    throw std::invalid_argument("pipeline queue capacity must be a power of two");
+  }
+}
+
+PipelineStats deck_of_cards::Pipeline::run(std::uint64_t num_hands)
+{
+  // the stages run on threads without a handler, so the evaluator must not get the chance to throw there
+  using EvaluateFunction = void (*)(const CardBatch&, RankBatch&);
+  const EvaluateFunction* evaluate = m_evaluate.target<EvaluateFunction>();
+  if (evaluate != nullptr && *evaluate == &Pipeline::evaluate_hands && m_config.cards_per_hand < 5)
+  {
+    throw std::invalid_argument("pipeline hands must hold 5 to MaxHandCards cards for the default evaluate stage");
+  }
+
+  const auto start = Clock::now();
+
+  std::vector<std::unique_ptr<Lane>> lanes;
+  for (std::size_t i = 0; i < m_config.lanes; ++i)
+  {
+    const std::uint64_t share = num_hands / m_config.lanes + (i < num_hands % m_config.lanes ? 1 : 0);
+    lanes.emplace_back(new Lane(m_config.queue_capacity, share, m_config.seed, i));
+  }
+
+  std::vector<std::thread> threads;
+  for (auto& lane_ptr : lanes)
+  {
+    Lane& lane = *lane_ptr;
+
+    threads.emplace_back([this, &lane]() {
+      std::uint64_t remaining = lane.num_hands;
+      do
+      {
+        CardBatch& batch = *wait_push(lane.cards, lane.deal);
+        batch.num_hands = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, m_config.batch_size));
+        batch.cards_per_hand = m_config.cards_per_hand;
+        if (batch.num_hands > 0)
+        {
+          const auto busy = Clock::now();
+          m_deal(lane.state, batch);
+          lane.deal.busy_seconds += seconds_since(busy);
+          lane.deal.batches++;
+          lane.deal.hands += batch.num_hands;
+        }
+        remaining -= batch.num_hands;
+        lane.cards.commit_push();
+      } while (remaining > 0);
+
+      // an empty batch tells the next stage the stream has ended, unless the last batch already was empty
+      if (lane.num_hands > 0)
+      {
+        wait_push(lane.cards, lane.deal)->num_hands = 0;
+        lane.cards.commit_push();
+      }
+    });
+
+    threads.emplace_back([this, &lane]() {
+      while (true)
+      {
+        const CardBatch& cards = *wait_front(lane.cards, lane.evaluate);
+        RankBatch& ranks = *wait_push(lane.ranks, lane.evaluate);
+        ranks.num_hands = cards.num_hands;
+        if (cards.num_hands == 0)
+        {
+          lane.ranks.commit_push();
+          lane.cards.pop();
+          return;
+        }
+
+        const auto busy = Clock::now();
+        m_evaluate(cards, ranks);
+        lane.evaluate.busy_seconds += seconds_since(busy);
+        lane.evaluate.batches++;
+        lane.evaluate.hands += cards.num_hands;
+        lane.ranks.commit_push();
+        lane.cards.pop();
+      }
+    });
+  }
+
+  // aggregate on this thread, visiting the lanes round-robin
+  PipelineStats stats = {};
+  std::size_t running = lanes.size();
+  while (running > 0)
+  {
+    bool progressed = false;
+    for (auto& lane : lanes)
+    {
+      if (lane->done)
+      {
+        continue;
+      }
+
+      const RankBatch* ranks = lane->ranks.front();
+      if (ranks == nullptr)
+      {
+        continue;
+      }
+      progressed = true;
+
+      if (ranks->num_hands == 0)
+      {
+        lane->done = true;
+        --running;
+      }
+      else
+      {
+        const auto busy = Clock::now();
+        m_aggregate(*ranks);
+        stats.aggregate.busy_seconds += seconds_since(busy);
+        stats.aggregate.batches++;
+        stats.aggregate.hands += ranks->num_hands;
+      }
+      lane->ranks.pop();
+    }
+
+    if (!progressed)
+    {
+      const auto stall = Clock::now();
+      std::this_thread::yield();
+      stats.aggregate.stall_seconds += seconds_since(stall);
+    }
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  for (const auto& lane : lanes)
+  {
+    accumulate(stats.deal, lane->deal);
+    accumulate(stats.evaluate, lane->evaluate);
+  }
+  stats.wall_seconds = seconds_since(start);
+
+  return stats;
+}
+
+void deck_of_cards::Pipeline::deal_hands(TableState& lane, CardBatch& batch)
+{
+  for (std::size_t hand = 0; hand < batch.num_hands; ++hand)
+  {
+    lane.deck.reset();
+    lane.shuffle();
+    lane.deck.deal_cards(batch.cards + hand * batch.cards_per_hand, batch.cards_per_hand);
+  }
+}
+
+void deck_of_cards::Pipeline::evaluate_hands(const CardBatch& cards, RankBatch& ranks)
+{
+  const HandEvaluator& evaluator = HandEvaluator::instance();
+  for (std::size_t hand = 0; hand < cards.num_hands; ++hand)
+  {
+    ranks.ranks[hand] = evaluator.evaluate(CardSet(cards.hand(hand), cards.cards_per_hand));
+  }
+}
@@ -0,0 +1,261 @@
+#include "PreflopEquity.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "FairnessMonitor.hpp"
+#include "HandEvaluator.hpp"
+#include "TableFile.hpp"
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+const char TableFileMagic[8] = { 'D', 'O', 'C', 'P', 'F', 'E', 'Q', '\0' };
+
+constexpr std::size_t NumCombosSquared = NumCombos * NumCombos;
+constexpr std::size_t NumClassesSquared = NumStartingHands * NumStartingHands;
+constexpr std::size_t NumEntries = NumCombosSquared + NumClassesSquared;
+constexpr std::uint16_t CertainWin = 65535;
+constexpr std::size_t NumSuitPermutations = 24;
+
+struct Tally
+{
+  const HandEvaluator& evaluator;
+  CardSet hero;
+  CardSet villain;
+  std::uint64_t wins;
+  std::uint64_t ties;
+  std::uint64_t boards;
+};
+
+// evaluates both hands on every way of drawing `count` more board cards from `remaining`
+void tally_runouts(std::uint64_t remaining, std::size_t count, CardSet board, Tally& tally)
+{
+  if (count == 0)
+  {
+    const HandRank hero = tally.evaluator.evaluate(board | tally.hero);
+    const HandRank villain = tally.evaluator.evaluate(board | tally.villain);
+    tally.wins += hero > villain;
+    tally.ties += hero == villain;
+    ++tally.boards;
+    return;
+  }
+
+  while (remaining != 0)
+  {
+    const std::uint64_t card = remaining & (~remaining + 1);
+    remaining ^= card;
+    // only later cards, so every board is drawn once
+    tally_runouts(remaining, count - 1, board | CardSet(card), tally);
+  }
+}
+
+// every combination under every relabeling of the suits
+struct ComboPermutations
+{
+  ComboPermutations()
+  {
+    int suits[4] = { 0, 1, 2, 3 };
+    std::size_t permutation = 0;
+    do
+    {
+      for (std::size_t combo = 0; combo < NumCombos; ++combo)
+      {
+        const CardId low = combo_low_card(combo);
+        const CardId high = combo_high_card(combo);
+        const CardId mapped_low = static_cast<CardId>(suits[low / 13] * 13 + low % 13);
+        const CardId mapped_high = static_cast<CardId>(suits[high / 13] * 13 + high % 13);
+        combos[permutation][combo] = static_cast<std::uint16_t>(combo_index(mapped_low, mapped_high));
+      }
+      ++permutation;
+    } while (std::next_permutation(suits, suits + 4));
+  }
+
+  std::uint16_t combos[NumSuitPermutations][NumCombos];
+};
+
+// smallest hero * NumCombos + villain over all suit relabelings and both seatings of a matchup
+std::uint32_t canonical_matchup(const ComboPermutations& permutations, std::size_t first, std::size_t second,
+                                bool& swapped)
+{
+  std::uint32_t best = NumCombosSquared;
+  swapped = false;
+  for (std::size_t permutation = 0; permutation < NumSuitPermutations; ++permutation)
+  {
+    const std::uint32_t x = permutations.combos[permutation][first];
+    const std::uint32_t y = permutations.combos[permutation][second];
+    const std::uint32_t straight = x * NumCombos + y;
+    const std::uint32_t reversed = y * NumCombos + x;
+    if (straight < best)
+    {
+      best = straight;
+      swapped = false;
+    }
+    if (reversed < best)
+    {
+      best = reversed;
+      swapped = true;
+    }
+  }
+
+  return best;
+}
+
+}  // namespace
+
+double deck_of_cards::heads_up_equity(CardSet hero, CardSet villain, CardSet board)
+{
+  if (hero.intersects(villain) || hero.intersects(board) || villain.intersects(board) || board.size() > 5)
+  {
+    throw std::invalid_argument("Hands and board must not share cards, and the board holds at most 5 cards");
+  }
+
+  Tally tally{ HandEvaluator::instance(), hero, villain, 0, 0, 0 };
+  const CardSet remaining = CardSet::full() - hero - villain - board;
+  tally_runouts(remaining.mask(), 5 - board.size(), board, tally);
+  if (tally.boards == 0)
+  {
+    throw std::invalid_argument("Not enough cards left to complete the board");
+  }
+
+  return (tally.wins + 0.5 * tally.ties) / tally.boards;
+}
+
+deck_of_cards::PreflopEquityTable::PreflopEquityTable(std::size_t num_threads, EquityFunction equity)
+  : m_storage(NumEntries, 0)
+  , m_file()
+  , m_combos(nullptr)
+  , m_classes(nullptr)
+  , m_num_matchup_classes(0)
+{
+  if (!equity)
+  {
+    equity = [](CardSet hero, CardSet villain) { return heads_up_equity(hero, villain); };
+  }
+
+  // group the matchups of two different combinations by suit isomorphism
+  std::unique_ptr<ComboPermutations> permutations(new ComboPermutations());
+  std::unordered_map<std::uint32_t, std::uint32_t> class_of_key;
+  std::vector<std::uint32_t> class_keys;
+  std::vector<std::uint32_t> pair_classes(NumCombosSquared, 0);  // class << 1 | swapped, for first < second
+  for (std::size_t first = 0; first < NumCombos; ++first)
+  {
+    for (std::size_t second = first + 1; second < NumCombos; ++second)
+    {
+      if (combo_cards(first).intersects(combo_cards(second)))
+      {
+        continue;
+      }
+      bool swapped;
+      const std::uint32_t key = canonical_matchup(*permutations, first, second, swapped);
+      const auto inserted = class_of_key.insert(std::make_pair(key, static_cast<std::uint32_t>(class_keys.size())));
+      if (inserted.second)
+      {
+        class_keys.push_back(key);
+      }
+      pair_classes[first * NumCombos + second] = inserted.first->second << 1 | (swapped ? 1 : 0);
+    }
+  }
+  m_num_matchup_classes = class_keys.size();
+
+  // one exact computation per class
+  std::vector<std::uint16_t> class_equities(class_keys.size());
+  {
+    ThreadPool pool(num_threads);
+    const std::size_t chunk = 64;
+    for (std::size_t begin = 0; begin < class_keys.size(); begin += chunk)
+    {
+      const std::size_t end = std::min(begin + chunk, class_keys.size());
+      pool.submit([&class_keys, &class_equities, &equity, begin, end]() {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          const double value = equity(combo_cards(class_keys[i] / NumCombos), combo_cards(class_keys[i] % NumCombos));
+          class_equities[i] = static_cast<std::uint16_t>(std::lround(value * CertainWin));
+        }
+      });
+    }
+    pool.wait_idle();
+  }
+
+  // every matchup from its class, the reverse seating getting the complement so the two always sum to one
+  std::uint16_t* combos = m_storage.data();
+  for (std::size_t first = 0; first < NumCombos; ++first)
+  {
+    for (std::size_t second = first + 1; second < NumCombos; ++second)
+    {
+      if (combo_cards(first).intersects(combo_cards(second)))
+      {
+        continue;
+      }
+      const std::uint32_t entry = pair_classes[first * NumCombos + second];
+      const std::uint16_t value = class_equities[entry >> 1];
+      const bool swapped = (entry & 1) != 0;
+      combos[first * NumCombos + second] = swapped ? static_cast<std::uint16_t>(CertainWin - value) : value;
+      combos[second * NumCombos + first] = swapped ? value : static_cast<std::uint16_t>(CertainWin - value);
+    }
+  }
+
+  // starting hand classes, averaging over the compatible combinations
+  std::vector<double> sums(NumClassesSquared, 0);
+  std::vector<std::uint32_t> counts(NumClassesSquared, 0);
+  for (std::size_t hero = 0; hero < NumCombos; ++hero)
+  {
+    const std::size_t hero_class = starting_hand_class(combo_low_card(hero), combo_high_card(hero));
+    for (std::size_t villain = 0; villain < NumCombos; ++villain)
+    {
+      if (combo_cards(hero).intersects(combo_cards(villain)))
+      {
+        continue;
+      }
+      const std::size_t index =
+        hero_class * NumStartingHands + starting_hand_class(combo_low_card(villain), combo_high_card(villain));
+      sums[index] += combos[hero * NumCombos + villain];
+      ++counts[index];
+    }
+  }
+  std::uint16_t* classes = combos + NumCombosSquared;
+  for (std::size_t index = 0; index < NumClassesSquared; ++index)
+  {
+    classes[index] = static_cast<std::uint16_t>(std::lround(sums[index] / counts[index]));
+  }
+
+  m_combos = combos;
+  m_classes = classes;
+}
+
+deck_of_cards::PreflopEquityTable::PreflopEquityTable(const std::string& path, bool verify)
+  : m_storage()
+  , m_file(new MappedTableFile(path, TableFileMagic, PreflopEquityVersion, NumEntries, sizeof(std::uint16_t), verify))
+  , m_combos(static_cast<const std::uint16_t*>(m_file->entries()))
+  , m_classes(m_combos + NumCombosSquared)
+  , m_num_matchup_classes(0)
+{
+}
+
+deck_of_cards::PreflopEquityTable::~PreflopEquityTable() = default;
+
+void deck_of_cards::PreflopEquityTable::save(const std::string& path) const
+{
+  write_table_file(path, TableFileMagic, PreflopEquityVersion, m_combos, NumEntries, sizeof(std::uint16_t));
+}
+
+double deck_of_cards::PreflopEquityTable::equity(CardSet hero, CardSet villain) const noexcept
+{
+  const std::uint64_t hero_mask = hero.mask();
+  const std::uint64_t villain_mask = villain.mask();
+  const std::size_t hero_combo = combo_index(static_cast<CardId>(__builtin_ctzll(hero_mask)),
+                                             static_cast<CardId>(63 - __builtin_clzll(hero_mask)));
+  const std::size_t villain_combo = combo_index(static_cast<CardId>(__builtin_ctzll(villain_mask)),
+                                                static_cast<CardId>(63 - __builtin_clzll(villain_mask)));
+
+  return equity(hero_combo, villain_combo);
+}
+
+double deck_of_cards::PreflopEquityTable::class_equity(std::size_t hero, std::size_t villain) const noexcept
+{
+  return m_classes[hero * NumStartingHands + villain] * (1.0 / 65535);
+}
@@ -0,0 +1,125 @@
+#include "Range.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace deck_of_cards;
+
+namespace
+{
+struct ComboTable
+{
+  ComboTable()
+  {
+    for (CardId high = 1; high < NumCards; ++high)
+    {
+      for (CardId low = 0; low < high; ++low)
+      {
+        cards[combo_index(low, high)][0] = low;
+        cards[combo_index(low, high)][1] = high;
+      }
+    }
+  }
+
+  CardId cards[NumCombos][2];
+};
+
+const ComboTable& combo_table()
+{
+  static const ComboTable table;
+  return table;
+}
+
+}  // namespace
+
+CardSet deck_of_cards::combo_cards(std::size_t combo) noexcept
+{
+  const CardId* cards = combo_table().cards[combo];
+  return CardSet((std::uint64_t(1) << cards[0]) | (std::uint64_t(1) << cards[1]));
+}
+
+CardId deck_of_cards::combo_low_card(std::size_t combo) noexcept
+{
+  return combo_table().cards[combo][0];
+}
+
+CardId deck_of_cards::combo_high_card(std::size_t combo) noexcept
+{
+  return combo_table().cards[combo][1];
+}
+
+deck_of_cards::Range::Range() noexcept
+  : m_weights()
+  , m_mask()
+{
+}
+
+Range deck_of_cards::Range::full() noexcept
+{
+  Range range;
+  std::fill(range.m_weights, range.m_weights + NumCombos, 1.0f);
+  std::fill(range.m_mask, range.m_mask + ComboMaskWords, ~std::uint64_t(0));
+  range.m_mask[ComboMaskWords - 1] = (std::uint64_t(1) << (NumCombos % 64)) - 1;
+
+  return range;
+}
+
+void deck_of_cards::Range::set_weight(std::size_t combo, float weight)
+{
+  if (combo >= NumCombos)
+  {
+    throw std::out_of_range("Combination index out of range");
+  }
+  if (!(weight >= 0))
+  {
+    throw std::invalid_argument("Range weights must not be negative");
+  }
+
+  m_weights[combo] = weight;
+  const std::uint64_t bit = std::uint64_t(1) << (combo % 64);
+  m_mask[combo / 64] = weight > 0 ? m_mask[combo / 64] | bit : m_mask[combo / 64] & ~bit;
+}
+
+void deck_of_cards::Range::set_weight(CardId first, CardId second, float weight)
+{
+  if (first == second || first >= NumCards || second >= NumCards)
+  {
+    throw std::invalid_argument("A combination needs two different cards");
+  }
+
+  set_weight(combo_index(first, second), weight);
+}
+
+void deck_of_cards::Range::remove(CardSet dead) noexcept
+{
+  for (std::size_t combo = 0; combo < NumCombos; ++combo)
+  {
+    if (combo_cards(combo).intersects(dead))
+    {
+      m_weights[combo] = 0;
+      m_mask[combo / 64] &= ~(std::uint64_t(1) << (combo % 64));
+    }
+  }
+}
+
+std::size_t deck_of_cards::Range::num_combos() const noexcept
+{
+  std::size_t count = 0;
+  for (const auto word : m_mask)
+  {
+    count += static_cast<std::size_t>(__builtin_popcountll(word));
+  }
+
+  return count;
+}
+
+double deck_of_cards::Range::total_weight() const noexcept
+{
+  double total = 0;
+  for (const auto weight : m_weights)
+  {
+    total += weight;
+  }
+
+  return total;
+}
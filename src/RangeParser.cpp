@@ -0,0 +1,350 @@
+#include "RangeParser.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "CardSet.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+// longest entry accepted once whitespace is dropped, e.g. "A5s-A2s:0.333333"
+constexpr std::size_t MaxEntryLength = 32;
+
+enum class Kind
+{
+  Pair,
+  Suited,
+  Offsuit,
+  Any,
+  Exact
+};
+
+// one hand class of an entry, values as poker ranks with deuce 0 and ace 12
+struct Spec
+{
+  Kind kind;
+  int high;
+  int low;
+  CardId cards[2];
+};
+
+int rank_of(char c) noexcept
+{
+  switch (std::toupper(static_cast<unsigned char>(c)))
+  {
+    case 'A':
+      return 12;
+    case 'K':
+      return 11;
+    case 'Q':
+      return 10;
+    case 'J':
+      return 9;
+    case 'T':
+      return 8;
+    default:
+      return c >= '2' && c <= '9' ? c - '2' : -1;
+  }
+}
+
+int suit_of(char c) noexcept
+{
+  switch (c)
+  {
+    case 'c':
+      return static_cast<int>(Suit::Club);
+    case 'd':
+      return static_cast<int>(Suit::Diamond);
+    case 'h':
+      return static_cast<int>(Suit::Heart);
+    case 's':
+      return static_cast<int>(Suit::Spade);
+    default:
+      return -1;
+  }
+}
+
+CardId card_of(int rank, int suit) noexcept
+{
+  // card ids put the ace first within a suit
+  return static_cast<CardId>(suit * 13 + (rank + 1) % 13);
+}
+
+bool parse_spec(const char* text, std::size_t length, Spec& spec) noexcept
+{
+  if (length == 4)
+  {
+    const int ranks[] = { rank_of(text[0]), rank_of(text[2]) };
+    const int suits[] = { suit_of(text[1]), suit_of(text[3]) };
+    if (ranks[0] < 0 || ranks[1] < 0 || suits[0] < 0 || suits[1] < 0)
+    {
+      return false;
+    }
+    spec.kind = Kind::Exact;
+    spec.cards[0] = card_of(ranks[0], suits[0]);
+    spec.cards[1] = card_of(ranks[1], suits[1]);
+    return spec.cards[0] != spec.cards[1];
+  }
+  if (length != 2 && length != 3)
+  {
+    return false;
+  }
+
+  const int first = rank_of(text[0]);
+  const int second = rank_of(text[1]);
+  if (first < 0 || second < 0)
+  {
+    return false;
+  }
+  spec.high = first > second ? first : second;
+  spec.low = first > second ? second : first;
+
+  if (first == second)
+  {
+    spec.kind = Kind::Pair;
+    return length == 2;
+  }
+  if (length == 2)
+  {
+    spec.kind = Kind::Any;
+    return true;
+  }
+  switch (std::tolower(static_cast<unsigned char>(text[2])))
+  {
+    case 's':
+      spec.kind = Kind::Suited;
+      return true;
+    case 'o':
+      spec.kind = Kind::Offsuit;
+      return true;
+    default:
+      return false;
+  }
+}
+
+void apply(Kind kind, int high, int low, float weight, Range& range)
+{
+  for (int first = 0; first < 4; ++first)
+  {
+    for (int second = 0; second < 4; ++second)
+    {
+      const bool valid = kind == Kind::Pair      ? first < second
+                         : kind == Kind::Suited  ? first == second
+                         : kind == Kind::Offsuit ? first != second
+                                                 : true;
+      if (valid)
+      {
+        range.set_weight(combo_index(card_of(high, first), card_of(low, second)), weight);
+      }
+    }
+  }
+}
+
+[[noreturn]] void invalid_entry(const char* begin, const char* end)
+{
+  throw std::invalid_argument("Invalid range entry '" + std::string(begin, end) + "'");
+}
+
+// parses one comma separated entry, begin and end delimiting the raw text for error messages
+void parse_entry(const char* begin, const char* end, Range& range)
+{
+  char entry[MaxEntryLength + 1];
+  std::size_t length = 0;
+  for (const char* c = begin; c != end; ++c)
+  {
+    if (std::isspace(static_cast<unsigned char>(*c)))
+    {
+      continue;
+    }
+    if (length == MaxEntryLength)
+    {
+      invalid_entry(begin, end);
+    }
+    entry[length++] = *c;
+  }
+  entry[length] = '\0';
+
+  float weight = 1;
+  if (char* colon = static_cast<char*>(std::memchr(entry, ':', length)))
+  {
+    char* parsed_end = nullptr;
+    const double parsed = std::strtod(colon + 1, &parsed_end);
+    if (parsed_end == colon + 1 || *parsed_end != '\0' || !std::isfinite(parsed) || parsed < 0)
+    {
+      invalid_entry(begin, end);
+    }
+    weight = static_cast<float>(parsed);
+    length = static_cast<std::size_t>(colon - entry);
+  }
+
+  Spec first;
+  if (length > 0 && entry[length - 1] == '+')
+  {
+    if (!parse_spec(entry, length - 1, first) || first.kind == Kind::Exact)
+    {
+      invalid_entry(begin, end);
+    }
+    const bool pair = first.kind == Kind::Pair;
+    for (int rank = pair ? first.high : first.low; rank <= (pair ? 12 : first.high - 1); ++rank)
+    {
+      apply(first.kind, pair ? rank : first.high, rank, weight, range);
+    }
+    return;
+  }
+
+  if (const char* dash = static_cast<const char*>(std::memchr(entry, '-', length)))
+  {
+    const std::size_t split = static_cast<std::size_t>(dash - entry);
+    Spec last;
+    if (!parse_spec(entry, split, first) || !parse_spec(dash + 1, length - split - 1, last) ||
+        first.kind == Kind::Exact || first.kind != last.kind || (first.kind != Kind::Pair && first.high != last.high))
+    {
+      invalid_entry(begin, end);
+    }
+    const int from = first.low < last.low ? first.low : last.low;
+    const int to = first.low < last.low ? last.low : first.low;
+    for (int rank = from; rank <= to; ++rank)
+    {
+      apply(first.kind, first.kind == Kind::Pair ? rank : first.high, rank, weight, range);
+    }
+    return;
+  }
+
+  if (!parse_spec(entry, length, first))
+  {
+    invalid_entry(begin, end);
+  }
+  if (first.kind == Kind::Exact)
+  {
+    range.set_weight(first.cards[0], first.cards[1], weight);
+  }
+  else
+  {
+    apply(first.kind, first.high, first.low, weight, range);
+  }
+}
+
+}  // namespace
+
+Range deck_of_cards::parse_range(const std::string& text)
+{
+  Range range;
+  const char* begin = text.data();
+  const char* const end = begin + text.size();
+
+  // an empty or blank text is the empty range, otherwise every entry must hold a hand
+  const char* first = begin;
+  while (first != end && std::isspace(static_cast<unsigned char>(*first)))
+  {
+    ++first;
+  }
+  if (first == end)
+  {
+    return range;
+  }
+
+  for (;;)
+  {
+    const char* comma = static_cast<const char*>(std::memchr(begin, ',', static_cast<std::size_t>(end - begin)));
+    parse_entry(begin, comma != nullptr ? comma : end, range);
+    if (comma == nullptr)
+    {
+      return range;
+    }
+    begin = comma + 1;
+  }
+}
+
+Range deck_of_cards::parse_range(const std::string& text, const Deck& deck)
+{
+  Range range = parse_range(text);
+  range.remove(CardSet::full() - deck.undealt());
+
+  return range;
+}
+
+deck_of_cards::RangeCache::RangeCache(std::size_t capacity)
+  : m_capacity(capacity)
+  , m_hits(0)
+  , m_misses(0)
+{
+  if (capacity == 0)
+  {
+    throw std::invalid_argument("A range cache needs room for at least one range");
+  }
+}
+
+std::shared_ptr<const Range> deck_of_cards::RangeCache::get(const std::string& text)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_index.find(text);
+    if (found != m_index.end())
+    {
+      ++m_hits;
+      m_entries.splice(m_entries.begin(), m_entries, found->second);
+      return found->second->second;
+    }
+    ++m_misses;
+  }
+
+  std::shared_ptr<const Range> range = std::make_shared<const Range>(parse_range(text));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto found = m_index.find(text);
+  if (found != m_index.end())
+  {
+    // another thread parsed the same text meanwhile
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    return found->second->second;
+  }
+  m_entries.emplace_front(text, range);
+  m_index.emplace(text, m_entries.begin());
+  if (m_entries.size() > m_capacity)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  return range;
+}
+
+Range deck_of_cards::RangeCache::get(const std::string& text, const Deck& deck)
+{
+  Range range = *get(text);
+  range.remove(CardSet::full() - deck.undealt());
+
+  return range;
+}
+
+void deck_of_cards::RangeCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+std::size_t deck_of_cards::RangeCache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+std::size_t deck_of_cards::RangeCache::hits() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_hits;
+}
+
+std::size_t deck_of_cards::RangeCache::misses() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_misses;
+}
@@ -0,0 +1,171 @@
+#include "Realtime.hpp"
+
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "HandEvaluator.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+std::size_t page_size()
+{
+#if defined(__linux__)
+  static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return size;
+#else
+  return 4096;
+#endif
+}
+
+}  // namespace
+
+std::size_t deck_of_cards::locked_process_memory()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, 6, "VmLck:") == 0)
+    {
+      return std::stoul(line.substr(6)) * 1024;  // reported in kB
+    }
+  }
+
+  return 0;
+}
+
+deck_of_cards::RealtimeMemory::RealtimeMemory(const Config& config)
+  : m_config(config)
+  , m_report()
+  , m_locked()
+  , m_process_locked(false)
+{
+  if (m_config.lock_process)
+  {
+    m_config.lock_memory = true;
+#if defined(__linux__)
+    m_process_locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    m_report.lock_failed = !m_process_locked;
+#else
+    m_report.lock_failed = true;
+#endif
+#if defined(__GLIBC__)
+    if (m_process_locked)
+    {
+      // keep freed heap memory, and the locked pages behind it, in the process instead of handing it back
+      mallopt(M_TRIM_THRESHOLD, -1);
+      mallopt(M_MMAP_MAX, 0);
+    }
+#endif
+  }
+
+  if (m_config.warm_evaluator)
+  {
+    const HandEvaluator& evaluator = HandEvaluator::instance();
+    add_region(evaluator.tables(), evaluator.table_bytes());
+  }
+}
+
+deck_of_cards::RealtimeMemory::~RealtimeMemory()
+{
+#if defined(__linux__)
+  if (m_process_locked)
+  {
+    munlockall();
+    return;
+  }
+  for (const auto& region : m_locked)
+  {
+    munlock(region.first, region.second);
+  }
+#endif
+}
+
+void deck_of_cards::RealtimeMemory::add_region(void* data, std::size_t bytes)
+{
+  // write every page so that it is backed by its own frame rather than the shared zero page
+  volatile char* cursor = static_cast<volatile char*>(data);
+  for (std::size_t offset = 0; offset < bytes; offset += page_size())
+  {
+    cursor[offset] = cursor[offset];
+  }
+  if (bytes > 0)
+  {
+    cursor[bytes - 1] = cursor[bytes - 1];
+  }
+
+  ++m_report.regions;
+  m_report.prefaulted_bytes += bytes;
+  lock(data, bytes);
+}
+
+void deck_of_cards::RealtimeMemory::add_region(const void* data, std::size_t bytes)
+{
+  // read every cache line, which also pulls small tables into the caches
+  const volatile char* cursor = static_cast<const volatile char*>(data);
+  char sink = 0;
+  for (std::size_t offset = 0; offset < bytes; offset += 64)
+  {
+    sink ^= cursor[offset];
+  }
+  (void)sink;
+
+  ++m_report.regions;
+  m_report.prefaulted_bytes += bytes;
+  lock(data, bytes);
+}
+
+void deck_of_cards::RealtimeMemory::add(PageBuffer& buffer)
+{
+  add_region(buffer.data(), buffer.size());
+}
+
+void deck_of_cards::RealtimeMemory::add(DeckBatch& batch)
+{
+  if (batch.size() > 0)
+  {
+    add_region(static_cast<void*>(batch.order(0)), batch.size() * DeckStride);
+  }
+}
+
+void deck_of_cards::RealtimeMemory::add(TableScheduler& scheduler, std::size_t messages)
+{
+  scheduler.reserve(messages);
+}
+
+RealtimeReport deck_of_cards::RealtimeMemory::report() const
+{
+  RealtimeReport report = m_report;
+  report.pinned_bytes = locked_process_memory();
+
+  return report;
+}
+
+void deck_of_cards::RealtimeMemory::lock(const void* data, std::size_t bytes)
+{
+  if (!m_config.lock_memory || bytes == 0)
+  {
+    return;
+  }
+
+#if defined(__linux__)
+  if (mlock(data, bytes) == 0)
+  {
+    m_locked.emplace_back(data, bytes);
+    m_report.locked_bytes += bytes;
+    return;
+  }
+#endif
+  m_report.lock_failed = true;
+}
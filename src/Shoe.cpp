@@ -0,0 +1,121 @@
+#include "Shoe.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace deck_of_cards;
+
+deck_of_cards::Shoe::Shoe(std::size_t num_decks)
+  : m_cards(num_decks * NumCards)
+  , m_cursor(0)
+  , m_counts()
+{
+  if (num_decks == 0)
+  {
+    throw std::invalid_argument("A shoe needs at least one deck");
+  }
+
+  reset();
+}
+
+void deck_of_cards::Shoe::reset() noexcept
+{
+  for (std::size_t i = 0; i < m_cards.size(); ++i)
+  {
+    m_cards[i] = static_cast<CardId>(i % NumCards);
+  }
+  m_cursor = 0;
+  std::fill(m_counts, m_counts + 13, 4 * num_decks());
+}
+
+void deck_of_cards::Shoe::shuffle()
+{
+  int (*generator)() = &rand;
+  shuffle(generator);
+}
+
+std::size_t deck_of_cards::Shoe::deal_cards(CardId* cards, std::size_t count) noexcept
+{
+  const std::size_t dealt = std::min(count, num_cards());
+  for (std::size_t i = 0; i < dealt; ++i)
+  {
+    cards[i] = deal_card();
+  }
+
+  return dealt;
+}
+
+namespace
+{
+// the weight of every card id of a value or card weighted composition
+std::vector<double> card_weights(const double* weights, std::size_t num_weights)
+{
+  if (num_weights != 13 && num_weights != NumCards)
+  {
+    throw std::invalid_argument("An infinite shoe needs 13 value weights or 52 card weights");
+  }
+  std::vector<double> cards(NumCards);
+  for (std::size_t card = 0; card < NumCards; ++card)
+  {
+    cards[card] = num_weights == NumCards ? weights[card] : weights[card % 13] / 4;
+  }
+
+  return cards;
+}
+
+}  // namespace
+
+deck_of_cards::InfiniteShoe::InfiniteShoe(std::uint64_t seed)
+  : InfiniteShoe(std::vector<double>(13, 1.0).data(), 13, seed)
+{
+}
+
+deck_of_cards::InfiniteShoe::InfiniteShoe(const double* weights, std::size_t num_weights, std::uint64_t seed)
+  : m_table(card_weights(weights, num_weights).data(), NumCards)
+  , m_state(seed)
+  , m_dealt(0)
+{
+}
+
+void deck_of_cards::InfiniteShoe::shuffle()
+{
+  // glibc's rand() yields 31 bits, so three draws are folded into the 64 bits of the state
+  const std::uint64_t high = static_cast<std::uint64_t>(rand());
+  const std::uint64_t middle = static_cast<std::uint64_t>(rand());
+  const std::uint64_t low = static_cast<std::uint64_t>(rand());
+  m_state = high << 33 ^ middle << 2 ^ low;
+}
+
+std::size_t deck_of_cards::InfiniteShoe::deal_cards(CardId* cards, std::size_t count) noexcept
+{
+  constexpr std::size_t Block = 64;
+  std::uint64_t randoms[Block];
+  std::uint32_t outcomes[Block];
+  for (std::size_t begin = 0; begin < count; begin += Block)
+  {
+    const std::size_t size = std::min(Block, count - begin);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      randoms[i] = next();
+    }
+    m_table.sample_batch(randoms, outcomes, size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      cards[begin + i] = static_cast<CardId>(outcomes[i]);
+    }
+  }
+  m_dealt += count;
+
+  return count;
+}
+
+double deck_of_cards::InfiniteShoe::probability(Value value) const noexcept
+{
+  double probability = 0;
+  for (const auto suit : Suits)
+  {
+    probability += m_table.probability(card_id(suit, value));
+  }
+
+  return probability;
+}
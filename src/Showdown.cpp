@@ -0,0 +1,99 @@
+#include "Showdown.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace deck_of_cards;
+
+namespace
+{
+void check_seats(std::size_t num_seats)
+{
+  if (num_seats == 0 || num_seats > MaxShowdownSeats)
+  {
+    throw std::invalid_argument("A showdown needs 1 to 16 seats");
+  }
+}
+
+// ranks of all seats, the unused lanes left at 0 which is below every valid rank
+void rank_seats(const HandEvaluator& evaluator, CardSet board, const CardSet* hands, std::size_t num_seats,
+                HandRank* ranks)
+{
+  // a card held twice would make the winner meaningless
+  CardSet dealt = board;
+  for (std::size_t seat = 0; seat < num_seats; ++seat)
+  {
+    if (dealt.intersects(hands[seat]))
+    {
+      throw std::invalid_argument("A hand shares a card with the board or another hand");
+    }
+    dealt = dealt | hands[seat];
+    ranks[seat] = evaluator.evaluate(board | hands[seat]);
+  }
+}
+
+ShowdownResult find_winners(const HandRank* ranks) noexcept
+{
+  ShowdownResult result;
+#if defined(__SSE2__)
+  // ranks fit in 13 bits, so the signed 16 bit instructions of SSE2 order them correctly
+  const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ranks));
+  const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ranks + 8));
+  __m128i best = _mm_max_epi16(low, high);
+  best = _mm_max_epi16(best, _mm_srli_si128(best, 8));
+  best = _mm_max_epi16(best, _mm_srli_si128(best, 4));
+  best = _mm_max_epi16(best, _mm_srli_si128(best, 2));
+  result.best = static_cast<HandRank>(_mm_extract_epi16(best, 0));
+
+  const __m128i broadcast = _mm_set1_epi16(static_cast<short>(result.best));
+  const __m128i equal = _mm_packs_epi16(_mm_cmpeq_epi16(low, broadcast), _mm_cmpeq_epi16(high, broadcast));
+  result.winners = static_cast<std::uint32_t>(_mm_movemask_epi8(equal));
+#else
+  result.best = 0;
+  for (std::size_t seat = 0; seat < MaxShowdownSeats; ++seat)
+  {
+    result.best = std::max(result.best, ranks[seat]);
+  }
+  result.winners = 0;
+  for (std::size_t seat = 0; seat < MaxShowdownSeats; ++seat)
+  {
+    result.winners |= static_cast<std::uint32_t>(ranks[seat] == result.best) << seat;
+  }
+#endif
+
+  return result;
+}
+
+}  // namespace
+
+ShowdownResult deck_of_cards::showdown(CardSet board, const CardSet* hands, std::size_t num_seats, HandRank* ranks)
+{
+  check_seats(num_seats);
+
+  HandRank seat_ranks[MaxShowdownSeats] = {};
+  rank_seats(HandEvaluator::instance(), board, hands, num_seats, seat_ranks);
+  if (ranks != nullptr)
+  {
+    std::copy(seat_ranks, seat_ranks + num_seats, ranks);
+  }
+
+  return find_winners(seat_ranks);
+}
+
+void deck_of_cards::showdown_batch(const CardSet* boards, const CardSet* hands, std::size_t num_seats,
+                                   ShowdownResult* results, std::size_t count)
+{
+  check_seats(num_seats);
+
+  const HandEvaluator& evaluator = HandEvaluator::instance();
+  HandRank seat_ranks[MaxShowdownSeats] = {};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    rank_seats(evaluator, boards[i], hands + i * num_seats, num_seats, seat_ranks);
+    results[i] = find_winners(seat_ranks);
+  }
+}
@@ -0,0 +1,186 @@
+#include "SortingNetwork.hpp"
+
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace deck_of_cards;
+
+namespace
+{
+struct Comparator
+{
+  std::uint8_t low;   ///< Position receiving the smaller value.
+  std::uint8_t high;  ///< Position receiving the larger value.
+};
+
+// Batcher's odd-even merge sort networks with redundant comparators removed, size-optimal up to 8 cards
+constexpr Comparator Comparators[] = {
+  // 2 cards, 1 comparators
+  { 0, 1 },
+  // 3 cards, 3 comparators
+  { 0, 1 }, { 0, 2 }, { 1, 2 },
+  // 4 cards, 5 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 },
+  // 5 cards, 9 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 0, 4 }, { 2, 4 }, { 1, 2 }, { 3, 4 },
+  // 6 cards, 12 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 0, 4 }, { 2, 4 }, { 1, 5 }, { 3, 5 }, { 1, 2 },
+  { 3, 4 },
+  // 7 cards, 16 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 4, 6 }, { 5, 6 }, { 0, 4 }, { 2, 6 }, { 2, 4 },
+  { 1, 5 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 },
+  // 8 cards, 19 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 6, 7 }, { 4, 6 }, { 5, 7 }, { 5, 6 }, { 0, 4 },
+  { 2, 6 }, { 2, 4 }, { 1, 5 }, { 3, 7 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 },
+  // 9 cards, 27 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 6, 7 }, { 4, 6 }, { 5, 7 }, { 5, 6 }, { 0, 4 },
+  { 2, 6 }, { 2, 4 }, { 1, 5 }, { 3, 7 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 0, 8 }, { 4, 8 }, { 2, 4 },
+  { 6, 8 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 },
+  // 10 cards, 32 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 6, 7 }, { 4, 6 }, { 5, 7 }, { 5, 6 }, { 0, 4 },
+  { 2, 6 }, { 2, 4 }, { 1, 5 }, { 3, 7 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 8, 9 }, { 0, 8 }, { 4, 8 },
+  { 2, 4 }, { 6, 8 }, { 1, 9 }, { 5, 9 }, { 3, 5 }, { 7, 9 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 },
+  // 11 cards, 37 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 6, 7 }, { 4, 6 }, { 5, 7 }, { 5, 6 }, { 0, 4 },
+  { 2, 6 }, { 2, 4 }, { 1, 5 }, { 3, 7 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 8, 9 }, { 8, 10 }, { 9, 10 },
+  { 0, 8 }, { 4, 8 }, { 2, 10 }, { 6, 10 }, { 2, 4 }, { 6, 8 }, { 1, 9 }, { 5, 9 }, { 3, 5 }, { 7, 9 }, { 1, 2 },
+  { 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 },
+  // 12 cards, 41 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 6, 7 }, { 4, 6 }, { 5, 7 }, { 5, 6 }, { 0, 4 },
+  { 2, 6 }, { 2, 4 }, { 1, 5 }, { 3, 7 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 8, 9 }, { 10, 11 }, { 8, 10 },
+  { 9, 11 }, { 9, 10 }, { 0, 8 }, { 4, 8 }, { 2, 10 }, { 6, 10 }, { 2, 4 }, { 6, 8 }, { 1, 9 }, { 5, 9 }, { 3, 11 },
+  { 7, 11 }, { 3, 5 }, { 7, 9 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 },
+  // 13 cards, 48 comparators
+  { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 }, { 4, 5 }, { 6, 7 }, { 4, 6 }, { 5, 7 }, { 5, 6 }, { 0, 4 },
+  { 2, 6 }, { 2, 4 }, { 1, 5 }, { 3, 7 }, { 3, 5 }, { 1, 2 }, { 3, 4 }, { 5, 6 }, { 8, 9 }, { 10, 11 }, { 8, 10 },
+  { 9, 11 }, { 9, 10 }, { 8, 12 }, { 10, 12 }, { 9, 10 }, { 11, 12 }, { 0, 8 }, { 4, 12 }, { 4, 8 }, { 2, 10 },
+  { 6, 10 }, { 2, 4 }, { 6, 8 }, { 10, 12 }, { 1, 9 }, { 5, 9 }, { 3, 11 }, { 7, 11 }, { 3, 5 }, { 7, 9 }, { 1, 2 },
+  { 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },};
+
+// the comparators of the network for n cards are [NetworkStart[n], NetworkStart[n + 1])
+constexpr std::size_t NetworkStart[] = { 0, 0, 0, 1, 4, 9, 18, 30, 46, 65, 92, 124, 161, 202, 250 };
+
+void compare_exchange(CardId& a, CardId& b) noexcept
+{
+  const CardId low = std::min(a, b);
+  b = std::max(a, b);
+  a = low;
+}
+
+#if defined(__SSE2__)
+void compare_exchange(__m128i& a, __m128i& b) noexcept
+{
+  const __m128i low = _mm_min_epu8(a, b);
+  b = _mm_max_epu8(a, b);
+  a = low;
+}
+
+constexpr std::size_t VectorHands = 16;
+#endif
+
+// with Count a constant the loop has a fixed trip count and unrolls into straight line min/max code
+template <std::size_t Count, typename Value>
+void apply_network(Value* values) noexcept
+{
+  for (std::size_t i = NetworkStart[Count]; i < NetworkStart[Count + 1]; ++i)
+  {
+    compare_exchange(values[Comparators[i].low], values[Comparators[i].high]);
+  }
+}
+
+template <typename Value>
+void apply_network(Value* values, std::size_t count) noexcept
+{
+  switch (count)
+  {
+    case 2:
+      return apply_network<2>(values);
+    case 3:
+      return apply_network<3>(values);
+    case 4:
+      return apply_network<4>(values);
+    case 5:
+      return apply_network<5>(values);
+    case 6:
+      return apply_network<6>(values);
+    case 7:
+      return apply_network<7>(values);
+    case 8:
+      return apply_network<8>(values);
+    case 9:
+      return apply_network<9>(values);
+    case 10:
+      return apply_network<10>(values);
+    case 11:
+      return apply_network<11>(values);
+    case 12:
+      return apply_network<12>(values);
+    case 13:
+      return apply_network<13>(values);
+    default:
+      return;
+  }
+}
+
+}  // namespace
+
+std::size_t deck_of_cards::sorting_network_size(std::size_t count) noexcept
+{
+  return count > MaxSortCards ? 0 : NetworkStart[count + 1] - NetworkStart[count];
+}
+
+void deck_of_cards::sort_cards(CardId* cards, std::size_t count) noexcept
+{
+  if (count > MaxSortCards)
+  {
+    std::sort(cards, cards + count);
+    return;
+  }
+
+  apply_network(cards, count);
+}
+
+void deck_of_cards::sort_hands(CardId* cards, std::size_t cards_per_hand, std::size_t num_hands) noexcept
+{
+  std::size_t hand = 0;
+#if defined(__SSE2__)
+  if (cards_per_hand <= MaxSortCards)
+  {
+    for (; hand + VectorHands <= num_hands; hand += VectorHands)
+    {
+      CardId* block = cards + hand * cards_per_hand;
+
+      // one vector per card position, lane h holding hand h of the block
+      __m128i positions[MaxSortCards];
+      for (std::size_t position = 0; position < cards_per_hand; ++position)
+      {
+        alignas(16) CardId column[VectorHands];
+        for (std::size_t lane = 0; lane < VectorHands; ++lane)
+        {
+          column[lane] = block[lane * cards_per_hand + position];
+        }
+        positions[position] = _mm_load_si128(reinterpret_cast<const __m128i*>(column));
+      }
+
+      apply_network(positions, cards_per_hand);
+
+      for (std::size_t position = 0; position < cards_per_hand; ++position)
+      {
+        alignas(16) CardId column[VectorHands];
+        _mm_store_si128(reinterpret_cast<__m128i*>(column), positions[position]);
+        for (std::size_t lane = 0; lane < VectorHands; ++lane)
+        {
+          block[lane * cards_per_hand + position] = column[lane];
+        }
+      }
+    }
+  }
+#endif
+  for (; hand < num_hands; ++hand)
+  {
+    sort_cards(cards + hand * cards_per_hand, cards_per_hand);
+  }
+}
@@ -0,0 +1,80 @@
+#include "Statistics.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+double deck_of_cards::normal_quantile(double p)
+{
+  if (!(p > 0.0 && p < 1.0))
+  {
+    throw std::domain_error("normal_quantile requires 0 < p < 1");
+  }
+
+  // Acklam's rational approximation, relative error below 1.2e-9 over the whole range
+  static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                              1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00 };
+  static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                              6.680131188771972e+01,  -1.328068155288572e+01 };
+  static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                              -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00 };
+  static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                              3.754408661907416e+00 };
+
+  const double low = 0.02425;
+  if (p < low)
+  {
+    const double q = std::sqrt(-2.0 * std::log(p));
+    return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+           ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  }
+  if (p > 1.0 - low)
+  {
+    const double q = std::sqrt(-2.0 * std::log(1.0 - p));
+    return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+           ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  }
+
+  const double q = p - 0.5;
+  const double r = q * q;
+  return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+         (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+double deck_of_cards::chi_squared_critical_value(double dofs, double alpha)
+{
+  if (dofs <= 0.0)
+  {
+    throw std::domain_error("chi_squared_critical_value requires positive degrees of freedom");
+  }
+
+  const double z = normal_quantile(1.0 - alpha);
+  const double h = 2.0 / (9.0 * dofs);
+  const double base = 1.0 - h + z * std::sqrt(h);
+
+  return dofs * base * base * base;
+}
+
+std::size_t deck_of_cards::binomial_critical_value(std::size_t n, double p, double alpha)
+{
+  if (!(p > 0.0 && p < 1.0))
+  {
+    throw std::domain_error("binomial_critical_value requires 0 < p < 1");
+  }
+
+  // accumulate the CDF from the bottom, working in log space so that large n does not underflow
+  const double log_p = std::log(p);
+  const double log_q = std::log1p(-p);
+  double cdf = 0.0;
+  for (std::size_t k = 0; k <= n; ++k)
+  {
+    const double log_pmf = std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0) + k * log_p +
+                           (n - k) * log_q;
+    cdf += std::exp(log_pmf);
+    if (cdf >= 1.0 - alpha)
+    {
+      return k;
+    }
+  }
+
+  return n;
+}
@@ -0,0 +1,361 @@
+#include "TableFile.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace deck_of_cards;
+
+namespace
+{
+static_assert(sizeof(TableFileHeader) == 64, "the entries following the header must stay cache line aligned");
+
+constexpr std::uint32_t ByteOrderMark = 0x01020304;
+
+// returns why a table file is unusable, or nullptr if it is fine
+const char* check_table_file(const char* bytes, std::size_t size, const char* magic, std::uint32_t version,
+                             std::size_t num_entries, std::size_t entry_bytes, bool verify)
+{
+  TableFileHeader header;
+  if (size < sizeof(header))
+  {
+    return "file too small";
+  }
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0)
+  {
+    return "wrong kind of table file";
+  }
+  if (header.version != version)
+  {
+    return "unsupported version";
+  }
+  if (header.byte_order != ByteOrderMark)
+  {
+    return "wrong byte order";
+  }
+  if (header.num_entries != num_entries || size != sizeof(header) + num_entries * entry_bytes)
+  {
+    return "wrong size";
+  }
+  if (verify && table_checksum(bytes + sizeof(header), size - sizeof(header)) != header.checksum)
+  {
+    return "checksum mismatch";
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+std::uint64_t deck_of_cards::table_checksum(const void* data, std::size_t bytes, std::uint64_t hash) noexcept
+{
+  const unsigned char* cursor = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < bytes; ++i)
+  {
+    hash = (hash ^ cursor[i]) * 1099511628211ull;
+  }
+
+  return hash;
+}
+
+void deck_of_cards::write_table_file(const std::string& path, const char* magic, std::uint32_t version,
+                                     const void* entries, std::size_t num_entries, std::size_t entry_bytes)
+{
+  TableFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, magic, sizeof(header.magic));
+  header.version = version;
+  header.byte_order = ByteOrderMark;
+  header.num_entries = num_entries;
+  header.checksum = table_checksum(entries, num_entries * entry_bytes);
+
+  // write next to the target and rename over it, so that readers see either the old or the new file
+  const std::string temporary = path + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(static_cast<const char*>(entries), static_cast<std::streamsize>(num_entries * entry_bytes));
+    if (!file)
+    {
+      std::remove(temporary.c_str());
+      throw std::runtime_error("Cannot write table file " + temporary);
+    }
+  }
+  if (std::rename(temporary.c_str(), path.c_str()) != 0)
+  {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("Cannot replace table file " + path);
+  }
+}
+
+deck_of_cards::WritableTableFile::WritableTableFile(const std::string& path, const char* magic, std::uint32_t version,
+                                                    std::size_t num_entries, std::size_t entry_bytes)
+  : m_path(path)
+  , m_header()
+  , m_entries_size(num_entries * entry_bytes)
+  , m_fd(-1)
+  , m_mutex()
+  , m_stream()
+{
+  std::memset(&m_header, 0, sizeof(m_header));
+  std::memcpy(m_header.magic, magic, sizeof(m_header.magic));
+  m_header.version = version;
+  m_header.byte_order = ByteOrderMark;
+  m_header.num_entries = num_entries;
+  const std::size_t size = sizeof(m_header) + m_entries_size;
+
+#if defined(__linux__)
+  m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  struct stat status;
+  if (m_fd < 0 || fstat(m_fd, &status) != 0)
+  {
+    if (m_fd >= 0)
+    {
+      close(m_fd);
+    }
+    throw std::runtime_error("Cannot open table file " + path);
+  }
+  const std::size_t existing = static_cast<std::size_t>(status.st_size);
+  const char* error = nullptr;
+  if (existing == 0)
+  {
+    // the zero filled entries are holes until written
+    if (ftruncate(m_fd, static_cast<off_t>(size)) != 0 ||
+        pwrite(m_fd, &m_header, sizeof(m_header), 0) != static_cast<ssize_t>(sizeof(m_header)))
+    {
+      error = "cannot allocate";
+    }
+  }
+  else
+  {
+    TableFileHeader header;
+    error = existing < sizeof(header) || pread(m_fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+              ? "file too small"
+              : check_table_file(reinterpret_cast<const char*>(&header), existing, magic, version, num_entries,
+                                 entry_bytes, false);
+  }
+  if (error != nullptr)
+  {
+    close(m_fd);
+    throw std::runtime_error("Cannot open table file " + path + ": " + error);
+  }
+#else
+  {
+    std::ifstream existing(path, std::ios::binary | std::ios::ate);
+    if (!existing || existing.tellg() == 0)
+    {
+      // no sparse files here, so the entries are written out as zeros
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+      const std::vector<char> zeros(1 << 20, 0);
+      for (std::size_t written = 0; written < m_entries_size; written += zeros.size())
+      {
+        file.write(zeros.data(), static_cast<std::streamsize>(std::min(zeros.size(), m_entries_size - written)));
+      }
+      if (!file)
+      {
+        throw std::runtime_error("Cannot open table file " + path + ": cannot allocate");
+      }
+    }
+    else
+    {
+      const std::size_t existing_size = static_cast<std::size_t>(existing.tellg());
+      TableFileHeader header;
+      existing.seekg(0);
+      existing.read(reinterpret_cast<char*>(&header), sizeof(header));
+      const char* error = !existing ? "file too small" :
+                                      check_table_file(reinterpret_cast<const char*>(&header), existing_size, magic,
+                                                       version, num_entries, entry_bytes, false);
+      if (error != nullptr)
+      {
+        throw std::runtime_error("Cannot open table file " + path + ": " + error);
+      }
+    }
+  }
+  m_stream.open(path, std::ios::binary | std::ios::in | std::ios::out);
+  if (!m_stream)
+  {
+    throw std::runtime_error("Cannot open table file " + path);
+  }
+#endif
+}
+
+deck_of_cards::WritableTableFile::~WritableTableFile()
+{
+#if defined(__linux__)
+  close(m_fd);
+#endif
+}
+
+void deck_of_cards::WritableTableFile::write(std::size_t offset, const void* data, std::size_t bytes)
+{
+#if defined(__linux__)
+  const char* cursor = static_cast<const char*>(data);
+  while (bytes > 0)
+  {
+    const ssize_t written = pwrite(m_fd, cursor, bytes, static_cast<off_t>(sizeof(TableFileHeader) + offset));
+    if (written <= 0)
+    {
+      throw std::runtime_error("Cannot write table file " + m_path);
+    }
+    cursor += written;
+    offset += static_cast<std::size_t>(written);
+    bytes -= static_cast<std::size_t>(written);
+  }
+#else
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stream.seekp(static_cast<std::streamoff>(sizeof(TableFileHeader) + offset));
+  m_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+  if (!m_stream)
+  {
+    throw std::runtime_error("Cannot write table file " + m_path);
+  }
+#endif
+}
+
+void deck_of_cards::WritableTableFile::read(std::size_t offset, void* data, std::size_t bytes) const
+{
+#if defined(__linux__)
+  char* cursor = static_cast<char*>(data);
+  while (bytes > 0)
+  {
+    const ssize_t read = pread(m_fd, cursor, bytes, static_cast<off_t>(sizeof(TableFileHeader) + offset));
+    if (read <= 0)
+    {
+      throw std::runtime_error("Cannot read table file " + m_path);
+    }
+    cursor += read;
+    offset += static_cast<std::size_t>(read);
+    bytes -= static_cast<std::size_t>(read);
+  }
+#else
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stream.seekg(static_cast<std::streamoff>(sizeof(TableFileHeader) + offset));
+  m_stream.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+  if (!m_stream)
+  {
+    throw std::runtime_error("Cannot read table file " + m_path);
+  }
+#endif
+}
+
+void deck_of_cards::WritableTableFile::sync()
+{
+#if defined(__linux__)
+  if (fdatasync(m_fd) != 0)
+  {
+    throw std::runtime_error("Cannot flush table file " + m_path);
+  }
+#else
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_stream.flush())
+  {
+    throw std::runtime_error("Cannot flush table file " + m_path);
+  }
+#endif
+}
+
+void deck_of_cards::WritableTableFile::finish()
+{
+  std::vector<char> chunk(std::size_t(1) << 20);
+  std::uint64_t hash = TableChecksumBasis;
+  for (std::size_t offset = 0; offset < m_entries_size; offset += chunk.size())
+  {
+    const std::size_t bytes = std::min(chunk.size(), m_entries_size - offset);
+    read(offset, chunk.data(), bytes);
+    hash = table_checksum(chunk.data(), bytes, hash);
+  }
+
+  m_header.checksum = hash;
+#if defined(__linux__)
+  if (pwrite(m_fd, &m_header, sizeof(m_header), 0) != static_cast<ssize_t>(sizeof(m_header)))
+  {
+    throw std::runtime_error("Cannot write table file " + m_path);
+  }
+#else
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stream.seekp(0);
+    m_stream.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+  }
+#endif
+  sync();
+}
+
+deck_of_cards::MappedTableFile::MappedTableFile(const std::string& path, const char* magic, std::uint32_t version,
+                                                std::size_t num_entries, std::size_t entry_bytes, bool verify)
+  : m_mapping(nullptr)
+  , m_size(0)
+  , m_buffer()
+  , m_entries(nullptr)
+{
+#if defined(__linux__)
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Cannot open table file " + path);
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || status.st_size == 0)
+  {
+    close(fd);
+    throw std::runtime_error("Cannot map table file " + path + ": file too small");
+  }
+
+  // a shared read only mapping is paged in on demand and shares its page cache pages with every other process
+  const std::size_t size = static_cast<std::size_t>(status.st_size);
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    throw std::runtime_error("Cannot map table file " + path);
+  }
+
+  const char* bytes = static_cast<const char*>(mapping);
+  const char* error = check_table_file(bytes, size, magic, version, num_entries, entry_bytes, verify);
+  if (error != nullptr)
+  {
+    munmap(mapping, size);
+    throw std::runtime_error("Cannot map table file " + path + ": " + error);
+  }
+  m_mapping = mapping;
+  m_size = size;
+  m_entries = bytes + sizeof(TableFileHeader);
+#else
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+  {
+    throw std::runtime_error("Cannot open table file " + path);
+  }
+  m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  const char* error =
+    check_table_file(m_buffer.data(), m_buffer.size(), magic, version, num_entries, entry_bytes, verify);
+  if (error != nullptr)
+  {
+    throw std::runtime_error("Cannot read table file " + path + ": " + error);
+  }
+  m_size = m_buffer.size();
+  m_entries = m_buffer.data() + sizeof(TableFileHeader);
+#endif
+}
+
+deck_of_cards::MappedTableFile::~MappedTableFile()
+{
+#if defined(__linux__)
+  if (m_mapping != nullptr)
+  {
+    munmap(m_mapping, m_size);
+  }
+#endif
+}
@@ -0,0 +1,242 @@
+#include "TableGame.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#include "TableFile.hpp"
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+constexpr const char* CheckpointMagic = "DOCVERI";
+constexpr std::uint32_t CheckpointVersion = 1;
+
+// the state of one work unit as stored in a checkpoint
+struct UnitRecord
+{
+  std::uint64_t game;     // fingerprint of the game the record belongs to
+  std::uint64_t done;     // 1 once the unit is finished
+  double weight;          // size of the suit isomorphism class of the unit
+  double sum;             // sum of the results of the settled deals
+  double squares;         // sum of their squares
+  std::uint64_t settled;  // deals settled
+  std::uint64_t reserved[2];
+};
+
+static_assert(sizeof(UnitRecord) == 64, "checkpoint records are one cache line");
+
+std::uint64_t fingerprint(const TableGame& game, const std::vector<std::size_t>& groups)
+{
+  std::string identity = game.name();
+  for (const auto size : groups)
+  {
+    identity += '/' + std::to_string(size);
+  }
+
+  return table_checksum(identity.data(), identity.size());
+}
+
+void settle_groups(const TableGame& game, const std::vector<std::size_t>& groups, std::size_t group, CardSet used,
+                   CardSet* hands, UnitRecord& record)
+{
+  if (group == groups.size())
+  {
+    const double result = game.settle(hands);
+    record.sum += result;
+    record.squares += result * result;
+    ++record.settled;
+    return;
+  }
+
+  CardId cards[NumCards];
+  std::size_t num_cards = 0;
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    if (!used.contains(card))
+    {
+      cards[num_cards++] = card;
+    }
+  }
+  for_each_combination(cards, num_cards, groups[group], [&](CardSet hand) {
+    hands[group] = hand;
+    settle_groups(game, groups, group + 1, used | hand, hands, record);
+  });
+}
+
+}  // namespace
+
+deck_of_cards::TableGameVerifier::TableGameVerifier(const TableGame& game, const Config& config)
+  : m_game(game)
+  , m_config(config)
+  , m_groups(game.groups())
+{
+  std::size_t total = 0;
+  for (const auto size : m_groups)
+  {
+    if (size == 0)
+    {
+      throw std::invalid_argument("Every group must receive at least one card");
+    }
+    total += size;
+  }
+  if (m_groups.empty() || total > NumCards)
+  {
+    throw std::invalid_argument("A game must deal between one card and one deck");
+  }
+  if (config.checkpoint_interval == 0)
+  {
+    throw std::invalid_argument("The checkpoint interval must be positive");
+  }
+
+  CardId cards[NumCards];
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    cards[card] = card;
+  }
+  for_each_combination(cards, NumCards, m_groups[0], [this](CardSet first) {
+    if (suit_canonical(first))
+    {
+      m_units.push_back(first);
+    }
+  });
+}
+
+VerificationResult deck_of_cards::TableGameVerifier::run()
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  const std::uint64_t game = fingerprint(m_game, m_groups);
+
+  std::vector<UnitRecord> records(m_units.size(), UnitRecord());
+  if (!m_config.checkpoint.empty() && std::ifstream(m_config.checkpoint).good())
+  {
+    const MappedTableFile file(m_config.checkpoint, CheckpointMagic, CheckpointVersion, records.size(),
+                               sizeof(UnitRecord), true);
+    const UnitRecord* stored = static_cast<const UnitRecord*>(file.entries());
+    for (std::size_t unit = 0; unit < records.size(); ++unit)
+    {
+      if (stored[unit].game != game)
+      {
+        throw std::runtime_error("Checkpoint " + m_config.checkpoint + " belongs to another game");
+      }
+      records[unit] = stored[unit];
+    }
+  }
+  for (auto& record : records)
+  {
+    record.game = game;
+  }
+
+  std::size_t units_done = 0;
+  for (const auto& record : records)
+  {
+    units_done += record.done != 0;
+  }
+
+  std::mutex mutex;
+  std::size_t finished = 0;
+  std::uint64_t settled = 0;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto save = [this, &records]() {
+    write_table_file(m_config.checkpoint, CheckpointMagic, CheckpointVersion, records.data(), records.size(),
+                     sizeof(UnitRecord));
+  };
+
+  {
+    ThreadPool pool(m_config.num_threads);
+    std::size_t submitted = 0;
+    for (std::size_t unit = 0; unit < m_units.size(); ++unit)
+    {
+      if (records[unit].done != 0)
+      {
+        continue;
+      }
+      if (m_config.max_units != 0 && submitted == m_config.max_units)
+      {
+        break;
+      }
+      ++submitted;
+
+      pool.submit([&, unit]() {
+        try
+        {
+          UnitRecord record = UnitRecord();
+          record.game = game;
+          record.weight = static_cast<double>(suit_class_size(m_units[unit]));
+          std::vector<CardSet> hands(m_groups.size());
+          hands[0] = m_units[unit];
+          settle_groups(m_game, m_groups, 1, m_units[unit], hands.data(), record);
+          record.done = 1;
+
+          std::lock_guard<std::mutex> lock(mutex);
+          records[unit] = record;
+          ++units_done;
+          ++finished;
+          settled += record.settled;
+          if (!m_config.checkpoint.empty() && finished % m_config.checkpoint_interval == 0)
+          {
+            save();
+          }
+          if (m_config.progress)
+          {
+            m_config.progress(VerificationProgress{ units_done, m_units.size(), settled,
+                                                    std::chrono::duration<double>(Clock::now() - start).count() });
+          }
+        }
+        catch (...)
+        {
+          // keep the first failure, the remaining units still run but the result is not reported
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+        }
+      });
+    }
+    pool.wait_idle();
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+  if (!m_config.checkpoint.empty() && finished > 0)
+  {
+    save();
+  }
+
+  VerificationResult result = VerificationResult();
+  result.num_units = m_units.size();
+  double deals = 0;
+  double sum = 0;
+  double squares = 0;
+  for (const auto& record : records)
+  {
+    if (record.done == 0)
+    {
+      continue;
+    }
+    ++result.units_done;
+    result.settled += record.settled;
+    deals += record.weight * record.settled;
+    sum += record.weight * record.sum;
+    squares += record.weight * record.squares;
+  }
+  result.deals = static_cast<std::uint64_t>(deals);
+  if (deals > 0)
+  {
+    result.expected_value = sum / deals;
+    const double variance = squares / deals - result.expected_value * result.expected_value;
+    result.standard_deviation = std::sqrt(std::max(0.0, variance));
+  }
+
+  return result;
+}
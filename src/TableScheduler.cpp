@@ -0,0 +1,95 @@
+#include "TableScheduler.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+using namespace deck_of_cards;
+
+deck_of_cards::TableScheduler::TableScheduler(std::size_t num_tables, std::size_t num_threads, std::uint64_t seed)
+  : m_num_tables(num_tables)
+  , m_tables(new Table[num_tables])
+  , m_pool(num_threads)
+{
+  for (TableId table = 0; table < num_tables; ++table)
+  {
+    m_tables[table].state.generator = TableGenerator(seed, table);
+  }
+}
+
+deck_of_cards::TableScheduler::~TableScheduler()
+{
+  // messages may post further messages, so drain every mailbox before the workers stop
+  m_pool.wait_idle();
+}
+
+void deck_of_cards::TableScheduler::post(TableId table, Message message)
+{
+  if (table >= m_num_tables)
+  {
+    throw std::out_of_range("Table id out of range");
+  }
+
+  Table& actor = m_tables[table];
+  {
+    std::lock_guard<std::mutex> lock(actor.mutex);
+    actor.mailbox.push_back(std::move(message));
+  }
+
+  if (!actor.scheduled.exchange(true))
+  {
+    schedule(actor);
+  }
+}
+
+void deck_of_cards::TableScheduler::wait_idle()
+{
+  m_pool.wait_idle();
+}
+
+void deck_of_cards::TableScheduler::reserve(std::size_t messages)
+{
+  for (std::size_t table = 0; table < m_num_tables; ++table)
+  {
+    Table& actor = m_tables[table];
+    // the processing vector belongs to the running actor; run() hands the capacity back to the mailbox on the swap
+    std::lock_guard<std::mutex> lock(actor.mutex);
+    actor.mailbox.reserve(messages);
+  }
+}
+
+void deck_of_cards::TableScheduler::schedule(Table& table)
+{
+  m_pool.submit([this, &table]() { run(table); });
+}
+
+void deck_of_cards::TableScheduler::run(Table& table)
+{
+  {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    table.processing.swap(table.mailbox);
+    // keep the reserved capacity on the posting side once both vectors have it, so the swap does not undo reserve()
+    if (table.mailbox.capacity() < table.processing.capacity())
+    {
+      table.mailbox.reserve(table.processing.capacity());
+    }
+  }
+
+  // only this worker holds the table, so its state needs no lock
+  for (auto& message : table.processing)
+  {
+    message(table.state);
+  }
+  table.processing.clear();
+
+  // a message posted after the swap saw the table as scheduled and did not reschedule it, so look again
+  table.scheduled.store(false);
+  bool more = false;
+  {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    more = !table.mailbox.empty();
+  }
+  if (more && !table.scheduled.exchange(true))
+  {
+    schedule(table);
+  }
+}
@@ -0,0 +1,143 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace deck_of_cards;
+
+namespace
+{
+// identifies the pool and worker the current thread belongs to, if any
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_worker = 0;
+
+}  // namespace
+
+deck_of_cards::ThreadPool::ThreadPool(std::size_t num_threads)
+  : m_queued(0)
+  , m_pending(0)
+  , m_next(0)
+  , m_stop(false)
+{
+  if (num_threads == 0)
+  {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    m_workers.emplace_back(new Worker());
+  }
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    m_threads.emplace_back(&ThreadPool::run, this, i);
+  }
+}
+
+deck_of_cards::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+
+  for (auto& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+void deck_of_cards::ThreadPool::submit(Task task)
+{
+  const bool local = current_pool == this;
+  const std::size_t index = local ? current_worker : m_next++ % m_workers.size();
+
+  m_pending++;
+  m_queued++;
+  {
+    Worker& worker = *m_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (local)
+    {
+      worker.tasks.push_front(std::move(task));
+    }
+    else
+    {
+      worker.tasks.push_back(std::move(task));
+    }
+  }
+
+  // taking the lock orders this wake-up after any worker's check of m_queued
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+  }
+  m_work_cv.notify_one();
+}
+
+void deck_of_cards::ThreadPool::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle_cv.wait(lock, [this]() { return m_pending == 0; });
+}
+
+bool deck_of_cards::ThreadPool::try_pop(std::size_t index, Task& task)
+{
+  // our own deque first, from the front
+  {
+    Worker& worker = *m_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty())
+    {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+      return true;
+    }
+  }
+
+  // then steal from the back of everybody else's
+  for (std::size_t offset = 1; offset < m_workers.size(); ++offset)
+  {
+    Worker& victim = *m_workers[(index + offset) % m_workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty())
+    {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void deck_of_cards::ThreadPool::run(std::size_t index)
+{
+  current_pool = this;
+  current_worker = index;
+
+  Task task;
+  while (true)
+  {
+    if (try_pop(index, task))
+    {
+      m_queued--;
+      task();
+      task = nullptr;
+
+      if (--m_pending == 0)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idle_cv.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_work_cv.wait(lock, [this]() { return m_stop || m_queued > 0; });
+    if (m_stop && m_queued == 0)
+    {
+      return;
+    }
+  }
+}
@@ -0,0 +1,148 @@
+#include "ThreeCardPoker.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace deck_of_cards;
+
+namespace
+{
+// poker ranks, deuces being 0
+constexpr std::uint32_t Four = 2;
+constexpr std::uint32_t Six = 4;
+constexpr std::uint32_t Queen = 10;
+constexpr std::uint32_t Ace = 12;
+
+constexpr std::uint32_t rank_code(ThreeCardCategory category, std::uint32_t first, std::uint32_t second = 0,
+                                  std::uint32_t third = 0) noexcept
+{
+  return static_cast<std::uint32_t>(category) << 12 | first << 8 | second << 4 | third;
+}
+
+// the weakest hand the player plays and the weakest hand that qualifies the dealer
+constexpr std::uint32_t PlayerMinimum = rank_code(ThreeCardCategory::HighCard, Queen, Six, Four);
+constexpr std::uint32_t DealerMinimum = rank_code(ThreeCardCategory::HighCard, Queen);
+
+std::string paytable_name(const char* game, const double* pays)
+{
+  std::ostringstream name;
+  name << game;
+  for (std::size_t category = 0; category < NumThreeCardCategories; ++category)
+  {
+    name << (category == 0 ? ' ' : '/') << pays[category];
+  }
+
+  return name.str();
+}
+
+}  // namespace
+
+std::uint32_t deck_of_cards::three_card_rank(CardSet hand) noexcept
+{
+  std::uint32_t ranks[3];
+  std::size_t count = 0;
+  bool flush = false;
+  for (const auto suit : Suits)
+  {
+    const std::uint32_t mask = hand.suit_mask(suit);
+    flush = flush || __builtin_popcount(mask) == 3;
+    for (std::uint32_t value = 0; value < 13; ++value)
+    {
+      if (mask & (1u << value))
+      {
+        // card values put the ace first
+        ranks[count++] = (value + 12) % 13;
+      }
+    }
+  }
+  std::sort(ranks, ranks + 3, [](std::uint32_t a, std::uint32_t b) { return a > b; });
+
+  if (ranks[0] == ranks[2])
+  {
+    return rank_code(ThreeCardCategory::ThreeOfAKind, ranks[0]);
+  }
+  if (ranks[0] == ranks[1] || ranks[1] == ranks[2])
+  {
+    const std::uint32_t kicker = ranks[0] == ranks[1] ? ranks[2] : ranks[0];
+    return rank_code(ThreeCardCategory::Pair, ranks[1], kicker);
+  }
+
+  const bool wheel = ranks[0] == Ace && ranks[1] == 1 && ranks[2] == 0;
+  if (wheel || ranks[0] - ranks[2] == 2)
+  {
+    const std::uint32_t top = wheel ? 1 : ranks[0];
+    return rank_code(flush ? ThreeCardCategory::StraightFlush : ThreeCardCategory::Straight, top);
+  }
+
+  return rank_code(flush ? ThreeCardCategory::Flush : ThreeCardCategory::HighCard, ranks[0], ranks[1], ranks[2]);
+}
+
+ThreeCardCategory deck_of_cards::three_card_category(std::uint32_t rank) noexcept
+{
+  return static_cast<ThreeCardCategory>(rank >> 12);
+}
+
+deck_of_cards::ThreeCardPoker::ThreeCardPoker()
+  : m_ante_bonus{ 0, 0, 0, 1, 4, 5 }
+{
+}
+
+deck_of_cards::ThreeCardPoker::ThreeCardPoker(const double* ante_bonus)
+{
+  std::copy(ante_bonus, ante_bonus + NumThreeCardCategories, m_ante_bonus);
+}
+
+std::string deck_of_cards::ThreeCardPoker::name() const
+{
+  return paytable_name("Three Card Poker ante/play", m_ante_bonus);
+}
+
+std::vector<std::size_t> deck_of_cards::ThreeCardPoker::groups() const
+{
+  return { 3, 3 };
+}
+
+double deck_of_cards::ThreeCardPoker::settle(const CardSet* groups) const
+{
+  const std::uint32_t player = three_card_rank(groups[0]);
+  if (player < PlayerMinimum)
+  {
+    return -1;
+  }
+
+  const double bonus = m_ante_bonus[static_cast<std::size_t>(three_card_category(player))];
+  const std::uint32_t dealer = three_card_rank(groups[1]);
+  if (dealer < DealerMinimum)
+  {
+    return 1 + bonus;
+  }
+
+  return bonus + (player > dealer ? 2 : player < dealer ? -2 : 0);
+}
+
+deck_of_cards::PairPlus::PairPlus()
+  : m_pays{ 0, 1, 4, 6, 30, 40 }
+{
+}
+
+deck_of_cards::PairPlus::PairPlus(const double* pays)
+{
+  std::copy(pays, pays + NumThreeCardCategories, m_pays);
+}
+
+std::string deck_of_cards::PairPlus::name() const
+{
+  return paytable_name("Pairplus", m_pays);
+}
+
+std::vector<std::size_t> deck_of_cards::PairPlus::groups() const
+{
+  return { 3 };
+}
+
+double deck_of_cards::PairPlus::settle(const CardSet* groups) const
+{
+  const double pays = m_pays[static_cast<std::size_t>(three_card_category(three_card_rank(groups[0])))];
+
+  return pays > 0 ? pays : -1;
+}
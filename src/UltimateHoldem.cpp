@@ -0,0 +1,188 @@
+#include "UltimateHoldem.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace deck_of_cards;
+
+namespace
+{
+// poker ranks, deuces being 0
+constexpr int Three = 1;
+constexpr int Five = 3;
+constexpr int Six = 4;
+constexpr int Eight = 6;
+constexpr int Ten = 8;
+constexpr int Jack = 9;
+constexpr int Queen = 10;
+constexpr int King = 11;
+constexpr int Ace = 12;
+
+constexpr std::size_t NumCategories = 9;
+
+// card masks of the four deuces, and suit masks of the ten to ace
+constexpr std::uint64_t Deuces = std::uint64_t(1) << 1 | std::uint64_t(1) << 14 | std::uint64_t(1) << 27 |
+                                 std::uint64_t(1) << 40;
+constexpr std::uint32_t TenOrBetter = 0x1E01;
+
+int poker_rank(CardId card) noexcept
+{
+  return (card % 13 + 12) % 13;
+}
+
+// category of a set of fewer than five cards, only telling high card, pair, two pair and trips apart
+HandCategory small_category(CardSet cards) noexcept
+{
+  std::uint32_t ranks = 0;
+  std::uint32_t pairs = 0;
+  std::uint32_t trips = 0;
+  for (const auto suit : Suits)
+  {
+    const std::uint32_t mask = cards.suit_mask(suit);
+    trips |= pairs & mask;
+    pairs |= ranks & mask;
+    ranks |= mask;
+  }
+
+  return trips != 0                        ? HandCategory::ThreeOfAKind
+         : __builtin_popcount(pairs) >= 2 ? HandCategory::TwoPair
+         : pairs != 0                      ? HandCategory::Pair
+                                           : HandCategory::HighCard;
+}
+
+bool raise_preflop(CardSet hole)
+{
+  CardId cards[2];
+  std::size_t count = 0;
+  for (CardId card = 0; card < NumCards && count < 2; ++card)
+  {
+    if (hole.contains(card))
+    {
+      cards[count++] = card;
+    }
+  }
+  const int high = std::max(poker_rank(cards[0]), poker_rank(cards[1]));
+  const int low = std::min(poker_rank(cards[0]), poker_rank(cards[1]));
+  const bool suited = cards[0] / 13 == cards[1] / 13;
+
+  if (high == low)
+  {
+    return high >= Three;
+  }
+  switch (high)
+  {
+    case Ace:
+      return true;
+    case King:
+      return suited || low >= Five;
+    case Queen:
+      return low >= (suited ? Six : Eight);
+    case Jack:
+      return low >= (suited ? Eight : Ten);
+    default:
+      return false;
+  }
+}
+
+bool raise_flop(CardSet hole, CardSet flop)
+{
+  const HandCategory hand = hand_category(evaluate(hole | flop));
+  const HandCategory board = small_category(flop);
+  if (hand >= HandCategory::TwoPair && hand > board)
+  {
+    return true;
+  }
+
+  // a pair made with a hole card, pocket deuces excepted
+  const bool pocket_deuces = (hole.mask() & Deuces) == hole.mask();
+  if (hand == HandCategory::Pair && board == HandCategory::HighCard && !pocket_deuces)
+  {
+    return true;
+  }
+
+  // four to a flush with a hidden ten or better of the suit
+  for (const auto suit : Suits)
+  {
+    const CardSet all = hole | flop;
+    const std::uint32_t hidden = hole.suit_mask(suit);
+    if (__builtin_popcount(all.suit_mask(suit)) == 4 && (hidden & TenOrBetter) != 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool raise_river(CardSet hole, CardSet board)
+{
+  const HandCategory hand = hand_category(evaluate(hole | board));
+
+  return hand >= HandCategory::Pair && hand > hand_category(evaluate(board));
+}
+
+}  // namespace
+
+deck_of_cards::UltimateHoldem::UltimateHoldem()
+  : m_blind_pays{ 0, 0, 0, 0, 1, 1.5, 3, 10, 50 }
+  , m_royal_pays(500)
+{
+}
+
+deck_of_cards::UltimateHoldem::UltimateHoldem(const double* blind_pays, double royal_pays)
+  : m_royal_pays(royal_pays)
+{
+  std::copy(blind_pays, blind_pays + NumCategories, m_blind_pays);
+}
+
+int deck_of_cards::UltimateHoldem::play_wager(CardSet hole, CardSet flop, CardSet turn_river)
+{
+  if (raise_preflop(hole))
+  {
+    return 4;
+  }
+  if (raise_flop(hole, flop))
+  {
+    return 2;
+  }
+
+  return raise_river(hole, flop | turn_river) ? 1 : 0;
+}
+
+std::string deck_of_cards::UltimateHoldem::name() const
+{
+  std::ostringstream name;
+  name << "Ultimate Texas Hold'em blind " << m_royal_pays;
+  for (std::size_t category = NumCategories; category-- > 0;)
+  {
+    name << '/' << m_blind_pays[category];
+  }
+
+  return name.str();
+}
+
+std::vector<std::size_t> deck_of_cards::UltimateHoldem::groups() const
+{
+  return { 2, 3, 2, 2 };
+}
+
+double deck_of_cards::UltimateHoldem::settle(const CardSet* groups) const
+{
+  const int play = play_wager(groups[0], groups[1], groups[2]);
+  if (play == 0)
+  {
+    return -2;
+  }
+
+  const CardSet board = groups[1] | groups[2];
+  const HandRank player = evaluate(groups[0] | board);
+  const HandRank dealer = evaluate(groups[3] | board);
+  const double ante = hand_category(dealer) >= HandCategory::Pair ? 1 : 0;
+  if (player > dealer)
+  {
+    const double blind = player == NumHandRanks ? m_royal_pays : m_blind_pays[static_cast<int>(hand_category(player))];
+    return play + ante + blind;
+  }
+
+  return player < dealer ? -play - ante - 1 : 0;
+}
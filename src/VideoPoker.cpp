@@ -0,0 +1,363 @@
+#include "VideoPoker.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "ThreadPool.hpp"
+
+using namespace deck_of_cards;
+
+namespace
+{
+constexpr std::size_t HandCards = 5;
+
+// poker rank of the jack, deuces being 0
+constexpr int JackRank = 9;
+
+// poker rank masks, bit r set for rank r with deuces at bit 0 and aces at bit 12
+constexpr std::uint32_t WheelRanks = 0x100F;
+constexpr std::uint32_t BroadwayRanks = 0x1F00;
+
+struct Binomials
+{
+  Binomials()
+  {
+    for (std::size_t n = 0; n <= NumCards; ++n)
+    {
+      values[n][0] = 1;
+      for (std::size_t k = 1; k <= HandCards; ++k)
+      {
+        values[n][k] = n == 0 ? 0 : values[n - 1][k - 1] + values[n - 1][k];
+      }
+    }
+  }
+
+  std::uint32_t values[NumCards + 1][HandCards + 1];
+};
+
+const Binomials& binomials()
+{
+  static const Binomials table;
+  return table;
+}
+
+// dense index of a set of ascending cards among all sets of the same size
+std::size_t colex_index(const CardId* sorted, std::size_t count) noexcept
+{
+  const Binomials& table = binomials();
+  std::size_t index = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    index += table.values[sorted[i]][i + 1];
+  }
+
+  return index;
+}
+
+// gathers the cards of deal picked by mask, keeping them ascending
+std::size_t subset_cards(const CardId* deal, unsigned mask, CardId* cards) noexcept
+{
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < HandCards; ++i)
+  {
+    if (mask & (1u << i))
+    {
+      cards[count++] = deal[i];
+    }
+  }
+
+  return count;
+}
+
+// subtracts the value of every superset of each hold, turning per subset totals into totals over the hands that
+// contain exactly the held cards of the deal
+template <typename Subtract>
+void superset_moebius(Subtract subtract)
+{
+  for (unsigned bit = 1; bit < NumHolds; bit <<= 1)
+  {
+    for (unsigned mask = 0; mask < NumHolds; ++mask)
+    {
+      if (!(mask & bit))
+      {
+        subtract(mask, mask | bit);
+      }
+    }
+  }
+}
+
+// category of every five card hand and the number of hands of every category containing each smaller set
+struct DrawTables
+{
+  DrawTables()
+    : categories(binomials().values[NumCards][HandCards])
+  {
+    for (std::size_t k = 0; k < HandCards; ++k)
+    {
+      counts[k].assign(binomials().values[NumCards][k] * NumPayCategories, 0);
+    }
+
+    CardId hand[HandCards];
+    for (hand[4] = 4; hand[4] < NumCards; ++hand[4])
+    {
+      for (hand[3] = 3; hand[3] < hand[4]; ++hand[3])
+      {
+        for (hand[2] = 2; hand[2] < hand[3]; ++hand[2])
+        {
+          for (hand[1] = 1; hand[1] < hand[2]; ++hand[1])
+          {
+            for (hand[0] = 0; hand[0] < hand[1]; ++hand[0])
+            {
+              add(hand);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void add(const CardId* hand)
+  {
+    const std::size_t category = static_cast<std::size_t>(pay_category(CardSet(hand, HandCards)));
+    categories[colex_index(hand, HandCards)] = static_cast<std::uint8_t>(category);
+
+    CardId cards[HandCards];
+    for (unsigned mask = 0; mask + 1 < NumHolds; ++mask)
+    {
+      const std::size_t count = subset_cards(hand, mask, cards);
+      ++counts[count][colex_index(cards, count) * NumPayCategories + category];
+    }
+  }
+
+  std::vector<std::uint8_t> categories;          // PayCategory of every five card hand, by colex index
+  std::vector<std::uint32_t> counts[HandCards];  // per set of k < 5 cards, the hands of every category containing it
+};
+
+const DrawTables& draw_tables()
+{
+  static const DrawTables tables;
+  return tables;
+}
+
+struct PartialAnalysis
+{
+  double total;
+  double categories[NumPayCategories];
+  std::uint64_t deal_classes;
+};
+
+}  // namespace
+
+PayCategory deck_of_cards::pay_category(CardSet hand) noexcept
+{
+  std::uint32_t ranks = 0;
+  std::uint32_t pairs = 0;
+  std::uint32_t trips = 0;
+  bool flush = false;
+  for (const auto suit : Suits)
+  {
+    const std::uint32_t mask = hand.suit_mask(suit);
+    const std::uint32_t poker = (mask >> 1) | ((mask & 1) << 12);
+    flush = flush || __builtin_popcount(mask) == 5;
+    // ranks held in at least three and at least two of the suits so far
+    trips |= pairs & poker;
+    pairs |= ranks & poker;
+    ranks |= poker;
+  }
+
+  switch (__builtin_popcount(ranks))
+  {
+    case 5:
+    {
+      const bool straight = ranks == WheelRanks || (ranks >> __builtin_ctz(ranks)) == 0x1F;
+      if (straight && flush)
+      {
+        return ranks == BroadwayRanks ? PayCategory::RoyalFlush : PayCategory::StraightFlush;
+      }
+      return flush ? PayCategory::Flush : straight ? PayCategory::Straight : PayCategory::Nothing;
+    }
+    case 4:
+      return __builtin_ctz(pairs) >= JackRank ? PayCategory::HighPair : PayCategory::LowPair;
+    case 3:
+      return trips != 0 ? PayCategory::ThreeOfAKind : PayCategory::TwoPair;
+    default:
+      // two values: four of a kind leaves a single value with a pair, a full house two of them
+      return __builtin_popcount(pairs) == 1 ? PayCategory::FourOfAKind : PayCategory::FullHouse;
+  }
+}
+
+Paytable deck_of_cards::Paytable::jacks_or_better() noexcept
+{
+  return Paytable{ { 0, 0, 1, 2, 3, 4, 6, 9, 25, 50, 800 } };
+}
+
+deck_of_cards::VideoPokerSolver::VideoPokerSolver(const Paytable& paytable)
+  : m_paytable(paytable)
+{
+  const DrawTables& tables = draw_tables();
+  for (std::size_t k = 0; k < HandCards; ++k)
+  {
+    const std::size_t num_sets = tables.counts[k].size() / NumPayCategories;
+    m_totals[k].resize(num_sets);
+    for (std::size_t set = 0; set < num_sets; ++set)
+    {
+      double total = 0;
+      for (std::size_t category = 0; category < NumPayCategories; ++category)
+      {
+        total += tables.counts[k][set * NumPayCategories + category] * paytable.pays[category];
+      }
+      m_totals[k][set] = total;
+    }
+  }
+}
+
+void deck_of_cards::VideoPokerSolver::subset_values(const CardId* sorted, double* values) const noexcept
+{
+  const DrawTables& tables = draw_tables();
+  CardId cards[HandCards];
+  for (unsigned mask = 0; mask < NumHolds; ++mask)
+  {
+    const std::size_t count = subset_cards(sorted, mask, cards);
+    values[mask] = count == HandCards ? m_paytable.pays[tables.categories[colex_index(cards, count)]]
+                                      : m_totals[count][colex_index(cards, count)];
+  }
+
+  superset_moebius([values](unsigned mask, unsigned superset) { values[mask] -= values[superset]; });
+
+  const Binomials& table = binomials();
+  for (unsigned mask = 0; mask < NumHolds; ++mask)
+  {
+    values[mask] /= table.values[NumCards - HandCards][HandCards - __builtin_popcount(mask)];
+  }
+}
+
+void deck_of_cards::VideoPokerSolver::hold_values(const CardId* cards, double* values) const
+{
+  std::pair<CardId, unsigned> sorted[HandCards];
+  for (std::size_t i = 0; i < HandCards; ++i)
+  {
+    if (cards[i] >= NumCards)
+    {
+      throw std::invalid_argument("Card id out of range");
+    }
+    sorted[i] = std::make_pair(cards[i], 1u << i);
+  }
+  std::sort(sorted, sorted + HandCards);
+  CardId sorted_cards[HandCards];
+  for (std::size_t i = 0; i < HandCards; ++i)
+  {
+    if (i > 0 && sorted[i].first == sorted[i - 1].first)
+    {
+      throw std::invalid_argument("A deal needs five different cards");
+    }
+    sorted_cards[i] = sorted[i].first;
+  }
+
+  double sorted_values[NumHolds];
+  subset_values(sorted_cards, sorted_values);
+  for (unsigned mask = 0; mask < NumHolds; ++mask)
+  {
+    unsigned hold = 0;
+    for (std::size_t i = 0; i < HandCards; ++i)
+    {
+      hold |= (mask & (1u << i)) ? sorted[i].second : 0;
+    }
+    values[hold] = sorted_values[mask];
+  }
+}
+
+unsigned deck_of_cards::VideoPokerSolver::best_hold(const CardId* cards) const
+{
+  double values[NumHolds];
+  hold_values(cards, values);
+
+  return static_cast<unsigned>(std::max_element(values, values + NumHolds) - values);
+}
+
+VideoPokerAnalysis deck_of_cards::VideoPokerSolver::analyze(std::size_t num_threads) const
+{
+  const DrawTables& tables = draw_tables();
+  const Binomials& table = binomials();
+
+  // one task per highest card of the deal
+  std::vector<PartialAnalysis> partials(NumCards, PartialAnalysis());
+  {
+    ThreadPool pool(num_threads);
+    for (CardId top = HandCards - 1; top < NumCards; ++top)
+    {
+      pool.submit([this, &tables, &table, &partials, top]() {
+        PartialAnalysis& partial = partials[top];
+        CardId deal[HandCards];
+        deal[4] = top;
+        for (deal[3] = 3; deal[3] < deal[4]; ++deal[3])
+        {
+          for (deal[2] = 2; deal[2] < deal[3]; ++deal[2])
+          {
+            for (deal[1] = 1; deal[1] < deal[2]; ++deal[1])
+            {
+              for (deal[0] = 0; deal[0] < deal[1]; ++deal[0])
+              {
+                // solve only the deal whose suits are ordered by descending rank mask, for its whole class
+                const CardSet cards(deal, HandCards);
+                if (!suit_canonical(cards))
+                {
+                  continue;
+                }
+                const double weight = static_cast<double>(suit_class_size(cards));
+
+                double values[NumHolds];
+                subset_values(deal, values);
+                const unsigned best = static_cast<unsigned>(std::max_element(values, values + NumHolds) - values);
+                partial.total += weight * values[best];
+                ++partial.deal_classes;
+
+                // distribution of the final hand under the best hold, by inclusion-exclusion over the discards
+                const unsigned discards = (NumHolds - 1) & ~best;
+                const double draws = table.values[NumCards - HandCards][HandCards - __builtin_popcount(best)];
+                CardId held[HandCards];
+                for (unsigned extra = discards;; extra = (extra - 1) & discards)
+                {
+                  const unsigned mask = best | extra;
+                  const double sign = (__builtin_popcount(extra) & 1) ? -weight / draws : weight / draws;
+                  const std::size_t count = subset_cards(deal, mask, held);
+                  const std::size_t index = colex_index(held, count);
+                  if (count == HandCards)
+                  {
+                    partial.categories[tables.categories[index]] += sign;
+                  }
+                  else
+                  {
+                    for (std::size_t category = 0; category < NumPayCategories; ++category)
+                    {
+                      partial.categories[category] += sign * tables.counts[count][index * NumPayCategories + category];
+                    }
+                  }
+                  if (extra == 0)
+                  {
+                    break;
+                  }
+                }
+              }
+            }
+          }
+        }
+      });
+    }
+    pool.wait_idle();
+  }
+
+  VideoPokerAnalysis analysis = VideoPokerAnalysis();
+  const double deals = table.values[NumCards][HandCards];
+  for (const auto& partial : partials)
+  {
+    analysis.expected_return += partial.total / deals;
+    analysis.deal_classes += partial.deal_classes;
+    for (std::size_t category = 0; category < NumPayCategories; ++category)
+    {
+      analysis.probabilities[category] += partial.categories[category] / deals;
+    }
+  }
+
+  return analysis;
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <AliasTable.hpp>
+#include <Statistics.hpp>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(AliasTableTest, ProbabilityTest)
+{
+  using namespace deck_of_cards;
+  const double weights[] = { 1, 0, 3, 6, 0.5, 2.5 };
+  const AliasTable table(weights, 6);
+  EXPECT_EQ(table.size(), 6u);
+  for (std::size_t outcome = 0; outcome < 6; ++outcome)
+  {
+    EXPECT_NEAR(table.probability(outcome), weights[outcome] / 13, 1e-9);
+  }
+
+  const double single = 4;
+  EXPECT_DOUBLE_EQ(AliasTable(&single, 1).probability(0), 1);
+
+  const double negative[] = { 1, -1 };
+  const double zero[] = { 0, 0 };
+  EXPECT_THROW(AliasTable(weights, 0), std::invalid_argument);
+  EXPECT_THROW(AliasTable(negative, 2), std::invalid_argument);
+  EXPECT_THROW(AliasTable(zero, 2), std::invalid_argument);
+}
+
+TEST(AliasTableTest, SampleTest)
+{
+  using namespace deck_of_cards;
+  std::vector<double> weights(20);
+  double total = 0;
+  for (std::size_t i = 0; i < weights.size(); ++i)
+  {
+    weights[i] = i % 5 == 0 ? 0 : i;
+    total += weights[i];
+  }
+  const AliasTable table(weights.data(), weights.size());
+
+  const std::size_t draws = 200000;
+  std::mt19937_64 generator(3);
+  std::vector<std::uint64_t> randoms(draws);
+  for (auto& random : randoms)
+  {
+    random = generator();
+  }
+  std::vector<std::uint32_t> outcomes(draws);
+  table.sample_batch(randoms.data(), outcomes.data(), draws);
+
+  std::vector<std::size_t> counts(weights.size(), 0);
+  for (std::size_t i = 0; i < draws; ++i)
+  {
+    ASSERT_EQ(outcomes[i], table.sample(randoms[i]));
+    ++counts[outcomes[i]];
+  }
+
+  // chi-squared goodness of fit over the outcomes that can be drawn
+  double chi_squared = 0;
+  double cells = 0;
+  for (std::size_t i = 0; i < weights.size(); ++i)
+  {
+    if (weights[i] == 0)
+    {
+      EXPECT_EQ(counts[i], 0u);
+      continue;
+    }
+    const double expected = draws * weights[i] / total;
+    chi_squared += (counts[i] - expected) * (counts[i] - expected) / expected;
+    ++cells;
+  }
+  EXPECT_LT(chi_squared, chi_squared_critical_value(cells - 1, 1e-6));
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <Baccarat.hpp>
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <Shoe.hpp>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+int point(deck_of_cards::CardId card)
+{
+  return card % 13 < 9 ? card % 13 + 1 : 0;
+}
+
+}  // namespace
+
+TEST(BaccaratTest, TableauTest)
+{
+  using namespace deck_of_cards;
+  // banker draws with 0 to 5 after a standing player, and by the point of the player's third card otherwise
+  const char* rows[] = { "DDDDDDDDDD", "DDDDDDDDDD", "DDDDDDDDDD", "DDDDDDDDSD",
+                         "SSDDDDDDSS", "SSSSDDDDSS", "SSSSSSDDSS", "SSSSSSSSSS" };
+  for (int banker = 0; banker < 8; ++banker)
+  {
+    EXPECT_EQ(banker_draws(banker, -1), banker <= 5);
+    for (int third = 0; third < 10; ++third)
+    {
+      EXPECT_EQ(banker_draws(banker, third), rows[banker][third] == 'D') << banker << " " << third;
+    }
+  }
+
+  for (std::size_t index = 0; index < NumBaccaratOutcomes; ++index)
+  {
+    ASSERT_EQ(outcome_index(outcome_at(index)), index);
+  }
+}
+
+TEST(BaccaratTest, ExactTest)
+{
+  using namespace deck_of_cards;
+  // the published figures for eight decks
+  const BaccaratDistribution distribution{ Shoe(8) };
+  EXPECT_NEAR(distribution.banker_win(), 0.458597, 1e-6);
+  EXPECT_NEAR(distribution.player_win(), 0.446247, 1e-6);
+  EXPECT_NEAR(distribution.tie(), 0.095156, 1e-6);
+  EXPECT_NEAR(distribution.expected_value(&banker_bet), -0.010579, 1e-6);
+  EXPECT_NEAR(distribution.expected_value(&player_bet), -0.012351, 1e-6);
+  EXPECT_NEAR(distribution.expected_value(&tie_bet), -0.143596, 1e-6);
+  EXPECT_NEAR(distribution.expected_value(&player_pair_bet), -0.103614, 1e-6);
+  EXPECT_NEAR(distribution.expected_value(&dragon_seven_bet), -0.076113, 1e-6);
+  EXPECT_NEAR(distribution.expected_value(&panda_eight_bet), -0.1019, 1e-4);
+}
+
+TEST(BaccaratTest, DepletedTest)
+{
+  using namespace deck_of_cards;
+  Deck deck;
+  deck.shuffle();
+  CardId dealt[41];
+  deck.deal_cards(dealt, 41);
+  const CardSet undealt = deck.undealt();
+  std::vector<CardId> cards;
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    if (undealt.contains(card))
+    {
+      cards.push_back(card);
+    }
+  }
+
+  // play every ordered sequence of six of the eleven remaining cards
+  std::vector<double> expected(NumBaccaratOutcomes);
+  double sequences = 0;
+  CardId order[6];
+  std::vector<bool> used(cards.size());
+  std::function<void(std::size_t)> deal = [&](std::size_t depth) {
+    if (depth == 6)
+    {
+      int player = (point(order[0]) + point(order[2])) % 10;
+      int banker = (point(order[1]) + point(order[3])) % 10;
+      int player_cards = 2;
+      int banker_cards = 2;
+      if (player < 8 && banker < 8)
+      {
+        int third = -1;
+        if (player <= 5)
+        {
+          third = point(order[4]);
+          player = (player + third) % 10;
+          player_cards = 3;
+        }
+        if (banker_draws(banker, third))
+        {
+          banker = (banker + point(order[player_cards == 3 ? 5 : 4])) % 10;
+          banker_cards = 3;
+        }
+      }
+      const BaccaratOutcome outcome{ static_cast<std::uint8_t>(player), static_cast<std::uint8_t>(banker),
+                                     static_cast<std::uint8_t>(player_cards), static_cast<std::uint8_t>(banker_cards),
+                                     order[0] % 13 == order[2] % 13, order[1] % 13 == order[3] % 13 };
+      expected[outcome_index(outcome)] += 1;
+      sequences += 1;
+      return;
+    }
+    for (std::size_t i = 0; i < cards.size(); ++i)
+    {
+      if (!used[i])
+      {
+        used[i] = true;
+        order[depth] = cards[i];
+        deal(depth + 1);
+        used[i] = false;
+      }
+    }
+  };
+  deal(0);
+
+  const BaccaratDistribution distribution(deck);
+  for (std::size_t index = 0; index < NumBaccaratOutcomes; ++index)
+  {
+    ASSERT_NEAR(distribution.probability(outcome_at(index)), expected[index] / sequences, 1e-12) << index;
+  }
+
+  deck.deal_cards(dealt, 6);
+  EXPECT_THROW(BaccaratDistribution{ deck }, std::invalid_argument);
+}
+
+TEST(BaccaratTest, SimulatorTest)
+{
+  using namespace deck_of_cards;
+  BaccaratSimulator::Config config;
+  const BaccaratSimulator simulator(config);
+  const BaccaratBet bets[] = { &banker_bet, &player_pair_bet, &dragon_seven_bet };
+  const BaccaratSimulation simulation = simulator.run(bets, 3, 400000, 2);
+  EXPECT_EQ(simulation.coups, 400000u);
+  EXPECT_GT(simulation.shoes, 400000u / 90);
+
+  // the shoe is reshuffled well before depletion matters, so the fresh shoe figures hold
+  const BaccaratDistribution distribution{ Shoe(8) };
+  for (std::size_t bet = 0; bet < 3; ++bet)
+  {
+    EXPECT_GT(simulation.standard_errors[bet], 0);
+    EXPECT_NEAR(simulation.means[bet], distribution.expected_value(bets[bet]), 5 * simulation.standard_errors[bet]);
+  }
+
+  // the same seed and thread count reproduce the run
+  EXPECT_EQ(simulator.run(bets, 3, 1000, 2).means, simulator.run(bets, 3, 1000, 2).means);
+
+  config.cut_card = 5;
+  EXPECT_THROW(BaccaratSimulator{ config }, std::invalid_argument);
+}
+
+TEST(BaccaratTest, InfiniteDeckTest)
+{
+  using namespace deck_of_cards;
+  BaccaratSimulator::Config config;
+  config.infinite_deck = true;
+  const BaccaratSimulator simulator(config);
+  const BaccaratBet bets[] = { &banker_bet, &player_bet, &tie_bet, &player_pair_bet };
+  const BaccaratSimulation simulation = simulator.run(bets, 4, 400000, 2);
+  EXPECT_EQ(simulation.shoes, 2u);
+
+  // a shoe of a hundred thousand decks is as good as infinite at this precision
+  std::size_t counts[13];
+  std::fill(counts, counts + 13, 400000);
+  const BaccaratDistribution distribution(counts);
+  for (std::size_t bet = 0; bet < 4; ++bet)
+  {
+    EXPECT_NEAR(simulation.means[bet], distribution.expected_value(bets[bet]), 5 * simulation.standard_errors[bet]);
+  }
+  // pairs are rarer in a finite shoe
+  const BaccaratDistribution eight_decks{ Shoe(8) };
+  EXPECT_GT(distribution.expected_value(&player_pair_bet), eight_decks.expected_value(&player_pair_bet));
+
+  InfiniteShoe shoe;
+  for (int coup = 0; coup < 1000; ++coup)
+  {
+    const BaccaratOutcome outcome = play_coup(shoe);
+    EXPECT_LE(outcome.player_total, 9);
+  }
+  EXPECT_GE(shoe.num_dealt(), 4000u);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <BitslicedEvaluator.hpp>
+#include <CardSet.hpp>
+#include <HandEvaluator.hpp>
+#include <Pipeline.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+std::vector<deck_of_cards::CardSet> random_hands(std::size_t count)
+{
+  std::vector<deck_of_cards::CardSet> hands(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const std::size_t size = 5 + i % 3;
+    while (hands[i].size() < size)
+    {
+      hands[i].insert(static_cast<deck_of_cards::CardId>(rand() % deck_of_cards::NumCards));
+    }
+  }
+
+  return hands;
+}
+
+}  // namespace
+
+TEST(BitslicedEvaluatorTest, TransposeTest)
+{
+  using namespace deck_of_cards;
+  std::uint64_t words[64];
+  std::uint64_t original[64];
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    words[i] = original[i] = (std::uint64_t(rand()) << 33) ^ (std::uint64_t(rand()) << 11) ^ rand();
+  }
+
+  transpose_bits(words);
+  for (std::size_t row = 0; row < 64; ++row)
+  {
+    for (std::size_t column = 0; column < 64; ++column)
+    {
+      ASSERT_EQ((words[column] >> row) & 1, (original[row] >> column) & 1);
+    }
+  }
+}
+
+TEST(BitslicedEvaluatorTest, MatchesLookupTest)
+{
+  using namespace deck_of_cards;
+  // an odd count leaves partially filled blocks for both bitsliced kernels
+  const std::vector<CardSet> hands = random_hands(3001);
+  const BitslicedEvaluator::Kernel kernels[] = { BitslicedEvaluator::Kernel::Lookup,
+                                                 BitslicedEvaluator::Kernel::Bitsliced64,
+                                                 BitslicedEvaluator::Kernel::Bitsliced512 };
+
+  for (const auto kernel : kernels)
+  {
+    const BitslicedEvaluator evaluator(kernel);
+    std::vector<HandCategory> categories(hands.size());
+    evaluator.categorize(hands.data(), categories.data(), hands.size());
+    for (std::size_t i = 0; i < hands.size(); ++i)
+    {
+      ASSERT_EQ(categories[i], hand_category(evaluate(hands[i]))) << "hand " << i;
+    }
+  }
+}
+
+TEST(BitslicedEvaluatorTest, CalibrateTest)
+{
+  using namespace deck_of_cards;
+  // calibrating leaves the rand() stream of Deck alone
+  srand(17);
+  const int expected = rand();
+  srand(17);
+  BitslicedEvaluator::calibrate(512);
+  EXPECT_EQ(rand(), expected);
+}
+
+TEST(BitslicedEvaluatorTest, CategoryTest)
+{
+  using namespace deck_of_cards;
+  const BitslicedEvaluator evaluator(BitslicedEvaluator::Kernel::Bitsliced64);
+  const CardId wheel_straight_flush[] = { 0, 1, 2, 3, 4, 20, 30 };
+  const CardId broadway[] = { 0, 22, 11, 12, 10, 40, 41 };
+  const CardId two_trips[] = { 5, 18, 31, 6, 19, 32, 50 };
+  const CardId flush[] = { 13, 15, 17, 19, 21, 0, 26 };
+  const CardSet hands[] = { CardSet(wheel_straight_flush, 7), CardSet(broadway, 7), CardSet(two_trips, 7),
+                            CardSet(flush, 7) };
+
+  HandCategory categories[4];
+  evaluator.categorize(hands, categories, 4);
+  EXPECT_EQ(categories[0], HandCategory::StraightFlush);
+  EXPECT_EQ(categories[1], HandCategory::Straight);
+  EXPECT_EQ(categories[2], HandCategory::FullHouse);
+  EXPECT_EQ(categories[3], HandCategory::Flush);
+
+  const CardSet four(static_cast<std::uint64_t>(0xF));
+  EXPECT_THROW(evaluator.categorize(&four, categories, 1), std::invalid_argument);
+}
+
+TEST(BitslicedEvaluatorTest, CardBatchTest)
+{
+  using namespace deck_of_cards;
+  TableState lane{ PackedDeck(), TableGenerator(1, 0) };
+  CardBatch batch;
+  batch.num_hands = 100;
+  batch.cards_per_hand = 7;
+  Pipeline::deal_hands(lane, batch);
+
+  HandCategory categories[MaxBatchHands];
+  BitslicedEvaluator::instance().categorize(batch, categories);
+  for (std::size_t i = 0; i < batch.num_hands; ++i)
+  {
+    EXPECT_EQ(categories[i], hand_category(evaluate(CardSet(batch.hand(i), 7))));
+  }
+}
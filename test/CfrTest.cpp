@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <Cfr.hpp>
+#include <stdexcept>
+#include <vector>
+
+TEST(CfrTest, InfosetTableTest)
+{
+  using namespace deck_of_cards;
+  InfosetTable table(4);
+  for (std::uint64_t history = 1; history <= 100; ++history)
+  {
+    table.insert(history, static_cast<std::uint32_t>(history % 7), 2).regrets[0] = static_cast<float>(history);
+  }
+  EXPECT_EQ(table.size(), 100u);
+  EXPECT_GE(table.slots().size(), 200u);
+  for (std::uint64_t history = 1; history <= 100; ++history)
+  {
+    const CfrInfoset* infoset = table.find(history, static_cast<std::uint32_t>(history % 7));
+    ASSERT_NE(infoset, nullptr);
+    EXPECT_EQ(infoset->regrets[0], static_cast<float>(history));
+    EXPECT_EQ(infoset->num_actions, 2u);
+  }
+  EXPECT_EQ(table.find(1, 2), nullptr);
+
+  table.clear();
+  EXPECT_EQ(table.size(), 0u);
+  EXPECT_EQ(table.find(5, 5), nullptr);
+}
+
+TEST(CfrTest, KuhnTest)
+{
+  using namespace deck_of_cards;
+  const KuhnPoker game;
+  CfrSolver::Config config;
+  config.num_threads = 2;
+  CfrSolver solver(game, config);
+  solver.train(1000);
+  EXPECT_EQ(solver.iterations(), 1000u);
+  EXPECT_EQ(solver.num_infosets(), 12u);
+
+  // the equilibrium: player 0 loses 1/18, never bets a queen and bets a king three times as often as a jack
+  EXPECT_LT(solver.exploitability(), 1e-3);
+  EXPECT_NEAR(solver.expected_value(), -1.0 / 18, 2e-3);
+  const std::size_t raise = static_cast<std::size_t>(CfrAction::Raise);
+  const double jack = solver.average_strategy({}, 10)[raise];
+  EXPECT_LT(solver.average_strategy({}, 11)[raise], 0.01);
+  EXPECT_NEAR(solver.average_strategy({}, 12)[raise], 3 * jack, 0.03);
+  // player 1 folds a jack and calls with a king facing a bet
+  EXPECT_GT(solver.average_strategy({ CfrAction::Raise }, 10)[static_cast<std::size_t>(CfrAction::Fold)], 0.99);
+  EXPECT_GT(solver.average_strategy({ CfrAction::Raise }, 12)[static_cast<std::size_t>(CfrAction::Call)], 0.99);
+  EXPECT_EQ(solver.average_strategy({ CfrAction::Raise }, 12).size(), NumCfrActions);
+
+  EXPECT_THROW(solver.average_strategy({ CfrAction::Fold }, 10), std::invalid_argument);
+  EXPECT_THROW(solver.average_strategy({ CfrAction::Raise, CfrAction::Call }, 10), std::invalid_argument);
+}
+
+namespace
+{
+// Kuhn poker with four rounds of betting, capped at a given number of raises each
+class LongKuhnPoker : public deck_of_cards::KuhnPoker
+{
+public:
+  explicit LongKuhnPoker(int max_raises)
+    : m_max_raises(max_raises)
+  {
+  }
+
+  std::vector<deck_of_cards::BettingRound> rounds() const override
+  {
+    return std::vector<deck_of_cards::BettingRound>(4, { 0, 1, m_max_raises });
+  }
+
+private:
+  int m_max_raises;
+};
+
+}  // namespace
+
+TEST(CfrTest, HistoryLimitTest)
+{
+  using namespace deck_of_cards;
+  CfrSolver::Config config;
+  config.num_threads = 1;
+
+  // four rounds of a check, five raises and a call are 28 actions, six raises make 32
+  const LongKuhnPoker fits(5);
+  EXPECT_NO_THROW(CfrSolver(fits, config));
+  const LongKuhnPoker overflows(6);
+  EXPECT_THROW(CfrSolver(overflows, config), std::invalid_argument);
+}
+
+TEST(CfrTest, LeducTest)
+{
+  using namespace deck_of_cards;
+  const LeducPoker game;
+  CfrSolver::Config config;
+  config.num_threads = 2;
+  CfrSolver solver(game, config);
+  solver.train(300);
+  EXPECT_EQ(solver.num_infosets(), 288u);
+  EXPECT_LT(solver.exploitability(), 0.01);
+  EXPECT_NEAR(solver.expected_value(), -0.0856, 0.01);
+}
+
+TEST(CfrTest, ExternalSamplingTest)
+{
+  using namespace deck_of_cards;
+  const KuhnPoker game;
+  CfrSolver::Config config;
+  config.algorithm = CfrAlgorithm::ExternalSampling;
+  config.num_threads = 4;
+  config.seed = 7;
+  CfrSolver solver(game, config);
+  solver.train(2000);
+  EXPECT_LT(solver.exploitability(), 0.02);
+
+  // a fixed seed and thread count reproduce the run exactly, another seed does not
+  CfrSolver same(game, config);
+  same.train(2000);
+  config.seed = 8;
+  CfrSolver other(game, config);
+  other.train(2000);
+  EXPECT_EQ(same.expected_value(), solver.expected_value());
+  EXPECT_EQ(same.average_strategy({ CfrAction::Call }, 11), solver.average_strategy({ CfrAction::Call }, 11));
+  EXPECT_NE(other.expected_value(), solver.expected_value());
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <Cribbage.hpp>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+deck_of_cards::CardSet cards(std::initializer_list<deck_of_cards::CardId> ids)
+{
+  return deck_of_cards::CardSet(ids.begin(), ids.size());
+}
+
+}  // namespace
+
+TEST(CribbageTest, ScoreTest)
+{
+  using namespace deck_of_cards;
+  // club ids: ace 0, deuce 1, ..., king 12; diamonds start at 13, hearts at 26 and spades at 39
+  // three fives and the jack of spades, cut the five of spades: the perfect 29
+  EXPECT_EQ(cribbage_score(cards({ 4, 17, 30, 49 }), 43), 29);
+  // with the jack of clubs instead there are no nobs
+  EXPECT_EQ(cribbage_score(cards({ 4, 17, 30, 10 }), 43), 28);
+  // 3-3-4-5 cut a 4: two fifteens, two pairs and four runs of three
+  EXPECT_EQ(cribbage_score(cards({ 2, 15, 3, 4 }), 16), 4 + 4 + 12);
+  // a four card flush scores in the hand but not in the crib, five of a suit score in both
+  EXPECT_EQ(cribbage_score(cards({ 0, 2, 6, 12 }), 21), 4);
+  EXPECT_EQ(cribbage_score(cards({ 0, 2, 6, 12 }), 21, true), 0);
+  EXPECT_EQ(cribbage_score(cards({ 0, 2, 6, 12 }), 8, true), 5);
+  // nobs alone
+  EXPECT_EQ(cribbage_score(cards({ 23, 1, 29, 37 }), 20), 1);
+}
+
+TEST(CribbageTest, DistributionTest)
+{
+  using namespace deck_of_cards;
+  // every hand and starter: the well known counts of 29s and of the impossible 19
+  std::uint64_t counts[30] = {};
+  std::uint64_t hands = 0;
+  for (CardId a = 0; a < NumCards; ++a)
+  {
+    for (CardId b = a + 1; b < NumCards; ++b)
+    {
+      for (CardId c = b + 1; c < NumCards; ++c)
+      {
+        for (CardId d = c + 1; d < NumCards; ++d)
+        {
+          const CardSet hand = cards({ a, b, c, d });
+          for (CardId starter = 0; starter < NumCards; ++starter)
+          {
+            if (!hand.contains(starter))
+            {
+              ++counts[cribbage_score(hand, starter)];
+              ++hands;
+            }
+          }
+        }
+      }
+    }
+  }
+  EXPECT_EQ(hands, 12994800u);
+  EXPECT_EQ(counts[0], 1009008u);
+  EXPECT_EQ(counts[19], 0u);
+  EXPECT_EQ(counts[29], 4u);
+}
+
+TEST(CribbageTest, AnalyzeTest)
+{
+  using namespace deck_of_cards;
+  const CribbageAnalyzer analyzer(2);
+
+  // the cache agrees with the exhaustive enumeration for every suit pattern
+  for (const CardSet discard : { cards({ 4, 17 }), cards({ 4, 10 }), cards({ 4, 23 }), cards({ 39, 51 }) })
+  {
+    EXPECT_NEAR(analyzer.crib_value(discard), CribbageAnalyzer::exact_crib_value(discard), 1e-12);
+  }
+  // a pair of fives is the best discard to one's own crib
+  EXPECT_GT(analyzer.crib_value(cards({ 4, 17 })), 8);
+  EXPECT_GT(analyzer.crib_value(cards({ 4, 17 })), analyzer.crib_value(cards({ 4, 10 })));
+
+  // 5-5-J-K-3-9: the dealer keeps the fives and the jack, the pone gives away neither five
+  const CardSet dealt = cards({ 4, 17, 10, 25, 28, 47 });
+  const auto dealer = analyzer.analyze(dealt, true);
+  ASSERT_EQ(dealer.size(), 15u);
+  for (std::size_t i = 1; i < dealer.size(); ++i)
+  {
+    EXPECT_GE(dealer[i - 1].expected_value, dealer[i].expected_value);
+  }
+  const auto pone = analyzer.analyze(dealt, false);
+  EXPECT_FALSE(pone[0].discard.contains(4) || pone[0].discard.contains(17));
+
+  // the hand value averages all 46 starters
+  double points = 0;
+  for (CardId starter = 0; starter < NumCards; ++starter)
+  {
+    points += dealt.contains(starter) ? 0 : cribbage_score(dealer[0].keep, starter);
+  }
+  EXPECT_NEAR(dealer[0].hand_value, points / 46, 1e-12);
+  EXPECT_NEAR(dealer[0].expected_value, dealer[0].hand_value + dealer[0].crib_value, 1e-12);
+
+  EXPECT_THROW(analyzer.analyze(cards({ 1, 2, 3 }), true), std::invalid_argument);
+  EXPECT_THROW(analyzer.crib_value(cards({ 1 })), std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <DeckBatch.hpp>
+#include <PageBuffer.hpp>
+#include <cstdint>
+#include <random>
+
+TEST(DeckBatchTest, PageBufferFallbackTest)
+{
+  using namespace deck_of_cards;
+  const PageMode modes[] = { PageMode::Default, PageMode::Transparent, PageMode::Explicit };
+
+  for (const auto mode : modes)
+  {
+    PageBuffer buffer(3 * HugePageSize + 1, mode);
+    ASSERT_NE(buffer.data(), nullptr);
+    EXPECT_GE(buffer.size(), 3 * HugePageSize + 1);
+
+    // whatever was obtained, huge page backing is 2 MB aligned
+    if (buffer.mode() != PageMode::Default)
+    {
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % HugePageSize, 0u);
+    }
+    EXPECT_EQ(static_cast<unsigned char*>(buffer.data())[buffer.size() - 1], 0);
+
+    PageBuffer moved(std::move(buffer));
+    EXPECT_EQ(buffer.data(), nullptr);
+    EXPECT_NE(moved.data(), nullptr);
+  }
+}
+
+TEST(DeckBatchTest, ShuffleAllTest)
+{
+  using namespace deck_of_cards;
+  DeckBatch batch(1000, PageMode::Transparent);
+  std::mt19937 generator(5);
+  batch.shuffle_all(generator);
+
+  std::size_t unmoved = 0;
+  for (std::size_t deck = 0; deck < batch.size(); ++deck)
+  {
+    const CardSet cards(batch.order(deck), NumCards);
+    EXPECT_EQ(cards, CardSet::full());
+    EXPECT_EQ(batch.num_cards(deck), NumCards);
+    unmoved += batch.order(deck)[0] == 0;
+  }
+  // the first card stays put about once every 52 decks
+  EXPECT_LT(unmoved, 60u);
+}
+
+TEST(DeckBatchTest, DealTest)
+{
+  using namespace deck_of_cards;
+  DeckBatch batch(4);
+  batch.shuffle_all();
+
+  CardId hand[NumCards];
+  EXPECT_EQ(batch.deal_cards(2, hand, 5), 5u);
+  EXPECT_EQ(hand[0], batch.order(2)[0]);
+  EXPECT_EQ(batch.num_cards(2), NumCards - 5);
+  EXPECT_EQ(batch.num_cards(1), NumCards);
+
+  // shuffling leaves the dealt cards in place
+  batch.shuffle_all();
+  EXPECT_EQ(hand[4], batch.order(2)[4]);
+  EXPECT_EQ(batch.deal_cards(2, hand, NumCards), NumCards - 5);
+  EXPECT_EQ(batch.deal_cards(2, hand, 1), 0u);
+
+  batch.reset_all();
+  EXPECT_EQ(batch.num_cards(2), NumCards);
+}
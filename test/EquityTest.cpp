@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <Equity.hpp>
+#include <HandEvaluator.hpp>
+#include <PreflopEquity.hpp>
+#include <Range.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace
+{
+deck_of_cards::CardSet cards(std::initializer_list<deck_of_cards::CardId> ids)
+{
+  return deck_of_cards::CardSet(ids.begin(), ids.size());
+}
+
+// sums every compatible (runout, hero, villain) triple directly
+deck_of_cards::EquityResult brute_force(const deck_of_cards::Range& hero, const deck_of_cards::Range& villain,
+                                        deck_of_cards::CardSet board, deck_of_cards::CardSet dead)
+{
+  using namespace deck_of_cards;
+  const CardSet remaining = CardSet::full() - board - dead;
+  double win = 0;
+  double tie = 0;
+  double matchups = 0;
+  for (CardId turn = 0; turn < NumCards; ++turn)
+  {
+    if (!remaining.contains(turn))
+    {
+      continue;
+    }
+    const CardSet full = board | CardSet(std::uint64_t(1) << turn);
+    for (std::size_t h = 0; h < NumCombos; ++h)
+    {
+      const CardSet hero_cards = combo_cards(h);
+      if (hero.weight(h) == 0 || hero_cards.intersects(full | dead))
+      {
+        continue;
+      }
+      for (std::size_t v = 0; v < NumCombos; ++v)
+      {
+        const CardSet villain_cards = combo_cards(v);
+        if (villain.weight(v) == 0 || villain_cards.intersects(full | dead | hero_cards))
+        {
+          continue;
+        }
+        const double weight = double(hero.weight(h)) * villain.weight(v);
+        const HandRank hero_rank = evaluate(full | hero_cards);
+        const HandRank villain_rank = evaluate(full | villain_cards);
+        win += hero_rank > villain_rank ? weight : 0;
+        tie += hero_rank == villain_rank ? weight : 0;
+        matchups += weight;
+      }
+    }
+  }
+
+  EquityResult result;
+  result.win = win / matchups;
+  result.tie = tie / matchups;
+  result.equity = result.win + result.tie / 2;
+  result.matchups = matchups;
+  result.runouts = 0;
+  return result;
+}
+
+}  // namespace
+
+TEST(EquityTest, ComboIndexTest)
+{
+  using namespace deck_of_cards;
+  for (CardId high = 1; high < NumCards; ++high)
+  {
+    for (CardId low = 0; low < high; ++low)
+    {
+      const std::size_t combo = combo_index(low, high);
+      ASSERT_LT(combo, NumCombos);
+      ASSERT_EQ(combo, combo_index(high, low));
+      ASSERT_EQ(combo_low_card(combo), low);
+      ASSERT_EQ(combo_high_card(combo), high);
+      ASSERT_EQ(combo_cards(combo), cards({ low, high }));
+    }
+  }
+
+  Range range = Range::full();
+  EXPECT_EQ(range.num_combos(), NumCombos);
+  range.remove(cards({ 0 }));
+  EXPECT_EQ(range.num_combos(), NumCombos - 51);
+  EXPECT_THROW(range.set_weight(3, 3, 1), std::invalid_argument);
+  EXPECT_THROW(range.set_weight(0, 1, -1), std::invalid_argument);
+  EXPECT_THROW(range.set_weight(NumCombos, 1), std::out_of_range);
+}
+
+TEST(EquityTest, SingleComboTest)
+{
+  using namespace deck_of_cards;
+  // aces against kings on a dry flop: the kings need one of two outs twice, or runner-runner
+  Range aces;
+  aces.set_weight(card_id(Suit::Spade, Value::Ace), card_id(Suit::Heart, Value::Ace), 1);
+  Range kings;
+  kings.set_weight(card_id(Suit::Spade, Value::King), card_id(Suit::Heart, Value::King), 1);
+  const CardSet flop = cards({ card_id(Suit::Club, Value::Two), card_id(Suit::Diamond, Value::Seven),
+                               card_id(Suit::Club, Value::Nine) });
+
+  const EquityResult result = range_equity(aces, kings, flop);
+  EXPECT_EQ(result.runouts, 1176u);        // C(49, 2), runouts holding a hole card are skipped per combination
+  EXPECT_DOUBLE_EQ(result.matchups, 990);  // C(45, 2)
+  EXPECT_GT(result.equity, 0.9);
+
+  const EquityResult reverse = range_equity(kings, aces, flop, CardSet(), 2);
+  EXPECT_NEAR(result.equity + reverse.equity, 1, 1e-12);
+}
+
+TEST(EquityTest, WeightedRangesTest)
+{
+  using namespace deck_of_cards;
+  srand(11);
+  Range hero;
+  Range villain;
+  for (int i = 0; i < 40; ++i)
+  {
+    hero.set_weight(static_cast<std::size_t>(rand() % NumCombos), 0.25f + rand() % 4);
+    villain.set_weight(static_cast<std::size_t>(rand() % NumCombos), 0.5f + rand() % 3);
+  }
+  // overlapping ranges exercise the card removal between the two ranges
+  villain.set_weight(combo_index(0, 1), 1);
+  hero.set_weight(combo_index(0, 1), 1);
+  hero.set_weight(combo_index(0, 2), 1);
+
+  const CardSet board = cards({ 5, 18, 31, 44 });
+  const CardSet dead = cards({ 50, 3 });
+  const EquityResult result = range_equity(hero, villain, board, dead, 3);
+  const EquityResult expected = brute_force(hero, villain, board, dead);
+
+  EXPECT_EQ(result.runouts, 46u);
+  EXPECT_NEAR(result.matchups, expected.matchups, 1e-6 * expected.matchups);
+  EXPECT_NEAR(result.win, expected.win, 1e-9);
+  EXPECT_NEAR(result.tie, expected.tie, 1e-9);
+  EXPECT_NEAR(result.equity, expected.equity, 1e-9);
+}
+
+TEST(EquityTest, InvalidTest)
+{
+  using namespace deck_of_cards;
+  const Range full = Range::full();
+  EXPECT_THROW(range_equity(full, full, cards({ 1, 2 })), std::invalid_argument);
+  EXPECT_THROW(range_equity(full, full, cards({ 1, 2, 3 }), cards({ 3 })), std::invalid_argument);
+
+  Range only;
+  only.set_weight(0, 1, 1);
+  EXPECT_THROW(range_equity(only, only, cards({ 10, 11, 12 })), std::invalid_argument);
+}
+
+TEST(EquityTest, SimulationUnbiasedTest)
+{
+  using namespace deck_of_cards;
+  // a flush and overcard draw against an overpair
+  const CardSet hero = cards({ card_id(Suit::Heart, Value::Ace), card_id(Suit::Heart, Value::Jack) });
+  const CardSet villain = cards({ card_id(Suit::Spade, Value::Queen), card_id(Suit::Club, Value::Queen) });
+  const CardSet flop = cards({ card_id(Suit::Heart, Value::Two), card_id(Suit::Heart, Value::Seven),
+                               card_id(Suit::Diamond, Value::Ten) });
+  const double exact = heads_up_equity(hero, villain, flop);
+
+  const EquitySampling samplings[] = { EquitySampling::Independent, EquitySampling::Antithetic,
+                                       EquitySampling::Stratified, EquitySampling::ControlVariate };
+  for (const EquitySampling sampling : samplings)
+  {
+    // the spread of many small runs checks both the mean and the reported standard error
+    const int runs = 200;
+    double sum = 0;
+    double squares = 0;
+    double reported = 0;
+    for (int run = 0; run < runs; ++run)
+    {
+      EquitySimulator::Config config;
+      config.sampling = sampling;
+      config.seed = static_cast<std::uint64_t>(run) + 1;
+      config.pilot_deals = 200;
+      const EquitySimulation simulation = EquitySimulator(config).run(hero, villain, flop, 180, 1);
+      ASSERT_EQ(simulation.deals, 180u);
+      sum += simulation.equity;
+      squares += simulation.equity * simulation.equity;
+      reported += simulation.standard_error * simulation.standard_error;
+    }
+    const double mean = sum / runs;
+    const double variance = (squares - runs * mean * mean) / (runs - 1);
+    EXPECT_NEAR(mean, exact, 4.5 * std::sqrt(variance / runs)) << static_cast<int>(sampling);
+    EXPECT_NEAR(reported / runs / variance, 1, 0.4) << static_cast<int>(sampling);
+  }
+}
+
+TEST(EquityTest, EffectiveDealsTest)
+{
+  using namespace deck_of_cards;
+  const CardSet hero = cards({ card_id(Suit::Heart, Value::Ace), card_id(Suit::Heart, Value::Jack) });
+  const CardSet villain = cards({ card_id(Suit::Spade, Value::Queen), card_id(Suit::Club, Value::Queen) });
+  const CardSet flop = cards({ card_id(Suit::Heart, Value::Two), card_id(Suit::Heart, Value::Seven),
+                               card_id(Suit::Diamond, Value::Ten) });
+  const CardSet turn = flop | cards({ card_id(Suit::Club, Value::Three) });
+
+  EquitySimulator::Config config;
+  const EquitySimulation independent = EquitySimulator(config).run(hero, villain, flop, 20000, 2);
+  EXPECT_EQ(independent.deals, 20000u);
+  EXPECT_NEAR(independent.effective_deals / independent.deals, 1, 0.05);
+  EXPECT_NEAR(independent.equity, heads_up_equity(hero, villain, flop), 4 * independent.standard_error);
+
+  // counting hearts explains most of the outcome
+  config.sampling = EquitySampling::ControlVariate;
+  const EquitySimulation control = EquitySimulator(config).run(hero, villain, flop, 20000, 2);
+  EXPECT_GT(control.effective_deals, 1.5 * control.deals);
+  EXPECT_LT(control.standard_error, independent.standard_error);
+
+  // every river card is a runout class, dealt the same number of times
+  config.sampling = EquitySampling::Stratified;
+  const EquitySimulation stratified = EquitySimulator(config).run(hero, villain, turn, 44 * 3, 2);
+  EXPECT_NEAR(stratified.equity, heads_up_equity(hero, villain, turn), 1e-12);
+  EXPECT_GT(stratified.effective_deals, 1e6);
+
+  config.sampling = EquitySampling::Antithetic;
+  const EquitySimulation antithetic = EquitySimulator(config).run(hero, villain, flop, 20001, 2);
+  EXPECT_EQ(antithetic.deals, 20000u);
+  EXPECT_NEAR(antithetic.equity, heads_up_equity(hero, villain, flop), 4 * antithetic.standard_error);
+
+  const EquitySimulation river = EquitySimulator(config).run(hero, villain, turn | cards({ 0 }), 10, 2);
+  EXPECT_EQ(river.standard_error, 0);
+  EXPECT_EQ(river.effective_deals, 10);
+}
+
+TEST(EquityTest, SimulationInvalidTest)
+{
+  using namespace deck_of_cards;
+  EquitySimulator::Config config;
+  const EquitySimulator simulator(config);
+  EXPECT_THROW(simulator.run(cards({ 1, 2 }), cards({ 2, 3 }), CardSet(), 100), std::invalid_argument);
+  EXPECT_THROW(simulator.run(cards({ 1, 2 }), cards({ 3, 4 }), cards({ 5, 6, 7, 8, 9, 10 }), 100),
+               std::invalid_argument);
+  EXPECT_THROW(simulator.run(cards({ 1, 2 }), cards({ 3, 4 }), CardSet(), 1), std::invalid_argument);
+
+  config.sampling = EquitySampling::Stratified;
+  EXPECT_THROW(EquitySimulator(config).run(cards({ 1, 2 }), cards({ 3, 4 }), CardSet(), 95), std::invalid_argument);
+  config.sampling = EquitySampling::ControlVariate;
+  config.pilot_deals = 0;
+  EXPECT_THROW(EquitySimulator{ config }, std::invalid_argument);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include <Deck.hpp>
+#include <FairnessMonitor.hpp>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(FairnessMonitorTest, StartingHandClassTest)
+{
+  using namespace deck_of_cards;
+
+  const auto aa = starting_hand_class(card_id(Suit::Club, Value::Ace), card_id(Suit::Spade, Value::Ace));
+  const auto aks = starting_hand_class(card_id(Suit::Heart, Value::King), card_id(Suit::Heart, Value::Ace));
+  const auto ako = starting_hand_class(card_id(Suit::Heart, Value::Ace), card_id(Suit::Club, Value::King));
+  const auto deuces = starting_hand_class(card_id(Suit::Club, Value::Two), card_id(Suit::Heart, Value::Two));
+
+  EXPECT_EQ(aa, 0u);
+  EXPECT_EQ(aks, 1u);
+  EXPECT_EQ(ako, 13u);
+  EXPECT_EQ(deuces, NumStartingHands - 1);
+
+  const auto probabilities = starting_hand_probabilities();
+  EXPECT_NEAR(std::accumulate(probabilities.begin(), probabilities.end(), 0.0), 1.0, 1e-12);
+}
+
+TEST(FairnessMonitorTest, FairDeckPassesTest)
+{
+  using namespace deck_of_cards;
+  FairnessMonitor::Config config;
+  config.num_seats = 6;
+  config.num_tables = 2;
+  FairnessMonitor monitor(config);
+
+  Deck deck;
+  for (int hand = 0; hand < 4000; ++hand)
+  {
+    deck.reset();
+    deck.shuffle();
+    for (std::size_t seat = 0; seat < config.num_seats; ++seat)
+    {
+      const auto first = deck.deal_card();
+      const auto second = deck.deal_card();
+      monitor.record_hand(hand % 2, seat, *first, *second);
+    }
+  }
+
+  for (std::size_t seat = 0; seat < config.num_seats; ++seat)
+  {
+    EXPECT_TRUE(monitor.seat_test(seat).passed) << "seat " << seat;
+    EXPECT_TRUE(monitor.binomial_test(seat, 0).passed) << "seat " << seat;
+  }
+  EXPECT_TRUE(monitor.table_test(0).passed);
+  EXPECT_EQ(monitor.table_test(1).hands, 2000u * config.num_seats);
+}
+
+TEST(FairnessMonitorTest, BiasedSeatFailsTest)
+{
+  using namespace deck_of_cards;
+  FairnessMonitor::Config config;
+  config.num_seats = 2;
+  FairnessMonitor monitor(config);
+
+  // seat 1 gets pocket aces once every 50 hands instead of once every 221
+  for (std::size_t hand = 0; hand < 20000; ++hand)
+  {
+    monitor.record(0, 1, hand % 50 == 0 ? 0 : 1 + hand % (NumStartingHands - 1));
+  }
+
+  const auto result = monitor.binomial_test(1, 0);
+  EXPECT_FALSE(result.passed);
+  EXPECT_GT(result.statistic, result.threshold);
+  EXPECT_TRUE(monitor.binomial_test(0, 0).passed);
+}
+
+TEST(FairnessMonitorTest, OutOfRangeTest)
+{
+  using namespace deck_of_cards;
+  FairnessMonitor::Config config;
+  config.num_seats = 2;
+  config.num_tables = 3;
+  FairnessMonitor monitor(config);
+  ShardedFairnessMonitor sharded(config, 2);
+  const Card ace(Suit::Club, Value::Ace);
+  const Card king(Suit::Club, Value::King);
+
+  EXPECT_THROW(monitor.record(3, 0, 0), std::out_of_range);
+  EXPECT_THROW(monitor.record(0, 2, 0), std::out_of_range);
+  EXPECT_THROW(monitor.record(0, 0, NumStartingHands), std::out_of_range);
+  EXPECT_THROW(monitor.record_hand(0, 2, ace, king), std::out_of_range);
+  EXPECT_THROW(sharded.record(3, 0, 0), std::out_of_range);
+  EXPECT_THROW(sharded.record_hand(0, 2, ace, king), std::out_of_range);
+  EXPECT_THROW(monitor.seat_test(2), std::out_of_range);
+  EXPECT_THROW(monitor.table_test(3), std::out_of_range);
+  EXPECT_THROW(monitor.binomial_test(0, NumStartingHands), std::out_of_range);
+  EXPECT_EQ(monitor.table_test(2).hands, 0u);
+
+  // hole cards only map onto a monitor of starting hand classes
+  config.expected.assign(9, 1.0 / 9);
+  FairnessMonitor categories(config);
+  categories.record(0, 0, 8);
+  EXPECT_THROW(categories.record_hand(0, 0, ace, king), std::invalid_argument);
+  EXPECT_THROW(ShardedFairnessMonitor(config, 2).record_hand(0, 0, ace, king), std::invalid_argument);
+}
+
+TEST(FairnessMonitorTest, ExactBinomialTest)
+{
+  using namespace deck_of_cards;
+  FairnessMonitor::Config config;
+  config.num_seats = 2;
+  FairnessMonitor monitor(config);
+
+  // 500 hands expect 2.26 pocket aces; P(X >= 10) is 1.2e-4 and P(X >= 11) 2.4e-5 against alpha / 2 = 5e-5, while
+  // the normal approximation already rejects 10 with a z-score of 5.2
+  for (std::size_t hand = 0; hand < 500; ++hand)
+  {
+    monitor.record(0, 0, hand < 10 ? 0 : 1 + hand % (NumStartingHands - 1));
+    monitor.record(0, 1, hand < 11 ? 0 : 1 + hand % (NumStartingHands - 1));
+  }
+
+  const auto ten = monitor.binomial_test(0, 0);
+  EXPECT_TRUE(ten.passed);
+  EXPECT_EQ(ten.statistic, 10.0);
+  EXPECT_EQ(ten.threshold, 10.0);
+  EXPECT_FALSE(monitor.binomial_test(1, 0).passed);
+
+
+  // no pocket aces in 2000 hands has probability 1.2e-4, in 3000 hands 1.3e-6
+  FairnessMonitor lower(config);
+  for (std::size_t hand = 0; hand < 3000; ++hand)
+  {
+    lower.record(0, hand < 2000 ? 0 : 1, 1 + hand % (NumStartingHands - 1));
+  }
+  EXPECT_TRUE(lower.binomial_test(0, 0).passed);
+  EXPECT_EQ(lower.binomial_test(0, 0).threshold, 0.0);
+  for (std::size_t hand = 0; hand < 2000; ++hand)
+  {
+    lower.record(0, 1, 1 + hand % (NumStartingHands - 1));
+  }
+  EXPECT_FALSE(lower.binomial_test(1, 0).passed);
+  EXPECT_GT(lower.binomial_test(1, 0).threshold, 0.0);
+}
+
+TEST(FairnessMonitorTest, WindowRotationTest)
+{
+  using namespace deck_of_cards;
+  FairnessMonitor::Config config;
+  config.num_seats = 1;
+  config.num_windows = 2;
+  FairnessMonitor monitor(config);
+
+  monitor.record(0, 0, 0);
+  monitor.advance_window();
+  monitor.record(0, 0, 0);
+  EXPECT_EQ(monitor.window_counts().count(0, 0), 2u);
+
+  // the first window falls out of the seat tests but not the table totals
+  monitor.advance_window();
+  EXPECT_EQ(monitor.window_counts().count(0, 0), 1u);
+  EXPECT_EQ(monitor.table_test(0).hands, 2u);
+}
+
+TEST(FairnessMonitorTest, ShardedMergeTest)
+{
+  using namespace deck_of_cards;
+  FairnessMonitor::Config config;
+  config.num_seats = 9;
+  config.num_tables = 8;
+  ShardedFairnessMonitor monitor(config, 4);
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&monitor, t]() {
+      for (std::size_t hand = 0; hand < 1000; ++hand)
+      {
+        monitor.record(t * 2 + hand % 2, hand % 9, hand % NumStartingHands);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  const auto merged = monitor.snapshot();
+  std::uint64_t total = 0;
+  for (std::size_t table = 0; table < config.num_tables; ++table)
+  {
+    total += merged.table_test(table).hands;
+  }
+  EXPECT_EQ(total, 4000u);
+  EXPECT_EQ(merged.window_counts().seat_total(0), 4u * 112);
+}
+
+TEST(FairnessMonitorTest, ShardedTableBlocksTest)
+{
+  using namespace deck_of_cards;
+  FairnessMonitor::Config config;
+  config.num_seats = 3;
+  config.num_tables = 10;
+
+  // four shards own blocks of 3, 3, 3 and 1 tables, and twenty shards only one table each
+  FairnessMonitor single(config);
+  ShardedFairnessMonitor four(config, 4);
+  ShardedFairnessMonitor twenty(config, 20);
+  for (std::size_t hand = 0; hand < 5000; ++hand)
+  {
+    const std::size_t table = hand * 7 % config.num_tables;
+    const std::size_t category = hand * 13 % NumStartingHands;
+    single.record(table, hand % 3, category);
+    four.record(table, hand % 3, category);
+    twenty.record(table, hand % 3, category);
+  }
+
+  for (const auto& merged : { four.snapshot(), twenty.snapshot() })
+  {
+    for (std::size_t table = 0; table < config.num_tables; ++table)
+    {
+      EXPECT_EQ(merged.table_test(table).hands, single.table_test(table).hands);
+      EXPECT_EQ(merged.table_test(table).statistic, single.table_test(table).statistic);
+    }
+    EXPECT_EQ(merged.window_counts().seat_total(1), single.window_counts().seat_total(1));
+  }
+
+  // a block only merges where it fits
+  FairnessMonitor::Config block = config;
+  block.num_tables = 3;
+  FairnessMonitor merged(config);
+  EXPECT_NO_THROW(merged.merge(FairnessMonitor(block), 7));
+  EXPECT_THROW(merged.merge(FairnessMonitor(block), 8), std::invalid_argument);
+}
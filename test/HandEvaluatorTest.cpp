@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <HandEvaluator.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+deck_of_cards::CardSet hand(std::initializer_list<deck_of_cards::CardId> cards)
+{
+  return deck_of_cards::CardSet(cards.begin(), cards.size());
+}
+
+}  // namespace
+
+TEST(HandEvaluatorTest, CardSetTest)
+{
+  using namespace deck_of_cards;
+  CardSet cards;
+  cards.insert(card_id(Suit::Heart, Value::Ace));
+  cards.insert(card_id(Suit::Heart, Value::King));
+
+  EXPECT_EQ(cards.size(), 2u);
+  EXPECT_TRUE(cards.contains(card_id(Suit::Heart, Value::Ace)));
+  EXPECT_FALSE(cards.contains(card_id(Suit::Spade, Value::Ace)));
+  EXPECT_EQ(cards.suit_mask(Suit::Heart), (1u << 0) | (1u << 12));
+  EXPECT_EQ(CardSet::full().size(), NumCards);
+
+  cards.erase(card_id(Suit::Heart, Value::Ace));
+  EXPECT_EQ(cards.size(), 1u);
+}
+
+TEST(HandEvaluatorTest, CategoryFrequencyTest)
+{
+  using namespace deck_of_cards;
+  const HandEvaluator& evaluator = HandEvaluator::instance();
+
+  // every 5 card hand, counted by category
+  std::array<std::size_t, 9> counts = {};
+  for (CardId a = 0; a < NumCards; ++a)
+  {
+    for (CardId b = a + 1; b < NumCards; ++b)
+    {
+      for (CardId c = b + 1; c < NumCards; ++c)
+      {
+        for (CardId d = c + 1; d < NumCards; ++d)
+        {
+          for (CardId e = d + 1; e < NumCards; ++e)
+          {
+            counts[static_cast<int>(hand_category(evaluator.evaluate(hand({ a, b, c, d, e }))))]++;
+          }
+        }
+      }
+    }
+  }
+
+  const std::array<std::size_t, 9> expected = { 1302540, 1098240, 123552, 54912, 10200, 5108, 3744, 624, 40 };
+  EXPECT_EQ(counts, expected);
+}
+
+TEST(HandEvaluatorTest, OrderingTest)
+{
+  using namespace deck_of_cards;
+  const auto royal = hand({ card_id(Suit::Spade, Value::Ace), card_id(Suit::Spade, Value::King),
+                            card_id(Suit::Spade, Value::Queen), card_id(Suit::Spade, Value::Jack),
+                            card_id(Suit::Spade, Value::Ten) });
+  const auto wheel = hand({ card_id(Suit::Spade, Value::Ace), card_id(Suit::Heart, Value::Two),
+                            card_id(Suit::Club, Value::Three), card_id(Suit::Spade, Value::Four),
+                            card_id(Suit::Diamond, Value::Five) });
+  const auto six_high = hand({ card_id(Suit::Heart, Value::Six), card_id(Suit::Heart, Value::Two),
+                               card_id(Suit::Club, Value::Three), card_id(Suit::Spade, Value::Four),
+                               card_id(Suit::Diamond, Value::Five) });
+  const auto worst = hand({ card_id(Suit::Heart, Value::Seven), card_id(Suit::Heart, Value::Two),
+                            card_id(Suit::Club, Value::Three), card_id(Suit::Spade, Value::Four),
+                            card_id(Suit::Diamond, Value::Five) });
+
+  EXPECT_EQ(evaluate(royal), NumHandRanks);
+  EXPECT_EQ(hand_category(evaluate(wheel)), HandCategory::Straight);
+  EXPECT_LT(evaluate(wheel), evaluate(six_high));
+  EXPECT_EQ(evaluate(worst), 1);
+  EXPECT_THROW(evaluate(hand({ 0, 1, 2, 3 })), std::invalid_argument);
+}
+
+TEST(HandEvaluatorTest, SevenCardTest)
+{
+  using namespace deck_of_cards;
+  const HandEvaluator& evaluator = HandEvaluator::instance();
+  srand(7);
+
+  // the 7 card result must be the best of the 21 five card sub-hands
+  for (int trial = 0; trial < 2000; ++trial)
+  {
+    std::array<CardId, NumCards> cards;
+    for (std::size_t i = 0; i < NumCards; ++i)
+    {
+      cards[i] = static_cast<CardId>(i);
+    }
+    for (std::size_t i = 0; i < 7; ++i)
+    {
+      std::swap(cards[i], cards[i + rand() % (NumCards - i)]);
+    }
+
+    HandRank best = 0;
+    for (int skip_a = 0; skip_a < 7; ++skip_a)
+    {
+      for (int skip_b = skip_a + 1; skip_b < 7; ++skip_b)
+      {
+        CardSet five;
+        for (int i = 0; i < 7; ++i)
+        {
+          if (i != skip_a && i != skip_b)
+          {
+            five.insert(cards[i]);
+          }
+        }
+        best = std::max(best, evaluator.evaluate(five));
+      }
+    }
+
+    CardSet six(cards.data(), 6);
+    EXPECT_EQ(evaluator.evaluate(CardSet(cards.data(), 7)), best);
+    EXPECT_GE(evaluator.evaluate(six), evaluator.evaluate(CardSet(cards.data(), 5)));
+  }
+}
+
+TEST(HandEvaluatorTest, ParallelGenerationTest)
+{
+  using namespace deck_of_cards;
+  const HandEvaluator serial(1);
+  const HandEvaluator parallel(3);
+  const HandEvaluator& shared = HandEvaluator::instance();
+
+  ASSERT_EQ(serial.table_bytes(), shared.table_bytes());
+  ASSERT_EQ(parallel.table_bytes(), shared.table_bytes());
+  EXPECT_EQ(std::memcmp(serial.tables(), shared.tables(), shared.table_bytes()), 0);
+  EXPECT_EQ(std::memcmp(parallel.tables(), shared.tables(), shared.table_bytes()), 0);
+}
+
+TEST(HandEvaluatorTest, PersistTest)
+{
+  using namespace deck_of_cards;
+  const std::string path = ::testing::TempDir() + "HandEvaluatorTest.tables";
+  const HandEvaluator& generated = HandEvaluator::instance();
+  generated.save(path);
+
+  const HandEvaluator mapped(path);
+  EXPECT_TRUE(mapped.mapped());
+  ASSERT_EQ(mapped.table_bytes(), generated.table_bytes());
+  EXPECT_EQ(std::memcmp(mapped.tables(), generated.tables(), generated.table_bytes()), 0);
+  EXPECT_EQ(mapped.evaluate(hand({ 0, 9, 10, 11, 12 })), NumHandRanks);
+
+  // flip one table byte
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(1000);
+    file.put('\x7f');
+  }
+  EXPECT_THROW(HandEvaluator(path, true), std::runtime_error);
+  EXPECT_NO_THROW(HandEvaluator(path, false));
+
+  // truncate it
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "DOCEVAL";
+  }
+  EXPECT_THROW(HandEvaluator(path, false), std::runtime_error);
+
+  std::remove(path.c_str());
+  EXPECT_THROW(HandEvaluator(path, false), std::runtime_error);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <HandEvaluator.hpp>
+#include <HandStrength.hpp>
+#include <PreflopEquity.hpp>
+#include <Range.hpp>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+deck_of_cards::CardSet cards(std::initializer_list<deck_of_cards::CardId> ids)
+{
+  return deck_of_cards::CardSet(ids.begin(), ids.size());
+}
+
+}  // namespace
+
+TEST(HandStrengthTest, RiverTest)
+{
+  using namespace deck_of_cards;
+  // club ids: ace 0, deuce 1, ..., king 12; diamonds start at 13, hearts at 26 and spades at 39
+  const CardSet board = cards({ 0, 13, 20, 33, 47 });
+  std::vector<float> strengths(NumCombos, -1);
+  river_strengths(board, strengths.data());
+
+  for (std::size_t combo = 0; combo < NumCombos; combo += 7)
+  {
+    const CardSet hole = combo_cards(combo);
+    if (hole.intersects(board))
+    {
+      EXPECT_EQ(strengths[combo], -1);
+      continue;
+    }
+    const HandRank rank = evaluate(hole | board);
+    double wins = 0;
+    double opponents = 0;
+    for (std::size_t other = 0; other < NumCombos; ++other)
+    {
+      const CardSet opponent = combo_cards(other);
+      if (!opponent.intersects(board | hole))
+      {
+        const HandRank opponent_rank = evaluate(opponent | board);
+        wins += rank > opponent_rank ? 1 : rank == opponent_rank ? 0.5 : 0;
+        ++opponents;
+      }
+    }
+    EXPECT_EQ(opponents, 990);
+    EXPECT_NEAR(strengths[combo], wins / opponents, 1e-6);
+  }
+  EXPECT_THROW(river_strengths(cards({ 1, 2, 3 }), strengths.data()), std::invalid_argument);
+}
+
+TEST(HandStrengthTest, TurnJobTest)
+{
+  using namespace deck_of_cards;
+  const std::string path = ::testing::TempDir() + "HandStrengthTest.turn";
+  std::remove(path.c_str());
+
+  HandStrengthJob::Config config;
+  config.num_bins = 10;
+  config.num_threads = 2;
+  config.path = path;
+  config.checkpoint_interval = 1;
+  config.max_units = 2;
+  std::vector<std::size_t> reports;
+  config.progress = [&reports](const HandStrengthProgress& progress) { reports.push_back(progress.units_done); };
+
+  HandStrengthJob job(Street::Turn, config);
+  EXPECT_EQ(job.num_units(), 16432u);
+  EXPECT_FALSE(job.run());
+  EXPECT_EQ(job.units_done(), 2u);
+  // a second job resumes from the file, marking the units finished since the last checkpoint done when it stops
+  config.checkpoint_interval = 64;
+  HandStrengthJob resumed(Street::Turn, config);
+  EXPECT_FALSE(resumed.run());
+  EXPECT_EQ(resumed.units_done(), 4u);
+  config.max_units = 1;
+  HandStrengthJob third(Street::Turn, config);
+  EXPECT_FALSE(third.run());
+  EXPECT_EQ(third.units_done(), 5u);
+  EXPECT_EQ(reports, (std::vector<std::size_t>{ 1, 2, 3, 4, 5 }));
+
+  const HandStrengthTable table(path, Street::Turn, 10);
+  EXPECT_EQ(table.num_entries(), 16432u * NumCombos);
+  EXPECT_THROW(HandStrengthTable(path, Street::Turn, 20), std::runtime_error);
+
+  // the first canonical turn is the ace to four of clubs; relabel it to spades and the hole cards with it
+  const CardSet board = cards({ 39, 40, 41, 42 });
+  for (const CardSet hole : { cards({ 12, 25 }), cards({ 43, 4 }), cards({ 51, 26 }) })
+  {
+    const std::size_t entry = table.entry(hole, board);
+    EXPECT_LT(entry, NumCombos);
+
+    // EHS is the equity against a random hand
+    double equity = 0;
+    double opponents = 0;
+    for (std::size_t other = 0; other < NumCombos; ++other)
+    {
+      const CardSet opponent = combo_cards(other);
+      if (!opponent.intersects(board | hole))
+      {
+        equity += heads_up_equity(hole, opponent, board);
+        ++opponents;
+      }
+    }
+    EXPECT_NEAR(table.ehs(entry), equity / opponents, 1e-4);
+    EXPECT_GE(table.ehs2(entry), table.ehs(entry) * table.ehs(entry) - 1e-4);
+
+    std::size_t runouts = 0;
+    for (std::size_t bin = 0; bin < table.num_bins(); ++bin)
+    {
+      runouts += table.histogram(entry)[bin];
+    }
+    EXPECT_EQ(runouts, 46u);
+  }
+
+  EXPECT_THROW(table.entry(cards({ 39, 1 }), board), std::invalid_argument);
+  EXPECT_THROW(table.entry(cards({ 12, 25 }), cards({ 8, 9, 10, 11 })), std::out_of_range);
+
+  // a job of another shape refuses the file, and one without a file keeps its results in memory until saved
+  config.num_bins = 20;
+  EXPECT_THROW(HandStrengthJob(Street::Turn, config).run(), std::runtime_error);
+  const std::string saved = path + ".saved";
+  config.num_bins = 10;
+  config.path.clear();
+  config.max_units = 1;
+  config.progress = nullptr;
+  HandStrengthJob memory(Street::Flop, config);
+  EXPECT_FALSE(memory.run());
+  memory.save(saved);
+  const HandStrengthTable saved_table(saved, Street::Flop, 10);
+  const std::size_t entry = saved_table.entry(cards({ 12, 25 }), cards({ 39, 40, 41 }));
+  EXPECT_GT(saved_table.ehs(entry), 0.5);
+  EXPECT_THROW(saved_table.entry(cards({ 12, 25 }), cards({ 8, 9, 10 })), std::out_of_range);
+  std::remove(saved.c_str());
+  std::remove(path.c_str());
+
+  config.checkpoint_interval = 0;
+  EXPECT_THROW(HandStrengthJob(Street::Turn, config), std::invalid_argument);
+}
+
+TEST(HandStrengthTest, ClusterTest)
+{
+  using namespace deck_of_cards;
+  const std::string path = ::testing::TempDir() + "HandStrengthTest.river";
+  std::remove(path.c_str());
+
+  HandStrengthJob::Config config;
+  config.num_threads = 2;
+  config.path = path;
+  config.max_units = 20;
+  HandStrengthJob job(Street::River, config);
+  EXPECT_EQ(job.num_units(), 134459u);
+  job.run();
+
+  const HandStrengthTable table(path, Street::River, 0);
+  EXPECT_EQ(table.histogram(0), nullptr);
+  const auto buckets = table.cluster(8, 5, 3);
+  ASSERT_EQ(buckets.size(), table.num_entries());
+  EXPECT_EQ(buckets, table.cluster(8, 5, 1));
+
+  // stronger hands never land in a weaker bucket, and the unused entries in none
+  std::vector<double> lowest(8, 2);
+  std::vector<double> highest(8, -1);
+  std::size_t clustered = 0;
+  for (std::size_t entry = 0; entry < buckets.size(); ++entry)
+  {
+    if (buckets[entry] == NoBucket)
+    {
+      continue;
+    }
+    ++clustered;
+    lowest[buckets[entry]] = std::min(lowest[buckets[entry]], table.ehs(entry));
+    highest[buckets[entry]] = std::max(highest[buckets[entry]], table.ehs(entry));
+  }
+  EXPECT_EQ(clustered, 20u * 1081);
+  for (std::size_t bucket = 1; bucket < 8; ++bucket)
+  {
+    EXPECT_LE(highest[bucket - 1], lowest[bucket]);
+  }
+
+  EXPECT_THROW(table.cluster(0, 1), std::invalid_argument);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <Deck.hpp>
+#include <DeckBatch.hpp>
+#include <Hand.hpp>
+#include <PackedDeck.hpp>
+#include <Shoe.hpp>
+#include <random>
+#include <stdexcept>
+
+TEST(HandTest, AppendRemoveTest)
+{
+  using namespace deck_of_cards;
+  Hand<5> hand;
+  EXPECT_TRUE(hand.empty());
+  EXPECT_EQ(Hand<5>::capacity(), 5u);
+
+  const CardId cards[] = { 12, 40, 3, 27, 51 };
+  for (const auto card : cards)
+  {
+    hand.push_back(card);
+  }
+  EXPECT_EQ(hand.size(), 5u);
+  EXPECT_EQ(hand.set(), CardSet(cards, 5));
+  EXPECT_THROW(hand.push_back(0), std::length_error);
+
+  EXPECT_TRUE(hand.contains(3));
+  EXPECT_TRUE(hand.remove(3));
+  EXPECT_FALSE(hand.contains(3));
+  EXPECT_FALSE(hand.remove(3));
+  ASSERT_EQ(hand.size(), 4u);
+  EXPECT_EQ(hand[0], 12);
+  EXPECT_EQ(hand[1], 40);
+  EXPECT_EQ(hand[2], 27);
+  EXPECT_EQ(hand[3], 51);
+
+  // a card is held once, even when added again
+  EXPECT_THROW(hand.push_back(40), std::invalid_argument);
+  EXPECT_EQ(hand.size(), 4u);
+  EXPECT_TRUE(hand.remove(40));
+  EXPECT_FALSE(hand.contains(40));
+
+  hand.clear();
+  EXPECT_TRUE(hand.empty());
+  EXPECT_FALSE(hand.contains(12));
+}
+
+TEST(HandTest, ShoeDuplicatesTest)
+{
+  using namespace deck_of_cards;
+  // half of a double deck shoe repeats some cards
+  Shoe shoe(2);
+  std::mt19937 generator(5);
+  shoe.shuffle(generator);
+  Hand<NumCards> hand;
+  ASSERT_EQ(hand.deal(shoe, NumCards), NumCards);
+
+  std::size_t repeats = 0;
+  for (CardId card = 0; card < NumCards; ++card)
+  {
+    std::size_t copies = 0;
+    for (std::size_t i = 0; i < hand.size(); ++i)
+    {
+      copies += hand[i] == card;
+    }
+    if (copies == 2)
+    {
+      ++repeats;
+      EXPECT_TRUE(hand.remove(card));
+      EXPECT_TRUE(hand.contains(card));
+      EXPECT_TRUE(hand.remove(card));
+      EXPECT_FALSE(hand.contains(card));
+    }
+  }
+  EXPECT_GT(repeats, 0u);
+  EXPECT_EQ(hand.set().size(), hand.size());
+}
+
+TEST(HandTest, DealTest)
+{
+  using namespace deck_of_cards;
+  Deck deck;
+  deck.shuffle();
+  Hand<7> hand;
+  EXPECT_EQ(hand.deal(deck, 2), 2u);
+  EXPECT_EQ(hand.deal(deck, 10), 5u);
+  EXPECT_EQ(hand.size(), 7u);
+  EXPECT_EQ(hand.set().size(), 7u);
+  EXPECT_EQ(deck.num_cards(), NumCards - 7);
+
+  PackedDeck packed;
+  Hand<2> hole;
+  EXPECT_EQ(hole.deal(packed, 2), 2u);
+  EXPECT_EQ(hole[0], packed.card_at(0));
+  EXPECT_EQ(hole[1], packed.card_at(1));
+
+  DeckBatch batch(3);
+  Hand<5> board;
+  EXPECT_EQ(board.deal(batch, 1, 5), 5u);
+  EXPECT_EQ(board[4], batch.order(1)[4]);
+  EXPECT_EQ(batch.num_cards(1), NumCards - 5);
+}
+
+TEST(HandTest, DealTableTest)
+{
+  using namespace deck_of_cards;
+  Deck deck;
+  deck.shuffle();
+  Hand<2> seats[9];
+  EXPECT_EQ(deal_table(deck, seats, 9, 2), 18u);
+
+  CardSet dealt;
+  for (const auto& seat : seats)
+  {
+    ASSERT_EQ(seat.size(), 2u);
+    EXPECT_FALSE(dealt.intersects(seat.set()));
+    dealt |= seat.set();
+  }
+  EXPECT_EQ(dealt.size(), 18u);
+  EXPECT_EQ(deck.num_cards(), NumCards - 18);
+
+  // the seats are full now
+  EXPECT_THROW(deal_table(deck, seats, 9, 1), std::length_error);
+  Hand<7> big[8];
+  EXPECT_THROW(deal_table(deck, big, 8, 7), std::length_error);
+}
+
+TEST(HandTest, DealTableShoeTest)
+{
+  using namespace deck_of_cards;
+  // eight decks deal the same card to a seat now and then, which must not stop the table half dealt
+  Shoe shoe(8);
+  std::mt19937 generator(3);
+  shoe.shuffle(generator);
+  std::size_t repeats = 0;
+  for (int table = 0; table < 4; ++table)
+  {
+    Hand<8> seats[6];
+    ASSERT_EQ(deal_table(shoe, seats, 6, 8), 48u);
+    for (const auto& seat : seats)
+    {
+      ASSERT_EQ(seat.size(), 8u);
+      repeats += seat.size() - seat.set().size();
+    }
+  }
+  EXPECT_GT(repeats, 0u);
+  EXPECT_EQ(shoe.num_cards(), 8 * NumCards - 4 * 48);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <Deck.hpp>
+#include <HealthMonitor.hpp>
+#include <Statistics.hpp>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+TEST(HealthMonitorTest, CutoffTest)
+{
+  using namespace deck_of_cards;
+  HealthMonitor::Config config;
+  config.min_entropy = 6.0;
+  config.alpha = 9.313225746154785e-10;  // 2^-30
+  HealthMonitor monitor(nullptr, config);
+
+  // 1 + ceil(30 / 6)
+  EXPECT_EQ(monitor.repetition_cutoff(), 6u);
+  // the expected count per window is 8, the cutoff must sit well above it
+  EXPECT_GT(monitor.proportion_cutoff(), 20u);
+  EXPECT_LT(monitor.proportion_cutoff(), 64u);
+}
+
+TEST(HealthMonitorTest, RepetitionCountFailureTest)
+{
+  using namespace deck_of_cards;
+  std::vector<HealthFailure> failures;
+  HealthMonitor monitor([&failures](const HealthFailure& failure) { failures.push_back(failure); });
+
+  for (std::size_t i = 0; i < monitor.repetition_cutoff(); ++i)
+  {
+    monitor.add_sample(0x42);
+  }
+
+  ASSERT_FALSE(failures.empty());
+  EXPECT_EQ(failures.front().test, HealthTest::RepetitionCount);
+}
+
+TEST(HealthMonitorTest, AdaptiveProportionFailureTest)
+{
+  using namespace deck_of_cards;
+  std::vector<HealthFailure> failures;
+  HealthMonitor monitor([&failures](const HealthFailure& failure) { failures.push_back(failure); });
+
+  // alternate a stuck value with a counter so that no repetition run forms
+  for (std::uint32_t i = 0; i < 512; ++i)
+  {
+    monitor.add_sample(i % 2 == 0 ? 0x00 : i);
+  }
+
+  ASSERT_FALSE(failures.empty());
+  EXPECT_EQ(failures.front().test, HealthTest::AdaptiveProportion);
+}
+
+TEST(HealthMonitorTest, PositionalFailureTest)
+{
+  using namespace deck_of_cards;
+  std::vector<HealthFailure> failures;
+  HealthMonitor monitor([&failures](const HealthFailure& failure) { failures.push_back(failure); });
+
+  // a "shuffle" that always deals the same order
+  for (int i = 0; i < 100; ++i)
+  {
+    for (std::size_t position = 0; position < NumCards; ++position)
+    {
+      monitor.add_deal(position, static_cast<CardId>(position));
+    }
+  }
+
+  EXPECT_FALSE(monitor.evaluate_positions());
+  ASSERT_EQ(failures.size(), 1u);
+  EXPECT_EQ(failures.front().test, HealthTest::PositionalChiSquared);
+}
+
+TEST(HealthMonitorTest, HealthyDeckTest)
+{
+  using namespace deck_of_cards;
+  std::vector<HealthFailure> failures;
+  HealthMonitor::Config config;
+  config.check_every = 1;
+  config.chi_squared_window = 500;
+  auto monitor = std::make_shared<HealthMonitor>(
+      [&failures](const HealthFailure& failure) { failures.push_back(failure); }, config);
+
+  Deck deck;
+  deck.set_health_monitor(monitor);
+  for (int i = 0; i < 1000; ++i)
+  {
+    deck.reset();
+    deck.shuffle();
+    while (deck.deal_card())
+    {
+    }
+  }
+
+  EXPECT_EQ(monitor->samples(), 1000u * (NumCards - 1));
+  EXPECT_TRUE(monitor->evaluate_positions());
+  EXPECT_TRUE(failures.empty());
+}
+
+TEST(HealthMonitorTest, WholeDeckFalseAlarmTest)
+{
+  using namespace deck_of_cards;
+  std::size_t failures = 0;
+  HealthMonitor::Config config;
+  config.chi_squared_alpha = 0.01;
+  HealthMonitor monitor([&failures](const HealthFailure&) { ++failures; }, config);
+
+  // fair shuffles dealt out completely must fail about alpha of the windows
+  const std::size_t windows = 1000;
+  std::mt19937 generator(7);
+  CardId cards[NumCards];
+  std::iota(cards, cards + NumCards, 0);
+  for (std::size_t window = 0; window < windows; ++window)
+  {
+    for (int shuffle = 0; shuffle < 100; ++shuffle)
+    {
+      std::shuffle(cards, cards + NumCards, generator);
+      for (std::size_t position = 0; position < NumCards; ++position)
+      {
+        monitor.add_deal(position, cards[position]);
+      }
+    }
+    monitor.evaluate_positions();
+  }
+
+  // 10 expected, the unscaled statistic gives about 50
+  EXPECT_LT(failures, 25u);
+}
+
+TEST(HealthMonitorTest, CriticalValueTest)
+{
+  using namespace deck_of_cards;
+
+  // reference values from tables of the chi-squared distribution
+  EXPECT_NEAR(chi_squared_critical_value(100, 0.05), 124.342, 0.2);
+  EXPECT_NEAR(chi_squared_critical_value(2652, 0.05), 2773.2, 1.0);
+  EXPECT_NEAR(normal_quantile(0.975), 1.959964, 1e-6);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <HealthMonitor.hpp>
+#include <KeyedPermutation.hpp>
+#include <Statistics.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// chi-squared statistic of counts against a uniform distribution
+double chi_squared(const std::vector<std::uint32_t>& counts, double expected)
+{
+  double statistic = 0;
+  for (const auto count : counts)
+  {
+    statistic += (count - expected) * (count - expected) / expected;
+  }
+  return statistic;
+}
+
+}  // namespace
+
+TEST(KeyedPermutationTest, BijectionTest)
+{
+  using namespace deck_of_cards;
+  for (const std::uint64_t key : { 0ull, 1ull, 0xDEADBEEFull, ~0ull })
+  {
+    for (std::uint64_t shuffle = 0; shuffle < 100; ++shuffle)
+    {
+      const KeyedPermutation permutation(key, shuffle);
+      CardId cards[NumCards];
+      permutation.order(cards);
+
+      std::vector<bool> seen(NumCards, false);
+      for (std::size_t position = 0; position < NumCards; ++position)
+      {
+        ASSERT_LT(cards[position], NumCards);
+        EXPECT_FALSE(seen[cards[position]]);
+        seen[cards[position]] = true;
+        EXPECT_EQ(permutation.position_of(cards[position]), position);
+        EXPECT_EQ(card_at(key, shuffle, position), cards[position]);
+      }
+    }
+  }
+
+  // the same key and shuffle always give the same order, other shuffles and keys another
+  CardId first[NumCards];
+  CardId again[NumCards];
+  CardId next[NumCards];
+  CardId other[NumCards];
+  KeyedPermutation(7, 42).order(first);
+  KeyedPermutation(7, 42).order(again);
+  KeyedPermutation(7, 43).order(next);
+  KeyedPermutation(8, 42).order(other);
+  EXPECT_TRUE(std::equal(first, first + NumCards, again));
+  EXPECT_FALSE(std::equal(first, first + NumCards, next));
+  EXPECT_FALSE(std::equal(first, first + NumCards, other));
+}
+
+TEST(KeyedPermutationTest, HealthMonitorTest)
+{
+  using namespace deck_of_cards;
+  std::vector<HealthFailure> failures;
+  HealthMonitor::Config config;
+  config.check_every = 1;
+  config.chi_squared_window = 2000;
+  HealthMonitor monitor([&failures](const HealthFailure& failure) { failures.push_back(failure); }, config);
+
+  // consecutive shuffles under one key, then one shuffle under consecutive keys
+  for (std::uint64_t n = 0; n < 20000; ++n)
+  {
+    const KeyedPermutation permutation = n < 10000 ? KeyedPermutation(12345, n) : KeyedPermutation(n, 0);
+    monitor.begin_shuffle();
+    for (std::size_t position = 0; position < NumCards; ++position)
+    {
+      monitor.add_deal(position, permutation.card_at(position));
+    }
+  }
+
+  EXPECT_TRUE(monitor.evaluate_positions());
+  EXPECT_TRUE(failures.empty());
+}
+
+TEST(KeyedPermutationTest, PairTest)
+{
+  using namespace deck_of_cards;
+  // the marginals of every position can be uniform while pairs of cards are not: test the first two cards of an
+  // order, and the first cards of neighbouring shuffles
+  const std::size_t shuffles = 100000;
+  std::vector<std::uint32_t> adjacent(NumCards * (NumCards - 1), 0);
+  std::vector<std::uint32_t> successive(NumCards * NumCards, 0);
+  CardId previous = KeyedPermutation(99, 0).card_at(0);
+  for (std::uint64_t shuffle = 1; shuffle <= shuffles; ++shuffle)
+  {
+    const KeyedPermutation permutation(99, shuffle);
+    const CardId first = permutation.card_at(0);
+    const CardId second = permutation.card_at(1);
+    ++adjacent[first * (NumCards - 1) + second - (second > first ? 1 : 0)];
+    ++successive[previous * NumCards + first];
+    previous = first;
+  }
+
+  const double alpha = 1e-6;
+  EXPECT_LT(chi_squared(adjacent, static_cast<double>(shuffles) / adjacent.size()),
+            chi_squared_critical_value(adjacent.size() - 1.0, alpha));
+  EXPECT_LT(chi_squared(successive, static_cast<double>(shuffles) / successive.size()),
+            chi_squared_critical_value(successive.size() - 1.0, alpha));
+}
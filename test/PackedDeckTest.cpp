@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <Deck.hpp>
+#include <PackedDeck.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+TEST(PackedDeckTest, SizeTest)
+{
+  using namespace deck_of_cards;
+
+  EXPECT_EQ(sizeof(PackedDeck), 40u);
+  EXPECT_TRUE(std::is_trivially_copyable<PackedDeck>::value);
+}
+
+TEST(PackedDeckTest, PackRoundTripTest)
+{
+  using namespace deck_of_cards;
+  srand(11);
+
+  for (int trial = 0; trial < 100; ++trial)
+  {
+    std::array<CardId, NumCards> cards;
+    for (std::size_t i = 0; i < NumCards; ++i)
+    {
+      cards[i] = static_cast<CardId>(i);
+    }
+    for (std::size_t i = NumCards - 1; i > 0; --i)
+    {
+      std::swap(cards[i], cards[rand() % (i + 1)]);
+    }
+
+    std::array<std::uint8_t, PackedOrderBytes> packed;
+    std::array<CardId, NumCards> unpacked;
+    pack_order(cards.data(), packed.data());
+    unpack_order(packed.data(), unpacked.data());
+    EXPECT_EQ(unpacked, cards);
+
+    PackedDeck deck;
+    deck.set_order(cards.data());
+    for (std::size_t i = 0; i < NumCards; ++i)
+    {
+      EXPECT_EQ(deck.card_at(i), cards[i]);
+    }
+  }
+}
+
+TEST(PackedDeckTest, DealTest)
+{
+  using namespace deck_of_cards;
+  PackedDeck deck;
+  deck.shuffle();
+
+  std::array<CardId, NumCards> order;
+  deck.order(order.data());
+
+  const auto first = deck.deal_card();
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first->id(), order[0]);
+  EXPECT_EQ(deck.num_cards(), NumCards - 1);
+  EXPECT_FALSE(deck.undealt().contains(order[0]));
+
+  std::array<CardId, NumCards> rest;
+  EXPECT_EQ(deck.deal_cards(rest.data(), NumCards), NumCards - 1);
+  EXPECT_TRUE(std::equal(order.begin() + 1, order.end(), rest.begin()));
+  EXPECT_EQ(deck.deal_card(), nullptr);
+  EXPECT_TRUE(deck.undealt().empty());
+
+  deck.reset();
+  EXPECT_EQ(deck.num_cards(), NumCards);
+  EXPECT_EQ(deck.undealt(), CardSet::full());
+}
+
+TEST(PackedDeckTest, ShuffleKeepsDealtCardsTest)
+{
+  using namespace deck_of_cards;
+  PackedDeck deck;
+  deck.shuffle();
+
+  std::array<CardId, 5> dealt;
+  deck.deal_cards(dealt.data(), dealt.size());
+  const CardSet before = deck.undealt();
+  deck.shuffle();
+
+  EXPECT_EQ(deck.undealt(), before);
+  for (std::size_t i = 0; i < dealt.size(); ++i)
+  {
+    EXPECT_EQ(deck.card_at(i), dealt[i]);
+  }
+}
+
+TEST(PackedDeckTest, BulkScanTest)
+{
+  using namespace deck_of_cards;
+  std::vector<PackedDeck> decks(1000);
+  for (std::size_t i = 0; i < decks.size(); ++i)
+  {
+    decks[i].shuffle();
+    std::array<CardId, NumCards> sink;
+    decks[i].deal_cards(sink.data(), i % NumCards);
+  }
+
+  std::vector<CardSet> undealt(decks.size());
+  undealt_cards(decks.data(), decks.size(), undealt.data());
+  for (std::size_t i = 0; i < decks.size(); ++i)
+  {
+    EXPECT_EQ(undealt[i].size(), NumCards - i % NumCards);
+  }
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <DeckBatch.hpp>
+#include <PackedDeck.hpp>
+#include <Permutation.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+deck_of_cards::Permutation random_permutation(std::mt19937& generator)
+{
+  std::vector<std::uint8_t> sources(deck_of_cards::NumCards);
+  std::iota(sources.begin(), sources.end(), 0);
+  std::shuffle(sources.begin(), sources.end(), generator);
+  return deck_of_cards::Permutation(sources.data());
+}
+
+}  // namespace
+
+TEST(PermutationTest, ApplyTest)
+{
+  using namespace deck_of_cards;
+  std::mt19937 generator(5);
+  std::vector<CardId> cards(NumCards);
+  std::iota(cards.begin(), cards.end(), 0);
+  std::shuffle(cards.begin(), cards.end(), generator);
+
+  for (int round = 0; round < 100; ++round)
+  {
+    const Permutation permutation = random_permutation(generator);
+    std::vector<CardId> result(NumCards);
+    apply(permutation, cards.data(), result.data());
+    for (std::size_t i = 0; i < NumCards; ++i)
+    {
+      ASSERT_EQ(result[i], cards[permutation[i]]);
+    }
+    for (std::size_t i = NumCards; i < PermutationBytes; ++i)
+    {
+      ASSERT_EQ(permutation.data()[i], i);
+    }
+
+    // in place, and undone by the inverse
+    std::vector<CardId> copy = cards;
+    apply(permutation, copy.data(), copy.data());
+    EXPECT_EQ(copy, result);
+    apply(permutation.inverse(), copy.data(), copy.data());
+    EXPECT_EQ(copy, cards);
+    EXPECT_EQ(Permutation::between(cards.data(), result.data()), permutation);
+  }
+
+  std::vector<std::uint8_t> sources(NumCards, 0);
+  EXPECT_THROW(Permutation{ sources.data() }, std::invalid_argument);
+  std::vector<CardId> twice = cards;
+  twice[3] = twice[4];
+  EXPECT_THROW(Permutation::between(cards.data(), twice.data()), std::invalid_argument);
+  EXPECT_THROW(Permutation::between(twice.data(), cards.data()), std::invalid_argument);
+}
+
+TEST(PermutationTest, ComposeTest)
+{
+  using namespace deck_of_cards;
+  std::mt19937 generator(9);
+  std::vector<CardId> cards(NumCards);
+  std::iota(cards.begin(), cards.end(), 0);
+
+  for (int round = 0; round < 100; ++round)
+  {
+    const Permutation first = random_permutation(generator);
+    const Permutation second = random_permutation(generator);
+    const Permutation third = random_permutation(generator);
+    std::vector<CardId> stepwise(NumCards);
+    std::vector<CardId> composed(NumCards);
+    apply(first, cards.data(), stepwise.data());
+    apply(second, stepwise.data(), stepwise.data());
+    apply(compose(first, second), cards.data(), composed.data());
+    ASSERT_EQ(stepwise, composed);
+
+    EXPECT_EQ(compose(compose(first, second), third), compose(first, compose(second, third)));
+    EXPECT_EQ(compose(first, first.inverse()), Permutation());
+    EXPECT_EQ(compose(Permutation(), first), first);
+  }
+
+  // cuts add up, and eight out faros restore a deck of 52 cards while an in faro needs 52
+  EXPECT_EQ(compose(Permutation::cut(10), Permutation::cut(45)), Permutation::cut(3));
+  Permutation faros;
+  for (int count = 1; count <= 52; ++count)
+  {
+    faros = compose(faros, Permutation::faro());
+    EXPECT_EQ(faros == Permutation(), count % 8 == 0) << count;
+  }
+  faros = Permutation::faro(false);
+  for (int count = 2; count <= 52; ++count)
+  {
+    faros = compose(faros, Permutation::faro(false));
+    EXPECT_EQ(faros == Permutation(), count == 52) << count;
+  }
+}
+
+TEST(PermutationTest, DeckTest)
+{
+  using namespace deck_of_cards;
+  std::mt19937 generator(13);
+  const Permutation permutation = random_permutation(generator);
+  CardId cards[NumCards];
+  std::iota(cards, cards + NumCards, 0);
+  CardId expected[NumCards];
+  apply(permutation, cards, expected);
+
+  DeckBatch batch(3);
+  batch.deal_cards(1, cards, 2);
+  batch.permute(1, permutation);
+  EXPECT_TRUE(std::equal(expected, expected + NumCards, batch.order(1)));
+  EXPECT_EQ(batch.num_cards(1), NumCards);
+  EXPECT_EQ(batch.order(0)[5], 5);
+
+  PackedDeck deck;
+  deck.deal_cards(cards, 3);
+  deck.permute(permutation);
+  EXPECT_EQ(deck.num_cards(), NumCards);
+  CardId order[NumCards];
+  deck.order(order);
+  EXPECT_TRUE(std::equal(expected, expected + NumCards, order));
+}
+
+TEST(PermutationTest, PermuteDealtDeckTest)
+{
+  using namespace deck_of_cards;
+  const Permutation cut = Permutation::cut(1);
+  CardId cards[NumCards];
+
+  PackedDeck deck;
+  deck.deal_cards(cards, 2);
+  deck.permute(cut);
+  EXPECT_EQ(deck.deal_cards(cards, NumCards), NumCards);
+  EXPECT_EQ(CardSet(cards, NumCards).size(), NumCards);
+  EXPECT_EQ(cards[0], 1);
+  EXPECT_EQ(cards[NumCards - 1], 0);
+
+  DeckBatch batch(2);
+  batch.deal_cards(0, cards, 2);
+  batch.permute(0, cut);
+  EXPECT_EQ(batch.deal_cards(0, cards, NumCards), NumCards);
+  EXPECT_EQ(CardSet(cards, NumCards).size(), NumCards);
+  EXPECT_EQ(cards[0], 1);
+  EXPECT_EQ(cards[NumCards - 1], 0);
+}
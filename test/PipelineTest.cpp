@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <Pipeline.hpp>
+#include <SpscQueue.hpp>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+TEST(PipelineTest, SpscQueueTest)
+{
+  using namespace deck_of_cards;
+  SpscQueue<int> queue(4);
+
+  EXPECT_THROW(SpscQueue<int>(3), std::invalid_argument);
+
+  // a full queue refuses the producer, which is what applies backpressure
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+
+  int value = -1;
+  EXPECT_TRUE(queue.try_pop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(queue.try_push(4));
+
+  std::thread consumer([&queue]() {
+    int expected = 1;
+    int next = 0;
+    while (expected < 10000)
+    {
+      if (queue.try_pop(next))
+      {
+        EXPECT_EQ(next, expected++);
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (int i = 5; i < 10000; ++i)
+  {
+    while (!queue.try_push(i))
+    {
+      std::this_thread::yield();
+    }
+  }
+  consumer.join();
+}
+
+TEST(PipelineTest, AggregatesEveryHandTest)
+{
+  using namespace deck_of_cards;
+  Pipeline::Config config;
+  config.lanes = 2;
+  config.batch_size = 64;
+  config.queue_capacity = 2;
+
+  std::array<std::uint64_t, 9> categories = {};
+  Pipeline pipeline(config, [&categories](const RankBatch& batch) {
+    for (std::size_t hand = 0; hand < batch.num_hands; ++hand)
+    {
+      categories[static_cast<int>(hand_category(batch.ranks[hand]))]++;
+    }
+  });
+
+  const std::uint64_t num_hands = 5000;
+  const auto stats = pipeline.run(num_hands);
+
+  std::uint64_t total = 0;
+  for (const auto count : categories)
+  {
+    total += count;
+  }
+  EXPECT_EQ(total, num_hands);
+  EXPECT_EQ(stats.deal.hands, num_hands);
+  EXPECT_EQ(stats.evaluate.hands, num_hands);
+  EXPECT_EQ(stats.aggregate.hands, num_hands);
+  EXPECT_EQ(stats.deal.batches, (num_hands / 2 + 63) / 64 * 2);
+  EXPECT_GT(stats.wall_seconds, 0.0);
+
+  // one pair or better shows up in about 83% of 7 card hands
+  EXPECT_GT(categories[0], 0u);
+  EXPECT_GT(categories[1], categories[0]);
+}
+
+TEST(PipelineTest, SeedTest)
+{
+  using namespace deck_of_cards;
+  Pipeline::Config config;
+  config.lanes = 3;
+  config.batch_size = 16;
+
+  // the lanes finish in any order, so compare what they dealt rather than the order of the batches
+  std::array<std::uint64_t, 9> categories = {};
+  std::uint64_t checksum = 0;
+  Pipeline pipeline(config, [&categories, &checksum](const RankBatch& batch) {
+    for (std::size_t hand = 0; hand < batch.num_hands; ++hand)
+    {
+      categories[static_cast<int>(hand_category(batch.ranks[hand]))]++;
+      checksum += batch.ranks[hand];
+    }
+  });
+
+  pipeline.run(2000);
+  const auto first = categories;
+  const std::uint64_t first_checksum = checksum;
+  categories = {};
+  checksum = 0;
+  pipeline.run(2000);
+  EXPECT_EQ(categories, first);
+  EXPECT_EQ(checksum, first_checksum);
+
+  // rand() is left alone
+  std::srand(9);
+  const int expected = std::rand();
+  std::srand(9);
+  pipeline.run(100);
+  EXPECT_EQ(std::rand(), expected);
+
+  config.seed = 2;
+  checksum = 0;
+  Pipeline other(config, [&checksum](const RankBatch& batch) {
+    for (std::size_t hand = 0; hand < batch.num_hands; ++hand)
+    {
+      checksum += batch.ranks[hand];
+    }
+  });
+  other.run(2000);
+  EXPECT_NE(checksum, first_checksum);
+}
+
+TEST(PipelineTest, CustomStagesTest)
+{
+  using namespace deck_of_cards;
+  Pipeline::Config config;
+  config.cards_per_hand = 2;
+  config.lanes = 3;
+
+  // the default evaluate stage cannot rank two cards
+  const Pipeline::AggregateStage ignore = [](const RankBatch&) {};
+  EXPECT_THROW(Pipeline(config, ignore).run(0), std::invalid_argument);
+  config.cards_per_hand = 4;
+  EXPECT_THROW(Pipeline(config, ignore).run(0), std::invalid_argument);
+  config.cards_per_hand = 2;
+
+  std::uint64_t hands = 0;
+  const Pipeline::EvaluateStage evaluate = [](const CardBatch& cards, RankBatch& ranks) {
+    for (std::size_t hand = 0; hand < cards.num_hands; ++hand)
+    {
+      ranks.ranks[hand] = cards.hand(hand)[0] != cards.hand(hand)[1];
+    }
+  };
+  Pipeline pipeline(config, evaluate, [&hands](const RankBatch& batch) {
+    for (std::size_t hand = 0; hand < batch.num_hands; ++hand)
+    {
+      EXPECT_EQ(batch.ranks[hand], 1);
+    }
+    hands += batch.num_hands;
+  });
+  pipeline.set_deal_stage([](TableState&, CardBatch& batch) {
+    for (std::size_t i = 0; i < batch.num_hands * batch.cards_per_hand; ++i)
+    {
+      batch.cards[i] = static_cast<CardId>(i % NumCards);
+    }
+  });
+
+  pipeline.run(1001);
+  EXPECT_EQ(hands, 1001u);
+
+  pipeline.run(0);
+  EXPECT_EQ(hands, 1001u);
+
+  // nor when it replaces the custom stage
+  pipeline.set_evaluate_stage(&Pipeline::evaluate_hands);
+  EXPECT_THROW(pipeline.run(1), std::invalid_argument);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <Equity.hpp>
+#include <FairnessMonitor.hpp>
+#include <PreflopEquity.hpp>
+#include <Range.hpp>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+deck_of_cards::CardSet cards(std::initializer_list<deck_of_cards::CardId> ids)
+{
+  return deck_of_cards::CardSet(ids.begin(), ids.size());
+}
+
+// a cheap stand-in for the exact equity that only looks at the values, so it is invariant under suit relabeling
+double value_equity(deck_of_cards::CardSet hero, deck_of_cards::CardSet villain)
+{
+  int difference = 0;
+  for (deck_of_cards::CardId card = 0; card < deck_of_cards::NumCards; ++card)
+  {
+    difference += hero.contains(card) ? card % 13 : 0;
+    difference -= villain.contains(card) ? card % 13 : 0;
+  }
+  return 0.5 + difference / 100.0;
+}
+
+}  // namespace
+
+TEST(PreflopEquityTest, HeadsUpTest)
+{
+  using namespace deck_of_cards;
+  const CardSet hero = cards({ 0, 13 });
+  const CardSet villain = cards({ 12, 25 });
+  const CardSet flop = cards({ 27, 33, 46 });
+
+  Range hero_range;
+  hero_range.set_weight(0, 13, 1);
+  Range villain_range;
+  villain_range.set_weight(12, 25, 1);
+  EXPECT_NEAR(heads_up_equity(hero, villain, flop), range_equity(hero_range, villain_range, flop, CardSet(), 1).equity,
+              1e-12);
+  EXPECT_NEAR(heads_up_equity(hero, villain, flop) + heads_up_equity(villain, hero, flop), 1, 1e-12);
+
+  // on the river the better hand simply wins
+  const CardSet river = flop | cards({ 5, 6 });
+  EXPECT_EQ(heads_up_equity(hero, villain, river), 1);
+  EXPECT_THROW(heads_up_equity(hero, hero, flop), std::invalid_argument);
+}
+
+TEST(PreflopEquityTest, TableTest)
+{
+  using namespace deck_of_cards;
+  const PreflopEquityTable table(2, &value_equity);
+
+  // 1326 * 1225 / 2 matchups of disjoint combinations collapse into far fewer suit isomorphism classes
+  EXPECT_LT(table.num_matchup_classes(), 50000u);
+
+  for (std::size_t hero = 0; hero < NumCombos; hero += 7)
+  {
+    for (std::size_t villain = 0; villain < NumCombos; villain += 11)
+    {
+      if (combo_cards(hero).intersects(combo_cards(villain)))
+      {
+        EXPECT_EQ(table.equity(hero, villain), 0);
+        continue;
+      }
+      ASSERT_NEAR(table.equity(hero, villain), value_equity(combo_cards(hero), combo_cards(villain)), 1.0 / 65535);
+      ASSERT_NEAR(table.equity(hero, villain) + table.equity(villain, hero), 1, 1e-12);
+    }
+  }
+
+  // AKs against 72o, the classes of the value based equity only depend on the values
+  const std::size_t aks = starting_hand_class(0, 12);
+  const std::size_t seven_two = starting_hand_class(6, 14);
+  EXPECT_NEAR(table.class_equity(aks, seven_two), 0.5 + (0 + 12 - 6 - 1) / 100.0, 1.0 / 65535);
+  EXPECT_NEAR(table.class_equity(aks, seven_two) + table.class_equity(seven_two, aks), 1, 1e-4);
+  EXPECT_NEAR(table.equity(cards({ 0, 12 }), cards({ 6, 14 })), table.class_equity(aks, seven_two), 1.0 / 65535);
+}
+
+TEST(PreflopEquityTest, PersistTest)
+{
+  using namespace deck_of_cards;
+  const std::string path = ::testing::TempDir() + "PreflopEquityTest.table";
+  {
+    const PreflopEquityTable generated(1, &value_equity);
+    generated.save(path);
+  }
+
+  const PreflopEquityTable mapped(path);
+  EXPECT_EQ(mapped.num_matchup_classes(), 0u);
+  EXPECT_NEAR(mapped.equity(combo_index(0, 13), combo_index(12, 25)), value_equity(cards({ 0, 13 }), cards({ 12, 25 })),
+              1.0 / 65535);
+
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(4096);
+    file.put('\x55');
+  }
+  EXPECT_THROW(PreflopEquityTable(path, true), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(PreflopEquityTable(path, false), std::runtime_error);
+}
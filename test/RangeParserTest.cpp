@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <Deck.hpp>
+#include <Range.hpp>
+#include <RangeParser.hpp>
+#include <stdexcept>
+#include <string>
+
+TEST(RangeParserTest, NotationTest)
+{
+  using namespace deck_of_cards;
+  EXPECT_EQ(parse_range("").num_combos(), 0u);
+  EXPECT_EQ(parse_range("AA").num_combos(), 6u);
+  EXPECT_EQ(parse_range("AKs").num_combos(), 4u);
+  EXPECT_EQ(parse_range("AKo").num_combos(), 12u);
+  EXPECT_EQ(parse_range("AK").num_combos(), 16u);
+  EXPECT_EQ(parse_range("TT+").num_combos(), 30u);
+  EXPECT_EQ(parse_range("TT-77").num_combos(), 24u);
+  EXPECT_EQ(parse_range("77-TT").num_combos(), 24u);
+  EXPECT_EQ(parse_range("A5s-A2s").num_combos(), 16u);
+  EXPECT_EQ(parse_range("A5s+").num_combos(), 36u);
+  EXPECT_EQ(parse_range("K9o+").num_combos(), 48u);
+  EXPECT_EQ(parse_range("22+, A2+, K2+, Q2+, J2+, T2+, 92+, 82+, 72+, 62+, 52+, 42+, 32").num_combos(), NumCombos);
+
+  // order of the values, case and whitespace do not matter
+  const Range ak = parse_range("AKs");
+  const Range ka = parse_range(" k a S ");
+  for (std::size_t combo = 0; combo < NumCombos; ++combo)
+  {
+    ASSERT_EQ(ak.weight(combo), ka.weight(combo));
+  }
+  const CardId ace_club = card_id(Suit::Club, Value::Ace);
+  const CardId king_club = card_id(Suit::Club, Value::King);
+  EXPECT_EQ(ak.weight(combo_index(ace_club, king_club)), 1);
+  EXPECT_EQ(ak.weight(combo_index(ace_club, card_id(Suit::Heart, Value::King))), 0);
+
+  const Range exact = parse_range("AhKh");
+  EXPECT_EQ(exact.num_combos(), 1u);
+  EXPECT_TRUE(exact.contains(combo_index(card_id(Suit::Heart, Value::Ace), card_id(Suit::Heart, Value::King))));
+}
+
+TEST(RangeParserTest, WeightTest)
+{
+  using namespace deck_of_cards;
+  const Range range = parse_range("AKs, A5s-A2s:0.5, AcKc:0.25, QQ:0");
+  const CardId ace_club = card_id(Suit::Club, Value::Ace);
+  EXPECT_EQ(range.weight(combo_index(ace_club, card_id(Suit::Club, Value::King))), 0.25f);
+  EXPECT_EQ(range.weight(combo_index(ace_club, card_id(Suit::Diamond, Value::King))), 0.0f);
+  EXPECT_EQ(range.weight(combo_index(card_id(Suit::Spade, Value::Ace), card_id(Suit::Spade, Value::King))), 1.0f);
+  EXPECT_EQ(range.weight(combo_index(ace_club, card_id(Suit::Club, Value::Three))), 0.5f);
+  EXPECT_EQ(range.num_combos(), 20u);
+  EXPECT_DOUBLE_EQ(range.total_weight(), 3 + 0.25 + 16 * 0.5);
+
+  // the combination bitmask follows the weights
+  std::size_t members = 0;
+  for (std::size_t combo = 0; combo < NumCombos; ++combo)
+  {
+    ASSERT_EQ(range.contains(combo), range.weight(combo) > 0);
+    members += range.contains(combo);
+  }
+  EXPECT_EQ(members, range.num_combos());
+  EXPECT_EQ(Range::full().num_combos(), NumCombos);
+}
+
+TEST(RangeParserTest, InvalidTest)
+{
+  using namespace deck_of_cards;
+  for (const char* text : { "AKx", "AAs", "AA+s", "AKs-QJs", "AKs-A2o", "AhKh+", "AhAh", "AA:", "AA:-1", "AA:x",
+                            "AA,,KK", "AA,", "AK-", "XX", "A", "AhK", "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA" })
+  {
+    EXPECT_THROW(parse_range(text), std::invalid_argument) << text;
+  }
+}
+
+TEST(RangeParserTest, DeckTest)
+{
+  using namespace deck_of_cards;
+  Deck deck;
+  deck.shuffle();
+  CardId dealt[5];
+  ASSERT_EQ(deck.deal_cards(dealt, 5), 5u);
+  const CardSet removed(dealt, 5);
+  EXPECT_EQ(deck.undealt(), CardSet::full() - removed);
+
+  const Range range = parse_range("22+, A2+, K2+, Q2+, J2+, T2+, 92+, 82+, 72+, 62+, 52+, 42+, 32", deck);
+  EXPECT_EQ(range.num_combos(), 47u * 46 / 2);
+  for (std::size_t combo = 0; combo < NumCombos; ++combo)
+  {
+    ASSERT_EQ(range.contains(combo), !combo_cards(combo).intersects(removed));
+  }
+}
+
+TEST(RangeParserTest, CacheTest)
+{
+  using namespace deck_of_cards;
+  RangeCache cache(2);
+  const auto first = cache.get("TT+");
+  EXPECT_EQ(cache.get("TT+"), first);
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 1u);
+
+  cache.get("AKs");
+  cache.get("TT+");
+  cache.get("QQ");  // evicts AKs, the least recently used
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.get("TT+"), first);
+  cache.get("AKs");
+  EXPECT_EQ(cache.misses(), 4u);
+
+  EXPECT_THROW(cache.get("AKx"), std::invalid_argument);
+  EXPECT_EQ(cache.size(), 2u);
+
+  Deck deck;
+  EXPECT_EQ(cache.get("TT+", deck).num_combos(), 30u);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.hits(), 0u);
+  EXPECT_THROW(RangeCache(0), std::invalid_argument);
+}
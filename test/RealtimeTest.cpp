@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <DeckBatch.hpp>
+#include <HandEvaluator.hpp>
+#include <Realtime.hpp>
+#include <TableScheduler.hpp>
+#include <atomic>
+
+TEST(RealtimeTest, PrefaultTest)
+{
+  using namespace deck_of_cards;
+  DeckBatch batch(100);
+  PageBuffer buffer(HugePageSize, PageMode::Transparent);
+
+  RealtimeMemory::Config config;
+  RealtimeMemory realtime(config);
+  realtime.add(batch);
+  realtime.add(buffer);
+
+  const RealtimeReport report = realtime.report();
+  EXPECT_EQ(report.regions, 3u);
+  EXPECT_EQ(report.prefaulted_bytes, HandEvaluator::instance().table_bytes() + 100 * DeckStride + buffer.size());
+  EXPECT_EQ(report.locked_bytes, 0u);
+  EXPECT_FALSE(report.lock_failed);
+
+  // prefaulting must not change the contents
+  EXPECT_EQ(batch.order(99)[51], 51);
+  EXPECT_EQ(batch.num_cards(99), NumCards);
+}
+
+TEST(RealtimeTest, LockTest)
+{
+  using namespace deck_of_cards;
+  DeckBatch batch(1000);
+
+  RealtimeMemory::Config config;
+  config.lock_memory = true;
+  config.warm_evaluator = false;
+  {
+    RealtimeMemory realtime(config);
+    realtime.add(batch);
+
+    // an unprivileged process may be refused by RLIMIT_MEMLOCK, which must be reported rather than thrown
+    const RealtimeReport report = realtime.report();
+    if (report.lock_failed)
+    {
+      EXPECT_EQ(report.locked_bytes, 0u);
+    }
+    else
+    {
+      EXPECT_EQ(report.locked_bytes, 1000 * DeckStride);
+      EXPECT_GE(report.pinned_bytes, report.locked_bytes);
+    }
+  }
+  EXPECT_EQ(locked_process_memory(), 0u);
+}
+
+TEST(RealtimeTest, TableReserveTest)
+{
+  using namespace deck_of_cards;
+  TableScheduler scheduler(4, 2);
+
+  RealtimeMemory::Config config;
+  config.warm_evaluator = false;
+  RealtimeMemory realtime(config);
+  realtime.add(scheduler, 64);
+
+  std::atomic<int> dealt(0);
+  for (TableId table = 0; table < 4; ++table)
+  {
+    scheduler.post(table, [&dealt](TableState& state) { dealt += state.deck.deal_card() != nullptr; });
+  }
+  scheduler.wait_idle();
+  EXPECT_EQ(dealt.load(), 4);
+}
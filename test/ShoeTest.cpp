@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <Shoe.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(ShoeTest, DealTest)
+{
+  using namespace deck_of_cards;
+  Shoe shoe(6);
+  EXPECT_EQ(shoe.num_decks(), 6u);
+  EXPECT_EQ(shoe.num_cards(), 6 * NumCards);
+  EXPECT_EQ(shoe.count(Value::Ace), 24u);
+
+  std::mt19937 generator(7);
+  shoe.shuffle(generator);
+  std::vector<CardId> cards(shoe.num_cards() + 1);
+  EXPECT_EQ(shoe.deal_cards(cards.data(), 100), 100u);
+  EXPECT_EQ(shoe.num_dealt(), 100u);
+
+  std::size_t counted = 0;
+  for (std::size_t value = 0; value < 13; ++value)
+  {
+    const std::size_t dealt = std::count_if(cards.begin(), cards.begin() + 100,
+                                            [value](CardId card) { return card % 13 == value; });
+    EXPECT_EQ(shoe.counts()[value] + dealt, 24u);
+    counted += shoe.counts()[value];
+  }
+  EXPECT_EQ(counted, shoe.num_cards());
+
+  // shuffling keeps the dealt cards dealt and the remainder intact
+  shoe.shuffle();
+  EXPECT_EQ(shoe.deal_cards(cards.data() + 100, cards.size()), 6 * NumCards - 100);
+  EXPECT_EQ(shoe.num_cards(), 0u);
+  cards.pop_back();
+  std::sort(cards.begin(), cards.end());
+  for (std::size_t i = 0; i < cards.size(); ++i)
+  {
+    ASSERT_EQ(cards[i], i / 6);
+  }
+
+  shoe.reset();
+  EXPECT_EQ(shoe.num_cards(), 6 * NumCards);
+  EXPECT_EQ(shoe.count(Value::King), 24u);
+  EXPECT_THROW(Shoe(0), std::invalid_argument);
+}
+
+TEST(ShoeTest, InfiniteShoeTest)
+{
+  using namespace deck_of_cards;
+  InfiniteShoe shoe(5);
+  EXPECT_EQ(shoe.num_cards(), std::numeric_limits<std::size_t>::max());
+  EXPECT_NEAR(shoe.probability(Value::Seven), 1.0 / 13, 1e-9);
+
+  // batches draw the same cards as single deals
+  InfiniteShoe same(5);
+  std::vector<CardId> cards(1000);
+  EXPECT_EQ(shoe.deal_cards(cards.data(), cards.size()), cards.size());
+  for (const auto card : cards)
+  {
+    ASSERT_EQ(card, same.deal_card());
+  }
+  EXPECT_EQ(shoe.num_dealt(), 1000u);
+  shoe.reset();
+  EXPECT_EQ(shoe.num_dealt(), 0u);
+
+  // shuffling reseeds from the generator
+  std::mt19937 first(11);
+  std::mt19937 second(11);
+  shoe.shuffle(first);
+  same.shuffle(second);
+  EXPECT_EQ(shoe.deal_card(), same.deal_card());
+
+  // a composition of tens and aces only, tens four times as likely
+  double weights[13] = {};
+  weights[0] = 1;
+  weights[9] = 4;
+  InfiniteShoe weighted(weights, 13);
+  EXPECT_NEAR(weighted.probability(Value::Ten), 0.8, 1e-9);
+  EXPECT_EQ(weighted.probability(Value::King), 0);
+  weighted.deal_cards(cards.data(), cards.size());
+  const auto tens = std::count_if(cards.begin(), cards.end(), [](CardId card) { return card % 13 == 9; });
+  const auto aces = std::count_if(cards.begin(), cards.end(), [](CardId card) { return card % 13 == 0; });
+  EXPECT_EQ(tens + aces, 1000);
+  EXPECT_NEAR(tens, 800, 70);
+
+  EXPECT_THROW(InfiniteShoe(weights, 12), std::invalid_argument);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <HandEvaluator.hpp>
+#include <Showdown.hpp>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// deals a board and num_seats two card hands from a fresh random deck
+void deal_showdown(deck_of_cards::CardSet& board, deck_of_cards::CardSet* hands, std::size_t num_seats)
+{
+  using namespace deck_of_cards;
+  CardSet used;
+  auto next = [&used]() {
+    CardId card;
+    do
+    {
+      card = static_cast<CardId>(rand() % NumCards);
+    } while (used.contains(card));
+    used.insert(card);
+    return card;
+  };
+
+  board = CardSet();
+  for (int i = 0; i < 5; ++i)
+  {
+    board.insert(next());
+  }
+  for (std::size_t seat = 0; seat < num_seats; ++seat)
+  {
+    hands[seat] = CardSet();
+    hands[seat].insert(next());
+    hands[seat].insert(next());
+  }
+}
+
+}  // namespace
+
+TEST(ShowdownTest, MatchesScalarTest)
+{
+  using namespace deck_of_cards;
+  for (int trial = 0; trial < 2000; ++trial)
+  {
+    const std::size_t num_seats = 2 + trial % 9;
+    CardSet board;
+    CardSet hands[MaxShowdownSeats];
+    deal_showdown(board, hands, num_seats);
+
+    HandRank ranks[MaxShowdownSeats];
+    const ShowdownResult result = showdown(board, hands, num_seats, ranks);
+
+    HandRank best = 0;
+    for (std::size_t seat = 0; seat < num_seats; ++seat)
+    {
+      ASSERT_EQ(ranks[seat], evaluate(board | hands[seat]));
+      best = std::max(best, ranks[seat]);
+    }
+    std::uint32_t winners = 0;
+    for (std::size_t seat = 0; seat < num_seats; ++seat)
+    {
+      winners |= (ranks[seat] == best ? 1u : 0u) << seat;
+    }
+    ASSERT_EQ(result.best, best);
+    ASSERT_EQ(result.winners, winners);
+  }
+}
+
+TEST(ShowdownTest, SplitPotTest)
+{
+  using namespace deck_of_cards;
+  // a royal flush in spades on the board plays for every seat
+  const CardId royal[] = { 39, 48, 49, 50, 51 };
+  const CardSet board(royal, 5);
+  const CardId holes[][2] = { { 0, 1 }, { 13, 14 }, { 26, 27 } };
+  const CardSet hands[] = { CardSet(holes[0], 2), CardSet(holes[1], 2), CardSet(holes[2], 2) };
+
+  const ShowdownResult result = showdown(board, hands, 3);
+  EXPECT_EQ(result.winners, 0x7u);
+  EXPECT_EQ(result.best, NumHandRanks);
+  EXPECT_EQ(result.num_winners(), 3u);
+  EXPECT_TRUE(result.split());
+
+  EXPECT_THROW(showdown(board, hands, 0), std::invalid_argument);
+  EXPECT_THROW(showdown(board, hands, 17), std::invalid_argument);
+  const CardSet overlapping[] = { CardSet(std::uint64_t(1) << 39) | CardSet(std::uint64_t(1) << 1) };
+  EXPECT_THROW(showdown(board, overlapping, 1), std::invalid_argument);
+  const CardSet shared[] = { hands[0], hands[1], CardSet(std::uint64_t(1) << 14 | std::uint64_t(1) << 27) };
+  EXPECT_THROW(showdown(board, shared, 3), std::invalid_argument);
+  EXPECT_THROW(showdown_batch(&board, shared, 3, nullptr, 1), std::invalid_argument);
+}
+
+TEST(ShowdownTest, BatchTest)
+{
+  using namespace deck_of_cards;
+  const std::size_t num_seats = 9;
+  const std::size_t count = 500;
+  std::vector<CardSet> boards(count);
+  std::vector<CardSet> hands(count * num_seats);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    deal_showdown(boards[i], &hands[i * num_seats], num_seats);
+  }
+
+  std::vector<ShowdownResult> results(count);
+  showdown_batch(boards.data(), hands.data(), num_seats, results.data(), count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const ShowdownResult single = showdown(boards[i], &hands[i * num_seats], num_seats);
+    EXPECT_EQ(results[i].winners, single.winners);
+    EXPECT_EQ(results[i].best, single.best);
+  }
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <SortingNetwork.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+TEST(SortingNetworkTest, ZeroOnePrincipleTest)
+{
+  using namespace deck_of_cards;
+  // a comparator network sorts every input if and only if it sorts every sequence of zeros and ones
+  for (std::size_t count = 0; count <= MaxSortCards; ++count)
+  {
+    for (unsigned bits = 0; bits < (1u << count); ++bits)
+    {
+      CardId cards[MaxSortCards];
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        cards[i] = (bits >> i) & 1;
+      }
+      sort_cards(cards, count);
+      ASSERT_TRUE(std::is_sorted(cards, cards + count)) << count << " cards, input " << bits;
+    }
+  }
+
+  EXPECT_EQ(sorting_network_size(2), 1u);
+  EXPECT_EQ(sorting_network_size(5), 9u);
+  EXPECT_EQ(sorting_network_size(7), 16u);
+}
+
+TEST(SortingNetworkTest, SortCardsTest)
+{
+  using namespace deck_of_cards;
+  for (std::size_t count = 0; count <= NumCards; ++count)
+  {
+    std::vector<CardId> cards(count);
+    for (auto& card : cards)
+    {
+      card = static_cast<CardId>(rand() % NumCards);
+    }
+    std::vector<CardId> expected = cards;
+    std::sort(expected.begin(), expected.end());
+
+    sort_cards(cards.data(), count);
+    EXPECT_EQ(cards, expected);
+  }
+}
+
+TEST(SortingNetworkTest, SortHandsTest)
+{
+  using namespace deck_of_cards;
+  // 1000 hands leave a tail that does not fill a vector
+  const std::size_t num_hands = 1000;
+  for (std::size_t cards_per_hand = 2; cards_per_hand <= MaxSortCards; ++cards_per_hand)
+  {
+    std::vector<CardId> cards(num_hands * cards_per_hand);
+    for (auto& card : cards)
+    {
+      card = static_cast<CardId>(rand() % NumCards);
+    }
+    std::vector<CardId> expected = cards;
+    for (std::size_t hand = 0; hand < num_hands; ++hand)
+    {
+      std::sort(expected.begin() + hand * cards_per_hand, expected.begin() + (hand + 1) * cards_per_hand);
+    }
+
+    sort_hands(cards.data(), cards_per_hand, num_hands);
+    ASSERT_EQ(cards, expected) << cards_per_hand << " cards per hand";
+  }
+}
+
+TEST(SortingNetworkTest, SortedHandTest)
+{
+  using namespace deck_of_cards;
+  const CardId dealt[] = { 40, 3, 17, 51, 0 };
+  SortedHand hand(dealt, 5);
+  EXPECT_EQ(hand.size(), 5u);
+  EXPECT_TRUE(std::is_sorted(hand.begin(), hand.end()));
+  EXPECT_EQ(hand[0], 0);
+  EXPECT_EQ(hand[4], 51);
+
+  hand.insert(20);
+  EXPECT_EQ(hand.size(), 6u);
+  EXPECT_EQ(hand[3], 20);
+  EXPECT_TRUE(hand.contains(20));
+  EXPECT_EQ(hand.rank(20), 3u);
+  EXPECT_EQ(hand.set(), CardSet(dealt, 5) | CardSet(std::uint64_t(1) << 20));
+
+  EXPECT_TRUE(hand.erase(3));
+  EXPECT_FALSE(hand.erase(3));
+  EXPECT_FALSE(hand.contains(3));
+  EXPECT_EQ(hand.size(), 5u);
+  EXPECT_TRUE(std::is_sorted(hand.begin(), hand.end()));
+
+  SortedHand full;
+  for (CardId card = 0; card < MaxSortCards; ++card)
+  {
+    full.insert(static_cast<CardId>(50 - 3 * card));
+  }
+  EXPECT_TRUE(std::is_sorted(full.begin(), full.end()));
+  EXPECT_THROW(full.insert(51), std::length_error);
+  EXPECT_THROW(SortedHand(dealt, 14), std::length_error);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <TableGame.hpp>
+#include <ThreeCardPoker.hpp>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+// one card each, the higher value wins even money with aces high
+class HighCard : public deck_of_cards::TableGame
+{
+public:
+  std::string name() const override
+  {
+    return "high card";
+  }
+
+  std::vector<std::size_t> groups() const override
+  {
+    return { 1, 1 };
+  }
+
+  double settle(const deck_of_cards::CardSet* groups) const override
+  {
+    const int player = rank(groups[0]);
+    const int dealer = rank(groups[1]);
+    return player > dealer ? 1 : player < dealer ? -1 : 0;
+  }
+
+private:
+  static int rank(deck_of_cards::CardSet card)
+  {
+    return (__builtin_ctzll(card.mask()) % 13 + 12) % 13;
+  }
+};
+
+}  // namespace
+
+TEST(TableGameTest, SuitClassTest)
+{
+  using namespace deck_of_cards;
+  // every set of two cards belongs to exactly one class whose sizes add up to all sets
+  std::size_t classes = 0;
+  std::size_t sets = 0;
+  for (CardId high = 1; high < NumCards; ++high)
+  {
+    for (CardId low = 0; low < high; ++low)
+    {
+      const CardId cards[] = { low, high };
+      const CardSet set(cards, 2);
+      if (suit_canonical(set))
+      {
+        ++classes;
+        sets += suit_class_size(set);
+      }
+    }
+  }
+  EXPECT_EQ(classes, 169u);
+  EXPECT_EQ(sets, 1326u);
+}
+
+TEST(TableGameTest, EnumerationTest)
+{
+  using namespace deck_of_cards;
+  const HighCard game;
+  TableGameVerifier verifier(game, TableGameVerifier::Config());
+  EXPECT_EQ(verifier.num_units(), 13u);
+
+  const VerificationResult result = verifier.run();
+  EXPECT_TRUE(result.complete());
+  EXPECT_EQ(result.deals, 52u * 51);
+  EXPECT_EQ(result.settled, 13u * 51);
+  EXPECT_NEAR(result.expected_value, 0, 1e-15);
+  EXPECT_NEAR(result.standard_deviation, std::sqrt(48.0 / 51), 1e-12);
+}
+
+TEST(TableGameTest, CheckpointTest)
+{
+  using namespace deck_of_cards;
+  const std::string path = ::testing::TempDir() + "TableGameTest.checkpoint";
+  std::remove(path.c_str());
+
+  const PairPlus game;
+  const VerificationResult reference = TableGameVerifier(game, TableGameVerifier::Config()).run();
+
+  TableGameVerifier::Config config;
+  config.num_threads = 2;
+  config.checkpoint = path;
+  config.checkpoint_interval = 10;
+  config.max_units = 100;
+  std::vector<VerificationProgress> reports;
+  config.progress = [&reports](const VerificationProgress& progress) { reports.push_back(progress); };
+
+  TableGameVerifier verifier(game, config);
+  const VerificationResult partial = verifier.run();
+  EXPECT_FALSE(partial.complete());
+  EXPECT_EQ(partial.units_done, 100u);
+  ASSERT_EQ(reports.size(), 100u);
+  EXPECT_EQ(reports.back().units_done, 100u);
+  EXPECT_EQ(reports.back().num_units, verifier.num_units());
+
+  // a new verifier resumes where the first one stopped
+  config.max_units = 0;
+  const VerificationResult resumed = TableGameVerifier(game, config).run();
+  EXPECT_TRUE(resumed.complete());
+  EXPECT_EQ(resumed.deals, reference.deals);
+  EXPECT_EQ(resumed.settled, reference.settled);
+  EXPECT_NEAR(resumed.expected_value, reference.expected_value, 1e-15);
+  EXPECT_EQ(reports.size(), verifier.num_units());
+  EXPECT_EQ(reports.back().units_done, verifier.num_units());
+
+  // the checkpoint of one paytable does not resume another
+  const double pays[] = { 0, 1, 3, 6, 30, 40 };
+  const PairPlus other(pays);
+  EXPECT_THROW(TableGameVerifier(other, config).run(), std::runtime_error);
+  std::remove(path.c_str());
+
+  config.checkpoint_interval = 0;
+  EXPECT_THROW(TableGameVerifier(game, config), std::invalid_argument);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <TableScheduler.hpp>
+#include <ThreadPool.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
+TEST(TableSchedulerTest, ThreadPoolRunsAllTasksTest)
+{
+  using namespace deck_of_cards;
+  std::atomic<int> count(0);
+  ThreadPool pool(4);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    // nested submissions land on the submitting worker's own deque
+    pool.submit([&pool, &count]() {
+      count++;
+      pool.submit([&count]() { count++; });
+    });
+  }
+  pool.wait_idle();
+
+  EXPECT_EQ(count, 2000);
+}
+
+TEST(TableSchedulerTest, MessagesRunInOrderTest)
+{
+  using namespace deck_of_cards;
+  const std::size_t num_tables = 1000;
+  const int num_messages = 20;
+  TableScheduler scheduler(num_tables, 4);
+
+  // plain ints: every table's messages run one at a time, so no synchronization is needed
+  std::vector<int> next(num_tables, 0);
+  std::vector<int> out_of_order(num_tables, 0);
+  for (int message = 0; message < num_messages; ++message)
+  {
+    for (TableId table = 0; table < num_tables; ++table)
+    {
+      scheduler.post(table, [&next, &out_of_order, table, message](TableState&) {
+        if (next[table]++ != message)
+        {
+          out_of_order[table]++;
+        }
+      });
+    }
+  }
+  scheduler.wait_idle();
+
+  for (TableId table = 0; table < num_tables; ++table)
+  {
+    EXPECT_EQ(next[table], num_messages);
+    EXPECT_EQ(out_of_order[table], 0);
+  }
+}
+
+TEST(TableSchedulerTest, DealHandsTest)
+{
+  using namespace deck_of_cards;
+  const std::size_t num_tables = 200;
+  TableScheduler scheduler(num_tables, 2);
+
+  std::atomic<int> dealt(0);
+  std::atomic<int> follow_ups(0);
+  for (TableId table = 0; table < num_tables; ++table)
+  {
+    scheduler.post(table, [](TableState& state) {
+      state.deck.reset();
+      state.shuffle();
+    });
+    scheduler.post(table, [&dealt](TableState& state) {
+      for (int card = 0; card < 9 * 2 + 5; ++card)
+      {
+        if (state.deck.deal_card())
+        {
+          dealt++;
+        }
+      }
+    });
+    // a message can post follow-ups to other tables
+    scheduler.post(table, [&scheduler, &dealt, &follow_ups, table, num_tables](TableState& state) {
+      dealt += static_cast<int>(state.deck.num_cards());
+      scheduler.post((table + 1) % num_tables, [&follow_ups](TableState&) { follow_ups++; });
+    });
+  }
+  scheduler.wait_idle();
+
+  EXPECT_EQ(dealt, static_cast<int>(num_tables * NumCards));
+  EXPECT_EQ(follow_ups, static_cast<int>(num_tables));
+}
+
+TEST(TableSchedulerTest, TableGeneratorTest)
+{
+  using namespace deck_of_cards;
+  const std::size_t num_tables = 64;
+
+  // the first card of every table after one shuffle, which only depends on the seed and the table id
+  auto first_cards = [num_tables](std::uint64_t seed) {
+    TableScheduler scheduler(num_tables, 2, seed);
+    std::vector<CardId> cards(num_tables);
+    for (TableId table = 0; table < num_tables; ++table)
+    {
+      scheduler.post(table, [&cards, table](TableState& state) {
+        state.shuffle();
+        state.deck.deal_cards(&cards[table], 1);
+      });
+    }
+    scheduler.wait_idle();
+    return cards;
+  };
+
+  srand(1);
+  const std::vector<CardId> first = first_cards(7);
+  srand(2);
+  EXPECT_EQ(first_cards(7), first);
+  EXPECT_NE(first_cards(8), first);
+
+  // tables get streams of their own
+  std::vector<bool> seen(NumCards, false);
+  std::size_t distinct = 0;
+  for (const CardId card : first)
+  {
+    distinct += seen[card] ? 0 : 1;
+    seen[card] = true;
+  }
+  EXPECT_GT(distinct, 20u);
+}
+
+TEST(TableSchedulerTest, ReserveWhileRunningTest)
+{
+  using namespace deck_of_cards;
+  const std::size_t num_tables = 100;
+  TableScheduler scheduler(num_tables, 2);
+
+  // reserving touches every mailbox, including those of tables whose messages are running
+  std::atomic<int> count(0);
+  for (int message = 0; message < 10; ++message)
+  {
+    for (TableId table = 0; table < num_tables; ++table)
+    {
+      scheduler.post(table, [&scheduler, &count, message](TableState&) {
+        scheduler.reserve(static_cast<std::size_t>(message) * 4);
+        count++;
+      });
+    }
+  }
+  scheduler.wait_idle();
+
+  EXPECT_EQ(count, static_cast<int>(num_tables * 10));
+}
+
+TEST(TableSchedulerTest, UnknownTableTest)
+{
+  using namespace deck_of_cards;
+  TableScheduler scheduler(1, 1);
+
+  EXPECT_THROW(scheduler.post(1, [](TableState&) {}), std::out_of_range);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <TableGame.hpp>
+#include <ThreeCardPoker.hpp>
+
+namespace
+{
+deck_of_cards::CardSet cards(std::initializer_list<deck_of_cards::CardId> ids)
+{
+  return deck_of_cards::CardSet(ids.begin(), ids.size());
+}
+
+}  // namespace
+
+TEST(ThreeCardPokerTest, RankTest)
+{
+  using namespace deck_of_cards;
+  // club ids: ace 0, deuce 1, ..., king 12; diamonds start at 13
+  EXPECT_EQ(three_card_category(three_card_rank(cards({ 0, 12, 11 }))), ThreeCardCategory::StraightFlush);
+  EXPECT_EQ(three_card_category(three_card_rank(cards({ 4, 17, 30 }))), ThreeCardCategory::ThreeOfAKind);
+  EXPECT_EQ(three_card_category(three_card_rank(cards({ 0, 14, 2 }))), ThreeCardCategory::Straight);
+  EXPECT_EQ(three_card_category(three_card_rank(cards({ 0, 5, 9 }))), ThreeCardCategory::Flush);
+  EXPECT_EQ(three_card_category(three_card_rank(cards({ 0, 13, 9 }))), ThreeCardCategory::Pair);
+  EXPECT_EQ(three_card_category(three_card_rank(cards({ 0, 18, 9 }))), ThreeCardCategory::HighCard);
+
+  // ace-2-3 is the lowest straight, ace-king-queen the highest
+  EXPECT_LT(three_card_rank(cards({ 0, 14, 2 })), three_card_rank(cards({ 1, 15, 3 })));
+  EXPECT_GT(three_card_rank(cards({ 0, 25, 11 })), three_card_rank(cards({ 12, 24, 10 })));
+  // pairs compare by the pair first, then the kicker
+  EXPECT_GT(three_card_rank(cards({ 4, 17, 1 })), three_card_rank(cards({ 3, 16, 0 })));
+  EXPECT_GT(three_card_rank(cards({ 4, 17, 6 })), three_card_rank(cards({ 30, 43, 5 })));
+  EXPECT_EQ(three_card_rank(cards({ 4, 17, 6 })), three_card_rank(cards({ 30, 43, 19 })));
+}
+
+TEST(ThreeCardPokerTest, SettleTest)
+{
+  using namespace deck_of_cards;
+  const ThreeCardPoker game;
+  // Q-6-3 folds, Q-6-4 plays against a non qualifying dealer
+  const CardSet folded[] = { cards({ 11, 18, 28 }), cards({ 40, 46, 50 }) };
+  EXPECT_EQ(game.settle(folded), -1);
+  const CardSet played[] = { cards({ 11, 18, 29 }), cards({ 40, 20, 49 }) };
+  EXPECT_EQ(game.settle(played), 1);
+  // a straight loses to trips but keeps its ante bonus
+  const CardSet straight[] = { cards({ 0, 14, 2 }), cards({ 4, 17, 30 }) };
+  EXPECT_EQ(game.settle(straight), -1);
+}
+
+TEST(ThreeCardPokerTest, HouseEdgeTest)
+{
+  using namespace deck_of_cards;
+  TableGameVerifier::Config config;
+  config.num_threads = 2;
+
+  // the published figures of the common paytables
+  const PairPlus pair_plus;
+  const VerificationResult pairs = TableGameVerifier(pair_plus, config).run();
+  EXPECT_EQ(pairs.deals, 22100u);
+  EXPECT_NEAR(pairs.expected_value, -0.0232, 1e-4);
+
+  const ThreeCardPoker ante;
+  TableGameVerifier verifier(ante, config);
+  EXPECT_EQ(verifier.num_units(), 1755u);
+  const VerificationResult result = verifier.run();
+  EXPECT_EQ(result.deals, 22100u * 18424);
+  EXPECT_NEAR(result.expected_value, -0.0337, 1e-4);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <UltimateHoldem.hpp>
+
+namespace
+{
+deck_of_cards::CardSet cards(std::initializer_list<deck_of_cards::CardId> ids)
+{
+  return deck_of_cards::CardSet(ids.begin(), ids.size());
+}
+
+}  // namespace
+
+TEST(UltimateHoldemTest, StrategyTest)
+{
+  using namespace deck_of_cards;
+  // club ids: ace 0, deuce 1, ..., king 12; diamonds start at 13, hearts at 26 and spades at 39
+  const CardSet flop = cards({ 27, 33, 47 });
+  const CardSet turn_river = cards({ 43, 18 });
+
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 2, 15 }), flop, turn_river), 4);   // 33
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 0, 14 }), flop, turn_river), 4);   // A2 offsuit
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 12, 4 }), flop, turn_river), 4);   // K5 suited
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 12, 17 }), flop, turn_river), 4);  // K5 offsuit
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 12, 16 }), flop, turn_river), 0);  // K4 offsuit, nothing later
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 11, 28 }), flop, turn_river), 0);  // Q3 offsuit, nothing later
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 11, 5 }), flop, turn_river), 4);   // Q6 suited
+
+  // J8 offsuit pairs the eight on the flop, 54 offsuit pairs the five on the river
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 10, 20 }), flop, turn_river), 2);
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 4, 16 }), flop, turn_river), 1);
+  // pocket deuces make trips on this flop, but check another one and raise with two pair on the river
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 1, 14 }), flop, turn_river), 2);
+  EXPECT_EQ(UltimateHoldem::play_wager(cards({ 1, 14 }), cards({ 30, 35, 50 }), turn_river), 1);
+}
+
+TEST(UltimateHoldemTest, SettleTest)
+{
+  using namespace deck_of_cards;
+  const UltimateHoldem game;
+  const CardSet flop = cards({ 27, 33, 47 });
+  const CardSet turn_river = cards({ 43, 18 });
+
+  // aces raised 4 times beat a qualifying dealer pair of tens: play, ante and a pushed blind
+  const CardSet aces[] = { cards({ 0, 13 }), flop, turn_river, cards({ 22, 9 }) };
+  EXPECT_EQ(game.settle(aces), 5);
+  // against a non qualifying dealer the ante pushes
+  const CardSet unqualified[] = { cards({ 0, 13 }), flop, turn_river, cards({ 22, 23 }) };
+  EXPECT_EQ(game.settle(unqualified), 4);
+  // a folded hand loses ante and blind
+  const CardSet folded[] = { cards({ 11, 18 }), flop, cards({ 43, 20 }), cards({ 22, 23 }) };
+  EXPECT_EQ(game.settle(folded), -2);
+  // a flush pays the blind at 3 to 2
+  const CardSet flush[] = { cards({ 26, 35 }), flop, cards({ 29, 18 }), cards({ 19, 7 }) };
+  EXPECT_EQ(game.settle(flush), 4 + 1 + 1.5);
+  // losing a 4 times raise costs everything
+  const CardSet beaten[] = { cards({ 12, 25 }), flop, turn_river, cards({ 20, 46 }) };
+  EXPECT_EQ(game.settle(beaten), -6);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <CardSet.hpp>
+#include <VideoPoker.hpp>
+#include <functional>
+#include <stdexcept>
+
+namespace
+{
+deck_of_cards::CardSet cards(std::initializer_list<deck_of_cards::CardId> ids)
+{
+  return deck_of_cards::CardSet(ids.begin(), ids.size());
+}
+
+// enumerates the draws of one hold directly
+double brute_force(const deck_of_cards::Paytable& paytable, const deck_of_cards::CardId* deal, unsigned hold)
+{
+  using namespace deck_of_cards;
+  const CardSet dealt(deal, 5);
+  CardSet held;
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    if (hold & (1u << i))
+    {
+      held.insert(deal[i]);
+    }
+  }
+  const std::size_t missing = 5 - held.size();
+
+  double total = 0;
+  double draws = 0;
+  CardId drawn[5] = {};
+  // odometer over ascending draws from the cards not dealt
+  std::function<void(std::size_t, CardId)> draw = [&](std::size_t depth, CardId from) {
+    if (depth == missing)
+    {
+      total += paytable.pays[static_cast<int>(pay_category(held | CardSet(drawn, missing)))];
+      draws += 1;
+      return;
+    }
+    for (CardId card = from; card < NumCards; ++card)
+    {
+      if (!dealt.contains(card))
+      {
+        drawn[depth] = card;
+        draw(depth + 1, static_cast<CardId>(card + 1));
+      }
+    }
+  };
+  draw(0, 0);
+
+  return total / draws;
+}
+
+}  // namespace
+
+TEST(VideoPokerTest, CategoryTest)
+{
+  using namespace deck_of_cards;
+  // club ids: ace 0, deuce 1, ..., king 12; diamonds start at 13
+  EXPECT_EQ(pay_category(cards({ 0, 9, 10, 11, 12 })), PayCategory::RoyalFlush);
+  EXPECT_EQ(pay_category(cards({ 0, 1, 2, 3, 4 })), PayCategory::StraightFlush);
+  EXPECT_EQ(pay_category(cards({ 0, 13, 26, 39, 4 })), PayCategory::FourOfAKind);
+  EXPECT_EQ(pay_category(cards({ 0, 13, 26, 4, 17 })), PayCategory::FullHouse);
+  EXPECT_EQ(pay_category(cards({ 0, 2, 4, 6, 8 })), PayCategory::Flush);
+  EXPECT_EQ(pay_category(cards({ 13, 9, 10, 11, 12 })), PayCategory::Straight);
+  EXPECT_EQ(pay_category(cards({ 13, 1, 2, 3, 4 })), PayCategory::Straight);
+  EXPECT_EQ(pay_category(cards({ 1, 14, 27, 4, 8 })), PayCategory::ThreeOfAKind);
+  EXPECT_EQ(pay_category(cards({ 1, 14, 4, 17, 8 })), PayCategory::TwoPair);
+  EXPECT_EQ(pay_category(cards({ 10, 23, 4, 6, 8 })), PayCategory::HighPair);
+  EXPECT_EQ(pay_category(cards({ 9, 22, 4, 6, 8 })), PayCategory::LowPair);
+  EXPECT_EQ(pay_category(cards({ 13, 2, 4, 6, 8 })), PayCategory::Nothing);
+  EXPECT_EQ(pay_category(cards({ 12, 0, 1, 2, 16 })), PayCategory::Nothing);  // no wrap around straights
+}
+
+TEST(VideoPokerTest, HoldTest)
+{
+  using namespace deck_of_cards;
+  const Paytable paytable = Paytable::jacks_or_better();
+  const VideoPokerSolver solver(paytable);
+
+  const CardId deals[][5] = { { 10, 23, 4, 32, 47 }, { 0, 12, 11, 2, 44 }, { 51, 1, 27, 14, 40 }, { 3, 5, 7, 9, 33 } };
+  for (const auto& deal : deals)
+  {
+    double values[NumHolds];
+    solver.hold_values(deal, values);
+    for (unsigned hold = 0; hold < NumHolds; ++hold)
+    {
+      ASSERT_NEAR(values[hold], brute_force(paytable, deal, hold), 1e-12) << hold;
+    }
+  }
+
+  // a dealt royal flush is held whole, four to a royal beats a low pair
+  const CardId royal[] = { 12, 0, 9, 10, 11 };
+  EXPECT_EQ(solver.best_hold(royal), 31u);
+  const CardId four_to_royal[] = { 0, 9, 10, 11, 14 };
+  EXPECT_EQ(solver.best_hold(four_to_royal), 15u);
+  const CardId repeated[] = { 0, 0, 9, 10, 11 };
+  EXPECT_THROW(solver.best_hold(repeated), std::invalid_argument);
+}
+
+TEST(VideoPokerTest, AnalyzeTest)
+{
+  using namespace deck_of_cards;
+  const VideoPokerAnalysis analysis = VideoPokerSolver(Paytable::jacks_or_better()).analyze(2);
+
+  // the published return of full pay Jacks or Better
+  EXPECT_EQ(analysis.deal_classes, 134459u);
+  EXPECT_NEAR(analysis.expected_return, 0.995439, 1e-6);
+  EXPECT_NEAR(analysis.probabilities[static_cast<int>(PayCategory::RoyalFlush)], 0.0000247583, 1e-9);
+  EXPECT_NEAR(analysis.probabilities[static_cast<int>(PayCategory::FourOfAKind)], 0.0236248 / 10, 1e-7);
+
+  double total = 0;
+  for (const auto probability : analysis.probabilities)
+  {
+    total += probability;
+  }
+  EXPECT_NEAR(total, 1, 1e-12);
+}
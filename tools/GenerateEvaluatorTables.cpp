@@ -0,0 +1,43 @@
+// Generates the hand evaluator lookup tables and writes them to a file that HandEvaluator::instance() maps at startup
+// when DECK_OF_CARDS_EVALUATOR_TABLES names it.
+//
+// usage: GenerateEvaluatorTables <path> [threads]
+
+#include <HandEvaluator.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  if (argc < 2)
+  {
+    std::fprintf(stderr, "usage: %s <path> [threads]\n", argv[0]);
+    return 2;
+  }
+  const std::size_t num_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+  try
+  {
+    const auto start = Clock::now();
+    const HandEvaluator evaluator(num_threads);
+    const double generated = std::chrono::duration<double>(Clock::now() - start).count();
+    evaluator.save(argv[1]);
+
+    // map the file back to make sure it is usable before anyone relies on it
+    const HandEvaluator mapped{ std::string(argv[1]) };
+    std::printf("wrote %zu bytes of version %u tables to %s, generated in %.3f s\n", mapped.table_bytes(),
+                EvaluatorTableVersion, argv[1], generated);
+  }
+  catch (const std::exception& error)
+  {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+
+  return 0;
+}
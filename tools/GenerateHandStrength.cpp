@@ -0,0 +1,81 @@
+// Computes the expected hand strength table of a street and optionally clusters it into buckets. The output file is
+// also the checkpoint: stopping and restarting the tool resumes from the last write, and max_units splits the job into
+// several runs. The buckets of every entry are written as raw 16 bit integers, NoBucket for unused entries.
+//
+// usage: GenerateHandStrength <flop|turn|river> <file> [bins] [threads] [max_units] [buckets bucket_file]
+
+#include <HandStrength.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+
+  const std::string street_name = argc > 1 ? argv[1] : "";
+  Street street = Street::Flop;
+  bool valid = true;
+  if (street_name == "flop")
+  {
+    street = Street::Flop;
+  }
+  else if (street_name == "turn")
+  {
+    street = Street::Turn;
+  }
+  else if (street_name == "river")
+  {
+    street = Street::River;
+  }
+  else
+  {
+    valid = false;
+  }
+  if (!valid || argc < 3 || argc == 7)
+  {
+    std::fprintf(stderr, "usage: %s <flop|turn|river> <file> [bins] [threads] [max_units] [buckets bucket_file]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  HandStrengthJob::Config config;
+  config.path = argv[2];
+  config.num_bins = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : config.num_bins;
+  config.num_threads = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 0;
+  config.max_units = argc > 5 ? std::strtoul(argv[5], nullptr, 10) : 0;
+  config.progress = [](const HandStrengthProgress& progress) {
+    std::fprintf(stderr, "\r%zu/%zu boards in %.0f s", progress.units_done, progress.num_units, progress.seconds);
+  };
+
+  try
+  {
+    HandStrengthJob job(street, config);
+    const bool complete = job.run();
+    std::fprintf(stderr, "\n");
+    std::printf("%s: %zu/%zu boards\n", complete ? "complete" : "partial", job.units_done(), job.num_units());
+
+    if (argc > 7)
+    {
+      const HandStrengthTable table(config.path, street, config.num_bins);
+      const std::vector<std::uint16_t> buckets =
+        table.cluster(std::strtoul(argv[6], nullptr, 10), 20, config.num_threads);
+      std::FILE* file = std::fopen(argv[7], "wb");
+      if (file == nullptr || std::fwrite(buckets.data(), sizeof(std::uint16_t), buckets.size(), file) != buckets.size())
+      {
+        throw std::runtime_error(std::string("Cannot write ") + argv[7]);
+      }
+      std::fclose(file);
+      std::printf("%zu entries clustered into %s buckets\n", buckets.size(), argv[6]);
+    }
+  }
+  catch (const std::exception& error)
+  {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+
+  return 0;
+}
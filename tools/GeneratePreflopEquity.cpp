@@ -0,0 +1,44 @@
+// Computes the exact heads-up preflop equity of every pair of combinations and writes the PreflopEquityTable file.
+// Every suit isomorphism class enumerates all 1.7 million boards, so this takes CPU hours; run it once per format
+// version and ship the file.
+//
+// usage: GeneratePreflopEquity <path> [threads]
+
+#include <PreflopEquity.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+  using Clock = std::chrono::steady_clock;
+
+  if (argc < 2)
+  {
+    std::fprintf(stderr, "usage: %s <path> [threads]\n", argv[0]);
+    return 2;
+  }
+  const std::size_t num_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+  try
+  {
+    const auto start = Clock::now();
+    const PreflopEquityTable table(num_threads);
+    const double generated = std::chrono::duration<double>(Clock::now() - start).count();
+    table.save(argv[1]);
+
+    // map the file back to make sure it is usable before anyone relies on it
+    const PreflopEquityTable mapped{ std::string(argv[1]) };
+    std::printf("wrote version %u preflop equities of %zu matchup classes to %s, generated in %.0f s\n",
+                PreflopEquityVersion, table.num_matchup_classes(), argv[1], generated);
+  }
+  catch (const std::exception& error)
+  {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+// Enumerates every deal of a table game and prints its exact house edge. Ultimate Texas Hold'em settles trillions of
+// deals and runs for days, so give it a checkpoint file: stopping and restarting the tool resumes from the last
+// checkpoint, and max_units splits the enumeration into several runs.
+//
+// usage: VerifyTableGame <threecard|pairplus|ultimate> [checkpoint] [threads] [max_units]
+
+#include <TableGame.hpp>
+#include <ThreeCardPoker.hpp>
+#include <UltimateHoldem.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+int main(int argc, char** argv)
+{
+  using namespace deck_of_cards;
+
+  const std::string game_name = argc > 1 ? argv[1] : "";
+  std::unique_ptr<TableGame> game;
+  if (game_name == "threecard")
+  {
+    game.reset(new ThreeCardPoker());
+  }
+  else if (game_name == "pairplus")
+  {
+    game.reset(new PairPlus());
+  }
+  else if (game_name == "ultimate")
+  {
+    game.reset(new UltimateHoldem());
+  }
+  else
+  {
+    std::fprintf(stderr, "usage: %s <threecard|pairplus|ultimate> [checkpoint] [threads] [max_units]\n", argv[0]);
+    return 2;
+  }
+
+  TableGameVerifier::Config config;
+  config.checkpoint = argc > 2 ? argv[2] : "";
+  config.num_threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0;
+  config.max_units = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 0;
+  config.progress = [](const VerificationProgress& progress) {
+    std::fprintf(stderr, "\r%zu/%zu units, %llu deals settled in %.0f s", progress.units_done, progress.num_units,
+                 static_cast<unsigned long long>(progress.settled), progress.seconds);
+  };
+
+  try
+  {
+    TableGameVerifier verifier(*game, config);
+    const VerificationResult result = verifier.run();
+    std::fprintf(stderr, "\n");
+    std::printf("%s\n", game->name().c_str());
+    std::printf("%s: %zu/%zu units, %llu deals\n", result.complete() ? "complete" : "partial", result.units_done,
+                result.num_units, static_cast<unsigned long long>(result.deals));
+    std::printf("expected value %.8f, house edge %.6f%%, standard deviation %.6f\n", result.expected_value,
+                -100 * result.expected_value, result.standard_deviation);
+  }
+  catch (const std::exception& error)
+  {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+
+  return 0;
+}